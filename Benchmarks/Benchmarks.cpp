@@ -0,0 +1,18 @@
+// Benchmarks.cpp : This file contains the 'main' function. Program execution begins and ends there.
+// Benchmarks are meant to be run in Release; their numbers in Debug say little about the game's speed.
+//
+
+#include <cstdio>
+
+#include <Benchmarks.h>
+
+int main(int argc, char** argv) {
+    benchmarkLevelPackLoad();
+    benchmarkCookedLevelPackLoad();
+    benchmarkDeepAttackCompile();
+    benchmarkExpressionTFVBatch();
+    benchmarkSpatialHashTableUpdate();
+    benchmarkSweptCollision();
+    benchmarkBulletSpawn();
+    std::getchar(); // keep console window open until Return keystroke
+}
\ No newline at end of file
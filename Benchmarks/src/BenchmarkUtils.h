@@ -0,0 +1,22 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+// Amount of times each measurement is repeated; the median is reported
+const int RUNS = 5;
+
+/*
+Returns the median time in seconds that f takes out of RUNS runs.
+*/
+inline double medianSeconds(std::function<void()> f) {
+    std::vector<double> seconds;
+    for (int i = 0; i < RUNS; i++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(seconds.begin(), seconds.end());
+    return seconds[seconds.size() / 2];
+}
\ No newline at end of file
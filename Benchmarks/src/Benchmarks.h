@@ -0,0 +1,35 @@
+#pragma once
+
+/*
+Each benchmark prints its results to stdout.
+*/
+
+/*
+Times loading a synthetic 10k-object level pack from its JSON files.
+*/
+void benchmarkLevelPackLoad();
+/*
+Times starting up from a synthetic 10k-object level pack's cooked file against starting up from its JSON files.
+*/
+void benchmarkCookedLevelPackLoad();
+/*
+Times compiling the expressions of an attack whose EMPs are nested 64 deep and all redelegate their symbols to their parents.
+*/
+void benchmarkDeepAttackCompile();
+/*
+Times evaluating an ExpressionTFV in batches for a stream of bullets against evaluating the equivalent hand-written PiecewiseTFV.
+*/
+void benchmarkExpressionTFVBatch();
+/*
+Times updating a collision table incrementally against rebuilding it every frame, for slow, mixed, and fast bullets.
+*/
+void benchmarkSpatialHashTableUpdate();
+/*
+Times swept collision tests for fast bullets at the normal tick rate against discrete tests at twice the tick rate,
+and counts how many bullets each one catches.
+*/
+void benchmarkSweptCollision();
+/*
+Times spawning enemy bullets through EntityCreationQueue and reports how much memory each bullet's sprite takes.
+*/
+void benchmarkBulletSpawn();
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <Benchmarks.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <Constants.h>
+#include <LevelPack/Animatable.h>
+#include <DataStructs/SpatialHashTable.h>
+
+#include <BenchmarkUtils.h>
+
+namespace {
+    struct Mover {
+        uint32_t id;
+        PositionComponent position;
+        float vx;
+        float vy;
+    };
+
+    std::vector<Mover> createMovers(int count, float minSpeed, float maxSpeed, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> x(0, MAP_WIDTH);
+        std::uniform_real_distribution<float> y(0, MAP_HEIGHT);
+        std::uniform_real_distribution<float> angle(0, 6.2831853f);
+        std::uniform_real_distribution<float> speed(minSpeed, maxSpeed);
+        std::vector<Mover> movers;
+        for (int i = 0; i < count; i++) {
+            float a = angle(rng);
+            float s = speed(rng);
+            movers.push_back({ (uint32_t)i, PositionComponent(x(rng), y(rng)), s * std::cos(a), s * std::sin(a) });
+        }
+        return movers;
+    }
+
+    void step(std::vector<Mover>& movers, float deltaTime) {
+        for (Mover& mover : movers) {
+            float x = mover.position.getX() + mover.vx * deltaTime;
+            float y = mover.position.getY() + mover.vy * deltaTime;
+            // Bounce off the map edges so that the number of objects in the table stays constant
+            if (x < 0 || x > MAP_WIDTH) {
+                mover.vx = -mover.vx;
+            }
+            if (y < 0 || y > MAP_HEIGHT) {
+                mover.vy = -mover.vy;
+            }
+            mover.position.setX(std::max(0.0f, std::min((float)MAP_WIDTH, x)));
+            mover.position.setY(std::max(0.0f, std::min((float)MAP_HEIGHT, y)));
+        }
+    }
+
+    /*
+    The table as it was before it was incremental: every object is reinserted into every cell it overlaps each frame.
+    */
+    class RebuildingTable {
+    public:
+        RebuildingTable(float mapWidth, float mapHeight, float cellSize) : cellSize(cellSize) {
+            cellsPerMapWidth = (int)std::ceil(mapWidth / cellSize);
+            cellsPerMapHeight = (int)std::ceil(mapHeight / cellSize);
+            buckets.resize(cellsPerMapWidth * cellsPerMapHeight);
+        }
+
+        void clear() {
+            for (auto& bucket : buckets) {
+                bucket.clear();
+            }
+        }
+
+        void insert(uint32_t object, const HitboxComponent& hitbox, const PositionComponent& position) {
+            int left = std::max(0, (int)((position.getX() + hitbox.getX() - hitbox.getRadius()) / cellSize));
+            int right = std::min(cellsPerMapWidth - 1, (int)((position.getX() + hitbox.getX() + hitbox.getRadius()) / cellSize));
+            int bottom = std::max(0, (int)((position.getY() + hitbox.getY() - hitbox.getRadius()) / cellSize));
+            int top = std::min(cellsPerMapHeight - 1, (int)((position.getY() + hitbox.getY() + hitbox.getRadius()) / cellSize));
+            for (int xCell = left; xCell <= right; xCell++) {
+                for (int yCell = bottom; yCell <= top; yCell++) {
+                    buckets[xCell + yCell * cellsPerMapWidth].push_back(object);
+                }
+            }
+        }
+
+    private:
+        float cellSize;
+        int cellsPerMapWidth;
+        int cellsPerMapHeight;
+        std::vector<std::vector<uint32_t>> buckets;
+    };
+}
+
+void benchmarkSpatialHashTableUpdate() {
+    const int bullets = 5000;
+    const int frames = 240;
+    const float deltaTime = 1 / 120.0f;
+    // Cell size used by CollisionSystem's default table
+    const float cellSize = std::max(MAP_WIDTH, MAP_HEIGHT) / 10.0f;
+    HitboxComponent hitbox(ROTATION_TYPE::LOCK_ROTATION, 4, 0, 0);
+
+    struct SpeedDistribution {
+        const char* name;
+        float minSpeed;
+        float maxSpeed;
+    };
+    for (const SpeedDistribution& distribution : { SpeedDistribution{ "slow", 20, 80 }, SpeedDistribution{ "mixed", 20, 500 }, SpeedDistribution{ "fast", 400, 900 } }) {
+        const std::vector<Mover> initialMovers = createMovers(bullets, distribution.minSpeed, distribution.maxSpeed, 2);
+
+        double rebuildSeconds = medianSeconds([&]() {
+            std::vector<Mover> movers = initialMovers;
+            RebuildingTable table(MAP_WIDTH, MAP_HEIGHT, cellSize);
+            for (int frame = 0; frame < frames; frame++) {
+                step(movers, deltaTime);
+                table.clear();
+                for (const Mover& mover : movers) {
+                    table.insert(mover.id, hitbox, mover.position);
+                }
+            }
+        });
+        double incrementalSeconds = medianSeconds([&]() {
+            std::vector<Mover> movers = initialMovers;
+            SpatialHashTable<uint32_t> table(MAP_WIDTH, MAP_HEIGHT, cellSize);
+            for (int frame = 0; frame < frames; frame++) {
+                step(movers, deltaTime);
+                for (const Mover& mover : movers) {
+                    table.update(mover.id, hitbox, mover.position);
+                }
+            }
+        });
+
+        std::cout << "Spatial hash table update (" << bullets << " " << distribution.name << " bullets, median of " << RUNS << " runs): full rebuild "
+            << (rebuildSeconds / frames) * 1000000 << "us per frame; incremental update " << (incrementalSeconds / frames) * 1000000 << "us per frame" << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <Benchmarks.h>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <DataStructs/TimeFunctionVariable.h>
+
+#include <BenchmarkUtils.h>
+
+void benchmarkExpressionTFVBatch() {
+    const int bullets = 2000;
+    const int frames = 120;
+    const float deltaTime = 1 / 120.0f;
+
+    // The same curve written by hand as two linear segments
+    std::shared_ptr<ExpressionTFV> expressionTFV = std::make_shared<ExpressionTFV>("if(t < 1, 100*t, 100 + 50*(t-1))", 3);
+    expressionTFV->bindSymbols({});
+    std::shared_ptr<PiecewiseTFV> piecewiseTFV = std::make_shared<PiecewiseTFV>();
+    piecewiseTFV->insertSegment(std::make_pair(0.0f, std::make_shared<LinearTFV>(0, 100, 1)), 3);
+    piecewiseTFV->insertSegment(std::make_pair(1.0f, std::make_shared<LinearTFV>(100, 200, 2)), 3);
+
+    // Bullets spawned a frame apart, like a stream
+    std::vector<float> times(bullets);
+    for (int i = 0; i < bullets; i++) {
+        times[i] = (i % 240) * deltaTime;
+    }
+
+    // The sums keep the evaluations from being optimized away
+    float piecewiseSum = 0;
+    double piecewiseSeconds = medianSeconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            for (int i = 0; i < bullets; i++) {
+                piecewiseSum += piecewiseTFV->evaluate(times[i] + frame * deltaTime);
+            }
+        }
+    });
+
+    ExpressionTFVBatch batch;
+    std::shared_ptr<TFV> asTFV = expressionTFV;
+    float expressionSum = 0;
+    double expressionSeconds = medianSeconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            for (int i = 0; i < bullets; i++) {
+                asTFV->addToExpressionBatch(batch, times[i] + frame * deltaTime);
+            }
+            batch.run();
+            for (int i = 0; i < bullets; i++) {
+                expressionSum += asTFV->evaluate(times[i] + frame * deltaTime);
+            }
+            batch.clear();
+        }
+    });
+
+    std::cout << "TFV evaluation (" << bullets << " bullets, median of " << RUNS << " runs): hand-written PiecewiseTFV "
+        << (piecewiseSeconds / frames) * 1000000 << "us per frame; batched ExpressionTFV " << (expressionSeconds / frames) * 1000000
+        << "us per frame (sums " << piecewiseSum << ", " << expressionSum << ")" << std::endl;
+}
\ No newline at end of file
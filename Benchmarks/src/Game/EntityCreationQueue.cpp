@@ -0,0 +1,117 @@
+#include <Benchmarks.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include <Constants.h>
+#include <DataStructs/SpriteLoader.h>
+#include <DataStructs/TimeFunctionVariable.h>
+#include <Game/EntityCreationQueue.h>
+#include <Game/Components/LevelManagerTag.h>
+#include <Game/Components/PositionComponent.h>
+#include <Game/Components/SpriteComponent.h>
+#include <LevelPack/Animatable.h>
+#include <LevelPack/Attack.h>
+#include <LevelPack/EditorMovablePoint.h>
+#include <LevelPack/EditorMovablePointAction.h>
+#include <LevelPack/EditorMovablePointSpawnType.h>
+#include <LevelPack/Level.h>
+
+#include <BenchmarkUtils.h>
+
+// Every heap allocation made by BHM_benchmark, so that benchmarks can count the allocations made by some piece of code
+static std::atomic<size_t> allocationsCount{ 0 };
+static std::atomic<size_t> allocatedBytes{ 0 };
+
+void* operator new(std::size_t size) {
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t size) noexcept {
+    std::free(p);
+}
+
+/*
+Prints the heap allocations and bytes that a bullet's sprite costs when spawned, with the SpriteTemplates shared by
+SpriteComponent against the sf::Sprite that was copied out of SpriteLoader into a second sf::Sprite owned by each entity.
+*/
+static void printSpriteFootprint(SpriteLoader& spriteLoader, const Animatable& animatable) {
+    const int sprites = 1000;
+
+    std::vector<SpriteComponent> components;
+    components.reserve(sprites);
+    // The first use of a sprite caches its template, which later bullets share
+    components.emplace_back(spriteLoader, animatable, true, ENEMY_BULLET_LAYER, 0);
+    size_t allocationsBefore = allocationsCount;
+    size_t bytesBefore = allocatedBytes;
+    for (int i = 1; i < sprites; i++) {
+        components.emplace_back(spriteLoader, animatable, true, ENEMY_BULLET_LAYER, 0);
+    }
+    double templateAllocations = (double)(allocationsCount - allocationsBefore) / (sprites - 1);
+    double templateBytes = (double)(allocatedBytes - bytesBefore) / (sprites - 1);
+
+    std::vector<std::shared_ptr<sf::Sprite>> copiedSprites;
+    copiedSprites.reserve(sprites);
+    allocationsBefore = allocationsCount;
+    bytesBefore = allocatedBytes;
+    for (int i = 0; i < sprites; i++) {
+        copiedSprites.push_back(std::make_shared<sf::Sprite>(*spriteLoader.getSprite(animatable.getAnimatableName(), animatable.getSpriteSheetName())));
+    }
+    double copiedAllocations = (double)(allocationsCount - allocationsBefore) / sprites;
+    double copiedBytes = (double)(allocatedBytes - bytesBefore) / sprites;
+
+    std::cout << "Bullet sprite footprint: SpriteComponent is " << sizeof(SpriteComponent) << " bytes plus " << templateAllocations << " heap allocations ("
+        << templateBytes << " bytes) per bullet; the old sf::Sprite pair was 2 std::shared_ptr<sf::Sprite> (" << 2 * sizeof(std::shared_ptr<sf::Sprite>)
+        << " bytes) plus " << copiedAllocations << " heap allocations (" << copiedBytes << " bytes, sizeof(sf::Sprite) is " << sizeof(sf::Sprite) << ") per bullet" << std::endl;
+}
+
+void benchmarkBulletSpawn() {
+    const int bullets = 10000;
+
+    SpriteLoader spriteLoader("Benchmark_BulletSpawn");
+    // The sprite sheet doesn't exist, so every bullet uses the missing sprite, which is shared the same way any other sprite is
+    Animatable animatable("Bullet", "Benchmark", true, ROTATION_TYPE::LOCK_ROTATION);
+
+    EditorAttack attack(0);
+    std::shared_ptr<EditorMovablePoint> emp = attack.getMainEMP()->createChild();
+    emp->setHitboxRadius("4");
+    emp->setAnimatable(animatable);
+    emp->setSpawnType(std::make_shared<SpecificGlobalEMPSpawn>("0", "300", "300"));
+    emp->insertAction(0, std::make_shared<MoveCustomPolarEMPA>(std::make_shared<LinearTFV>(0, 500, 2), std::make_shared<ConstantTFV>(1.0f), 2));
+    attack.compileExpressions({});
+
+    // Registries are kept until the end so that destroying the bullets isn't timed
+    std::vector<std::unique_ptr<entt::DefaultRegistry>> registries;
+    double seconds = medianSeconds([&]() {
+        registries.push_back(std::make_unique<entt::DefaultRegistry>());
+        entt::DefaultRegistry& registry = *registries.back();
+        registry.assign<LevelManagerTag>(entt::tag_t{}, registry.create(), nullptr, std::make_shared<Level>());
+        uint32_t enemy = registry.create();
+        registry.assign<PositionComponent>(enemy, 300.0f, 300.0f);
+
+        EntityCreationQueue queue(registry);
+        for (int i = 0; i < bullets; i++) {
+            queue.pushBack(std::make_unique<EMPSpawnFromEnemyCommand>(registry, spriteLoader, emp, false, enemy, 0, attack.getID(), -1, -1, -1, false));
+        }
+        queue.executeAll();
+    });
+    std::cout << "Bullet spawn (" << bullets << " bullets through EntityCreationQueue, median of " << RUNS << " runs): "
+        << (seconds / bullets) * 1000000 << "us per bullet" << std::endl;
+
+    printSpriteFootprint(spriteLoader, animatable);
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include <Benchmarks.h>
+
+#include <iostream>
+#include <string>
+
+#include <LevelPack/Attack.h>
+#include <LevelPack/EditorMovablePoint.h>
+
+#include <BenchmarkUtils.h>
+
+void benchmarkDeepAttackCompile() {
+    const int depth = 64;
+    const int symbolsCount = 32;
+    const int compilesPerRun = 200;
+
+    EditorAttack attack(0);
+    ValueSymbolTable attackSymbols;
+    ValueSymbolTable redelegatedSymbols;
+    for (int i = 0; i < symbolsCount; i++) {
+        attackSymbols.setSymbol("s" + std::to_string(i), (float)i, false);
+        redelegatedSymbols.setSymbol("s" + std::to_string(i), 0, true);
+    }
+    attack.setSymbolTable(attackSymbols);
+
+    // Every EMP in the chain redelegates every symbol to its parent
+    std::shared_ptr<EditorMovablePoint> emp = attack.getMainEMP();
+    for (int i = 0; i < depth; i++) {
+        emp->setSymbolTable(redelegatedSymbols);
+        emp->setHitboxRadius("s1 + s2 * s3 + s" + std::to_string(i % symbolsCount));
+        emp = emp->createChild();
+    }
+
+    double seconds = medianSeconds([&]() {
+        for (int i = 0; i < compilesPerRun; i++) {
+            attack.compileExpressions({});
+        }
+    });
+    std::cout << "Deep attack compile (" << depth << " nested EMPs redelegating " << symbolsCount << " symbols, median of " << RUNS << " runs): "
+        << (seconds / compilesPerRun) * 1000000 << "us per EditorAttack::compileExpressions()" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <Benchmarks.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <Config.h>
+#include <Game/AudioPlayer.h>
+#include <DataStructs/SpriteLoader.h>
+#include <LevelPack/LevelPack.h>
+#include <LevelPack/Attack.h>
+#include <LevelPack/AttackPattern.h>
+#include <LevelPack/Enemy.h>
+#include <LevelPack/EnemyPhase.h>
+#include <LevelPack/EditorMovablePoint.h>
+#include <Util/StringUtils.h>
+
+#include <BenchmarkUtils.h>
+
+/*
+Fills a level pack with 10k small objects that reference each other.
+Returns the ID of one of the attacks.
+*/
+static int createSyntheticLevelPack(LevelPack& levelPack) {
+    const int attacksCount = 7000;
+    const int attackPatternsCount = 1500;
+    const int enemyPhasesCount = 1000;
+    const int enemiesCount = 500;
+
+    std::vector<int> attackIDs;
+    std::vector<int> attackPatternIDs;
+    for (int i = 0; i < attacksCount; i++) {
+        std::shared_ptr<EditorAttack> attack = levelPack.createAttack();
+        attack->setName("attack " + std::to_string(i));
+        attack->getMainEMP()->createChild()->setHitboxRadius(std::to_string(i % 17));
+        attackIDs.push_back(attack->getID());
+    }
+    for (int i = 0; i < attackPatternsCount; i++) {
+        std::shared_ptr<EditorAttackPattern> attackPattern = levelPack.createAttackPattern();
+        attackPattern->addAttack(std::to_string(i % 5), attackIDs[i % attacksCount], ExprSymbolTable());
+        attackPatternIDs.push_back(attackPattern->getID());
+    }
+    for (int i = 0; i < enemyPhasesCount; i++) {
+        std::shared_ptr<EditorEnemyPhase> enemyPhase = levelPack.createEnemyPhase();
+        enemyPhase->addAttackPatternID(std::to_string(i % 3), attackPatternIDs[i % attackPatternsCount], ExprSymbolTable());
+    }
+    for (int i = 0; i < enemiesCount; i++) {
+        levelPack.createEnemy()->setName("enemy " + std::to_string(i));
+    }
+    return attackIDs[0];
+}
+
+/*
+Reads and parses every file in some level pack object folder one after another, the same way LevelPack::load() does on many threads.
+*/
+template<class T>
+static void parseSerially(const std::string& folderPath, const std::string& packName) {
+    for (const auto& entry : std::filesystem::directory_iterator(format(folderPath, packName.c_str()))) {
+        std::ifstream file(entry.path());
+        nlohmann::json j;
+        file >> j;
+        std::make_shared<T>()->load(j);
+    }
+}
+
+void benchmarkLevelPackLoad() {
+    const std::string packName = "Benchmark_LevelPackLoad";
+    const std::string packFolder = format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s", packName.c_str());
+    std::filesystem::remove_all(packFolder);
+    std::filesystem::create_directories(packFolder);
+
+    AudioPlayer audioPlayer;
+    std::shared_ptr<SpriteLoader> spriteLoader = std::make_shared<SpriteLoader>(packName);
+    {
+        LevelPack original(audioPlayer, packName, spriteLoader);
+        createSyntheticLevelPack(original);
+        original.save();
+    }
+
+    // The constructor loads the level pack
+    double loadSeconds = medianSeconds([&]() {
+        LevelPack loaded(audioPlayer, packName, spriteLoader);
+    });
+    // The same files with the same parsing as LevelPack::load(), minus its bookkeeping, on one thread
+    double serialParseSeconds = medianSeconds([&]() {
+        parseSerially<EditorAttack>(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME, packName);
+        parseSerially<EditorAttackPattern>(RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME, packName);
+        parseSerially<EditorEnemyPhase>(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME, packName);
+        parseSerially<EditorEnemy>(RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME, packName);
+    });
+    std::cout << "Level pack load (10k objects, median of " << RUNS << " runs): LevelPack::load() " << loadSeconds
+        << "s; reading and parsing the same files on one thread " << serialParseSeconds << "s" << std::endl;
+
+    std::filesystem::remove_all(packFolder);
+}
+
+void benchmarkCookedLevelPackLoad() {
+    const std::string packName = "Benchmark_CookedLevelPackLoad";
+    const std::string packFolder = format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s", packName.c_str());
+    std::filesystem::remove_all(packFolder);
+    std::filesystem::create_directories(packFolder);
+
+    AudioPlayer audioPlayer;
+    std::shared_ptr<SpriteLoader> spriteLoader = std::make_shared<SpriteLoader>(packName);
+    int attackID;
+    {
+        LevelPack original(audioPlayer, packName, spriteLoader);
+        attackID = createSyntheticLevelPack(original);
+        original.save();
+        if (!original.cook()) {
+            std::cout << "Cooked level pack load: failed to cook the level pack" << std::endl;
+            std::filesystem::remove_all(packFolder);
+            return;
+        }
+    }
+
+    auto startUp = [&](bool preferCookedFile) {
+        LevelPack levelPack(audioPlayer, packName, spriteLoader, preferCookedFile);
+        // Fetch one object, since a cooked level pack doesn't decode anything until it is needed
+        levelPack.getAttack(attackID);
+    };
+    // The files were just written, so they are in the OS file cache for every run
+    double cookedSeconds = medianSeconds([&]() {
+        startUp(true);
+    });
+    double jsonSeconds = medianSeconds([&]() {
+        startUp(false);
+    });
+    std::cout << "Level pack startup (10k objects, median of " << RUNS << " runs, files cached): from cooked file " << cookedSeconds
+        << "s; from JSON files " << jsonSeconds << "s" << std::endl;
+
+    std::filesystem::remove_all(packFolder);
+}
\ No newline at end of file
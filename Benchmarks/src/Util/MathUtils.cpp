@@ -0,0 +1,60 @@
+#include <Benchmarks.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <Constants.h>
+#include <Util/MathUtils.h>
+#include <LevelPack/Animatable.h>
+#include <Game/Components/HitboxComponent.h>
+#include <Game/Components/PositionComponent.h>
+
+#include <BenchmarkUtils.h>
+
+void benchmarkSweptCollision() {
+    const int bullets = 5000;
+    const int ticks = 240;
+    HitboxComponent playerHitbox(ROTATION_TYPE::LOCK_ROTATION, 2, 0, 0);
+    HitboxComponent bulletHitbox(ROTATION_TYPE::LOCK_ROTATION, 4, 0, 0);
+    PositionComponent player(MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f);
+
+    // Bullets in a 100px wide band moving straight down past the player at 900 px/s
+    const float speed = 900;
+    std::vector<float> startX(bullets);
+    int bulletsInReach = 0;
+    for (int i = 0; i < bullets; i++) {
+        startX[i] = player.getX() + (i % 200 - 100) * 0.5f;
+        bulletsInReach += std::abs(startX[i] - player.getX()) <= playerHitbox.getRadius() + bulletHitbox.getRadius();
+    }
+
+    // Discrete test at twice the tick rate
+    int discreteHits = 0;
+    double discreteSeconds = medianSeconds([&]() {
+        const float deltaTime = MAX_PHYSICS_DELTA_TIME / 2;
+        discreteHits = 0;
+        for (int tick = 0; tick < ticks * 2; tick++) {
+            for (int i = 0; i < bullets; i++) {
+                PositionComponent position(startX[i], speed * tick * deltaTime);
+                discreteHits += collides(player, playerHitbox, position, bulletHitbox);
+            }
+        }
+    });
+
+    // Swept test at the normal tick rate
+    int sweptHits = 0;
+    double sweptSeconds = medianSeconds([&]() {
+        const float deltaTime = MAX_PHYSICS_DELTA_TIME;
+        sweptHits = 0;
+        for (int tick = 1; tick < ticks; tick++) {
+            for (int i = 0; i < bullets; i++) {
+                PositionComponent position(startX[i], speed * tick * deltaTime);
+                sweptHits += sweptCollides(player, playerHitbox, startX[i], speed * (tick - 1) * deltaTime, position, bulletHitbox);
+            }
+        }
+    });
+
+    std::cout << "Fast bullet collision (" << bullets << " bullets at " << speed << "px/s over " << ticks << " ticks, median of " << RUNS << " runs): discrete test at double tick rate "
+        << discreteSeconds * 1000 << "ms, " << discreteHits << " hits; swept test " << sweptSeconds * 1000 << "ms, " << sweptHits << " hits; "
+        << bulletsInReach << " bullets pass through the player" << std::endl;
+}
\ No newline at end of file
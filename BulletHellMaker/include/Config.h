@@ -25,4 +25,6 @@ const static std::string RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME = RELAT
 const static std::string RELATIVE_LEVEL_PACK_BULLET_MODELS_FOLDER_NAME = RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\BulletModels";
 const static std::string RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME = RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\Enemies";
 const static std::string RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME = RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\EnemyPhases";
-const static std::string RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME = RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\Levels";
\ No newline at end of file
+const static std::string RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME = RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\Levels";
+// The cooked file that the game loads the level pack from if it exists; see LevelPack::cook()
+const static std::string RELATIVE_LEVEL_PACK_COOKED_FILE_PATH = RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\cooked.bhmpack";
\ No newline at end of file
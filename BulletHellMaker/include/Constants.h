@@ -10,6 +10,15 @@ const static float MAX_PHYSICS_DELTA_TIME = 1 / 30.0f;
 // Time between each frame render; render FPS = 1/RENDER_INTERVAL
 const static float RENDER_INTERVAL = 1 / 60.0f;
 
+// Number of physics updates' worth of past positions kept for each moving entity.
+// Every time lag used when spawning relative to an entity is the leftover of a single physics update,
+// so the history never needs to cover more than a couple of MAX_PHYSICS_DELTA_TIME.
+const static int POSITION_HISTORY_PHYSICS_STEPS = 2;
+// Number of position samples kept per MAX_PHYSICS_DELTA_TIME seconds of history
+const static int POSITION_HISTORY_SAMPLES_PER_PHYSICS_STEP = 8;
+// Time between each sample of an entity's position history
+const static float POSITION_HISTORY_SAMPLE_INTERVAL = MAX_PHYSICS_DELTA_TIME / POSITION_HISTORY_SAMPLES_PER_PHYSICS_STEP;
+
 // Epsilon for checking float equality
 const static float EPSILON = MAX_PHYSICS_DELTA_TIME / 10.0f;
 
@@ -28,6 +37,17 @@ const static int INITIAL_EDITOR_ENTITY_RESERVATION = 5000;
 // Additional amount of entities to reserve space for when current limit is exceeded
 const static int ENTITY_RESERVATION_INCREMENT = 50000;
 
+// Maximum amount of sounds that can be playing at once; SFML can only have a limited amount of sound sources alive
+const static int MAX_SOUND_VOICES = 64;
+// Maximum amount of instances of the same sound file that can be playing at once
+const static int MAX_VOICES_PER_SOUND = 8;
+// Fraction of a sound's volume added to it for every extra play of the same sound coalesced into it in the same update
+const static float COALESCED_SOUND_VOLUME_BOOST = 0.2f;
+// Maximum total size of the decoded samples of every cached sound, in bytes
+const static std::size_t SOUND_BUFFER_CACHE_MAX_BYTES = 64 * 1024 * 1024;
+// Priority of sounds caused by the player, which can take voices from sounds of lower priority
+const static int PLAYER_SOUND_PRIORITY = 1;
+
 // Time before an item despawns
 const static float ITEM_DESPAWN_TIME = 11.0f;
 
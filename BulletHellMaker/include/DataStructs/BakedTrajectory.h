@@ -0,0 +1,143 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#include <SFML/Graphics.hpp>
+
+#include <DataStructs/LRUCache.h>
+
+class MovablePoint;
+
+/*
+A movement path that depends only on time, either sampled at a fixed time interval or, for paths that
+only ever jump between fixed positions, stored as the position held from each jump to the next.
+
+Every bullet that follows the same path can share one BakedTrajectory (through BakedMP) so that
+moving it is a lookup and a lerp instead of evaluating curves.
+Sampling adds up to MAX_ALLOWED_ERROR of error, so it is only used for paths that are already
+approximations (constant-speed Bezier curves); stepped paths are exact.
+BakedTrajectories are created with getOrBake() and getOrBakeSteps(), which share them among identical paths,
+when a level that has baking enabled is loaded. Bullets only look them up with getBaked().
+*/
+class BakedTrajectory {
+public:
+	/*
+	Totals of every BakedTrajectory created since the program started.
+	*/
+	struct Stats {
+		// Number of paths that were baked
+		unsigned long long baked = 0;
+		// Number of paths that couldn't be baked within MAX_SAMPLES samples
+		unsigned long long failed = 0;
+		// Total memory used by the samples of every baked path, in bytes
+		unsigned long long bytes = 0;
+		// The largest maxError of any baked path
+		float maxError = 0;
+	};
+
+	// Largest allowed distance between a baked path and the path it was sampled from
+	const static float MAX_ALLOWED_ERROR;
+	// Time between samples that is tried first
+	const static float INITIAL_SAMPLE_INTERVAL;
+	// Largest number of samples in a single BakedTrajectory
+	const static int MAX_SAMPLES = 8192;
+	// Largest number of paths kept in the cache; the least recently used ones are removed first
+	const static std::size_t MAX_CACHED_TRAJECTORIES;
+
+	/*
+	The values that define a path, compared exactly.
+	The first value is always a PATH_TYPE, so that different kinds of paths never have the same key.
+	*/
+	typedef std::vector<float> Key;
+
+	enum class PATH_TYPE {
+		CONSTANT_SPEED_BEZIER,
+		POLAR,
+		STATIONARY
+	};
+
+	/*
+	Returns the BakedTrajectory of some path, baking it if no path with the same key is cached.
+	Returns nullptr if baking is disabled or if the path could not be baked to within MAX_ALLOWED_ERROR.
+
+	key - uniquely identifies the path; two paths with the same key must be exactly the same function of time
+	mp - the path; it must depend only on time, and must not be a HomingMP
+	*/
+	static std::shared_ptr<const BakedTrajectory> getOrBake(const Key& key, MovablePoint& mp);
+	/*
+	Same as getOrBake(), but for a path that stays still between jumps.
+
+	stepTimes - the times at which mp jumps, in ascending order; mp must not move at any other time
+	*/
+	static std::shared_ptr<const BakedTrajectory> getOrBakeSteps(const Key& key, MovablePoint& mp, const std::vector<float>& stepTimes);
+	/*
+	Returns the cached BakedTrajectory of some path without baking anything.
+	Returns nullptr if baking is disabled or if the path wasn't baked.
+	*/
+	static std::shared_ptr<const BakedTrajectory> getBaked(const Key& key);
+
+	/*
+	Sets whether anything is baked or looked up. Baking is disabled by default, and is enabled per level by Level::getBakeTrajectories().
+	*/
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+	static Stats getStats();
+	/*
+	Removes every cached BakedTrajectory. BakedTrajectories still in use are not affected.
+	Should be called whenever a level is loaded.
+	*/
+	static void clearCache();
+
+	/*
+	Returns the baked position at some time, relative to the path's start.
+	time is clamped to [0, lifespan].
+	*/
+	sf::Vector2f get(float time) const;
+
+	inline float getLifespan() const { return lifespan; }
+	inline float getSampleInterval() const { return sampleInterval; }
+	inline int getSamplesCount() const { return samples.size(); }
+	/*
+	Returns the largest distance between this and the path it was sampled from,
+	measured at several points between every pair of samples.
+	*/
+	inline float getMaxError() const { return maxError; }
+	/*
+	Returns the number of bytes used by the samples.
+	*/
+	inline size_t getMemoryUsage() const { return samples.capacity() * sizeof(sf::Vector2f) + stepTimes.capacity() * sizeof(float); }
+
+private:
+	float lifespan = 0;
+	float sampleInterval = 0;
+	float inverseSampleInterval = 0;
+	float maxError = 0;
+	std::vector<sf::Vector2f> samples;
+	// Only for stepped paths; samples[i] is the position from stepTimes[i] until stepTimes[i + 1]
+	std::vector<float> stepTimes;
+
+	static std::atomic<bool> enabled;
+	static std::mutex cacheMutex;
+	// nullptr for paths that couldn't be baked, so that they aren't tried again
+	static Cache<Key, std::shared_ptr<const BakedTrajectory>> cache;
+	static Stats stats;
+
+	/*
+	Samples mp every sampleInterval seconds (rounded down so that the last sample is at mp's lifespan).
+	Returns whether the result is within maxAllowedError of mp.
+	*/
+	bool sample(MovablePoint& mp, float sampleInterval, float maxAllowedError);
+	/*
+	Returns nullptr if mp can't be baked to within maxAllowedError with at most MAX_SAMPLES samples.
+	*/
+	static std::shared_ptr<BakedTrajectory> bake(MovablePoint& mp, float maxAllowedError);
+	static std::shared_ptr<BakedTrajectory> bakeSteps(MovablePoint& mp, const std::vector<float>& stepTimes);
+	/*
+	Returns the cached BakedTrajectory with some key, calling bake to create and cache it if there isn't one.
+	*/
+	static std::shared_ptr<const BakedTrajectory> getOrCreate(const Key& key, MovablePoint& mp, std::function<std::shared_ptr<BakedTrajectory>()> bake);
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+/*
+A read-only view of a whole file mapped into memory.
+Pages are only read from disk when they are first touched, and stay in the OS file cache between runs.
+*/
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/*
+	Maps a file, unmapping the previously mapped one.
+	Returns false if the file can't be opened or is empty.
+	*/
+	bool open(const std::string& fileName);
+	void close();
+
+	inline bool isOpen() const { return view != nullptr; }
+	inline const unsigned char* getData() const { return view; }
+	inline std::size_t getSize() const { return size; }
+
+private:
+	// The Windows handles are kept as void* so that this header doesn't need to include Windows.h
+	void* file = nullptr;
+	void* mapping = nullptr;
+	const unsigned char* view = nullptr;
+	std::size_t size = 0;
+};
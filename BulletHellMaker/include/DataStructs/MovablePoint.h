@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <utility>
+#include <memory>
 
 #include <SFML/Graphics.hpp>
 #include <entt/entt.hpp>
@@ -8,6 +9,8 @@
 #include <Constants.h>
 #include <Util/MathUtils.h>
 #include <DataStructs/TimeFunctionVariable.h>
+#include <DataStructs/PositionHistory.h>
+#include <DataStructs/BakedTrajectory.h>
 #include <Game/Components/PositionComponent.h>
 
 /*
@@ -36,6 +39,11 @@ public:
 		this->lifespan = lifespan;
 	}
 
+	/*
+	Adds every ExpressionTFV that would be used by compute(relativeTo, time) to some batch.
+	*/
+	virtual void addToExpressionTFVBatch(ExpressionTFVBatch& batch, float time) {}
+
 protected:
 	// Lifespan of the MP in seconds
 	// Only purpose is to make it known how long an MP SHOULD be alive; computing a position past an MP's lifespan should work
@@ -61,6 +69,8 @@ public:
 		return mps[mps.size() - 1];
 	}
 
+	void addToExpressionTFVBatch(ExpressionTFVBatch& batch, float time) override;
+
 private:
 	std::vector<std::shared_ptr<MovablePoint>> mps;
 	// The minimum amount of time before reaching the MP; index of minTimes corresponds to index of mps
@@ -105,6 +115,31 @@ private:
 	}
 };
 
+/*
+MP that follows a BakedTrajectory, optionally rotated around (0, 0).
+*/
+class BakedMP : public MovablePoint {
+public:
+	/*
+	rotation - in radians
+	*/
+	BakedMP(std::shared_ptr<const BakedTrajectory> trajectory, float rotation = 0);
+
+private:
+	std::shared_ptr<const BakedTrajectory> trajectory;
+	bool rotated;
+	float rotationCos;
+	float rotationSin;
+
+	inline sf::Vector2f evaluate(float time) override {
+		sf::Vector2f pos = trajectory->get(time);
+		if (!rotated) {
+			return pos;
+		}
+		return sf::Vector2f(pos.x * rotationCos - pos.y * rotationSin, pos.x * rotationSin + pos.y * rotationCos);
+	}
+};
+
 /*
 MP represented in polar coordinates.
 */
@@ -115,6 +150,8 @@ public:
 	*/
 	PolarMP(float lifespan, std::shared_ptr<TFV> distance, std::shared_ptr<TFV> angle);
 
+	void addToExpressionTFVBatch(ExpressionTFVBatch& batch, float time) override;
+
 private:
 	std::shared_ptr<TFV> angle;
 	std::shared_ptr<TFV> distance;
@@ -124,19 +161,78 @@ private:
 
 /*
 MP represented by a Bezier curve.
+
+The curve is converted to power basis on construction so that evaluation is just Horner's rule.
 */
 class BezierMP : public MovablePoint {
 public:
+	// Number of intervals in an arc-length table; the table has this many + 1 entries
+	const static int ARC_LENGTH_TABLE_RESOLUTION = 128;
+
 	/*
-	angle - in radians
+	The curve's parameter increases linearly with time.
 	*/
 	BezierMP(float lifespan, std::vector<sf::Vector2f> controlPoints);
+	/*
+	constantSpeed - if true, the curve is traversed at a constant speed rather than at a constant rate of the curve's parameter
+	arcLengthTable - the result of computeArcLengthTable() on these control points or any rotation of them;
+		if nullptr and constantSpeed is true, it is computed here. Only used if constantSpeed is true.
+	*/
+	BezierMP(float lifespan, std::vector<sf::Vector2f> controlPoints, bool constantSpeed, std::shared_ptr<const std::vector<float>> arcLengthTable = nullptr);
+
+	/*
+	Returns a table where entry i is the value of the curve's parameter at which i/ARC_LENGTH_TABLE_RESOLUTION
+	of the curve's total length has been traveled.
+	The table only depends on the shape of the curve, so it can be shared by every rotation of the same control points.
+	*/
+	static std::shared_ptr<const std::vector<float>> computeArcLengthTable(const std::vector<sf::Vector2f>& controlPoints);
 
 private:
-	const std::vector<sf::Vector2f> controlPoints;
-	int numControlPoints;
+	// Number of evenly spaced curve parameters at which the curve is sampled when measuring its length
+	const static int ARC_LENGTH_SAMPLES = 512;
+
+	// The position at curve parameter u in [0, 1] is the sum of coefficients[i] * u^i
+	std::vector<sf::Vector2f> coefficients;
+
+	bool constantSpeed = false;
+	std::shared_ptr<const std::vector<float>> arcLengthTable;
 
 	sf::Vector2f evaluate(float time) override;
+
+	static std::vector<sf::Vector2f> computeCoefficients(const std::vector<sf::Vector2f>& controlPoints);
+	static sf::Vector2f evaluateCoefficients(const std::vector<sf::Vector2f>& coefficients, float u);
+	/*
+	Returns the curve parameter at which some fraction in [0, 1] of the curve's total length has been traveled.
+	*/
+	float arcLengthFractionToParameter(float fraction) const;
+};
+
+class HomingMP;
+
+/*
+Structure of arrays holding the steering inputs and outputs of many HomingMPs,
+so that every homing entity can be steered in one tight loop per physics update (see HomingMP::steer()).
+All vectors are cleared but never shrunk between updates, so steering does not allocate once warmed up.
+*/
+struct HomingSteeringBatch {
+	std::vector<HomingMP*> mps;
+	// The time each MP will be evaluated at
+	std::vector<float> times;
+	// Inputs
+	std::vector<float> fromX;
+	std::vector<float> fromY;
+	std::vector<float> toX;
+	std::vector<float> toY;
+	std::vector<float> prevAngles;
+	std::vector<float> homingStrengths;
+	std::vector<float> distances;
+	// Outputs
+	std::vector<float> angles;
+	std::vector<float> offsetX;
+	std::vector<float> offsetY;
+
+	void clear();
+	inline int size() const { return mps.size(); }
 };
 
 /*
@@ -165,28 +261,50 @@ public:
 
 	sf::Vector2f evaluate(float time) override;
 
-private:
-	struct CachedPositionSearchComparator {
-		int operator()(const std::pair<float, sf::Vector2f>& a, float b) {
-			return a.first < b;
-		}
-	};
-	
-	struct CachedPositionComparator {
-		int operator()(const std::pair<float, sf::Vector2f>& a, const std::pair<float, sf::Vector2f>& b) {
-			return a.first < b.first;
-		}
-	};
+	/*
+	Adds this MP to a steering batch so that its next evaluate(time) call can use the batch's result
+	instead of querying the registry. Returns false if this MP cannot be steered in a batch for that time,
+	in which case evaluate() will steer it on its own as usual.
+
+	time - the time this MP will next be evaluated at
+	fromX/fromY - the current global position of the homing entity's hitbox
+	toX/toY - the current global position of the target's hitbox; ignored if this MP homes in on a static position
+	*/
+	bool addToSteeringBatch(HomingSteeringBatch& batch, float time, float fromX, float fromY, float toX, float toY);
+	/*
+	Steers every MP in the batch and hands each one its result.
+	*/
+	static void steer(HomingSteeringBatch& batch);
+
+	inline uint32_t getFrom() const { return from; }
+	inline bool getTargetsEntity() const { return targetsEntity; }
+	inline uint32_t getTarget() const { return to; }
+	// Whether this MP was constructed with a registry and can be evaluated
+	inline bool getUsesRegistry() const { return usesRegistry; }
 
+private:
 	entt::DefaultRegistry& registry;
 	uint32_t from;
 	std::shared_ptr<TFV> angle;
 	std::shared_ptr<TFV> speed;
 	std::shared_ptr<TFV> homingStrength;
 
+	bool usesRegistry;
+	// If true, the target is the entity "to". Otherwise, the target is the static position (toX, toY).
+	bool targetsEntity = false;
+	uint32_t to;
+	float toX;
+	float toY;
+
 	float lastEvaluatedTime = 0;
 	float prevAngle;
 
-	// Vector of pairs of time and positions, sorted by ascending time
-	std::vector<std::pair<float, sf::Vector2f>> cachedPositions;
+	// Result of the last steer() call; only valid for an evaluate() call at exactly steeringTime
+	bool hasSteering = false;
+	float steeringTime;
+	float steeringAngle;
+	sf::Vector2f steeringOffset;
+
+	// Positions from the last few physics updates, for requests of past positions
+	PositionHistory cachedPositions;
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+
+#include <SFML/Graphics.hpp>
+
+#include <Constants.h>
+
+/*
+A fixed-capacity ring buffer of an entity's past global positions.
+
+Positions are resampled onto a fixed time grid (one sample every POSITION_HISTORY_SAMPLE_INTERVAL seconds)
+so that looking up the position at some time is O(1) and needs no knowledge of the entity's movement path.
+Only the most recent POSITION_HISTORY_PHYSICS_STEPS * MAX_PHYSICS_DELTA_TIME seconds are guaranteed to be kept;
+looking further back returns the oldest position still in the buffer.
+*/
+class PositionHistory {
+public:
+	// Number of grid samples stored; +2 so that both ends of the history window can always be interpolated
+	const static int CAPACITY = POSITION_HISTORY_PHYSICS_STEPS * POSITION_HISTORY_SAMPLES_PER_PHYSICS_STEP + 2;
+
+	PositionHistory();
+
+	/*
+	Records the entity's global position at some time.
+	time must be >= the time of the last record() call.
+
+	time - the time since the entity was spawned
+	*/
+	void record(float time, sf::Vector2f position);
+	/*
+	Returns the entity's global position at some time, linearly interpolated between samples.
+	If nothing has been recorded yet, returns (0, 0).
+
+	time - the time since the entity was spawned
+	*/
+	sf::Vector2f get(float time) const;
+
+	/*
+	Returns the time of the most recent record() call.
+	*/
+	inline float getNewestTime() const { return newestTime; }
+	/*
+	Returns the earliest time that get() knows the real position at.
+	Anything before this, such as before the first record() call, is only a guess.
+	Must not be called if nothing has been recorded yet.
+	*/
+	float getOldestTime() const;
+	inline bool isEmpty() const { return !hasRecord; }
+
+private:
+	// Grid samples; sample with grid index i is at time i * POSITION_HISTORY_SAMPLE_INTERVAL and is stored in samples[i % CAPACITY]
+	std::array<sf::Vector2f, CAPACITY> samples;
+	// Grid index of the most recent grid sample; -1 if no grid samples exist
+	long long newestGridIndex = -1;
+	// Number of valid grid samples, at most CAPACITY
+	int gridSamplesCount = 0;
+
+	// The exact time and position of the most recent record() call, which usually lies between grid points
+	bool hasRecord = false;
+	// The time of the first record() call
+	float firstTime = 0;
+	float newestTime = 0;
+	sf::Vector2f newestPosition;
+
+	inline const sf::Vector2f& sampleAt(long long gridIndex) const { return samples[gridIndex % CAPACITY]; }
+};
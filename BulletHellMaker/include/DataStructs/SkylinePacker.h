@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+
+/*
+Packs rectangles into a fixed-size bin using the skyline bottom-left heuristic.
+
+The top edge of everything packed so far is kept as a skyline of horizontal segments, and every rectangle
+is placed on the skyline where its top edge ends up lowest. This wastes a little more space than
+a maxrects packer, but inserting is linear in the number of segments instead of in the number of free rectangles.
+Rectangles are never rotated.
+*/
+class SkylinePacker {
+public:
+	SkylinePacker(int binWidth, int binHeight);
+
+	/*
+	Finds a place for a rectangle and marks it as used.
+	Returns false and changes nothing if the rectangle doesn't fit.
+
+	x, y - set to the position of the rectangle's top-left corner in the bin
+	*/
+	bool insert(int width, int height, int& x, int& y);
+
+	inline int getBinWidth() const { return binWidth; }
+	inline int getBinHeight() const { return binHeight; }
+	// Returns the fraction of the bin's area covered by inserted rectangles, in the range [0, 1]
+	float getOccupancy() const;
+
+private:
+	// A horizontal segment of the skyline; everything below y in [x, x + width) may be used
+	struct Segment {
+		int x;
+		int y;
+		int width;
+	};
+
+	int binWidth;
+	int binHeight;
+	// Sorted by x and covering the whole width of the bin
+	std::vector<Segment> skyline;
+	long long usedArea = 0;
+
+	/*
+	Returns the lowest y at which a rectangle whose left edge is at the left edge of the segment at some index
+	can be placed, or -1 if it doesn't fit there.
+	*/
+	int fit(int segmentIndex, int width, int height) const;
+};
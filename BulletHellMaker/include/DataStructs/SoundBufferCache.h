@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <list>
+#include <set>
+#include <memory>
+#include <unordered_map>
+
+#include <SFML/Audio.hpp>
+
+/*
+Cache of decoded SoundBuffers, keyed by file name.
+
+The total size of the cached samples is kept under a byte budget by evicting the least recently used buffers.
+Buffers are handed out as shared_ptrs so that an evicted buffer stays alive until every sound playing it is done.
+
+Sounds are meant to be preloaded with preload() before they are needed. A sound that is first requested with get()
+is decoded on the spot, which can cause a hitch, so its file name is reported and remembered.
+*/
+class SoundBufferCache {
+public:
+	SoundBufferCache(std::size_t maxBytes);
+
+	/*
+	Decodes every sound in fileNames that isn't already cached, using multiple threads, and adds them to the cache.
+	Returns once every sound is cached or failed to load.
+	*/
+	void preload(const std::set<std::string>& fileNames);
+	/*
+	Returns the SoundBuffer for some file, loading it if it isn't cached.
+	Returns nullptr if the file can't be loaded.
+	*/
+	std::shared_ptr<sf::SoundBuffer> get(const std::string& fileName);
+
+	inline std::size_t getCachedBytes() const { return cachedBytes; }
+	// Returns the file names of every sound that had to be loaded by get()
+	inline const std::set<std::string>& getLazilyLoadedFileNames() const { return lazilyLoadedFileNames; }
+
+private:
+	struct Entry {
+		std::shared_ptr<sf::SoundBuffer> buffer;
+		std::size_t bytes;
+		// Position in recentlyUsed
+		std::list<std::string>::iterator recentlyUsedPosition;
+	};
+
+	std::size_t maxBytes;
+	std::size_t cachedBytes = 0;
+	std::unordered_map<std::string, Entry> entries;
+	// File names of every entry, from most to least recently used
+	std::list<std::string> recentlyUsed;
+	std::set<std::string> lazilyLoadedFileNames;
+
+	/*
+	Adds a buffer to the cache as the most recently used one and evicts buffers until the cache is within budget.
+	*/
+	void insert(const std::string& fileName, std::shared_ptr<sf::SoundBuffer> buffer);
+	void evictToBudget();
+};
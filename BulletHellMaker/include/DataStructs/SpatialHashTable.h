@@ -3,6 +3,7 @@
 #include <cmath>
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
 
 #include <Game/Components/HitboxComponent.h>
 #include <Game/Components/PositionComponent.h>
@@ -13,6 +14,12 @@ Spatial hash table
 The spatial hash table is composed of square cells (except possibly the right/topmost cells, which may be truncated
 if the map width/height are not multiples of the cell size).
 When objects are inserted into the table, they are inserted into every cell that overlap with the object's hitbox.
+Circles are inserted into every cell in their bounding box, while capsules are inserted only into the cells along their segment
+so that a long diagonal capsule doesn't fill the whole rectangle around it.
+
+The table is updated incrementally: every object remembers the range of cells it is in and where it is stored in each
+of those cells, so update() does nothing for objects that haven't left their cells and removing an object from a cell
+is a swap with the last object in that cell. Objects stay in the table until they are removed.
 
 The table will not work for getting objects nearby objects that are outside map bounds.
 */
@@ -21,60 +28,260 @@ class SpatialHashTable {
 public:
 	SpatialHashTable() {}
 	SpatialHashTable(float mapWidth, float mapHeight, float cellSize) : mapWidth(mapWidth), mapHeight(mapHeight), cellSize(cellSize) {
-		buckets = std::vector<std::vector<T>>(int(ceil(mapWidth / cellSize)) * int(ceil(mapHeight / cellSize)));
-		cellsPerMapWidth = int(mapWidth / cellSize);
-		cellsPerMapHeight = int(mapHeight / cellSize);
+		cellsPerMapWidth = std::max(1, int(ceil(mapWidth / cellSize)));
+		cellsPerMapHeight = std::max(1, int(ceil(mapHeight / cellSize)));
+		buckets = std::vector<std::vector<Entry>>(cellsPerMapWidth * cellsPerMapHeight);
 	}
+	// Buckets point into records, which only stays valid if records is moved and not copied
+	SpatialHashTable(const SpatialHashTable&) = delete;
+	SpatialHashTable& operator=(const SpatialHashTable&) = delete;
+	SpatialHashTable(SpatialHashTable&&) = default;
+	SpatialHashTable& operator=(SpatialHashTable&&) = default;
 
+	/*
+	Removes every object from the table.
+	*/
 	void clear() {
-		for (std::vector<T>& bucket : buckets) {
+		for (std::vector<Entry>& bucket : buckets) {
 			bucket.clear();
 		}
+		records.clear();
 	}
 
-	void insert(T object, float hitboxX, float hitboxY, float hitboxRadius, const PositionComponent& position) {
-		int leftmostXCell = std::max(0, (int)((position.getX() + hitboxX - hitboxRadius) / cellSize));
-		int rightmostXCell = std::min(cellsPerMapWidth, (int)((position.getX() + hitboxX + hitboxRadius) / cellSize));
-		int topmostYCell = std::min(cellsPerMapHeight, (int)((position.getY() + hitboxY + hitboxRadius) / cellSize));
-		int bottommostYCell = std::max(0, (int)((position.getY() + hitboxY - hitboxRadius) / cellSize));
-		
-		for (int xCell = leftmostXCell; xCell <= rightmostXCell; xCell++) {
-			for (int yCell = bottommostYCell; yCell <= topmostYCell; yCell++) {
-				buckets[xCell + yCell * cellsPerMapWidth].push_back(object);
-			}
+	/*
+	Inserts an object into the table or, if it is already in the table, moves it to the cells its hitbox now overlaps.
+	*/
+	void update(T object, float hitboxX, float hitboxY, float hitboxRadius, const PositionComponent& position) {
+		CellRange range = getCellRange(position.getX() + hitboxX, position.getY() + hitboxY, hitboxRadius);
+
+		auto it = records.find(object);
+		if (it == records.end()) {
+			it = records.emplace(object, Record()).first;
+		} else if (!it->second.usesCells && it->second.range == range) {
+			return;
+		} else {
+			removeFromBuckets(it->second);
 		}
+		insertIntoBuckets(object, it->second, range);
 	}
 
-	void insert(T object, const HitboxComponent& hitbox, const PositionComponent& position) {
-		insert(object, hitbox.getX(), hitbox.getY(), hitbox.getRadius(), position);
+	/*
+	Same as update(), but for a capsule around the segment from (x1, y1) to (x2, y2), which are offsets from position.
+	*/
+	void updateCapsule(T object, float x1, float y1, float x2, float y2, float radius, const PositionComponent& position) {
+		getCapsuleCells(position.getX() + x1, position.getY() + y1, position.getX() + x2, position.getY() + y2, radius, capsuleCells);
+
+		auto it = records.find(object);
+		if (it == records.end()) {
+			it = records.emplace(object, Record()).first;
+		} else if (it->second.usesCells && it->second.cells == capsuleCells) {
+			return;
+		} else {
+			removeFromBuckets(it->second);
+		}
+		insertIntoBuckets(object, it->second, capsuleCells);
 	}
 
-	std::vector<T> getNearbyObjects(const HitboxComponent& hitbox, const PositionComponent& position) {
-		int leftmostXCell = std::max(0, (int)((position.getX() + hitbox.getX() - hitbox.getRadius()) / cellSize));
-		int rightmostXCell = std::min(cellsPerMapWidth, (int)((position.getX() + hitbox.getX() + hitbox.getRadius()) / cellSize));
-		int topmostYCell = std::min(cellsPerMapHeight, (int)((position.getY() + hitbox.getY() + hitbox.getRadius()) / cellSize));
-		int bottommostYCell = std::max(0, (int)((position.getY() + hitbox.getY() - hitbox.getRadius()) / cellSize));
+	void update(T object, const HitboxComponent& hitbox, const PositionComponent& position) {
+		if (hitbox.isCapsule()) {
+			updateCapsule(object, hitbox.getX() - hitbox.getCapsuleHalfX(), hitbox.getY() - hitbox.getCapsuleHalfY(),
+				hitbox.getX() + hitbox.getCapsuleHalfX(), hitbox.getY() + hitbox.getCapsuleHalfY(), hitbox.getRadius(), position);
+		} else {
+			update(object, hitbox.getX(), hitbox.getY(), hitbox.getRadius(), position);
+		}
+	}
+
+	/*
+	Removes an object from the table. Does nothing if the object is not in the table.
+	*/
+	void remove(T object) {
+		auto it = records.find(object);
+		if (it == records.end()) {
+			return;
+		}
+		removeFromBuckets(it->second);
+		records.erase(it);
+	}
 
+	bool contains(T object) const {
+		return records.count(object) > 0;
+	}
+
+	std::vector<T> getNearbyObjects(const HitboxComponent& hitbox, const PositionComponent& position) {
 		std::vector<T> all;
-		for (int xCell = leftmostXCell; xCell <= rightmostXCell; xCell++) {
-			for (int yCell = bottommostYCell; yCell <= topmostYCell; yCell++) {
-				int i = xCell + yCell * cellsPerMapWidth;
-				all.insert(all.end(), buckets[i].begin(), buckets[i].end());
+		auto addBucket = [this, &all](int bucket) {
+			for (const Entry& entry : buckets[bucket]) {
+				all.push_back(entry.object);
 			}
+		};
+
+		float x = position.getX() + hitbox.getX();
+		float y = position.getY() + hitbox.getY();
+		if (hitbox.isCapsule()) {
+			getCapsuleCells(x - hitbox.getCapsuleHalfX(), y - hitbox.getCapsuleHalfY(), x + hitbox.getCapsuleHalfX(), y + hitbox.getCapsuleHalfY(), hitbox.getRadius(), capsuleCells);
+			forEachBucket(CellRange(), true, capsuleCells, addBucket);
+		} else {
+			forEachBucket(getCellRange(x, y, hitbox.getRadius()), false, capsuleCells, addBucket);
 		}
 		return all;
 	}
 
 private:
+	/*
+	Inclusive range of cells. The range is empty if left > right or bottom > top.
+	*/
+	struct CellRange {
+		int left = 0;
+		int right = -1;
+		int bottom = 0;
+		int top = -1;
+
+		inline bool operator==(const CellRange& other) const {
+			return left == other.left && right == other.right && bottom == other.bottom && top == other.top;
+		}
+	};
+
+	const static int INLINE_SLOTS = 4;
+
+	struct Record {
+		// Whether the object is in the cells in cells instead of every cell in range
+		bool usesCells = false;
+		CellRange range;
+		// Indices of the buckets a capsule is in; only used if usesCells is true
+		std::vector<int> cells;
+		// The index of the object in each of its buckets, in the same order they are iterated in by forEachBucket().
+		// Most objects are in at most INLINE_SLOTS cells, so those slots are stored inline.
+		int inlineSlots[INLINE_SLOTS];
+		std::vector<int> extraSlots;
+
+		inline int& slot(int i) {
+			return i < INLINE_SLOTS ? inlineSlots[i] : extraSlots[i - INLINE_SLOTS];
+		}
+	};
+
+	struct Entry {
+		T object;
+		// Never invalidated since unordered_map doesn't move its elements
+		Record* record;
+		// Index of this entry in record's slots
+		int slotIndex;
+	};
+
 	float mapWidth;
 	float mapHeight;
 	float cellSize;
 	int cellsPerMapWidth;
 	int cellsPerMapHeight;
-	std::vector<std::vector<T>> buckets;
+	std::vector<std::vector<Entry>> buckets;
+	std::unordered_map<T, Record> records;
+	// Reused by getCapsuleCells() callers to avoid allocating every update
+	std::vector<int> capsuleCells;
 
-	int hash(float x, float y) {
-		return int(x / cellSize) + (int(y / cellSize) * cellsPerMapWidth);
+	CellRange getCellRange(float x, float y, float radius) const {
+		CellRange range;
+		range.left = std::max(0, (int)((x - radius) / cellSize));
+		range.right = std::min(cellsPerMapWidth - 1, (int)((x + radius) / cellSize));
+		range.bottom = std::max(0, (int)((y - radius) / cellSize));
+		range.top = std::min(cellsPerMapHeight - 1, (int)((y + radius) / cellSize));
+		return range;
+	}
+
+	/*
+	Finds the buckets that a capsule around the segment from (x1, y1) to (x2, y2) overlaps.
+	For each column of cells, only the part of the segment within radius of the column can reach it,
+	so the column's cells are the ones within radius of that part's vertical extent.
+	*/
+	void getCapsuleCells(float x1, float y1, float x2, float y2, float radius, std::vector<int>& cells) const {
+		cells.clear();
+		int left = std::max(0, (int)((std::min(x1, x2) - radius) / cellSize));
+		int right = std::min(cellsPerMapWidth - 1, (int)((std::max(x1, x2) + radius) / cellSize));
+		for (int xCell = left; xCell <= right; xCell++) {
+			float minY, maxY;
+			if (x1 == x2) {
+				minY = std::min(y1, y2);
+				maxY = std::max(y1, y2);
+			} else {
+				// Clip the segment to the column widened by radius on both sides
+				float t1 = (xCell * cellSize - radius - x1) / (x2 - x1);
+				float t2 = ((xCell + 1) * cellSize + radius - x1) / (x2 - x1);
+				if (t1 > t2) {
+					std::swap(t1, t2);
+				}
+				t1 = std::max(0.0f, t1);
+				t2 = std::min(1.0f, t2);
+				if (t1 > t2) {
+					continue;
+				}
+				minY = std::min(y1 + (y2 - y1) * t1, y1 + (y2 - y1) * t2);
+				maxY = std::max(y1 + (y2 - y1) * t1, y1 + (y2 - y1) * t2);
+			}
+
+			int bottom = std::max(0, (int)((minY - radius) / cellSize));
+			int top = std::min(cellsPerMapHeight - 1, (int)((maxY + radius) / cellSize));
+			for (int yCell = bottom; yCell <= top; yCell++) {
+				cells.push_back(xCell + yCell * cellsPerMapWidth);
+			}
+		}
 	}
-};
 
+	/*
+	Calls f with the index of every bucket in cells if usesCells is true, or in range otherwise.
+	*/
+	template<class F>
+	void forEachBucket(const CellRange& range, bool usesCells, const std::vector<int>& cells, F f) const {
+		if (usesCells) {
+			for (int bucket : cells) {
+				f(bucket);
+			}
+			return;
+		}
+		for (int xCell = range.left; xCell <= range.right; xCell++) {
+			for (int yCell = range.bottom; yCell <= range.top; yCell++) {
+				f(xCell + yCell * cellsPerMapWidth);
+			}
+		}
+	}
+
+	void insertIntoBuckets(T object, Record& record, const CellRange& range) {
+		record.usesCells = false;
+		record.range = range;
+		record.cells.clear();
+		insertIntoBuckets(object, record);
+	}
+
+	void insertIntoBuckets(T object, Record& record, const std::vector<int>& cells) {
+		record.usesCells = true;
+		record.range = CellRange();
+		record.cells = cells;
+		insertIntoBuckets(object, record);
+	}
+
+	void insertIntoBuckets(T object, Record& record) {
+		record.extraSlots.clear();
+		int slotIndex = 0;
+		forEachBucket(record.range, record.usesCells, record.cells, [this, object, &record, &slotIndex](int bucketIndex) {
+			std::vector<Entry>& bucket = buckets[bucketIndex];
+			bucket.push_back({ object, &record, slotIndex });
+			if (slotIndex < INLINE_SLOTS) {
+				record.inlineSlots[slotIndex] = bucket.size() - 1;
+			} else {
+				record.extraSlots.push_back(bucket.size() - 1);
+			}
+			slotIndex++;
+		});
+	}
+
+	void removeFromBuckets(Record& record) {
+		int slotIndex = 0;
+		forEachBucket(record.range, record.usesCells, record.cells, [this, &record, &slotIndex](int bucketIndex) {
+			std::vector<Entry>& bucket = buckets[bucketIndex];
+			int slot = record.slot(slotIndex++);
+			// Fill the gap with the last entry and tell that entry's owner where it went
+			if (slot != (int)bucket.size() - 1) {
+				bucket[slot] = bucket.back();
+				bucket[slot].record->slot(bucket[slot].slotIndex) = slot;
+			}
+			bucket.pop_back();
+		});
+	}
+};
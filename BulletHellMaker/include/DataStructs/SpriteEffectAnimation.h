@@ -6,27 +6,34 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <DataStructs/SpriteTemplate.h>
+
 /*
-Base class for modifying a sf::Sprite over time.
+Base class for modifying a sprite over time.
 SEA for short.
 
+An SEA only modifies the SpriteInstance passed into update(), never the SpriteTemplate shared with other sprites.
+
 See RenderSystem::loadShaders for the list of shaders that can be used.
 */
 class SpriteEffectAnimation {
 public:
+	SpriteEffectAnimation();
+	/*
+	spriteTemplate - the sprite currently being shown
+	instance - the part of the sprite that will be modified
+	*/
+	virtual void update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) = 0;
 	/*
-	sprite - the pointer to the sprite that will be modified
+	Returns true if further updates will not change the sprite, so the SEA can be discarded.
+	Whatever the SEA last did to the SpriteInstance stays after it is discarded.
 	*/
-	SpriteEffectAnimation(std::shared_ptr<sf::Sprite> sprite);
-	virtual void update(float deltaTime) = 0;
+	virtual bool isDone() const = 0;
 
 	bool usesShader() { return useShader; }
 	sf::Shader& getShader() { return shader; }
-	void setSpritePointer(std::shared_ptr<sf::Sprite> sprite) { this->sprite = sprite; }
 
 protected:
-	// Reference to the sprite being modified
-	std::shared_ptr<sf::Sprite> sprite;
 	// Shader to be used when drawing the sprite, if any
 	sf::Shader shader;
 	// Whether or not to use the shader
@@ -50,9 +57,10 @@ public:
 
 	The total interval between each entire flash animation is (flashInterval + flashDuration)
 	*/
-	FlashWhiteSEA(std::shared_ptr<sf::Sprite> sprite, float animationDuration, float flashInterval = 0.3f, float flashDuration = 0.2f);
+	FlashWhiteSEA(float animationDuration, float flashInterval = 0.3f, float flashDuration = 0.2f);
 
-	void update(float deltaTime) override;
+	void update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) override;
+	bool isDone() const override;
 
 private:
 	float flashInterval;
@@ -72,9 +80,10 @@ public:
 	animationDuration - total time for the sprite to fade from maxOpacity to minOpacity
 	keepEffectAfterEnding - if true, the sprite will maintain minOpacity even after the effect ends
 	*/
-	FadeAwaySEA(std::shared_ptr<sf::Sprite> sprite, float minOpacity, float maxOpacity, float animationDuration, bool keepEffectAfterEnding = false);
+	FadeAwaySEA(float minOpacity, float maxOpacity, float animationDuration, bool keepEffectAfterEnding = false);
 
-	void update(float deltaTime) override;
+	void update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) override;
+	bool isDone() const override;
 
 private:
 	float minOpacity;
@@ -94,9 +103,10 @@ public:
 	endScale - ending sprite scale
 	animationDuration - total time for the sprite to fade from maxOpacity to minOpacity
 	*/
-	ChangeSizeSEA(std::shared_ptr<sf::Sprite> sprite, float startScale, float endScale, float animationDuration);
+	ChangeSizeSEA(float startScale, float endScale, float animationDuration);
 
-	void update(float deltaTime) override;
+	void update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) override;
+	bool isDone() const override;
 
 private:
 	float startScale;
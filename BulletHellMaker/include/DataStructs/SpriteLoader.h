@@ -5,12 +5,15 @@
 #include <memory>
 #include <filesystem>
 #include <set>
+#include <future>
 
 #include <SFML\Graphics.hpp>
 
 #include <LevelPack/Animation.h>
+#include <LevelPack/Animatable.h>
 #include <LevelPack/TextMarshallable.h>
 #include <DataStructs/LRUCache.h>
+#include <DataStructs/SpriteTemplate.h>
 
 /*
 The only purpose of this class is to have an IntRect that can be used as a key for maps
@@ -157,6 +160,11 @@ public:
 	void deleteAnimation(const std::string& animationName);
 
 	bool loadTexture(const std::string& spriteSheetFilePath);
+	/*
+	Uploads an already decoded image as the texture.
+	Must be called on the thread that owns the OpenGL context.
+	*/
+	bool loadTexture(const sf::Image& image);
 
 	/*
 	Unloads an animation so that the next time it is fetched, changes in its AnimationData
@@ -164,6 +172,16 @@ public:
 	*/
 	void unloadAnimation(const std::string& animationName);
 
+	/*
+	Makes sprites with some name use an area of a texture atlas instead of this sprite sheet's texture.
+	Only affects sprites and animations fetched afterwards.
+	*/
+	void setAtlasRegion(const std::string& spriteName, std::shared_ptr<sf::Texture> atlasTexture, sf::IntRect area);
+	/*
+	Makes every sprite use this sprite sheet's texture again.
+	*/
+	void clearAtlasRegions();
+
 	/*
 	Scale all sprites by the same amount
 	*/
@@ -183,10 +201,21 @@ public:
 
 	/*
 	Returns nullptr if the requested sprite does not exist.
+	The same SpriteTemplate is returned every time until the sprite or its atlas region changes.
+	*/
+	std::shared_ptr<const SpriteTemplate> getSpriteTemplate(const std::string& spriteName);
+	/*
+	Returns nullptr if the requested sprite does not exist.
+	Returns an entirely new sf::Sprite.
 	*/
 	std::shared_ptr<sf::Sprite> getSprite(const std::string& spriteName);
 	/*
 	Returns nullptr if the requested animation does not exist.
+	The same AnimationClip is returned every time until the animation is unloaded.
+	*/
+	std::shared_ptr<const AnimationClip> getAnimationClip(const std::string& animationName);
+	/*
+	Returns nullptr if the requested animation does not exist.
 	*/
 	std::unique_ptr<Animation> getAnimation(const std::string& animationName, bool loop);
 	inline std::string getName() const { return name; }
@@ -213,8 +242,12 @@ private:
 
 	// The entire sprite sheet's texture
 	sf::Texture texture;
-	// Maps an animation name to a list of pairs of sprites and for how long each sprite appears for
-	std::map<std::string, std::vector<std::pair<float, std::shared_ptr<sf::Sprite>>>> animationSprites;
+	// Maps a sprite name to its SpriteTemplate, for sprites that have been fetched since they last changed
+	std::map<std::string, std::shared_ptr<const SpriteTemplate>> spriteTemplates;
+	// Maps an animation name to its AnimationClip, for animations that have been fetched since they were last unloaded
+	std::map<std::string, std::shared_ptr<const AnimationClip>> animationClips;
+	// Maps a sprite name to the texture atlas and the area in it that the sprite is drawn from, for sprites that were packed into an atlas
+	std::map<std::string, std::pair<std::shared_ptr<sf::Texture>, sf::IntRect>> atlasRegions;
 
 	float globalSpriteScale = 1.0f;
 
@@ -230,9 +263,26 @@ Note that if the SpriteLoader object goes out of scope, all Sprites loaded from
 */
 class SpriteLoader {
 public:
+	struct SpriteSheetLoadTimes {
+		// Time spent decoding the image on a worker thread
+		double decodeSeconds = 0;
+		// Time spent uploading the decoded image as a texture
+		double uploadSeconds = 0;
+	};
+	struct AtlasMetrics {
+		int atlasesCount = 0;
+		int spritesPacked = 0;
+		// Sprites that are too big for an atlas or whose area is outside their sprite sheet's image
+		int spritesSkipped = 0;
+		// The fraction of the atlases' area covered by sprites, not counting padding
+		float occupancy = 0;
+		double seconds = 0;
+	};
 	struct LoadMetrics {
 		int spriteSheetsFailed = 0;
 		int spriteSheetsTotal = 0;
+		// Maps sprite sheet name to how long its image took to load
+		std::map<std::string, SpriteSheetLoadTimes> spriteSheetLoadTimes;
 
 		std::string formatForUser();
 		bool containsFailedLoads();
@@ -255,6 +305,51 @@ public:
 	metafile are still loaded but will not contain any usable sprites or animations.
 	*/
 	LoadMetrics loadFromSpriteSheetsFolder();
+	/*
+	Loads all sprite sheets from already parsed metadata instead of from their metafiles, such as from a cooked level pack.
+	The images are still loaded from the sprite sheets folder.
+
+	spriteSheetsMetadata - a JSON object mapping each sprite sheet's image file name to its metadata
+	*/
+	LoadMetrics loadFromMetadata(const nlohmann::json& spriteSheetsMetadata);
+	/*
+	Same as loadFromSpriteSheetsFolder(), except that it returns as soon as the metafiles are loaded.
+	The images are decoded on worker threads, and each sprite sheet's texture stays empty until
+	uploadDecodedSpriteSheets() uploads it, so sprites can already be created from every sprite sheet.
+	A load that is still in progress is finished first.
+
+	Returns a future that becomes ready once every sprite sheet's texture has been uploaded.
+	*/
+	std::shared_future<LoadMetrics> loadFromSpriteSheetsFolderAsync();
+	/*
+	Same as loadFromMetadata(), except that the images are loaded like in loadFromSpriteSheetsFolderAsync().
+	*/
+	std::shared_future<LoadMetrics> loadFromMetadataAsync(const nlohmann::json& spriteSheetsMetadata);
+	/*
+	Uploads the textures of sprite sheets whose images have finished decoding.
+	Must be called on the thread that owns the OpenGL context, such as once every frame while a load is in progress.
+
+	wait - whether to also wait for every image that is still being decoded
+	Returns the number of sprite sheets that are still waiting to be uploaded.
+	*/
+	int uploadDecodedSpriteSheets(bool wait = false);
+	/*
+	Returns the number of sprite sheets from the last load whose textures haven't been uploaded yet.
+	*/
+	inline int getPendingSpriteSheetsCount() const { return pendingSpriteSheets.size(); }
+
+	/*
+	Packs every sprite used by some sprites and animations into as few texture atlases as possible, so that sprites
+	from different sprite sheets can be drawn without switching textures. Replaces the previously built atlases.
+	Sprites and animations fetched afterwards take their textures from the atlases; ones fetched before
+	must not be drawn anymore.
+	Must be called on the thread that owns the OpenGL context. Waits for the sprite sheets that are still being loaded.
+	*/
+	AtlasMetrics buildAtlases(const std::vector<Animatable>& animatables);
+	/*
+	Makes every sprite fetched afterwards use its sprite sheet's texture again.
+	*/
+	void clearAtlases();
 
 	/*
 	Returns whether both the image and its metafile were successfully loaded.
@@ -277,6 +372,7 @@ public:
 	Updates an sprite sheet.
 	If the sprite sheet name is already in the SpriteLoader, overwrite the sprite sheet.
 	If the sprite sheet name is not in the SpriteLoader, add in the sprite sheet.
+	Use LevelPack::updateSpriteSheet() instead for a level pack's SpriteLoader, or the change won't be saved.
 	*/
 	void updateSpriteSheet(std::shared_ptr<SpriteSheet> spriteSheet);
 
@@ -290,12 +386,20 @@ public:
 	*/
 	std::shared_ptr<sf::Texture> getGuiElementTexture(const std::string& guiElementFileName);
 	/*
+	Returns the missing sprite's template if the sprite doesn't exist.
+	*/
+	std::shared_ptr<const SpriteTemplate> getSpriteTemplate(const std::string& spriteName, const std::string& spriteSheetName);
+	/*
 	Returns an entirely new sf::Sprite.
 	*/
 	std::shared_ptr<sf::Sprite> getSprite(const std::string& spriteName, const std::string& spriteSheetName);
 	/*
 	Returns nullptr if the requested animation does not exist.
 	*/
+	std::shared_ptr<const AnimationClip> getAnimationClip(const std::string& animationName, const std::string& spriteSheetName);
+	/*
+	Returns nullptr if the requested animation does not exist.
+	*/
 	std::unique_ptr<Animation> getAnimation(const std::string& animationName, const std::string& spriteSheetName, bool loop);
 	/*
 	Returns default missing texture if the background could not be loaded.
@@ -308,6 +412,10 @@ public:
 	Returns a copy of the default missing sprite.
 	*/
 	const std::shared_ptr<sf::Sprite> getMissingSprite();
+	/*
+	Returns the template of the default missing sprite.
+	*/
+	std::shared_ptr<const SpriteTemplate> getMissingSpriteTemplate();
 	std::vector<std::string> getLoadedSpriteSheetNames();
 	std::set<std::string> getLoadedSpriteSheetNamesAsSet();
 	std::shared_ptr<SpriteSheet> getSpriteSheet(std::string spriteSheetName) const;
@@ -317,8 +425,25 @@ public:
 	std::string formatPathToSpriteSheetMetafile(std::string imageFileNameWithExtension);
 
 private:
+	struct DecodedImage {
+		// nullptr if the image couldn't be loaded
+		std::shared_ptr<sf::Image> image;
+		double decodeSeconds = 0;
+	};
+	struct PendingSpriteSheet {
+		std::shared_ptr<SpriteSheet> sheet;
+		std::future<DecodedImage> decodedImage;
+	};
+
 	const static std::size_t BACKGROUNDS_CACHE_MAX_SIZE;
 	const static std::size_t GUI_ELEMENTS_CACHE_MAX_SIZE;
+	// Width and height of every texture atlas, if the graphics card supports textures that big
+	const static int ATLAS_SIZE;
+	// Empty space around every sprite in an atlas, including the extruded edge pixels
+	const static int ATLAS_PADDING;
+	// How many times a sprite's edge pixels are repeated around it in an atlas, so that
+	// texture filtering at the sprite's edges doesn't blend in its neighbours
+	const static int ATLAS_EXTRUSION;
 
 	std::string levelPackName;
 	// Maps SpriteSheet name (as specified in the meta file) to SpriteSheet
@@ -330,6 +455,49 @@ private:
 
 	std::shared_ptr<sf::Texture> missingSpriteTexture;
 	std::shared_ptr<sf::Sprite> missingSprite;
+	// nullptr until it is first fetched after the global sprite scale changes
+	std::shared_ptr<const SpriteTemplate> missingSpriteTemplate;
 
 	float globalSpriteScale = 1.0f;
+
+	// The texture atlases from the last buildAtlases()
+	std::vector<std::shared_ptr<sf::Texture>> atlasTextures;
+
+	// Sprite sheets from the last load whose textures haven't been uploaded yet
+	std::vector<PendingSpriteSheet> pendingSpriteSheets;
+	// Paths of the images that the next startDecodingImages() will decode, and where to put each decoded image
+	std::vector<std::pair<std::string, std::shared_ptr<std::promise<DecodedImage>>>> queuedImages;
+	// Metrics of the load in progress, completed as its sprite sheets are uploaded
+	LoadMetrics pendingLoadMetrics;
+	// nullptr if there is no load in progress
+	std::shared_ptr<std::promise<LoadMetrics>> pendingLoadPromise;
+	// Decodes the images of the load in progress on worker threads.
+	// Declared last so that it is destroyed, and so waited on, before the rest of the SpriteLoader.
+	std::future<void> decodeTask;
+
+	/*
+	Finishes any load in progress and starts a new one.
+	*/
+	std::shared_future<LoadMetrics> beginAsyncLoad();
+	/*
+	Adds a sprite sheet whose metadata has been loaded and queues its image to be decoded by startDecodingImages().
+	*/
+	void queueSpriteSheetImage(std::shared_ptr<SpriteSheet> sheet);
+	/*
+	Starts decoding every queued image on worker threads.
+	*/
+	void startDecodingImages();
+	/*
+	Waits for a pending sprite sheet's image to be decoded and uploads it.
+	*/
+	void finishLoadingSpriteSheet(PendingSpriteSheet& pending);
+	/*
+	Waits for a sprite sheet's image to be decoded and uploads it, for sprite sheets that buildAtlases() needs right away.
+	Does nothing if the sprite sheet isn't waiting to be uploaded.
+	*/
+	void waitForSpriteSheet(const std::string& spriteSheetName);
+	/*
+	Makes the future of the load in progress ready if every sprite sheet has been uploaded.
+	*/
+	void completeAsyncLoadIfDone();
 };
\ No newline at end of file
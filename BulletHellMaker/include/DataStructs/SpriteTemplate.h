@@ -0,0 +1,50 @@
+#pragma once
+#include <memory>
+
+#include <SFML/Graphics.hpp>
+
+/*
+The parts of a sprite that are the same for every entity showing it.
+
+A SpriteSheet creates one SpriteTemplate per sprite and every SpriteComponent showing that sprite shares it,
+so spawning an entity doesn't need to allocate or copy a sf::Sprite. SpriteTemplates are never modified
+after they are created; a SpriteSheet makes new ones instead when its sprites change.
+*/
+class SpriteTemplate {
+public:
+	SpriteTemplate(const sf::Texture* texture, sf::IntRect textureRect, sf::Vector2f origin, sf::Vector2f scale, sf::Color color);
+
+	/*
+	Returns an entirely new sf::Sprite that looks like this template, for drawing outside of the game.
+	*/
+	std::shared_ptr<sf::Sprite> createSprite() const;
+
+	inline const sf::Texture* getTexture() const { return texture; }
+	inline const sf::IntRect& getTextureRect() const { return textureRect; }
+	inline const sf::Vector2f& getOrigin() const { return origin; }
+	inline const sf::Vector2f& getScale() const { return scale; }
+	inline const sf::Color& getColor() const { return color; }
+
+private:
+	// Either a sprite sheet's texture or a texture atlas
+	const sf::Texture* texture;
+	sf::IntRect textureRect;
+	// Local position of the sprite's origin, in texture pixels
+	sf::Vector2f origin;
+	// Scale that makes the texture rect the sprite's size, including the global sprite scale
+	sf::Vector2f scale;
+	sf::Color color;
+};
+
+/*
+The parts of a sprite that differ between entities showing the same SpriteTemplate.
+*/
+struct SpriteInstance {
+	sf::Vector2f position;
+	// In degrees, clockwise
+	float rotation = 0;
+	// Multiplies the template's scale
+	sf::Vector2f scale = sf::Vector2f(1, 1);
+	// Multiplies the template's color
+	sf::Color tint = sf::Color::White;
+};
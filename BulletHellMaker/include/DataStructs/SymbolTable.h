@@ -1,9 +1,66 @@
 #pragma once
 #include <string>
 #include <map>
+#include <vector>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 
 #include <exprtk.hpp>
 #include <LevelPack/TextMarshallable.h>
+#include <LevelPack/ExpressionCompiler.h>
+
+// Integer ID of an interned symbol name
+typedef int SymbolID;
+
+/*
+Maps symbol names to SymbolIDs so that symbols can be compared and looked up without string comparisons.
+A name's SymbolID never changes while the program is running.
+*/
+class SymbolInterner {
+public:
+	/*
+	Returns the SymbolID of some symbol name, assigning it a new one if it doesn't have one yet.
+	*/
+	static SymbolID intern(const std::string& symbol);
+	/*
+	Returns the SymbolID of some symbol name, or -1 if it has never been interned.
+	*/
+	static SymbolID find(const std::string& symbol);
+
+private:
+	static std::mutex mutex;
+	static std::unordered_map<std::string, SymbolID> ids;
+};
+
+/*
+Builds exprtk::symbol_tables of constants and reuses them for identical bindings, so that
+the many objects that bind the same symbols to the same values share a single symbol_table.
+
+Copies of an exprtk::symbol_table share a reference count that isn't thread-safe, so every thread
+has its own cache and symbol_tables are only ever shared between objects compiled on the same thread.
+*/
+class ExprtkSymbolTableCache {
+public:
+	// A symbol name, its SymbolID, and the value bound to it
+	struct Binding {
+		std::string symbol;
+		SymbolID id;
+		float value;
+	};
+
+	/*
+	Returns a symbol_table that defines every binding as a constant.
+	*/
+	static exprtk::symbol_table<float> get(const std::vector<Binding>& bindings);
+
+private:
+	// Max number of cached symbol_tables before the cache is cleared
+	const static size_t MAX_CACHED_SYMBOL_TABLES = 4096;
+
+	// Key is every binding's SymbolID and the exact bits of its value
+	static thread_local std::map<std::vector<std::pair<SymbolID, uint32_t>>, exprtk::symbol_table<float>> cache;
+};
 
 /*
 A symbol that can either be redelegated or is assigned some value.
@@ -42,15 +99,15 @@ public:
 		in the farthest-back symbol table will be used. Values from symbol_tables in this list are not added
 		to this ExprSymbolTable.
 	*/
-	exprtk::symbol_table<float> toLowerLevelSymbolTable(std::vector<exprtk::symbol_table<float>> higherLevelSymbolTables);
+	exprtk::symbol_table<float> toLowerLevelSymbolTable(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) const;
 	/*
-	Same thing as toLowerLevelSymbolTable(std::vector<exprtk::symbol_table<float>> higherLevelSymbolTables) but takes
-	an expression that has only the higherLevelSymbolTables registered.
+	Same thing as toLowerLevelSymbolTable(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) but takes
+	an ExpressionCompiler that was constructed with only the higherLevelSymbolTables.
 	*/
-	exprtk::symbol_table<float> toLowerLevelSymbolTable(exprtk::expression<float> expression);
+	exprtk::symbol_table<float> toLowerLevelSymbolTable(ExpressionCompiler& compiler) const;
 
-	std::map<std::string, ExprSymbolDefinition>::const_iterator getIteratorBegin();
-	std::map<std::string, ExprSymbolDefinition>::const_iterator getIteratorEnd();
+	std::vector<std::pair<std::string, ExprSymbolDefinition>>::const_iterator getIteratorBegin();
+	std::vector<std::pair<std::string, ExprSymbolDefinition>>::const_iterator getIteratorEnd();
 
 	ExprSymbolDefinition getSymbolDefinition(std::string symbol) const;
 	bool hasSymbol(std::string symbol) const;
@@ -58,7 +115,15 @@ public:
 	bool isEmpty() const;
 
 private:
-	std::map<std::string, ExprSymbolDefinition> map;
+	// Sorted by symbol name
+	std::vector<std::pair<std::string, ExprSymbolDefinition>> symbols;
+	// ids[i] is the SymbolID of symbols[i]
+	std::vector<SymbolID> ids;
+
+	/*
+	Returns the index of some symbol in symbols, or -1 if it doesn't exist.
+	*/
+	int indexOf(const std::string& symbol) const;
 };
 
 class ValueSymbolTable : public TextMarshallable {
@@ -74,6 +139,7 @@ public:
 
 	/*
 	Returns a symbol_table that defines constant values for every unredelegated symbol.
+	The symbol_table comes from ExprtkSymbolTableCache.
 	*/
 	exprtk::symbol_table<float> toExprtkSymbolTable() const;
 	/*
@@ -82,8 +148,8 @@ public:
 	*/
 	exprtk::symbol_table<float> toZeroFilledSymbolTable() const;
 
-	std::map<std::string, ValueSymbolDefinition>::const_iterator getIteratorBegin();
-	std::map<std::string, ValueSymbolDefinition>::const_iterator getIteratorEnd();
+	std::vector<std::pair<std::string, ValueSymbolDefinition>>::const_iterator getIteratorBegin();
+	std::vector<std::pair<std::string, ValueSymbolDefinition>>::const_iterator getIteratorEnd();
 
 	ValueSymbolDefinition getSymbolDefinition(std::string symbol) const;
 	bool hasSymbol(std::string symbol) const;
@@ -91,5 +157,13 @@ public:
 	bool isEmpty() const;
 
 private:
-	std::map<std::string, ValueSymbolDefinition> map;
+	// Sorted by symbol name
+	std::vector<std::pair<std::string, ValueSymbolDefinition>> symbols;
+	// ids[i] is the SymbolID of symbols[i]
+	std::vector<SymbolID> ids;
+
+	/*
+	Returns the index of some symbol in symbols, or -1 if it doesn't exist.
+	*/
+	int indexOf(const std::string& symbol) const;
 };
\ No newline at end of file
@@ -6,13 +6,42 @@
 #include <algorithm>
 #include <utility>
 #include <exception>
+#include <vector>
 
 #include <entt/entt.hpp>
+#include <exprtk.hpp>
 
 #include <Constants.h>
 #include <Util/MathUtils.h>
 #include <LevelPack/TextMarshallable.h>
 
+class ExpressionTFV;
+
+/*
+The times at which ExpressionTFVs will be evaluated during one physics update, so that each ExpressionTFV
+can evaluate its expression over all of its times in one loop instead of once per entity (see ExpressionTFV).
+All vectors are cleared but never shrunk between updates, so batching does not allocate once warmed up.
+*/
+struct ExpressionTFVBatch {
+	// Every ExpressionTFV and the time it will be evaluated at
+	std::vector<std::pair<ExpressionTFV*, float>> entries;
+	// Every ExpressionTFV that was handed results in the last run() call
+	std::vector<ExpressionTFV*> evaluatedTFVs;
+	// Scratch buffers for run()
+	std::vector<float> times;
+	std::vector<float> results;
+
+	inline void add(ExpressionTFV* tfv, float time) { entries.push_back(std::make_pair(tfv, time)); }
+	/*
+	Evaluates every ExpressionTFV at all of its times and hands each one its results.
+	*/
+	void run();
+	/*
+	Takes back results handed out by run() and removes all entries.
+	*/
+	void clear();
+};
+
 struct InvalidEvaluationDomainException : public std::exception {
 	const char* what() const throw () {
 		return "C++ Exception";
@@ -45,6 +74,18 @@ public:
 
 	virtual float evaluate(float time) = 0;
 
+	/*
+	Adds every ExpressionTFV that would be used by evaluate(time) to some batch.
+	*/
+	virtual void addToExpressionBatch(ExpressionTFVBatch& batch, float time) {}
+	/*
+	Binds the symbols that the expressions of any ExpressionTFVs in this TFV can use.
+	Every symbol in symbolTables must be a constant.
+
+	symbolTables - ordered in descending priority, same as for ExpressionCompilable::compileExpressions()
+	*/
+	virtual void bindSymbols(const std::vector<exprtk::symbol_table<float>>& symbolTables) {}
+
 	/*
 	For testing.
 	*/
@@ -385,6 +426,9 @@ public:
 		return valueTranslation + wrappedTFV->evaluate(time);
 	}
 
+	inline void addToExpressionBatch(ExpressionTFVBatch& batch, float time) override { wrappedTFV->addToExpressionBatch(batch, time); }
+	inline void bindSymbols(const std::vector<exprtk::symbol_table<float>>& symbolTables) override { wrappedTFV->bindSymbols(symbolTables); }
+
 	bool operator==(const TFV& other) const override;
 
 private:
@@ -479,6 +523,9 @@ public:
 
 	float evaluate(float time) override;
 
+	void addToExpressionBatch(ExpressionTFVBatch& batch, float time) override;
+	void bindSymbols(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
+
 	/*
 	Returns a pair containing, in order, the normal evaluation of the TFV and the index of the segment
 	in which the evaluation occurred.
@@ -537,6 +584,81 @@ private:
 	totalLifespan - the total lifespan of this TFV
 	*/
 	void recalculateMaxTimes(float totalLifespan);
+	/*
+	Returns the index of the segment that evaluate(time) would use, or -1 if time is before the first segment.
+	*/
+	int getSegmentIndex(float time) const;
+};
+
+/*
+TFV whose value is an expression of t, the time since the start of the TFV.
+The expression can also use any symbols bound with bindSymbols().
+
+The expression is compiled once, the first time it is evaluated after it or its symbols change.
+Every entity whose movement uses the same ExpressionTFV shares its compiled expression, and MovementSystem
+evaluates it for all of them in a single loop through an ExpressionTFVBatch.
+
+std::string expressionStr
+*/
+class ExpressionTFV : public TFV {
+public:
+	ExpressionTFV();
+	ExpressionTFV(std::string expressionStr, float maxTime);
+	/*
+	The compiled expression reads the t member of the object that compiled it,
+	so a copy recompiles its own expression instead of copying it.
+	Batch results are not copied.
+	*/
+	ExpressionTFV(const ExpressionTFV& copy);
+	ExpressionTFV& operator=(const ExpressionTFV& other);
+
+	std::shared_ptr<TFV> clone() override;
+
+	std::string format() const override;
+	void load(std::string formattedString) override;
+
+	nlohmann::json toJson() override;
+	void load(const nlohmann::json& j) override;
+
+	std::string getName() override { return "Expression"; }
+
+	float evaluate(float time) override;
+	/*
+	Evaluates the expression at count times.
+	*/
+	void evaluateBatch(const float* times, float* results, int count);
+
+	inline void addToExpressionBatch(ExpressionTFVBatch& batch, float time) override { batch.add(this, time); }
+	void bindSymbols(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
+
+	/*
+	Sets the results of the current physics update's batch, sorted ascending by time.
+	evaluate() uses these instead of evaluating the expression again, until clearBatchResults() is called.
+	*/
+	void setBatchResults(const float* times, const float* results, int count);
+	void clearBatchResults();
+
+	inline std::string getExpressionStr() const { return expressionStr; }
+	void setExpressionStr(std::string expressionStr);
+
+	bool operator==(const TFV& other) const override;
+
+private:
+	std::string expressionStr = "0";
+
+	std::vector<exprtk::symbol_table<float>> boundSymbolTables;
+
+	bool compiled = false;
+	exprtk::expression<float> expression;
+	// Defines t; always registered first so that t can't be shadowed by a bound symbol
+	exprtk::symbol_table<float> timeSymbolTable;
+	// The value of t that the expression reads
+	float t = 0;
+
+	// Pairs of time and the expression's value at that time, sorted ascending by time
+	std::vector<std::pair<float, float>> batchResults;
+
+	void compile();
 };
 
 class TFVFactory {
@@ -27,6 +27,8 @@ public:
 
 private:
 	std::unique_ptr<Animation> animation;
+	// The animation's current frame, if there is an animation
+	std::shared_ptr<const SpriteTemplate> curFrame;
 	std::shared_ptr<sf::Sprite> curSprite;
 
 	sf::Vector2f curSpriteOriginalScale;
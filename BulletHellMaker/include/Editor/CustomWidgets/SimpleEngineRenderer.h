@@ -73,6 +73,7 @@ protected:
 	std::unique_ptr<RenderSystem> renderSystem;
 	std::unique_ptr<CollisionSystem> collisionSystem;
 	std::unique_ptr<DespawnSystem> despawnSystem;
+	std::unique_ptr<OffScreenSystem> offScreenSystem;
 	std::unique_ptr<EnemySystem> enemySystem;
 	std::unique_ptr<SpriteAnimationSystem> spriteAnimationSystem;
 	std::unique_ptr<ShadowTrailSystem> shadowTrailSystem;
@@ -4,6 +4,7 @@
 #include <Editor/EventCapturable.h>
 #include <Editor/CopyPaste.h>
 #include <Editor/CustomWidgets/ListView.h>
+#include <Editor/CustomWidgets/EditBox.h>
 #include <Editor/CustomWidgets/NumericalEditBoxWithLimits.h>
 #include <Editor/CustomWidgets/SliderWithEditBox.h>
 #include <Editor/Util/ExtraSignals.h>
@@ -78,6 +79,8 @@ private:
 	std::shared_ptr<NumericalEditBoxWithLimits> tfvFloat4EditBox;
 	std::shared_ptr<tgui::Label> tfvInt1Label;
 	std::shared_ptr<NumericalEditBoxWithLimits> tfvInt1EditBox;
+	std::shared_ptr<tgui::Label> tfvExpressionLabel;
+	std::shared_ptr<EditBox> tfvExpressionEditBox;
 
 	std::shared_ptr<TFV> oldTFV; // Should never be modified after setTFV() is called
 	std::shared_ptr<PiecewiseTFV> tfv;
@@ -10,6 +10,7 @@
 #include <DataStructs/UndoStack.h>
 #include <Editor/Util/ExtraSignals.h>
 #include <Editor/CustomWidgets/EditBox.h>
+#include <Editor/CustomWidgets/NumericalEditBoxWithLimits.h>
 #include <Editor/CustomWidgets/AnimatableChooser.h>
 #include <Editor/CustomWidgets/SoundSettingsGroup.h>
 #include <Editor/CustomWidgets/SingleMarkerPlacer.h>
@@ -103,6 +104,12 @@ private:
 	std::shared_ptr<tgui::ComboBox> empiOnCollisionAction;
 	std::shared_ptr<tgui::Label> empiPierceResetTimeLabel;
 	std::shared_ptr<EditBox> empiPierceResetTime;
+	std::shared_ptr<tgui::CheckBox> empiContinuousCollision;
+	std::shared_ptr<tgui::Label> empiCapsuleEndXLabel;
+	std::shared_ptr<NumericalEditBoxWithLimits> empiCapsuleEndX;
+	std::shared_ptr<tgui::Label> empiCapsuleEndYLabel;
+	std::shared_ptr<NumericalEditBoxWithLimits> empiCapsuleEndY;
+	std::shared_ptr<tgui::Button> empiConvertChainToCapsule;
 	std::shared_ptr<tgui::Label> empiBulletModelLabel;
 	std::shared_ptr<tgui::CheckBox> empiInheritRadius;
 	std::shared_ptr<tgui::CheckBox> empiInheritDespawnTime;
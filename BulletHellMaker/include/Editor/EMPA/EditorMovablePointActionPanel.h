@@ -81,6 +81,7 @@ private:
 	std::shared_ptr<tgui::Label> empaiHomingSpeedLabel;
 	std::shared_ptr<TFVGroup> empaiHomingSpeed;
 	std::shared_ptr<tgui::Button> empaiEditBezierControlPoints;
+	std::shared_ptr<tgui::CheckBox> empaiBezierConstantSpeed;
 
 	// Symbol table editor child window.
 	// The window is added to the GUI directly and will be removed in this widget's destructor.
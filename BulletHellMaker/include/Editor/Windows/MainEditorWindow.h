@@ -109,6 +109,11 @@ public:
 	Returns whether there are any unsaved changes.
 	*/
 	bool hasUnsavedChanges();
+	/*
+	Saves the level pack to its folder and cooks it into the single file that the game loads on startup.
+	Unsaved changes in this editor are not included.
+	*/
+	void exportCookedLevelPack();
 
 	/*
 	Opens the preview window.
@@ -18,4 +18,5 @@ private:
 	void promptOpenLevelPack();
 
 	void onOpenLevelPackWhileUnsavedChangesExistConfirmation(EDITOR_WINDOW_CONFIRMATION_PROMPT_CHOICE choice);
+	void onExportLevelPackWhileUnsavedChangesExistConfirmation(EDITOR_WINDOW_CONFIRMATION_PROMPT_CHOICE choice);
 };
\ No newline at end of file
@@ -4,10 +4,14 @@
 #include <queue>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <set>
+#include <future>
 
 #include <SFML/Audio.hpp>
 
 #include <LevelPack/TextMarshallable.h>
+#include <DataStructs/SoundBufferCache.h>
 
 class AudioSettings {
 public:
@@ -85,11 +89,28 @@ private:
 	float transitionTime = 0;
 };
 
+/*
+Sounds are played from a fixed pool of MAX_SOUND_VOICES voices that are reused as they finish.
+
+Plays of the same sound file at the same pitch in the same update are coalesced into a single voice, which
+is made louder for every extra play. At most MAX_VOICES_PER_SOUND voices can play the same file at once.
+When there is no free voice for a play, the oldest voice with the lowest priority that is not higher than
+the play's priority is stopped and reused; if there is none, the play is dropped.
+*/
 class AudioPlayer {
 public:
+	AudioPlayer();
+
 	void update(float deltaTime);
 
-	void playSound(const SoundSettings& soundSettings);
+	/*
+	priority - sounds with a higher priority can take voices from sounds with a lower priority
+	*/
+	void playSound(const SoundSettings& soundSettings, int priority = 0);
+	/*
+	Decodes every sound file in fileNames ahead of time so that playing them doesn't have to load them.
+	*/
+	void preloadSounds(const std::set<std::string>& fileNames);
 	/*
 	Plays music.
 	Returns a pointer to the Music object.
@@ -109,6 +130,29 @@ public:
 	the old Music should be kept if it should be resumed later.
 	*/
 	void playMusic(std::shared_ptr<sf::Music> music, const MusicSettings& musicSettings);
+	/*
+	Starts opening a music file on a worker thread, so that a later playMusic() with the same file only has to start it.
+	The opened music is handed over to this AudioPlayer in update().
+	Does nothing if the file is already prefetched or being prefetched.
+	*/
+	void prefetchMusic(const MusicSettings& musicSettings);
+	/*
+	Closes every prefetched music that hasn't been played yet. Prefetches still in progress are discarded once they finish.
+	*/
+	void clearPrefetchedMusic();
+
+	// Amount of plays that were not played because every voice they could use was taken
+	inline int getDroppedSoundCount() const { return droppedSoundCount; }
+	// Amount of plays that were merged into a voice started in the same update
+	inline int getCoalescedSoundCount() const { return coalescedSoundCount; }
+	// Amount of voices that were stopped early to play another sound
+	inline int getStolenVoiceCount() const { return stolenVoiceCount; }
+	// Amount of playMusic() calls whose music had been prefetched
+	inline int getMusicPrefetchHitCount() const { return musicPrefetchHitCount; }
+	// Amount of playMusic() calls that had to open their music
+	inline int getMusicPrefetchMissCount() const { return musicPrefetchMissCount; }
+	// File names of every sound that had to be loaded when it was played because it wasn't preloaded
+	inline const std::set<std::string>& getLazilyLoadedSoundFileNames() const { return soundBuffers.getLazilyLoadedFileNames(); }
 
 private:
 	enum class VOLUME_CHANGE_STATUS {
@@ -116,12 +160,40 @@ private:
 		INCREASING
 	};
 
-	// Maps file names to SoundBuffers
-	std::map<std::string, sf::SoundBuffer> soundBuffers;
-	// Queue of sounds currently playing
-	std::queue<std::unique_ptr<sf::Sound>> currentSounds;
+	struct Voice {
+		// Kept so that the buffer isn't destroyed while it's playing, even if it's evicted from soundBuffers
+		std::shared_ptr<sf::SoundBuffer> buffer;
+		sf::Sound sound;
+		// The SoundSettings of the sound being played, before global volume settings
+		std::string fileName;
+		float pitch = 1;
+		float volume = 0;
+		int priority = 0;
+		// The update the voice started playing in
+		int startUpdate = -1;
+		// Amount of plays merged into this voice
+		int plays = 0;
+	};
+
+	SoundBufferCache soundBuffers;
+	// Never resized, so the sf::Sounds are only created once
+	std::vector<Voice> voices;
+	// Incremented every update; plays in the same update can be coalesced
+	int updateCount = 0;
+
+	int droppedSoundCount = 0;
+	int coalescedSoundCount = 0;
+	int stolenVoiceCount = 0;
 
 	std::shared_ptr<sf::Music> currentMusic;
+	// Maps file names to opened Musics that haven't been played yet
+	std::map<std::string, std::shared_ptr<sf::Music>> prefetchedMusic;
+	// Maps file names to Musics being opened on worker threads; the Music is nullptr if it couldn't be opened
+	std::map<std::string, std::future<std::shared_ptr<sf::Music>>> pendingMusic;
+	// Prefetches that were cleared while still being opened, kept until they finish so that clearing them doesn't wait on them
+	std::vector<std::future<std::shared_ptr<sf::Music>>> discardedMusic;
+	int musicPrefetchHitCount = 0;
+	int musicPrefetchMissCount = 0;
 
 	// Musics being faded, how they're being faded, original volume before global settings, and target volume before global settings
 	std::vector<std::tuple<std::shared_ptr<sf::Music>, VOLUME_CHANGE_STATUS, float, float>> currentlyFading;
@@ -130,4 +202,15 @@ private:
 	float musicTransitionTime = 0;
 	// Time since the last transition started, in seconds
 	float timeSinceMusicTransitionStart = 0;
+
+	/*
+	Moves every prefetched music that has finished opening into prefetchedMusic.
+	*/
+	void collectPrefetchedMusic();
+	/*
+	Collects prefetched music and advances the music transition by deltaTime seconds.
+	Unlike update(), this does not start a new update, so sounds played before and after a call
+	to this can still be coalesced.
+	*/
+	void updateMusic(float deltaTime);
 };
\ No newline at end of file
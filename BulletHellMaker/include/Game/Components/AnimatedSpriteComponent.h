@@ -0,0 +1,16 @@
+#pragma once
+#include <entt/entt.hpp>
+
+/*
+Component for entities whose SpriteComponent is animated (see SpriteComponent::isAnimated()).
+SpriteAnimationSystem updates only the sprites of entities with this component and removes it
+once the sprite stops being animated, so static sprites are never updated.
+*/
+class AnimatedSpriteComponent {
+public:
+	/*
+	Assigns an AnimatedSpriteComponent to the entity if its SpriteComponent is animated.
+	Must be called whenever an entity's SpriteComponent is given an animatable or an effect animation.
+	*/
+	static void markIfAnimated(entt::DefaultRegistry& registry, uint32_t entity);
+};
\ No newline at end of file
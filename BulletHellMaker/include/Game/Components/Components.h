@@ -1,5 +1,6 @@
 #pragma once
 #include <Game/Components/AnimatableSetComponent.h>
+#include <Game/Components/AnimatedSpriteComponent.h>
 #include <Game/Components/CollectibleComponent.h>
 #include <Game/Components/DespawnComponent.h>
 #include <Game/Components/EMPSpawnerComponent.h>
@@ -9,6 +10,7 @@
 #include <Game/Components/HitboxComponent.h>
 #include <Game/Components/LevelManagerTag.h>
 #include <Game/Components/MovementPathComponent.h>
+#include <Game/Components/OffScreenComponent.h>
 #include <Game/Components/PlayerBulletComponent.h>
 #include <Game/Components/PlayerTag.h>
 #include <Game/Components/PositionComponent.h>
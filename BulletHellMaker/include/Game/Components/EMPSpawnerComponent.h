@@ -37,6 +37,11 @@ public:
 
 	void update(entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, EntityCreationQueue& queue, float deltaTime);
 
+	/*
+	Returns whether there are still EMPs that have yet to be spawned.
+	*/
+	inline bool hasPendingEMPs() const { return !emps.empty(); }
+
 private:
 	enum class BULLET_TYPE {
 		ENEMY,
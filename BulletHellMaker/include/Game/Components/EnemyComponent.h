@@ -17,7 +17,57 @@ Component for an enemy.
 class EnemyComponent {
 public:
 	EnemyComponent(std::shared_ptr<EditorEnemy> enemyData, std::shared_ptr<EnemySpawnInfo> spawnInfo, int enemyID);
-	void update(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity, float deltaTime);
+
+	/*
+	Advances this enemy's timers. Must be called once every update, before anything else.
+	*/
+	void updateTime(float deltaTime);
+	/*
+	Executes every attack and attack pattern change that has become due since the last call.
+	EnemySystem only calls this when getTimeUntilNextAttackOrAttackPattern() says something may be due.
+	*/
+	void checkAttacksAndAttackPatterns(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity);
+	/*
+	Check for any missed phases since the last update and then executes their relevant actions.
+	Must be called every update, after checkAttacksAndAttackPatterns() if that is called.
+	*/
+	void checkPhases(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity);
+
+	/*
+	Returns the time until the next attack or attack pattern change, or infinity if there is none.
+	*/
+	float getTimeUntilNextAttackOrAttackPattern(const LevelPack& levelPack) const;
+	/*
+	Returns whether the time until the next attack or attack pattern change has changed for any reason
+	other than the passage of time since the last call to setScheduleID().
+	*/
+	inline bool needsRescheduling() const { return scheduleChanged; }
+	/*
+	Sets the ID of the entry this enemy has in EnemySystem's schedule.
+	Any older entry for this enemy is then ignored.
+	*/
+	inline void setScheduleID(unsigned long long scheduleID) { this->scheduleID = scheduleID; scheduleChanged = false; }
+	inline unsigned long long getScheduleID() const { return scheduleID; }
+	/*
+	Returns the time until the passage of time alone could satisfy the next phase's start condition,
+	or infinity if it can't or if the condition hasn't been evaluated yet.
+	*/
+	float getTimeUntilNextPhaseCheck() const;
+	/*
+	Returns whether the time until the next phase check has changed since the last call to setPhaseScheduleID().
+	*/
+	inline bool needsPhaseRescheduling() const { return phaseScheduleChanged; }
+	/*
+	Sets the ID of the entry this enemy has in EnemySystem's phase schedule.
+	Any older entry for this enemy is then ignored.
+	*/
+	inline void setPhaseScheduleID(unsigned long long phaseScheduleID) { this->phaseScheduleID = phaseScheduleID; phaseScheduleChanged = false; }
+	inline unsigned long long getPhaseScheduleID() const { return phaseScheduleID; }
+	/*
+	Makes the next checkPhases() evaluate the next phase's start condition, because enough time has passed that it may be satisfied.
+	Called by EnemySystem when this enemy's entry in its phase schedule is due.
+	*/
+	inline void markPhaseCheckDue() { phaseCheckDue = true; }
 
 	inline float getTimeSinceSpawned() const { return timeSinceSpawned; }
 	inline float getTimeSinceLastPhase() const { return timeSincePhase; }
@@ -52,6 +102,10 @@ private:
 	// Whether to keep checking for if the entity can continue to the next attack pattern
 	bool checkNextAttackPattern = true;
 
+	// See needsRescheduling() and setScheduleID()
+	bool scheduleChanged = true;
+	unsigned long long scheduleID = 0;
+
 	// Current phase index in list of phases in EditorEnemy
 	int currentPhaseIndex = -1;
 	// Current attack pattern index in list of attack patterns in current EditorEnemyPhase
@@ -59,13 +113,28 @@ private:
 	// Current attack index in list of attacks in current EditorAttackPattern
 	int currentAttackIndex = -1;
 
+	// The next phase's start condition is only re-evaluated once EnemySystem's phase schedule says timeSincePhase
+	// has reached nextPhaseCheckTime, or one of the other inputs it may depend on has changed since it was last evaluated
+	bool nextPhaseConditionEvaluated = false;
+	bool phaseCheckDue = false;
+	float nextPhaseCheckTime = 0;
+	unsigned int nextPhaseCheckHealthChangeCount = 0;
+	std::size_t nextPhaseCheckEnemiesAliveCount = 0;
+
+	// See needsPhaseRescheduling() and setPhaseScheduleID()
+	bool phaseScheduleChanged = false;
+	unsigned long long phaseScheduleID = 0;
+
 	// Emitted whenever phase changes.
 	// Parameters: this component's entity, the new phase, the start condition of the old 
 	// phase (nullptr if the new phase is the first phase), and the next phase's start condition (nullptr if next phase is the last phase)
 	std::shared_ptr<entt::SigH<void(uint32_t, std::shared_ptr<EditorEnemyPhase>, std::shared_ptr<EnemyPhaseStartCondition>, std::shared_ptr<EnemyPhaseStartCondition>)>> enemyPhaseChangeSignal;
 
-	// Check for any missed phases/attack patterns/attacks since the last update and then executes their relevant actions
-	void checkPhases(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity);
+	// Check for any missed attack patterns/attacks since the last update and then executes their relevant actions
+	/*
+	Returns whether the next phase's start condition may have a different result than when it was last evaluated.
+	*/
+	bool nextPhaseConditionMayHaveChanged(entt::DefaultRegistry& registry, uint32_t entity) const;
 	void checkAttackPatterns(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity);
 	void checkAttacks(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity);
 };
\ No newline at end of file
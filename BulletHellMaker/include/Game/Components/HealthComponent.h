@@ -23,12 +23,18 @@ public:
 
 	int getHealth() const;
 	int getMaxHealth() const;
+	/*
+	Returns the number of times health or max health has changed.
+	Used to tell whether anything that depends on health needs to be re-evaluated.
+	*/
+	inline unsigned int getChangeCount() const { return changeCount; }
 	void setHealth(int health);
 	void setMaxHealth(int maxHealth);
 
 private:
 	int health;
 	int maxHealth;
+	unsigned int changeCount = 0;
 
 	// Emitted whenever health changes.
 	// Parameters: new health and max health
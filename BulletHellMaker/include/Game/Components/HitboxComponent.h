@@ -3,10 +3,11 @@
 
 
 enum class ROTATION_TYPE;
+class PositionComponent;
 
 /*
 Component for an entity that has a hitbox.
-A hitbox is a single circle with variable radius and origin.
+A hitbox is a single circle with variable radius and origin, or a capsule (every point within the radius of a line segment).
 */
 class HitboxComponent {
 public:
@@ -17,10 +18,12 @@ public:
 	*/
 	HitboxComponent(ROTATION_TYPE rotationType, float radius, float x, float y);
 	/*
+	A hitbox centered on the origin of the entity's sprite. Sprites are always drawn with their origin
+	at the entity's position, so the hitbox stays at the entity's position no matter how the sprite is rotated.
+
 	radius - hitbox radius
-	sprite - this component's entity's sprite at the time of this HitboxComponent construction
 	*/
-	HitboxComponent(float radius, std::shared_ptr<sf::Sprite> sprite);
+	HitboxComponent(float radius);
 
 	void update(float deltaTime);
 
@@ -32,6 +35,10 @@ public:
 	make use of the boolean value.
 	*/
 	void disable(float time);
+	/*
+	Disables the hitbox until the entity is destroyed.
+	*/
+	void disablePermanently();
 
 	/*
 	Rotates this hitbox some amount counter-clockwise.
@@ -39,16 +46,80 @@ public:
 	*/
 	void rotate(float angle);
 	/*
-	Rotates this hitbox to match the sprite's rotation.
+	Same as rotate(angle), but with the sine and cosine of angle already known.
+	*/
+	void rotate(float angle, float sin, float cos);
+
+	/*
+	Turns this hitbox into a capsule around the segment from (startX, startY) to (endX, endY), which are local offsets
+	when rotated at angle 0. The segment replaces this hitbox's local offset and rotates the same way the offset would.
+	Capsules don't follow a sprite's origin, so this should only be used on a hitbox constructed with a rotation type.
+	*/
+	void setCapsule(float startX, float startY, float endX, float endY);
+
+	/*
+	Records where this component's entity is in this physics update and decides whether its hitbox
+	should be swept from where the entity was in the last updateSweep() call to where it is now.
+	The hitbox is swept if continuous collision is on or if the entity moved more than the hitbox's radius,
+	since a small enough target could otherwise be skipped over entirely.
+	The first call, and the first call after resetSweep(), never sweeps.
+
+	Returns isSweeping().
+	*/
+	bool updateSweep(const PositionComponent& position);
+	/*
+	Forgets where this component's entity was, so that the next updateSweep() call doesn't sweep.
+	Should be called whenever the entity jumps instead of moving continuously, such as when its path
+	or reference entity changes, so that the jump isn't treated as a path the hitbox passed through.
+	*/
+	void resetSweep();
+	/*
+	Records whether this hitbox's radius is at least largeObjectMinRadius, for keeping track of which of CollisionSystem's
+	tables its entity belongs in. Returns whether that changed since the last call. The first call always counts as a change.
+	*/
+	bool updateLargeObject(float largeObjectMinRadius);
+	/*
+	Returns whether this hitbox's radius was at least largeObjectMinRadius in the last updateLargeObject() call.
 	*/
-	void rotate(std::shared_ptr<sf::Sprite> sprite);
+	inline bool isLargeObject() const { return largeObject; }
 
+	/*
+	Returns whether rotating this hitbox never changes it, so that rotate() doesn't need to be called at all.
+	*/
+	inline bool isRotationInvariant() const { return rotationInvariant; }
 	bool isDisabled() const;
 	float getRadius() const;
 	float getX() const;
 	float getY() const;
+	inline bool isCapsule() const { return capsule; }
+	/*
+	Returns the vector from the center of this capsule to its segment's end, at its current rotation.
+	The segment goes from (getX(), getY()) - getCapsuleHalfX/Y() to (getX(), getY()) + getCapsuleHalfX/Y().
+	Both are 0 if this hitbox is not a capsule.
+	*/
+	inline float getCapsuleHalfX() const { return capsuleHalfX; }
+	inline float getCapsuleHalfY() const { return capsuleHalfY; }
+	/*
+	Returns the radius of the smallest circle centered at (getX(), getY()) that contains this entire hitbox.
+	*/
+	float getBoundingRadius() const;
+	/*
+	Returns whether collision checks against this hitbox should use the path it swept since the last physics update.
+	See updateSweep().
+	*/
+	inline bool isSweeping() const { return sweeping; }
+	/*
+	Returns the position of this component's entity at the start of the sweep.
+	Only meaningful if isSweeping() is true.
+	*/
+	inline sf::Vector2f getSweepStart() const { return sweepStart; }
+	inline bool getContinuousCollision() const { return continuousCollision; }
 
 	void setRadius(float radius);
+	/*
+	If true, this hitbox is always swept between physics updates instead of only when its entity moves fast.
+	*/
+	inline void setContinuousCollision(bool continuousCollision) { this->continuousCollision = continuousCollision; }
 
 private:
 	// If this component's entity has a SpriteComponent, this rotationType must match its SpriteComponent's rotationType
@@ -58,6 +129,25 @@ private:
 	float x = 0, y = 0;
 	// Local offset of hitbox when rotated at angle 0
 	float unrotatedX, unrotatedY;
+	// See isRotationInvariant()
+	bool rotationInvariant;
+
+	// See setCapsule()
+	bool capsule = false;
+	float capsuleHalfX = 0, capsuleHalfY = 0;
+	// Half of the capsule's segment when rotated at angle 0
+	float unrotatedCapsuleHalfX = 0, unrotatedCapsuleHalfY = 0;
 
 	float hitboxDisabledTimeLeft = 0;
+	bool permanentlyDisabled = false;
+
+	bool continuousCollision = false;
+	// See updateSweep()
+	bool sweeping = false;
+	bool hasLastPosition = false;
+	sf::Vector2f lastPosition;
+	sf::Vector2f sweepStart;
+	// See updateLargeObject()
+	bool largeObject = false;
+	bool largeObjectKnown = false;
 };
\ No newline at end of file
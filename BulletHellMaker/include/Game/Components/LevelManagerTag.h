@@ -28,6 +28,10 @@ public:
 
 	float getTimeSinceStartOfLevel() const;
 	float getTimeSinceLastEnemySpawn() const;
+	/*
+	Returns the number of enemies currently alive.
+	*/
+	inline std::size_t getEnemiesAliveCount() const { return enemiesAliveCount; }
 	int getPoints() const;
 	std::shared_ptr<Level> getLevel() const;
 	LevelPack* getLevelPack() const;
@@ -40,6 +44,13 @@ public:
 	enemy - the enemy entity
 	*/
 	void onEnemySpawn(uint32_t enemy);
+	/*
+	Should be called whenever an enemy is despawned.
+	SpawnEnemyCommand connects this to every enemy's despawn signal.
+
+	enemy - the enemy entity
+	*/
+	void onEnemyDespawn(uint32_t enemy);
 
 	void addPoints(int amount);
 	void subtractPoints(int amount);
@@ -58,6 +69,14 @@ private:
 	std::shared_ptr<Level> level;
 	// Current index in list of LevelEvents
 	int currentLevelEventsIndex = -1;
+	// The next LevelEvent's start condition is only evaluated when the time since the start of the level
+	// reaches this, or when nextEventConditionDirty is true
+	float nextEventCheckTime = 0;
+	// Whether something other than time that start conditions depend on has changed since the last evaluation
+	bool nextEventConditionDirty = true;
+
+	// Number of enemies currently alive
+	std::size_t enemiesAliveCount = 0;
 
 	// Points earned so far
 	int points = 0;
@@ -2,7 +2,10 @@
 #include <SFML/Graphics.hpp>
 #include <entt/entt.hpp>
 
+#include <DataStructs/PositionHistory.h>
+
 class MovablePoint;
+class HomingMP;
 struct MPSpawnInformation;
 class EntityCreationQueue;
 class EMPSpawnType;
@@ -35,39 +38,60 @@ public:
 	void update(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, PositionComponent& entityPosition, float deltaTime);
 
 	/*
-	Returns this component's entity's position some time ago.
+	Returns this component's entity's global position some time ago, interpolated from its position history.
+	Only the last few physics updates are remembered (see PositionHistory). If the history doesn't reach back far enough,
+	such as for an entity that was just spawned, the position is computed from the current path instead.
 	*/
 	sf::Vector2f getPreviousPosition(entt::DefaultRegistry& registry, float secondsAgo) const;
 
 	bool usesReferenceEntity() const;
 	uint32_t getReferenceEntity() const;
 	std::shared_ptr<MovablePoint> getPath() const;
+	/*
+	Returns the current path if it is a HomingMP, or nullptr otherwise.
+	*/
+	HomingMP* getHomingPath() const;
 	float getTime() const;
+	/*
+	Returns whether this component's entity has been frozen in place.
+	MovementSystem does not update frozen entities.
+	*/
+	inline bool isFrozen() const { return frozen; }
 
 	/*
 	Sets the reference entity of this component's entity.
 	The PositionComponent of this component's entity should be updated after this call.
 	*/
-	void setReferenceEntity(uint32_t reference);
+	void setReferenceEntity(entt::DefaultRegistry& registry, uint32_t entity, uint32_t reference);
 	/*
 	Changes the path of an entity.
 
 	timeLag - number of seconds ago that the path change should have happened
 	*/
 	void setPath(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, PositionComponent& entityPosition, std::shared_ptr<MovablePoint> newPath, float timeLag);
+	inline void setFrozen(bool frozen) { this->frozen = frozen; }
 
 private:
 	bool useReferenceEntity;
 	uint32_t referenceEntity;
 	// Elapsed time since the the last path change
 	float time;
+	// Elapsed time since this component's entity was spawned
+	float lifetime;
+	bool frozen = false;
 	std::shared_ptr<MovablePoint> path;
-	// Sorted descending in age (index 0 is the oldest path).
-	std::vector<std::shared_ptr<MovablePoint>> previousPaths;
+	// path, if it is a HomingMP; cached so that MovementSystem doesn't need a dynamic_cast every update
+	HomingMP* homingPath = nullptr;
+	// Global positions of this component's entity over the last few physics updates
+	PositionHistory positionHistory;
 	// Actions to be carried out in order; each one changes pushes back an MP to path
 	std::vector<std::shared_ptr<EMPAction>> actions;
 	int currentActionsIndex = 0;
 
 	void initialSpawn(entt::DefaultRegistry& registry, uint32_t entity, std::shared_ptr<EMPSpawnType> spawnType, std::vector<std::shared_ptr<EMPAction>>& actions);
 	void initialSpawn(entt::DefaultRegistry& registry, uint32_t entity, MPSpawnInformation spawnInfo, std::vector<std::shared_ptr<EMPAction>>& actions);
+	/*
+	Stops entity's hitbox, if any, from being swept across the jump caused by a path or reference entity change.
+	*/
+	void resetHitboxSweep(entt::DefaultRegistry& registry, uint32_t entity);
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+#include <LevelPack/OffScreenPolicy.h>
+
+/*
+Component for a bullet that is affected by an off-screen policy.
+Removed from the entity once the policy's action has been carried out.
+*/
+class OffScreenComponent {
+public:
+	OffScreenComponent(OffScreenPolicy policy);
+
+	OFF_SCREEN_ACTION getAction() const;
+	float getMargin() const;
+
+private:
+	OFF_SCREEN_ACTION action;
+	float margin;
+};
@@ -2,11 +2,12 @@
 #include <SFML/Graphics.hpp>
 
 #include <DataStructs/SpriteEffectAnimation.h>
+#include <DataStructs/SpriteTemplate.h>
+#include <LevelPack/Animation.h>
 
 enum class ROTATION_TYPE;
 class SpriteLoader;
 class Animatable;
-class Animation;
 
 class SpriteComponent {
 public:
@@ -19,8 +20,15 @@ public:
 	loopAnimatable - only applicable if animatable is an animation
 	*/
 	SpriteComponent(SpriteLoader& spriteLoader, Animatable animatable, bool loopAnimatable, int renderLayer, float subLayer);
-	SpriteComponent(ROTATION_TYPE rotationType, std::shared_ptr<sf::Sprite> sprite, int renderLayer, float subLayer);
+	/*
+	Shows a copy of some sprite as it currently appears, such as for a shadow.
+	*/
+	SpriteComponent(ROTATION_TYPE rotationType, std::shared_ptr<const SpriteTemplate> spriteTemplate, SpriteInstance instance, int renderLayer, float subLayer);
 
+	/*
+	Advances the animation and effect animation, if any.
+	Does nothing if the sprite is not animated.
+	*/
 	void update(float deltaTime);
 
 	/*
@@ -31,18 +39,44 @@ public:
 	int getRenderLayer() const;
 	float getSubLayer() const;
 	bool animationIsDone() const;
-	const std::shared_ptr<sf::Sprite> getSprite() const;
+	/*
+	Returns whether update() can still change the sprite, either because it has an unfinished animation
+	or an effect animation.
+	*/
+	bool isAnimated() const;
+	inline bool hasSprite() const { return spriteTemplate != nullptr; }
+	/*
+	Returns the sprite currently being shown, or nullptr if there is none.
+	*/
+	inline const std::shared_ptr<const SpriteTemplate>& getSpriteTemplate() const { return spriteTemplate; }
+	inline const SpriteInstance& getSpriteInstance() const { return instance; }
+	/*
+	Returns the transform from the sprite's texture rect to where it is drawn, the same as sf::Sprite::getTransform().
+	Must only be called if there is a sprite.
+	*/
+	sf::Transform getTransform() const;
+	/*
+	Returns the color the sprite is drawn with.
+	Must only be called if there is a sprite.
+	*/
+	sf::Color getColor() const;
 
 	/*
 	loopAnimatable - only applicable if animatable is an animation
 	*/
 	void setAnimatable(SpriteLoader& spriteLoader, Animatable animatable, bool loopAnimatable);
+	/*
+	Replaces the current effect animation, undoing whatever it did to the sprite.
+	*/
 	void setEffectAnimation(std::unique_ptr<SpriteEffectAnimation> effectAnimation);
 	/*
-	angle - in degrees
+	Sets the position the sprite's origin is drawn at, in pixels.
+	*/
+	void setPosition(float x, float y);
+	/*
+	Sets a color that every sprite shown is multiplied by.
 	*/
-	void setRotation(float angle);
-	void setScale(float x, float y);
+	void setTint(sf::Color tint);
 	bool usesShader() const;
 	sf::Shader& getShader();
 	ROTATION_TYPE getRotationType();
@@ -52,6 +86,19 @@ public:
 	*/
 	float getInheritedRotationAngle() const;
 
+	/*
+	Stretches the sprite along the segment from (startX, startY) to (endX, endY) so that it covers a capsule hitbox around that
+	segment with some radius. The segment's endpoints are local offsets from the entity when rotated at angle 0, same as
+	HitboxComponent::setCapsule(), and the sprite turns with the segment the same way the hitbox does.
+	*/
+	void setStretch(float startX, float startY, float endX, float endY, float radius);
+	inline bool isStretched() const { return stretched; }
+	/*
+	Scales a stretched sprite to the length of its segment at some resolution and returns the offset from the entity's position
+	to the center of the segment, which is where the sprite should be drawn.
+	*/
+	sf::Vector2f applyStretch(float resolutionMultiplier);
+
 private:
 	int renderLayer;
 	float subLayer;
@@ -63,15 +110,36 @@ private:
 	// In radians
 	float rotationAngle = 0;
 
-	std::shared_ptr<sf::Sprite> sprite;
+	// See setStretch()
+	bool stretched = false;
+	// Center of the segment when rotated at angle 0
+	float stretchX = 0, stretchY = 0;
+	// Angle of the segment when rotated at angle 0, in radians
+	float stretchAngle = 0;
+	// Length the sprite is stretched to, including the rounded ends of the capsule
+	float stretchLength = 0;
+	// Horizontal scale that makes the sprite stretchLength long, from the last applyStretch()
+	float stretchScaleX = 1;
+
+	std::shared_ptr<const SpriteTemplate> spriteTemplate;
 	// The original sprite. Used for returning to original appearance after an animation ends.
-	std::shared_ptr<sf::Sprite> originalSprite;
+	std::shared_ptr<const SpriteTemplate> originalSpriteTemplate;
+	// Position, rotation, and effects of the sprite being shown
+	SpriteInstance instance;
+	// The tint from setTint(), without anything the effect animation did to it
+	sf::Color tint = sf::Color::White;
 	// Effect animation that the sprite is currently undergoing, if any
 	std::unique_ptr<SpriteEffectAnimation> effectAnimation;
-	// Animation that the sprite is currently undergoing, if any
-	std::unique_ptr<Animation> animation;
+	// Playback position in the animation that the sprite is currently undergoing, if any
+	Animation animation;
 
-	void updateSprite(sf::Sprite newSprite);
-	void updateSprite(std::shared_ptr<sf::Sprite> newSprite);
-	void setAnimation(std::unique_ptr<Animation> animation);
+	/*
+	Does nothing if newSprite is nullptr.
+	*/
+	void updateSprite(std::shared_ptr<const SpriteTemplate> newSprite);
+	void setAnimation(Animation animation);
+	/*
+	Applies the rotation type, rotation angle, and stretch to the sprite instance.
+	*/
+	void applyRotation();
 };
\ No newline at end of file
@@ -35,6 +35,7 @@ static void reserveMemory(entt::DefaultRegistry& registry, unsigned int reserve)
 	registry.reserve<EMPSpawnerComponent>(reserve);
 	registry.reserve<ShadowTrailComponent>(reserve);
 	registry.reserve<AnimatableSetComponent>(reserve);
+	registry.reserve<AnimatedSpriteComponent>(reserve);
 	registry.reserve<CollectibleComponent>(reserve);
 	// Ignore level manager component since there can only be one
 }
@@ -58,13 +59,14 @@ Command for creating an entity that acts as a part of a shadow trail.
 */
 class SpawnShadowTrailCommand : public EntityCreationCommand {
 public:
-	SpawnShadowTrailCommand(entt::DefaultRegistry& registry, sf::Sprite sprite, float x, float y, float shadowRotationAngle, float shadowLifespan);
+	SpawnShadowTrailCommand(entt::DefaultRegistry& registry, std::shared_ptr<const SpriteTemplate> spriteTemplate, SpriteInstance spriteInstance, float x, float y, float shadowRotationAngle, float shadowLifespan);
 
 	void execute(EntityCreationQueue& queue) override;
 	int getEntitiesQueuedCount() override;
 
 private:
-	sf::Sprite sprite;
+	std::shared_ptr<const SpriteTemplate> spriteTemplate;
+	SpriteInstance spriteInstance;
 	// Global positions
 	float x;
 	float y;
@@ -12,6 +12,7 @@
 #include <Game/Systems/CollisionSystem.h>
 #include <Game/Systems/EnemySystem.h>
 #include <Game/Systems/DespawnSystem.h>
+#include <Game/Systems/OffScreenSystem.h>
 #include <Game/Systems/SpriteAnimationSystem.h>
 #include <Game/Systems/ShadowTrailSystem.h>
 #include <Game/Systems/PlayerSystem.h>
@@ -90,6 +91,7 @@ private:
 	std::unique_ptr<RenderSystem> renderSystem;
 	std::unique_ptr<CollisionSystem> collisionSystem;
 	std::unique_ptr<DespawnSystem> despawnSystem;
+	std::unique_ptr<OffScreenSystem> offScreenSystem;
 	std::unique_ptr<EnemySystem> enemySystem;
 	std::unique_ptr<SpriteAnimationSystem> spriteAnimationSystem;
 	std::unique_ptr<ShadowTrailSystem> shadowTrailSystem;
@@ -12,6 +12,7 @@ Manages collectibles.
 class CollectibleSystem {
 public:
 	CollectibleSystem(EntityCreationQueue& queue, entt::DefaultRegistry& registry, const LevelPack& levelPack, float mapWidth, float mapHeight);
+	~CollectibleSystem();
 
 	void update(float deltaTime);
 
@@ -19,8 +20,11 @@ private:
 	EntityCreationQueue& queue;
 	entt::DefaultRegistry& registry;
 
-	// Spatial hash table with cell size equal to largest item hitbox; contains all entities with CollectibleComponent inserted normally
+	// Spatial hash tables are updated incrementally; a collectible is in exactly one of them until its CollectibleComponent is destroyed
+	// Spatial hash table with cell size equal to largest item hitbox; contains all activated entities with CollectibleComponent inserted normally
 	SpatialHashTable<uint32_t> itemHitboxTable;
-	// Spatial hash table with cell size equal to largest item activation radius; contains all entities with CollectibleComponent inserted with hitbox radius equal to its item activation radius
+	// Spatial hash table with cell size equal to largest item activation radius; contains all unactivated entities with CollectibleComponent inserted with hitbox radius equal to its item activation radius
 	SpatialHashTable<uint32_t> activationTable;
+
+	void onCollectibleDestroy(entt::DefaultRegistry& registry, uint32_t entity);
 };
\ No newline at end of file
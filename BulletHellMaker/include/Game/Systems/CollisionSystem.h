@@ -4,6 +4,7 @@
 #include <DataStructs/SpatialHashTable.h>
 #include <DataStructs/SpriteLoader.h>
 #include <LevelPack/LevelPack.h>
+#include <Game/AudioPlayer.h>
 #include <Game/Components/HitboxComponent.h>
 #include <Game/Components/PositionComponent.h>
 #include <Util/json.hpp>
@@ -22,21 +23,95 @@ NLOHMANN_JSON_SERIALIZE_ENUM(BULLET_ON_COLLISION_ACTION, {
 	{BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY, "PIERCE_ENTITY"}
 })
 
+/*
+Collisions are handled in two phases every update. Detection only queries the spatial hash tables and records
+every bullet that hits something into a buffer of collision events, without changing any entity.
+The response phase then goes through the events in a deterministic order, applying damage and on-collision actions.
+Sounds are played and bullets are destroyed only after every event has been handled.
+*/
 class CollisionSystem {
 public:
 	CollisionSystem(LevelPack& levelPack, EntityCreationQueue& queue, SpriteLoader& spriteLoader, entt::DefaultRegistry& registry, float mapWidth, float mapHeight);
+	~CollisionSystem();
 
 	void update(float deltaTime);
 
 private:
+	enum class COLLISION_EVENT_TYPE {
+		ENEMY_BULLET_HIT_PLAYER,
+		PLAYER_BULLET_HIT_ENEMY
+	};
+
+	struct CollisionEvent {
+		COLLISION_EVENT_TYPE type;
+		// The player or enemy that was hit
+		uint32_t target;
+		uint32_t bullet;
+
+		inline bool operator<(const CollisionEvent& other) const {
+			if (type != other.type) return type < other.type;
+			if (target != other.target) return target < other.target;
+			return bullet < other.bullet;
+		}
+		inline bool operator==(const CollisionEvent& other) const {
+			return type == other.type && target == other.target && bullet == other.bullet;
+		}
+	};
+
 	LevelPack& levelPack;
 	EntityCreationQueue& queue;
 	SpriteLoader& spriteLoader;
 	entt::DefaultRegistry& registry;
+	// Spatial hash tables are updated incrementally; entities are removed when their HitboxComponent is destroyed or when they can no longer collide
 	// Spatial hash table with cell size equal to max(mapWidth, mapHeight)/10
 	SpatialHashTable<uint32_t> defaultTable;
 	// Spatial hash table with cell size equal to 2 * radius of largest hitbox; always contains all enemies and players
 	SpatialHashTable<uint32_t> largeObjectsTable;
 	// Cutoff size for insertion into default table; 2 * max(mapWidth, mapHeight)/10 since hitbox size is 2*radius
 	float defaultTableObjectMaxSize;
+
+	// Collision events found this update, sorted and without duplicates once detection is done
+	std::vector<CollisionEvent> events;
+	// Sounds and their priorities to be played at the end of the response phase; a sound is only played once per update
+	std::vector<std::pair<SoundSettings, int>> soundsToPlay;
+	// Bullets to be despawned along with their attached children at the end of the response phase
+	std::vector<uint32_t> bulletsToDespawn;
+	// Bullets whose components are to be removed at the end of the response phase, leaving only their movement
+	std::vector<uint32_t> bulletsToStrip;
+
+	/*
+	Fills events with every collision between a bullet and a player or enemy it can damage.
+	*/
+	void detectCollisions();
+	/*
+	Handles every event in events.
+	*/
+	void respondToCollisions();
+	void onEnemyBulletHitPlayer(uint32_t player, uint32_t bullet);
+	void onPlayerBulletHitEnemy(uint32_t enemy, uint32_t bullet);
+	/*
+	Queues the bullet to be destroyed if its BULLET_ON_COLLISION_ACTION destroys it on hitting something.
+	*/
+	void onBulletCollision(uint32_t bullet, BULLET_ON_COLLISION_ACTION action);
+	void queueSound(const SoundSettings& sound, int priority = 0);
+
+	/*
+	Updates a bullet's position in the tables. A bullet whose hitbox is being swept covers the whole path it swept
+	since the last update, so that it can be found by anything it passed through.
+	*/
+	void updateBulletInTables(uint32_t bullet, const PositionComponent& position, HitboxComponent& hitbox);
+	/*
+	Updates a player's or enemy's position in the tables. Players and enemies are always in largeObjectsTable,
+	and also in defaultTable if their hitbox is small enough.
+	*/
+	void updatePlayerOrEnemyInTables(uint32_t entity, const PositionComponent& position, HitboxComponent& hitbox);
+	/*
+	Returns whether a bullet collides with some target, using the bullet's swept path if its hitbox is being swept.
+	*/
+	static bool bulletCollides(const PositionComponent& targetPosition, const HitboxComponent& targetHitbox, const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox);
+	/*
+	Removes an entity from both tables.
+	*/
+	void removeFromTables(uint32_t entity);
+	void onHitboxDestroy(entt::DefaultRegistry& registry, uint32_t entity);
 };
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
+#include <queue>
+#include <vector>
+
 #include <entt/entt.hpp>
 
 #include <DataStructs/SpriteLoader.h>
 #include <LevelPack/LevelPack.h>
 
 class EntityCreationQueue;
+class EnemyComponent;
 
 /*
 Manages enemies' phases and attacks
@@ -16,8 +20,42 @@ public:
 	void update(float deltaTime);
 
 private:
+	/*
+	A time at which an enemy has to be checked for something.
+	*/
+	struct ScheduledEnemy {
+		// Value of time at which the enemy should be checked
+		double time;
+		uint32_t entity;
+		// Must match the enemy's EnemyComponent::getScheduleID() or getPhaseScheduleID(), depending on the schedule,
+		// for this entry to still be valid
+		unsigned long long scheduleID;
+
+		inline bool operator>(const ScheduledEnemy& other) const { return time > other.time; }
+	};
+
 	EntityCreationQueue& queue;
 	const LevelPack& levelPack;
 	entt::DefaultRegistry& registry;
 	SpriteLoader& spriteLoader;
-};
\ No newline at end of file
+
+	// Total time this system has been updated for
+	double time = 0;
+	// Min-heap of enemies to be checked for attacks and attack pattern changes, ordered by time
+	std::priority_queue<ScheduledEnemy, std::vector<ScheduledEnemy>, std::greater<ScheduledEnemy>> schedule;
+	// Min-heap of enemies whose next phase's start condition may be satisfied by the passage of time alone, ordered by
+	// the time at which it may become satisfied. Conditions on anything else are noticed by EnemyComponent::checkPhases().
+	std::priority_queue<ScheduledEnemy, std::vector<ScheduledEnemy>, std::greater<ScheduledEnemy>> phaseSchedule;
+	unsigned long long nextScheduleID = 1;
+	// Reused every update so that processing the schedule doesn't allocate
+	std::vector<uint32_t> dueEnemies;
+
+	/*
+	Adds an entry for some enemy to the schedule, invalidating any of its older entries.
+	*/
+	void scheduleEnemy(uint32_t entity, EnemyComponent& enemy);
+	/*
+	Adds an entry for some enemy to the phase schedule, invalidating any of its older entries.
+	*/
+	void schedulePhaseCheck(uint32_t entity, EnemyComponent& enemy);
+};
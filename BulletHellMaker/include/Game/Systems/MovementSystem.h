@@ -3,8 +3,11 @@
 #include <SFML/Graphics.hpp>
 
 #include <DataStructs/SpriteLoader.h>
+#include <DataStructs/MovablePoint.h>
 
 class EntityCreationQueue;
+class SpriteComponent;
+class HitboxComponent;
 
 /*
 Handles movement and spawning of enemy/player bullets.
@@ -16,7 +19,47 @@ public:
 	void update(float deltaTime);
 
 private:
+	/*
+	Structure of arrays of every entity that moved this update and has something that rotates with movement.
+	*/
+	struct RotationBatch {
+		std::vector<uint32_t> entities;
+		// How far each entity moved this update
+		std::vector<float> dx;
+		std::vector<float> dy;
+		// nullptr if the entity has no SpriteComponent
+		std::vector<SpriteComponent*> sprites;
+		// nullptr if the entity has no HitboxComponent or its hitbox is rotation invariant
+		std::vector<HitboxComponent*> hitboxes;
+		// Outputs; radians
+		std::vector<float> angles;
+
+		void clear();
+	};
+
 	EntityCreationQueue& queue;
 	SpriteLoader& spriteLoader;
 	entt::DefaultRegistry& registry;
+
+	// Reused every update so that steering homing entities doesn't allocate
+	HomingSteeringBatch homingSteeringBatch;
+	// Reused every update so that batching ExpressionTFVs doesn't allocate
+	ExpressionTFVBatch expressionTFVBatch;
+	// Reused every update so that rotating entities doesn't allocate
+	RotationBatch rotationBatch;
+
+	/*
+	Steers every entity that is currently following a HomingMP in a single batch.
+	Target positions are read from the registry once per target instead of once per homing entity.
+	*/
+	void steerHomingEntities(float deltaTime);
+	/*
+	Evaluates every ExpressionTFV that entities' paths will use this update, one batch per ExpressionTFV.
+	expressionTFVBatch must be cleared before any entity's path can change outside of update().
+	*/
+	void evaluateExpressionTFVs(float deltaTime);
+	/*
+	Rotates the sprite and hitbox of every entity in rotationBatch according to the direction it moved in.
+	*/
+	void rotateEntities();
 };
\ No newline at end of file
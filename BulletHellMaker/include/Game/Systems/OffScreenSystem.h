@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+#include <entt/entt.hpp>
+
+/*
+System for carrying out the off-screen policies of bullets that have left the play area.
+*/
+class OffScreenSystem {
+public:
+	OffScreenSystem(entt::DefaultRegistry& registry, float mapWidth, float mapHeight);
+
+	void update(float deltaTime);
+
+private:
+	entt::DefaultRegistry& registry;
+	float mapWidth;
+	float mapHeight;
+
+	// Reused every update so that the sweep doesn't allocate; all are indexed the same way
+	std::vector<uint32_t> entities;
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> margins;
+	std::vector<uint8_t> offScreen;
+
+	/*
+	Returns whether an entity can be despawned early without affecting anything else,
+	which is when it has nothing left to spawn and none of its recursive DespawnComponent children
+	are anything but movement reference entities.
+	*/
+	bool canDespawnEarly(uint32_t entity) const;
+	bool onlyHasReferenceChildren(uint32_t entity) const;
+};
@@ -81,4 +81,21 @@ protected:
 	float backgroundTextureSizeX, backgroundTextureSizeY;
 
 	std::shared_ptr<entt::SigH<void()>> onResolutionChange;
+
+	// Quads of consecutive sprites that use the same texture, drawn together in one draw call
+	sf::VertexArray batchVertices;
+	const sf::Texture* batchTexture = nullptr;
+	// Stats of the current frame
+	int drawCalls = 0;
+	int textureSwitches = 0;
+
+	/*
+	Adds a sprite to the batch, drawing the batch first if the sprite uses a different texture.
+	The sprite's vertices are made directly from its SpriteTemplate and SpriteInstance.
+	*/
+	void batchSprite(const SpriteComponent& sprite, sf::RenderTarget& target);
+	/*
+	Draws and empties the batch.
+	*/
+	void flushBatch(sf::RenderTarget& target, const sf::Shader* shader = nullptr);
 };
\ No newline at end of file
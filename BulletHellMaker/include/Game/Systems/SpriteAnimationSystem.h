@@ -1,4 +1,6 @@
 #pragma once
+#include <vector>
+
 #include <entt/entt.hpp>
 
 #include <DataStructs/SpriteLoader.h>
@@ -7,6 +9,7 @@
 System for updating sprite animations.
 Cannot be combined with RenderSystem because sprites should not undergo their animations
 if the game is paused.
+Only entities with an AnimatedSpriteComponent have their sprites updated.
 */
 class SpriteAnimationSystem {
 public:
@@ -16,4 +19,7 @@ public:
 private:
 	entt::DefaultRegistry& registry;
 	SpriteLoader& spriteLoader;
+
+	// Entities whose sprites stopped being animated during the current update
+	std::vector<uint32_t> stoppedEntities;
 };
\ No newline at end of file
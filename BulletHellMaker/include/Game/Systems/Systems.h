@@ -6,6 +6,7 @@
 #include <Game/Systems/DespawnSystem.h>
 #include <Game/Systems/EnemySystem.h>
 #include <Game/Systems/MovementSystem.h>
+#include <Game/Systems/OffScreenSystem.h>
 #include <Game/Systems/PlayerSystem.h>
 #include <Game/Systems/ShadowTrailSystem.h>
 #include <Game/Systems/SpriteAnimationSystem.h>
\ No newline at end of file
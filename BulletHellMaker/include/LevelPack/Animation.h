@@ -1,33 +1,58 @@
 #pragma once
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
 
+#include <DataStructs/SpriteTemplate.h>
+
+/*
+The sprites of an animation and how long each one is shown for.
+Created once per animation by its SpriteSheet and shared by everything playing that animation, so
+playing an animation doesn't copy its sprites. AnimationClips are never modified after they are created.
+*/
+class AnimationClip {
+public:
+	AnimationClip(std::string name, std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>> sprites);
+
+	inline const std::string& getName() const { return name; }
+	inline const std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>>& getSprites() const { return sprites; }
+	// Total duration of the animation, not including loops
+	inline float getTotalDuration() const { return totalDuration; }
+
+private:
+	// The name of the animation
+	std::string name;
+	// Sprites and for what amount of seconds that sprite will be used
+	std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>> sprites;
+	float totalDuration = 0;
+};
+
+/*
+A playback position in an AnimationClip.
+A default-constructed Animation has no clip and is always done.
+*/
 class Animation {
 public:
-	Animation(std::string name, std::vector<std::pair<float, std::shared_ptr<sf::Sprite>>> sprites, bool loops);
+	Animation();
+	Animation(std::shared_ptr<const AnimationClip> clip, bool loops);
 
 	/*
-	Returns a pointer to the current sprite.
+	Returns the current sprite.
 	If the animation is finished, nullptr is returned.
 	*/
-	std::shared_ptr<sf::Sprite> update(float deltaTime);
+	const std::shared_ptr<const SpriteTemplate>& update(float deltaTime);
 
-	inline bool isDone() { return done; }
-	inline float getTotalDuration() { return totalDuration; }
+	inline bool hasClip() const { return clip != nullptr; }
+	inline bool isDone() const { return done; }
+	inline float getTotalDuration() const { return clip ? clip->getTotalDuration() : 0; }
 
-protected:
-	// The name of the animation
-	std::string name;
-	// Sprite names and for what amount of seconds that sprite will be used
-	std::vector<std::pair<float, std::shared_ptr<sf::Sprite>>> sprites;
+private:
+	std::shared_ptr<const AnimationClip> clip;
 	int currentSpriteIndex = 0;
 
-	// Total duration of the animation, not including loops
-	float totalDuration = 0;
-
 	// True if the animation loops
 	bool looping = true;
 
@@ -36,4 +61,4 @@ protected:
 
 	// Time since the last sprite change
 	float time = 0;
-};
\ No newline at end of file
+};
@@ -37,7 +37,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	void loadEMPBulletModels(const LevelPack& levelPack);
 
@@ -0,0 +1,98 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <Util/json.hpp>
+#include <DataStructs/MappedFile.h>
+
+/*
+A whole LevelPack cooked into a single binary file so that the game can start without parsing
+thousands of JSON files. The JSON files in the level pack's folders are still the source that gets edited;
+a cooked file is only ever created from them by LevelPack::cook().
+
+File layout:
+	Header
+	Entry[entryCount], sorted by type and then ID
+	The JSON of every object encoded as MessagePack, at the offsets given by the entries
+
+A cooked file is mapped into memory when it is opened, and an object's JSON is only checked and decoded
+when it is read, so opening it only has to read the header and the entries.
+*/
+class CookedLevelPack {
+public:
+	enum class OBJECT_TYPE : std::uint32_t {
+		// The parts of the level pack that aren't level pack objects. Always has ID 0.
+		PACK_INFO,
+		// Always has ID 0
+		PLAYER,
+		// The metadata of every sprite sheet, keyed by sprite sheet name. Always has ID 0.
+		SPRITE_SHEETS,
+		LEVEL,
+		ATTACK,
+		ATTACK_PATTERN,
+		ENEMY,
+		ENEMY_PHASE,
+		BULLET_MODEL
+	};
+	struct Object {
+		OBJECT_TYPE type;
+		int id;
+		nlohmann::json json;
+	};
+
+	// Cooked files with a different version can't be opened and must be cooked again
+	const static std::uint32_t FORMAT_VERSION;
+
+	/*
+	Writes objects into a new cooked file, overwriting it if it exists.
+	Returns false if the file can't be written.
+	*/
+	static bool write(const std::string& fileName, const std::vector<Object>& objects);
+
+	/*
+	Maps a cooked file into memory and checks that it is complete, that its entries aren't corrupted and that it was cooked with this version.
+	Returns false and logs the reason if it can't be used.
+	*/
+	bool open(const std::string& fileName);
+
+	bool contains(OBJECT_TYPE type, int id) const;
+	// Returns the IDs of every object of some type, in ascending order
+	std::vector<int> getIDs(OBJECT_TYPE type) const;
+	/*
+	Decodes the JSON of an object.
+	Throws std::out_of_range if there is no such object or if the cooked file is corrupted.
+	*/
+	nlohmann::json read(OBJECT_TYPE type, int id) const;
+
+	inline std::size_t getObjectCount() const { return entryCount; }
+
+private:
+	struct Header {
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t entryCount;
+		std::uint32_t reserved;
+		std::uint64_t fileSize;
+		// FNV-1a hash of the entries
+		std::uint64_t checksum;
+	};
+	struct Entry {
+		std::uint32_t type;
+		std::int32_t id;
+		// Relative to the start of the file
+		std::uint64_t offset;
+		std::uint64_t size;
+		// FNV-1a hash of the object's MessagePack
+		std::uint64_t checksum;
+	};
+
+	MappedFile file;
+	// Points into the mapped file
+	const Entry* entries = nullptr;
+	std::size_t entryCount = 0;
+
+	const Entry* findEntry(OBJECT_TYPE type, int id) const;
+
+	static std::uint64_t computeChecksum(const unsigned char* data, std::size_t size, std::uint64_t hash = 14695981039346656037ull);
+};
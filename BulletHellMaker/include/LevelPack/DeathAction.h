@@ -32,7 +32,7 @@ public:
 	virtual void load(const nlohmann::json& j) = 0;
 
 	virtual std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const = 0;
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 	/*
 	entity - the entity executing this DeathAction
@@ -56,7 +56,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables);
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables);
 
 	void execute(LevelPack& levelPack, EntityCreationQueue& queue, entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, uint32_t entity) override;
 };
@@ -92,7 +92,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables);
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables);
 
 	void execute(LevelPack& levelPack, EntityCreationQueue& queue, entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, uint32_t entity) override;
 
@@ -135,7 +135,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables);
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables);
 
 	void execute(LevelPack& levelPack, EntityCreationQueue& queue, entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, uint32_t entity) override;
 
@@ -165,7 +165,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables);
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables);
 
 	void execute(LevelPack& levelPack, EntityCreationQueue& queue, entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, uint32_t entity) override;
 
@@ -213,7 +213,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables);
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables);
 
 	void execute(LevelPack& levelPack, EntityCreationQueue& queue, entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, uint32_t entity) override;
 
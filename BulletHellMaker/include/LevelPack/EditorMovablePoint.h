@@ -16,6 +16,7 @@
 #include <Game/EntityCreationQueue.h>
 #include <Game/Systems/CollisionSystem.h>
 #include <Game/AudioPlayer.h>
+#include <LevelPack/OffScreenPolicy.h>
 #include <Util/json.hpp>
 
 class EMPSpawnType;
@@ -43,7 +44,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	inline Animatable getAnimatable() const { return animatable; }
 	inline float getHitboxRadius() const { return hitboxRadius; }
@@ -154,7 +155,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	/*
 	Loads this EMP and its children's bullet models into the EMP, it they use models.
@@ -208,6 +209,15 @@ public:
 	inline float getPierceResetTime() const { return pierceResetTimeExprCompiledValue; }
 	inline std::string getRawPierceResetTime() const { return pierceResetTime; }
 	inline bool getIsBullet() const { return isBullet; }
+	inline bool getContinuousCollision() const { return continuousCollision; }
+	inline float getCapsuleEndX() const { return capsuleEndX; }
+	inline float getCapsuleEndY() const { return capsuleEndY; }
+	/*
+	Returns whether this bullet's hitbox is a capsule instead of a circle.
+	*/
+	inline bool isCapsule() const { return capsuleEndX != 0 || capsuleEndY != 0; }
+	inline bool getOverridesOffScreenPolicy() const { return overridesOffScreenPolicy; }
+	inline OffScreenPolicy getOffScreenPolicy() const { return offScreenPolicy; }
 	inline bool usesBulletModel() const { return bulletModelID >= 0; }
 	/*
 	Returns the ID of every recursive child in this EMP. Does not include this EMP's ID.
@@ -240,6 +250,13 @@ public:
 	void setInheritPierceResetTime(bool inheritPierceResetTime, const LevelPack& levelPack);
 	void setInheritSoundSettings(bool inheritSoundSettings, const LevelPack& levelPack);
 	inline void setIsBullet(bool isBullet) { this->isBullet = isBullet; }
+	inline void setContinuousCollision(bool continuousCollision) { this->continuousCollision = continuousCollision; }
+	/*
+	Set both to 0 for a circular hitbox.
+	*/
+	inline void setCapsuleEnd(float capsuleEndX, float capsuleEndY) { this->capsuleEndX = capsuleEndX; this->capsuleEndY = capsuleEndY; }
+	inline void setOverridesOffScreenPolicy(bool overridesOffScreenPolicy) { this->overridesOffScreenPolicy = overridesOffScreenPolicy; }
+	inline void setOffScreenPolicy(OffScreenPolicy offScreenPolicy) { this->offScreenPolicy = offScreenPolicy; }
 	inline void setSoundSettings(SoundSettings soundSettings) { this->soundSettings = soundSettings; }
 	inline void setActions(std::vector<std::shared_ptr<EMPAction>> actions) { this->actions = actions; }
 	/*
@@ -258,6 +275,19 @@ public:
 	*/
 	void removeChild(int id);
 	/*
+	Returns the children that make up a chain-laser, ordered from one end of the chain to the other, or an empty vector if there is none.
+	A chain-laser is every direct child that is a circular bullet attached to this EMP, never rotates (ROTATION_TYPE::LOCK_ROTATION),
+	has no children of its own and is the same as the first such child except for its spawn position. There must be at least 2 of them
+	and their spawn positions must be plain numbers that lie on a straight line.
+	*/
+	std::vector<std::shared_ptr<EditorMovablePoint>> getChildrenChain() const;
+	/*
+	Replaces the chain-laser from getChildrenChain() with a single bullet: the first EMP in the chain becomes a capsule that reaches
+	the last one, and every other EMP in the chain is removed from this EMP's children.
+	Returns the chain as it was before the conversion, or an empty vector if there is no chain, in which case nothing is changed.
+	*/
+	std::vector<std::shared_ptr<EditorMovablePoint>> convertChildrenChainToCapsule();
+	/*
 	Detaches this EMP from its parent, if it has one.
 	*/
 	void detachFromParent();
@@ -270,6 +300,11 @@ public:
 	*/
 	void addChild(std::shared_ptr<EditorMovablePoint> child);
 	/*
+	Adds an existing EMP to the list of children at some index instead of ordering it by spawn time.
+	Used to put a removed child back exactly where it was.
+	*/
+	void insertChild(int index, std::shared_ptr<EditorMovablePoint> child);
+	/*
 	Should be called whenever this EMP is changed to be part of a different EditorAttack.
 
 	newAttack - the new EditorAttack that this EMP is a child of
@@ -334,9 +369,23 @@ private:
 	// Time after hitting an enemy that the entity is able to be hit by this same bullet again; only for PIERCE_ENTITY onCollisionAction
 	DEFINE_EXPRESSION_VARIABLE_WITH_INITIAL_VALUE(pierceResetTime, float, 2)
 	
+	// Only for bullets; if true, collisions are checked along the whole path the bullet moved in each physics update
+	// instead of only where it ended up. Bullets that move more than their radius in one update do this anyway.
+	bool continuousCollision = false;
+
+	// Only for bullets; if not (0, 0), the bullet's hitbox is a capsule around the segment from the bullet's position
+	// to this offset from it, rotated with the bullet, and its sprite is stretched along the segment
+	float capsuleEndX = 0;
+	float capsuleEndY = 0;
+
 	// Sound played on this EMP spawn
 	SoundSettings soundSettings;
 
+	// If false, the Level's off-screen policy is used instead of offScreenPolicy
+	bool overridesOffScreenPolicy = false;
+	// Only for bullets; determines what happens when the bullet leaves the play area
+	OffScreenPolicy offScreenPolicy;
+
 	// ID of the bullet model to use; when a bullet model changes, all EMPs using that model also change
 	// Set to < 0 to not use a bullet model
 	int bulletModelID = -1;
@@ -369,6 +418,16 @@ private:
 	*/
 	void copyConstructorLoad(std::string formattedString);
 	/*
+	Helper function for load() and copyConstructorLoad(). Loads overridesOffScreenPolicy and offScreenPolicy
+	from the formatted items starting at index i, or resets them if the items are from before they existed.
+	*/
+	void loadOffScreenPolicy(const std::vector<std::string>& items, int i);
+	/*
+	Helper function for getChildrenChain(). Returns whether this EMP would behave the same as another one
+	if they were spawned at the same position, ignoring their children.
+	*/
+	bool isSameChainLink(const EditorMovablePoint& other) const;
+	/*
 	Helper function for getChildrenIDs(). Populates arr with this EMP's ID and all its
 	recursive children's IDs.
 	*/
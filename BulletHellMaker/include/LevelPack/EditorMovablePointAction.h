@@ -36,7 +36,7 @@ public:
 	virtual void load(const nlohmann::json& j) = 0;
 
 	virtual std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const = 0;
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 	virtual float evaluate(const entt::DefaultRegistry& registry, float xFrom, float yFrom) = 0;
 	// Same as the other evaluate, but for when only the player's position is known
@@ -63,7 +63,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	// Returns the angle in radians from coordinates (xFrom, yFrom) to the player plus the player offset (player.x + xOffset, player.y + yOffset)
 	float evaluate(const entt::DefaultRegistry& registry, float xFrom, float yFrom) override;
@@ -100,7 +100,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	// Returns the angle in radians from coordinates (xFrom, yFrom) to the global position (x, y)
 	float evaluate(const entt::DefaultRegistry& registry, float xFrom, float yFrom) override;
@@ -136,7 +136,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	// Returns 0
 	inline float evaluate(const entt::DefaultRegistry& registry, float xFrom, float yFrom) override { return 0; }
@@ -164,7 +164,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	inline std::string getRawValue() const { return value; }
 	inline void setValue(std::string value) { this->value = value; }
@@ -196,7 +196,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	float evaluate(const entt::DefaultRegistry& registry, float xFrom, float yFrom) override;
 	float evaluate(float xFrom, float yFrom, float playerX, float playerY) override;
@@ -226,7 +226,7 @@ public:
 	virtual void load(const nlohmann::json& j) = 0;
 
 	virtual std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const = 0;
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 	// Time for the action to be completed
 	virtual float getTime() = 0;
@@ -248,6 +248,11 @@ public:
 	x, y - the current position of whatever is going to use this MP
 	*/
 	virtual std::shared_ptr<MovablePoint> generateStandaloneMP(float x, float y, float playerX, float playerY) = 0;
+	/*
+	Bakes the path of this EMPA into BakedTrajectory's cache if it is a path that can be baked, so that execute()
+	can use the baked path. Called on every EMPA of a level when it is loaded, if the level has baking enabled.
+	*/
+	virtual void bakeTrajectory() {}
 
 	virtual bool operator==(const EMPAction& other) const = 0;
 };
@@ -271,7 +276,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	inline float getTime() override { return 0; }
 	std::string getGuiFormat() override;
@@ -301,7 +306,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	inline float getTime() override { return duration; }
 	std::string getGuiFormat() override;
@@ -310,6 +315,7 @@ public:
 
 	std::shared_ptr<MovablePoint> execute(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, float timeLag) override;
 	std::shared_ptr<MovablePoint> generateStandaloneMP(float x, float y, float playerX, float playerY) override;
+	void bakeTrajectory() override;
 
 	bool operator==(const EMPAction& other) const override;
 
@@ -335,7 +341,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	std::string getGuiFormat() override;
 	inline std::shared_ptr<TFV> getDistance() { return distance; }
@@ -350,6 +356,11 @@ public:
 
 	std::shared_ptr<MovablePoint> execute(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, float timeLag) override;
 	std::shared_ptr<MovablePoint> generateStandaloneMP(float x, float y, float playerX, float playerY) override;
+	/*
+	Only paths whose distance and angle are constant or piecewise constant are baked. Those only jump between fixed
+	positions, so they are baked exactly.
+	*/
+	void bakeTrajectory() override;
 
 	bool operator==(const EMPAction& other) const override;
 
@@ -360,6 +371,12 @@ private:
 	float time = 0;
 	// Evaluates to the angle in radians that will be added to the angle TFV evaluation
 	std::shared_ptr<EMPAAngleOffset> angleOffset;
+
+	/*
+	Returns false if the path can't be baked. Otherwise, sets key to the path's BakedTrajectory key and stepTimes to
+	the times at which the path jumps.
+	*/
+	bool getTrajectoryKey(BakedTrajectory::Key& key, std::vector<float>& stepTimes);
 };
 
 /*
@@ -382,21 +399,38 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	inline float getTime() override { return time; }
 	std::string getGuiFormat() override;
 	inline std::shared_ptr<EMPAAngleOffset> getRotationAngle() { return rotationAngle; }
 	const std::vector<sf::Vector2f> getUnrotatedControlPoints() { return unrotatedControlPoints; }
+	inline bool getConstantSpeed() const { return constantSpeed; }
 
-	inline void setTime(float duration) override { this->time = duration; }
+	inline void setTime(float duration) override { 
+		this->time = duration;
+		bakedTrajectory = nullptr;
+		bakeAttempted = false;
+	}
 	inline void setUnrotatedControlPoints(std::vector<sf::Vector2f> unrotatedControlPoints) { 
 		this->unrotatedControlPoints = unrotatedControlPoints;
+		arcLengthTable = nullptr;
+		bakedTrajectory = nullptr;
+		bakeAttempted = false;
+	}
+	inline void setConstantSpeed(bool constantSpeed) { 
+		this->constantSpeed = constantSpeed;
+		bakedTrajectory = nullptr;
+		bakeAttempted = false;
 	}
 	inline void setRotationAngle(std::shared_ptr<EMPAAngleOffset> rotationAngle) { this->rotationAngle = rotationAngle; }
 
 	std::shared_ptr<MovablePoint> execute(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, float timeLag) override;
 	std::shared_ptr<MovablePoint> generateStandaloneMP(float x, float y, float playerX, float playerY) override;
+	/*
+	Only constant-speed curves are baked, since they are already approximated with an arc-length table.
+	*/
+	void bakeTrajectory() override;
 
 	bool operator==(const EMPAction& other) const override;
 
@@ -407,6 +441,23 @@ private:
 	std::shared_ptr<EMPAAngleOffset> rotationAngle;
 	// Only used if rotationAngle is not nullptr
 	std::vector<sf::Vector2f> unrotatedControlPoints;
+	// Whether the curve is traversed at a constant speed
+	bool constantSpeed = false;
+
+	// Arc-length table of unrotatedControlPoints; computed on the first execution with constantSpeed and
+	// shared by every BezierMP created afterwards, since rotating the control points doesn't change it
+	std::shared_ptr<const std::vector<float>> arcLengthTable;
+	// The path of unrotatedControlPoints; looked up on the first execution if constantSpeed is true
+	std::shared_ptr<const BakedTrajectory> bakedTrajectory;
+	// Whether getBakedTrajectory() has looked up the baked path since the path last changed
+	bool bakeAttempted = false;
+
+	std::shared_ptr<MovablePoint> createBezierMP(float rotationRadians);
+	BakedTrajectory::Key getTrajectoryKey() const;
+	/*
+	Returns nullptr if the path wasn't baked.
+	*/
+	std::shared_ptr<const BakedTrajectory> getBakedTrajectory();
 };
 
 /*
@@ -430,7 +481,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	std::string getGuiFormat() override;
 
@@ -476,7 +527,7 @@ public:
 	void load(const nlohmann::json& j) override;
 	
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	std::string getGuiFormat() override;
 
@@ -3,6 +3,7 @@
 #include <vector>
 #include <utility>
 #include <memory>
+#include <limits>
 
 #include <entt/entt.hpp>
 
@@ -23,9 +24,15 @@ public:
 	virtual void load(const nlohmann::json& j) = 0;
 
 	virtual std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const = 0;
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 	virtual bool satisfied(entt::DefaultRegistry& registry, uint32_t entity) = 0;
+	/*
+	Returns the earliest time since the start of the enemy's current phase at which this condition can become satisfied
+	solely through the passage of time, or infinity if it can only become satisfied through a change in
+	the enemy's health or the number of enemies alive.
+	*/
+	virtual float getEarliestSatisfiedTime() = 0;
 };
 
 /*
@@ -45,9 +52,10 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	bool satisfied(entt::DefaultRegistry& registry, uint32_t entity) override;
+	float getEarliestSatisfiedTime() override;
 
 	float getTime();
 
@@ -75,9 +83,10 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	bool satisfied(entt::DefaultRegistry& registry, uint32_t entity) override;
+	float getEarliestSatisfiedTime() override;
 
 	float getRatio();
 
@@ -106,9 +115,10 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	bool satisfied(entt::DefaultRegistry& registry, uint32_t entity) override;
+	float getEarliestSatisfiedTime() override;
 
 	int getEnemyCount();
 	void setEnemyCount(std::string enemyCount);
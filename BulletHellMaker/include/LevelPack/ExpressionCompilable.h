@@ -20,7 +20,7 @@ public:
 		The symbol_tables should be ordered in descending priority such that in the case of the same symbol being defined multiple times, 
 		the definition in the farthest-back symbol_table will be used.
 	*/
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 	ValueSymbolTable getSymbolTable() {
 		return symbolTable;
@@ -30,6 +30,23 @@ public:
 	}
 
 protected:
+	/*
+	Returns higherLevelSymbolTables followed by this object's own symbol table. If this object has no symbols,
+	higherLevelSymbolTables is returned as is so that nothing has to be copied.
+
+	storage - the list that is returned if this object does have symbols
+	*/
+	const std::vector<exprtk::symbol_table<float>>& withOwnSymbolTable(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables,
+		std::vector<exprtk::symbol_table<float>>& storage) const {
+		if (symbolTable.isEmpty()) {
+			return higherLevelSymbolTables;
+		}
+		storage.reserve(higherLevelSymbolTables.size() + 1);
+		storage.insert(storage.end(), higherLevelSymbolTables.begin(), higherLevelSymbolTables.end());
+		storage.push_back(symbolTable.toExprtkSymbolTable());
+		return storage;
+	}
+
 	// The ValueSymbolTable that defines or redelegates all 
 	// symbols that are used in this object and its unique objects
 	ValueSymbolTable symbolTable;
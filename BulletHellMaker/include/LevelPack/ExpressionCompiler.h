@@ -0,0 +1,93 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <exprtk.hpp>
+
+/*
+Evaluates expression strings against a fixed list of symbol_tables. This is what
+ExpressionCompilable::compileExpressions uses to turn expression strings into values.
+
+Since every symbol used in compileExpressions is a constant, an expression's value depends only on
+its string and the names and values of the symbols it can see. So evaluate() tries, in order:
+1. Numeric literals and expressions made only of literals, + - * / and parentheses are evaluated
+	directly without exprtk.
+2. A cache shared by all ExpressionCompilers, keyed by the expression string and a signature of
+	every symbol's name and value.
+3. Compiling the expression with exprtk, using a parser that is reused by every ExpressionCompiler
+	on the same thread.
+*/
+class ExpressionCompiler {
+public:
+	/*
+	Totals of the work done by every ExpressionCompiler since the program started.
+	*/
+	struct Stats {
+		// Number of expressions that were compiled by exprtk
+		unsigned long long compiles = 0;
+		// Number of expressions that were evaluated without exprtk because they were constant-foldable
+		unsigned long long fastPathHits = 0;
+		// Number of expressions whose value came from the cache
+		unsigned long long cacheHits = 0;
+		// Total time spent compiling and evaluating expressions with exprtk
+		double compileSeconds = 0;
+
+		Stats operator-(const Stats& other) const;
+	};
+
+	/*
+	symbolTables - a list of symbol_tables; its content combined defines all symbols that will be needed to evaluate expressions.
+		The symbol_tables should be ordered in descending priority such that in the case of the same symbol being defined multiple times,
+		the definition in the farthest-back symbol_table will be used.
+	*/
+	ExpressionCompiler(const std::vector<exprtk::symbol_table<float>>& symbolTables);
+
+	/*
+	Returns the value of some expression.
+	*/
+	float evaluate(const std::string& expressionStr);
+
+	static Stats getStats();
+	/*
+	Removes every cached expression value.
+	*/
+	static void clearCache();
+	/*
+	Returns the exprtk parser for the calling thread.
+	*/
+	static exprtk::parser<float>& getParser();
+
+private:
+	// Max number of cached expression values before the cache is cleared
+	const static size_t MAX_CACHED_EXPRESSIONS = 8192;
+
+	std::vector<exprtk::symbol_table<float>> symbolTables;
+
+	// Only set up when an expression actually has to be compiled
+	bool expressionInitialized = false;
+	exprtk::expression<float> expression;
+
+	// Signature of every symbol's name and value; only computed when the cache is first used
+	bool signatureComputed = false;
+	std::string signature;
+
+	static std::mutex cacheMutex;
+	static std::unordered_map<std::string, float> cache;
+
+	static std::atomic<unsigned long long> compiles;
+	static std::atomic<unsigned long long> fastPathHits;
+	static std::atomic<unsigned long long> cacheHits;
+	static std::atomic<long long> compileNanoseconds;
+
+	/*
+	Attempts to evaluate an expression made only of numeric literals, + - * / and parentheses.
+	Returns false if the expression uses anything else, in which case result is not modified.
+	*/
+	static bool tryEvaluateConstant(const std::string& expressionStr, float& result);
+
+	const std::string& getSignature();
+	float compile(const std::string& expressionStr, bool& success);
+};
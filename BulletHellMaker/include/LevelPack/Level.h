@@ -17,6 +17,7 @@
 #include <LevelPack/LevelEvent.h>
 #include <Game/Systems/RenderSystem/RenderSystem.h>
 #include <Game/AudioPlayer.h>
+#include <LevelPack/OffScreenPolicy.h>
 #include <LevelPack/ExpressionCompilable.h>
 
 /*
@@ -37,7 +38,7 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	/*
 	Execute the LevelEvent at index eventIndex.
@@ -61,6 +62,10 @@ public:
 	inline sf::Color getBossHPBarColor() const { return bossHPBarColor; }
 	inline float getBackgroundTextureWidth() const { return backgroundTextureWidth; }
 	inline float getBackgroundTextureHeight() const { return backgroundTextureHeight; }
+	inline OffScreenPolicy getOffScreenPolicy() const { return offScreenPolicy; }
+	inline bool getBakeTrajectories() const { return bakeTrajectories; }
+	// Maps every EditorEnemy ID used by this level's events to the number of times it will be spawned
+	inline const std::map<int, int>& getEnemyIDCount() const { return enemyIDCount; }
 	inline bool usesEnemy(int enemyID) const { return enemyIDCount.find(enemyID) != enemyIDCount.end() && enemyIDCount.at(enemyID) > 0; }
 
 	inline void setMusicSettings(MusicSettings musicSettings) { this->musicSettings = musicSettings; }
@@ -70,6 +75,8 @@ public:
 	inline void setBackgroundScrollSpeedY(float backgroundScrollSpeedY) { this->backgroundScrollSpeedY = backgroundScrollSpeedY; }
 	inline void setBossNameColor(sf::Color bossNameColor) { this->bossNameColor = bossNameColor; }
 	inline void setBossHPBarColor(sf::Color bossHPBarColor) { this->bossHPBarColor = bossHPBarColor; }
+	inline void setOffScreenPolicy(OffScreenPolicy offScreenPolicy) { this->offScreenPolicy = offScreenPolicy; }
+	inline void setBakeTrajectories(bool bakeTrajectories) { this->bakeTrajectories = bakeTrajectories; }
 	inline float setBackgroundTextureWidth(float backgroundTextureWidth) { this->backgroundTextureWidth = backgroundTextureWidth; }
 	inline float setBackgroundTextureHeight(float backgroundTextureHeight) { this->backgroundTextureHeight = backgroundTextureHeight; }
 
@@ -89,6 +96,11 @@ public:
 	Returns whether the start condition for the LevelEvent at index conditionIndex has been satisfied.
 	*/
 	inline bool conditionSatisfied(int conditionIndex, entt::DefaultRegistry& registry) const { return events[conditionIndex].first->satisfied(registry); }
+	/*
+	Returns the earliest time since the start of the level at which the start condition for the LevelEvent at index conditionIndex
+	can become satisfied, assuming no enemies spawn or despawn before then.
+	*/
+	inline float getEarliestConditionSatisfiedTime(int conditionIndex, entt::DefaultRegistry& registry) const { return events[conditionIndex].first->getEarliestSatisfiedTime(registry); }
 
 private:
 	// Name of the level
@@ -118,6 +130,12 @@ private:
 	sf::Color bossNameColor = sf::Color::White;
 	sf::Color bossHPBarColor = sf::Color::Red;
 
+	// What happens to bullets that leave the play area, unless overridden by the bullet's EditorMovablePoint
+	OffScreenPolicy offScreenPolicy;
+	// Whether the paths of this level's bullets are baked into BakedTrajectory's cache when the level is loaded.
+	// Baked paths are cheaper to evaluate but constant-speed bezier paths are only accurate to BakedTrajectory::MAX_ALLOWED_ERROR.
+	bool bakeTrajectories = false;
+
 	// Maps an EditorEnemy ID to the number of times it will be spawned in events.
 	// This is not saved on format() but is reconstructed in load().
 	std::map<int, int> enemyIDCount;
@@ -2,6 +2,7 @@
 #include <vector>
 #include <utility>
 #include <string>
+#include <limits>
 
 #include <entt/entt.hpp>
 
@@ -20,9 +21,14 @@ public:
 	virtual void load(const nlohmann::json& j) = 0;
 
 	virtual std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const = 0;
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 	virtual bool satisfied(entt::DefaultRegistry& registry) = 0;
+	/*
+	Returns the earliest time since the start of the level at which this condition can become satisfied
+	if no enemies spawn or despawn before then, or infinity if it can only become satisfied through an enemy spawning or despawning.
+	*/
+	virtual float getEarliestSatisfiedTime(entt::DefaultRegistry& registry) = 0;
 };
 
 /*
@@ -42,9 +48,10 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	bool satisfied(entt::DefaultRegistry& registry) override;
+	float getEarliestSatisfiedTime(entt::DefaultRegistry& registry) override;
 
 private:
 	// Minimum time since the start of the level for this condition to be satisfied
@@ -68,9 +75,10 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	bool satisfied(entt::DefaultRegistry& registry) override;
+	float getEarliestSatisfiedTime(entt::DefaultRegistry& registry) override;
 
 private:
 	// Minimum time since the last enemy's spawn for this condition to be satisfied
@@ -94,9 +102,10 @@ public:
 	void load(const nlohmann::json& j) override;
 
 	std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const override;
-	void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) override;
+	void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) override;
 
 	bool satisfied(entt::DefaultRegistry& registry) override;
+	float getEarliestSatisfiedTime(entt::DefaultRegistry& registry) override;
 
 private:
 	// Maximum number of other enemies alive for this condition to be satisfied
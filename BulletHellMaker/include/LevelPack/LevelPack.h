@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <queue>
+#include <set>
+#include <functional>
 #include <algorithm>
 
 #include <SFML/Audio.hpp>
@@ -13,6 +15,7 @@
 #include <DataStructs/SpriteLoader.h>
 #include <DataStructs/IDGenerator.h>
 #include <LevelPack/TextMarshallable.h>
+#include <LevelPack/CookedLevelPack.h>
 #include <Game/AudioPlayer.h>
 
 class LayerRootLevelPackObject;
@@ -25,6 +28,7 @@ class EditorEnemy;
 class EditorEnemyPhase;
 class EditorPlayer;
 class BulletModel;
+class Animatable;
 
 class LevelPack {
 public:
@@ -67,21 +71,48 @@ public:
 		std::string formatForUser();
 		bool containsFailedLoads();
 	};
+	struct SaveMetrics {
+		int filesWritten = 0;
+		int filesFailed = 0;
+		int filesDeleted = 0;
+		double seconds = 0;
+	};
 
 	/*
 	spriteLoader - if not nullptr, this sprite loader will be used in the newly loaded level pack
-		so that textures don't have to be loaded twice
+		so that textures don't have to be loaded twice. If nullptr, the level pack creates its own and starts
+		loading its sprite sheets asynchronously; see getSpriteSheetsLoad().
+	preferCookedFile - whether to load the level pack from its cooked file if it has a usable one,
+		instead of from its folder
 	*/
-	LevelPack(AudioPlayer& audioPlayer, std::string name, std::shared_ptr<SpriteLoader> spriteLoader = nullptr);
+	LevelPack(AudioPlayer& audioPlayer, std::string name, std::shared_ptr<SpriteLoader> spriteLoader = nullptr, bool preferCookedFile = false);
 
 	/*
 	Load the LevelPack from its folder.
 	*/
 	LoadMetrics load();
 	/*
+	Load the LevelPack from its cooked file. Objects are only decoded from the cooked file
+	the first time they are needed.
+	Returns false if there is no usable cooked file, in which case this LevelPack is left unchanged.
+
+	loadSpriteSheets - whether to start loading the cooked sprite sheets into this LevelPack's SpriteLoader asynchronously;
+		see getSpriteSheetsLoad()
+	*/
+	bool loadCooked(bool loadSpriteSheets = true);
+	/*
 	Save the LevelPack into its folder.
+	Only the files of objects that were changed or deleted since the last save or load are written or deleted,
+	unless the LevelPack wasn't loaded from its folder, in which case every file is written.
+	Files are written atomically, so a failed save never leaves a partially written file.
+	This deletes the LevelPack's cooked file if anything was saved, since it would be out of date.
+	*/
+	SaveMetrics save();
+	/*
+	Cook the LevelPack into a single file that can be loaded with loadCooked().
+	Returns false if the file couldn't be written.
 	*/
-	void save();
+	bool cook();
 
 	/*
 	Insert a Level's ID into this LevelPack at the specified index.
@@ -229,6 +260,11 @@ public:
 	Returns the sprite loader that contains info for all animatables that are used in this level pack.
 	*/
 	std::shared_ptr<SpriteLoader> getSpriteLoader();
+	/*
+	Returns the asynchronous sprite sheets load started by the constructor or by loadCooked(), or an invalid future if neither started one.
+	It only becomes ready once SpriteLoader::uploadDecodedSpriteSheets() has uploaded every sprite sheet.
+	*/
+	inline std::shared_future<SpriteLoader::LoadMetrics> getSpriteSheetsLoad() const { return spriteSheetsLoad; }
 
 	/*
 	Returns a list of IDs of Levels that use the EditorEnemy
@@ -410,7 +446,24 @@ public:
 	// Returns the radius of the largest item hitbox radius in the level pack
 	float searchLargestItemCollectionHitbox() const;
 
-	void playSound(const SoundSettings& soundSettings) const;
+	// Returns the music of the first phase of every enemy spawned in the level at some index, for enemies whose first phase plays music
+	std::vector<MusicSettings> searchLevelFirstPhaseMusic(int levelIndex) const;
+	// Returns the file names of every sound that can be played in the level at some index, including the player's sounds
+	std::set<std::string> searchLevelSoundFileNames(int levelIndex) const;
+	// Returns every sprite and animation that can be shown in the level at some index, including the player's. May contain duplicates.
+	std::vector<Animatable> searchLevelAnimatables(int levelIndex) const;
+	// Returns every EMP that can be spawned in the level at some index, including by the player
+	std::vector<std::shared_ptr<EditorMovablePoint>> searchLevelEMPs(int levelIndex) const;
+
+	/*
+	See AudioPlayer::playSound() for more info.
+	*/
+	void playSound(const SoundSettings& soundSettings, int priority = 0) const;
+	/*
+	Decodes sounds from this level pack's sound folder ahead of time so that playing them doesn't cause a hitch.
+	See AudioPlayer::preloadSounds() for more info.
+	*/
+	void preloadSounds(const std::set<std::string>& soundFileNames) const;
 	/*
 	Returns the Music object that is played from this function call.
 
@@ -421,6 +474,14 @@ public:
 	See AudioPlayer::playMusic() for more info.
 	*/
 	void playMusic(std::shared_ptr<sf::Music> music, const MusicSettings& musicSettings) const;
+	/*
+	See AudioPlayer::prefetchMusic() for more info.
+	*/
+	void prefetchMusic(const MusicSettings& musicSettings) const;
+	/*
+	See AudioPlayer::clearPrefetchedMusic() for more info.
+	*/
+	void clearPrefetchedMusic() const;
 
 private:
 	const static std::string LEVELS_ORDER_FILE_NAME;
@@ -441,6 +502,8 @@ private:
 	std::string name;
 
 	std::shared_ptr<SpriteLoader> spriteLoader;
+	// The last asynchronous load of spriteLoader started by this LevelPack
+	std::shared_future<SpriteLoader::LoadMetrics> spriteSheetsLoad;
 	AudioPlayer& audioPlayer;
 
 	IDGenerator levelIDGen;
@@ -454,18 +517,37 @@ private:
 	// Ordered level IDs
 	std::vector<int> levels;
 	// The IDs of Level/EditorAttack/EditorAttackPattern/EditorEnemy/EditorEnemyPhase are always positive
+	// The maps are mutable so that objects can be decoded from cookedLevelPack when they are first fetched
 	// Maps level ID to the level
-	std::map<int, std::shared_ptr<Level>> levelsMap;
+	mutable std::map<int, std::shared_ptr<Level>> levelsMap;
 	// Maps attack ID to the attack
-	std::map<int, std::shared_ptr<EditorAttack>> attacks;
+	mutable std::map<int, std::shared_ptr<EditorAttack>> attacks;
 	// Maps attack pattern ID to the attack pattern
-	std::map<int, std::shared_ptr<EditorAttackPattern>> attackPatterns;
+	mutable std::map<int, std::shared_ptr<EditorAttackPattern>> attackPatterns;
 	// Maps enemy ID to the enemy
-	std::map<int, std::shared_ptr<EditorEnemy>> enemies;
+	mutable std::map<int, std::shared_ptr<EditorEnemy>> enemies;
 	// Maps enemy phase ID to the enemy phase
-	std::map<int, std::shared_ptr<EditorEnemyPhase>> enemyPhases;
+	mutable std::map<int, std::shared_ptr<EditorEnemyPhase>> enemyPhases;
 	// Maps bullet model ID to the bullet model
-	std::map<int, std::shared_ptr<BulletModel>> bulletModels;
+	mutable std::map<int, std::shared_ptr<BulletModel>> bulletModels;
+
+	// The cooked file this LevelPack was loaded from, if any. Objects missing from the maps are decoded from it.
+	std::shared_ptr<CookedLevelPack> cookedLevelPack;
+	// The types of objects that have all been decoded from cookedLevelPack, so the maps alone are complete for them
+	mutable std::set<CookedLevelPack::OBJECT_TYPE> fullyDecodedCookedTypes;
+	// The radius of the largest bullet, found when cookedLevelPack was cooked so that the attacks don't all have to be decoded
+	float cookedLargestBulletHitbox = 0;
+
+	// Whether the next save() has to write every file, because the folder may not match this LevelPack
+	bool everythingDirty = true;
+	// Objects that were created or changed since the last save or load
+	std::set<std::pair<LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE, int>> dirtyObjects;
+	// Objects that were deleted since the last save or load
+	std::set<std::pair<LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE, int>> deletedObjects;
+	// Names of the sprite sheets that were changed since the last save or load
+	std::set<std::string> dirtySpriteSheets;
+	// Whether the playable levels list was changed since the last save or load
+	bool levelsOrderDirty = false;
 
 	std::string fontFileName;
 
@@ -492,11 +574,90 @@ private:
 	std::set<int> getAllExistingLevelPackObjectFilesIDs(std::string folderPath, std::string levelPackObjectFilePrefix, std::string levelPackObjectFileExtension);
 	/*
 	Deletes all level pack object files in the folderPath folder that have an ID in ids.
-	Failed deletions are logged as warnings.
+	Failed deletions are logged as warnings. Returns the number of files that were deleted.
 
 	levelPackObjectFilePrefix - a file in folderPath must start with levelPackObjectFilePrefix to be counted as a level pack object file
 	levelPackObjectFileExtension - a file in folderPath must have this extension to be counted as a level pack object file (ie ".xml")
 	ids - the set of IDs of level pack objects to be deleted
 	*/
-	void deleteLevelPackObjectFiles(std::string folderPath, std::string levelPackObjectFilePrefix, std::string levelPackObjectFileExtension, std::set<int> ids);
-};
\ No newline at end of file
+	int deleteLevelPackObjectFiles(std::string folderPath, std::string levelPackObjectFilePrefix, std::string levelPackObjectFileExtension, std::set<int> ids);
+	/*
+	Loads every level pack object file of one type into objects, replacing its contents.
+	Files are read and parsed on multiple threads, and then the objects are added in ID order on this thread,
+	so the result is the same as loading the files one by one.
+
+	folderPath - the path of the folder relative to the game root, with %s in place of the level pack name
+	typeName - the plural name of the type of level pack object, for logging
+	failed, total - incremented by the amount of files that failed to load and the amount of files found
+	onLoad - called on this thread on every successfully parsed object, in ID order, before it is added;
+		if it throws, the object is considered to have failed to load
+	*/
+	template<class T>
+	void loadLevelPackObjectFiles(const std::string& folderPath, const std::string& levelPackObjectFilePrefix, const std::string& typeName,
+		std::map<int, std::shared_ptr<T>>& objects, IDGenerator& idGen, int& failed, int& total, std::function<void(std::shared_ptr<T>)> onLoad = nullptr);
+	/*
+	Writes the files of every dirty object of one type and deletes the files of every deleted object of that type.
+	If everythingDirty, every object's file is written instead and every other file in the folder is deleted.
+
+	folderPath - the path of the folder relative to the game root, with %s in place of the level pack name
+	*/
+	template<class T>
+	void saveLevelPackObjectFiles(const std::string& folderPath, const std::string& levelPackObjectFilePrefix, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE type,
+		const std::map<int, std::shared_ptr<T>>& objects, SaveMetrics& saveMetrics);
+	/*
+	Writes a JSON file atomically and counts it in saveMetrics.
+	*/
+	void saveJsonFile(const std::string& filePath, const nlohmann::json& j, SaveMetrics& saveMetrics);
+
+	/*
+	Marks an object as needing to be saved and emits onChange for it if emitOnChange is true.
+	*/
+	void onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE type, int id, bool emitOnChange = true);
+	/*
+	Marks an object as needing its file deleted and emits onChange for it.
+	*/
+	void onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE type, int id);
+	/*
+	Forgets about every change, such as after the LevelPack is saved or loaded from its folder.
+	*/
+	void clearDirtyState();
+
+	/*
+	Calls onEnemy on every enemy spawned in the level at some index, and onEMP on every EMP that can be spawned
+	in that level by them or by the player. Every attack and attack pattern is only visited once.
+	*/
+	void visitLevelObjects(int levelIndex, std::function<void(std::shared_ptr<EditorEnemy>)> onEnemy,
+		std::function<void(std::shared_ptr<EditorMovablePoint>)> onEMP) const;
+
+	/*
+	Returns the object with some ID, decoding it from cookedLevelPack if it hasn't been already.
+	Returns nullptr if there is no such object.
+	*/
+	template<class T>
+	std::shared_ptr<T> findObject(std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type, int id) const;
+	/*
+	Same as findObject(), but throws std::out_of_range if there is no such object.
+	*/
+	template<class T>
+	std::shared_ptr<T> getObject(std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type, int id) const;
+	/*
+	Returns whether there is an object with some ID, without decoding it.
+	*/
+	template<class T>
+	bool containsObject(const std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type, int id) const;
+	/*
+	Decodes every object of some type from cookedLevelPack that hasn't been decoded yet, so that objects can be iterated over.
+	*/
+	template<class T>
+	void decodeAllCookedObjects(std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type) const;
+	/*
+	Decodes every object from cookedLevelPack that hasn't been decoded yet.
+	*/
+	void decodeAllCookedObjects() const;
+	/*
+	Called on every object right after it is decoded from cookedLevelPack.
+	*/
+	template<class T>
+	void onCookedObjectDecoded(std::shared_ptr<T> object) const {}
+	void onCookedObjectDecoded(std::shared_ptr<EditorAttack> attack) const;
+};
@@ -10,12 +10,20 @@
 #include <LevelPack/TextMarshallable.h>
 #include <DataStructs/SymbolTable.h>
 #include <LevelPack/ExpressionCompilable.h>
+#include <LevelPack/ExpressionCompiler.h>
 #include <LevelPack/TextMarshallable.h>
 
-#define DEFINE_PARSER_AND_EXPR_FOR_COMPILE exprtk::parser<float> parser; \
-exprtk::expression<float> expr = exprtk::expression<float>(); \
-if (!this->symbolTable.isEmpty()) { symbolTables.push_back(symbolTable.toExprtkSymbolTable()); } \
-for (int i = symbolTables.size() - 1; i >= 0; i--) { expr.register_symbol_table(symbolTables[i]); } \
+/*
+Macro for defining symbolTables, the list of symbol_tables made of higherLevelSymbolTables and this object's own
+symbol table, inside compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables).
+*/
+#define DEFINE_SYMBOL_TABLES_FOR_COMPILE std::vector<exprtk::symbol_table<float>> symbolTablesWithOwn; \
+const std::vector<exprtk::symbol_table<float>>& symbolTables = withOwnSymbolTable(higherLevelSymbolTables, symbolTablesWithOwn); \
+/*
+Macro for defining symbolTables and the ExpressionCompiler, named expr, used by COMPILE_EXPRESSION_FOR_FLOAT and COMPILE_EXPRESSION_FOR_INT.
+*/
+#define DEFINE_PARSER_AND_EXPR_FOR_COMPILE DEFINE_SYMBOL_TABLES_FOR_COMPILE \
+ExpressionCompiler expr(symbolTables); \
 /*
 Macro for defining a variable whose value is defined by an expression, for a LevelPackObject. 
 The getter for the variable should return NameExprCompiledValue.
@@ -31,7 +39,7 @@ Type Name##ExprCompiledValue;\
 This macro only works if variables following the naming scheme in DEFINE_EXPRESSION_VARIABLE with float for TypeName.
 
 Usage:
-void compileExpressions(exprtk::symbol_table<float> symbolTable) {
+void compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(name1)
 	COMPILE_EXPRESSION_FOR_FLOAT(name2)
@@ -39,21 +47,19 @@ void compileExpressions(exprtk::symbol_table<float> symbolTable) {
 }
 ...
 */
-#define COMPILE_EXPRESSION_FOR_FLOAT(Name) parser.compile(##Name, expr); \
-Name##ExprCompiledValue = expr.value(); \
+#define COMPILE_EXPRESSION_FOR_FLOAT(Name) Name##ExprCompiledValue = expr.evaluate(Name); \
 /*
 This macro only works if variables following the naming scheme in DEFINE_EXPRESSION_VARIABLE with int for TypeName.
 
 Usage:
-void compileExpressions(exprtk::symbol_table<float> symbolTable) {
+void compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(name1)
 	COMPILE_EXPRESSION_FOR_INT(name2)
 	...
 }
 */
-#define COMPILE_EXPRESSION_FOR_INT(Name) parser.compile(##Name, expr); \
-Name##ExprCompiledValue = (int)std::lrint(expr.value()); \
+#define COMPILE_EXPRESSION_FOR_INT(Name) Name##ExprCompiledValue = (int)std::lrint(expr.evaluate(Name)); \
 
 #define DEFINE_PARSER_AND_EXPR_FOR_LEGAL_CHECK exprtk::parser<float> parser; \
 parser.enable_unknown_symbol_resolver(); \
@@ -109,7 +115,7 @@ public:
 	*/
 	virtual std::pair<LEGAL_STATUS, std::vector<std::string>> legal(LevelPack& levelPack, SpriteLoader& spriteLoader, std::vector<exprtk::symbol_table<float>> symbolTables) const = 0;
 
-	virtual void compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) = 0;
+	virtual void compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) = 0;
 
 protected:
 	// Format for the message in legal() for an invalid expression. The only parameter is the descriptive name of the field as a C string.
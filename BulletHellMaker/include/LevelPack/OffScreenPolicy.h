@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+
+#include <LevelPack/TextMarshallable.h>
+
+/*
+What happens to an entity once it has left the play area by more than some margin.
+*/
+enum class OFF_SCREEN_ACTION {
+	// Nothing happens; the entity lives until its usual despawn conditions are met
+	KEEP = 0,
+	// The entity is despawned
+	DESPAWN = 1,
+	// The entity stops moving and stops colliding, but is still alive
+	FREEZE = 2
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(OFF_SCREEN_ACTION, {
+	{OFF_SCREEN_ACTION::KEEP, "KEEP"},
+	{OFF_SCREEN_ACTION::DESPAWN, "DESPAWN"},
+	{OFF_SCREEN_ACTION::FREEZE, "FREEZE"}
+})
+
+/*
+Determines what happens to bullets that travel outside the play area.
+An entity is off-screen when its position is more than margin units outside
+the rectangle (0, 0) to (MAP_WIDTH, MAP_HEIGHT).
+*/
+class OffScreenPolicy : public TextMarshallable {
+public:
+	OffScreenPolicy();
+	OffScreenPolicy(OFF_SCREEN_ACTION action, float margin = 100);
+
+	std::string format() const override;
+	void load(std::string formattedString) override;
+
+	nlohmann::json toJson() override;
+	void load(const nlohmann::json& j) override;
+
+	inline OFF_SCREEN_ACTION getAction() const { return action; }
+	inline float getMargin() const { return margin; }
+
+	inline void setAction(OFF_SCREEN_ACTION action) { this->action = action; }
+	inline void setMargin(float margin) { this->margin = margin; }
+
+	bool operator==(const OffScreenPolicy& other) const;
+
+private:
+	OFF_SCREEN_ACTION action = OFF_SCREEN_ACTION::KEEP;
+	// in range [0, inf]
+	float margin = 100;
+};
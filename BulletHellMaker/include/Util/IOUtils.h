@@ -74,4 +74,11 @@ void showWindowsErrorDialog(DWORD errorCode, LPCWSTR dialogTitle);
 Returns the current date and time in a format that allows it to be put into
 a Windows file name.
 */
-std::string getCurDateTimeInWindowsFileNameCompliantFormat();
\ No newline at end of file
+std::string getCurDateTimeInWindowsFileNameCompliantFormat();
+
+/*
+Writes contents into a file by first writing a temporary file next to it and then renaming the temporary file
+over it, so that the file is never left partially written.
+Returns false if the file couldn't be written, in which case the original file is left unchanged.
+*/
+bool writeFileAtomically(const std::string& filePath, const std::string& contents);
\ No newline at end of file
@@ -16,9 +16,22 @@ Returns the distance between two points.
 */
 float distance(float x1, float y1, float x2, float y2);
 
+/*
+Returns the squared distance between the segment from (ax1, ay1) to (ax2, ay2) and the segment from (bx1, by1) to (bx2, by2).
+Either segment can be a single point.
+*/
+float segmentDistanceSquared(float ax1, float ay1, float ax2, float ay2, float bx1, float by1, float bx2, float by2);
+
 /*
 Returns whether an entity with PositionComponent p1 and HitboxComponent h1
 is colliding with an entity with PositionComponent p2 and HitboxComponent h2.
 */
 bool collides(const PositionComponent& p1, const HitboxComponent& h1, const PositionComponent& p2, const HitboxComponent& h2);
-bool collides(const PositionComponent& p1, const HitboxComponent& h1, const PositionComponent& p2, float h2x, float h2y, float h2radius);
\ No newline at end of file
+bool collides(const PositionComponent& p1, const HitboxComponent& h1, const PositionComponent& p2, float h2x, float h2y, float h2radius);
+/*
+Returns whether an entity with PositionComponent p1 and HitboxComponent h1 is touched at any point
+by HitboxComponent h2 as its entity moves in a straight line from (h2StartX, h2StartY) to PositionComponent p2.
+The first entity is treated as stationary.
+h2 must not be a capsule, since capsules are never swept.
+*/
+bool sweptCollides(const PositionComponent& p1, const HitboxComponent& h1, float h2StartX, float h2StartY, const PositionComponent& p2, const HitboxComponent& h2);
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+/*
+Calls f(i) for every i in [0, count) using up to maxThreads threads, including the calling thread.
+If maxThreads is 0, the amount of hardware threads is used.
+Indices are handed out one at a time, so f can take very different amounts of time for different indices.
+Returns once every call is done. f must not throw.
+*/
+template<typename F>
+void parallelFor(std::size_t count, F f, unsigned int maxThreads = 0) {
+	if (maxThreads == 0) {
+		maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	std::size_t threadCount = std::min(count, (std::size_t)maxThreads);
+
+	std::atomic<std::size_t> nextIndex(0);
+	auto work = [count, &f, &nextIndex]() {
+		for (std::size_t i = nextIndex++; i < count; i = nextIndex++) {
+			f(i);
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (std::size_t i = 1; i < threadCount; i++) {
+		workers.emplace_back(work);
+	}
+	work();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <map>
+#include <mutex>
+#include <chrono>
+
+/*
+A lightweight, thread-safe collector of named performance statistics.
+
+Counters are summed, gauges keep their most recent and maximum values, and timers accumulate
+total seconds and sample count. Statistics are kept until logAndReset() is called.
+*/
+class Profiler {
+public:
+	/*
+	Adds amount to the counter with some name.
+	*/
+	static void addToCounter(const std::string& name, long long amount = 1);
+	/*
+	Sets the current value of the gauge with some name.
+	*/
+	static void setGauge(const std::string& name, double value);
+	/*
+	Adds a timing sample, in seconds, to the timer with some name.
+	*/
+	static void addTime(const std::string& name, double seconds);
+
+	/*
+	Returns the value of the counter with some name, or 0 if it doesn't exist.
+	*/
+	static long long getCounter(const std::string& name);
+	/*
+	Returns the maximum value the gauge with some name has ever been set to, or 0 if it doesn't exist.
+	*/
+	static double getGaugeMax(const std::string& name);
+
+	/*
+	Logs every statistic at debug level under some title and then clears all statistics.
+	Nothing is logged if there are no statistics.
+	*/
+	static void logAndReset(const std::string& title);
+
+private:
+	struct Gauge {
+		double last = 0;
+		double max = 0;
+	};
+	struct Timer {
+		double totalSeconds = 0;
+		long long samples = 0;
+	};
+
+	static std::mutex mutex;
+	static std::map<std::string, long long> counters;
+	static std::map<std::string, Gauge> gauges;
+	static std::map<std::string, Timer> timers;
+};
+
+/*
+Adds the time between its construction and destruction to a Profiler timer.
+*/
+class ProfilerTimer {
+public:
+	ProfilerTimer(std::string name);
+	~ProfilerTimer();
+
+private:
+	std::string name;
+	std::chrono::steady_clock::time_point start;
+};
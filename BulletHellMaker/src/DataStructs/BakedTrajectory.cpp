@@ -0,0 +1,175 @@
+#include <DataStructs/BakedTrajectory.h>
+
+#include <cmath>
+#include <algorithm>
+
+#include <DataStructs/MovablePoint.h>
+#include <Util/Logger.h>
+#include <Util/Profiler.h>
+#include <Constants.h>
+
+const float BakedTrajectory::MAX_ALLOWED_ERROR = 0.25f;
+const float BakedTrajectory::INITIAL_SAMPLE_INTERVAL = MAX_PHYSICS_DELTA_TIME / 4.0f;
+const std::size_t BakedTrajectory::MAX_CACHED_TRAJECTORIES = 256;
+
+std::atomic<bool> BakedTrajectory::enabled(false);
+std::mutex BakedTrajectory::cacheMutex;
+Cache<BakedTrajectory::Key, std::shared_ptr<const BakedTrajectory>> BakedTrajectory::cache(BakedTrajectory::MAX_CACHED_TRAJECTORIES);
+BakedTrajectory::Stats BakedTrajectory::stats;
+
+std::shared_ptr<const BakedTrajectory> BakedTrajectory::getOrBake(const Key& key, MovablePoint& mp) {
+	return getOrCreate(key, mp, [&mp]() {
+		return bake(mp, MAX_ALLOWED_ERROR);
+	});
+}
+
+std::shared_ptr<const BakedTrajectory> BakedTrajectory::getOrBakeSteps(const Key& key, MovablePoint& mp, const std::vector<float>& stepTimes) {
+	return getOrCreate(key, mp, [&mp, &stepTimes]() {
+		return bakeSteps(mp, stepTimes);
+	});
+}
+
+std::shared_ptr<const BakedTrajectory> BakedTrajectory::getBaked(const Key& key) {
+	if (!enabled) {
+		return nullptr;
+	}
+
+	std::shared_ptr<const BakedTrajectory> cached;
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.tryGet(key, cached);
+	return cached;
+}
+
+std::shared_ptr<const BakedTrajectory> BakedTrajectory::getOrCreate(const Key& key, MovablePoint& mp, std::function<std::shared_ptr<BakedTrajectory>()> bake) {
+	if (!enabled) {
+		return nullptr;
+	}
+
+	std::shared_ptr<const BakedTrajectory> cached;
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		if (cache.tryGet(key, cached)) {
+			return cached;
+		}
+	}
+
+	// Bake outside the lock; if another thread bakes the same path at the same time, the first one to finish wins
+	std::shared_ptr<const BakedTrajectory> baked = bake();
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	if (cache.tryGet(key, cached)) {
+		return cached;
+	}
+	cache.insert(key, baked);
+
+	if (baked) {
+		stats.baked++;
+		stats.bytes += baked->getMemoryUsage();
+		stats.maxError = std::max(stats.maxError, baked->getMaxError());
+		L_(ldebug) << "Baked a " << baked->getLifespan() << "s trajectory into " << baked->getSamplesCount() << " samples ("
+			<< baked->getMemoryUsage() << " bytes) with a max deviation of " << baked->getMaxError();
+	} else {
+		stats.failed++;
+		L_(ldebug) << "Unable to bake a " << mp.getLifespan() << "s trajectory to within " << MAX_ALLOWED_ERROR << " with at most " << MAX_SAMPLES << " samples";
+	}
+	Profiler::setGauge("Baked trajectories", (double)stats.baked);
+	Profiler::setGauge("Baked trajectory memory (bytes)", (double)stats.bytes);
+	Profiler::setGauge("Baked trajectory max deviation", stats.maxError);
+	return baked;
+}
+
+void BakedTrajectory::setEnabled(bool enabled) {
+	BakedTrajectory::enabled = enabled;
+}
+
+bool BakedTrajectory::isEnabled() {
+	return enabled;
+}
+
+BakedTrajectory::Stats BakedTrajectory::getStats() {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return stats;
+}
+
+void BakedTrajectory::clearCache() {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.clear();
+}
+
+sf::Vector2f BakedTrajectory::get(float time) const {
+	if (!stepTimes.empty()) {
+		// The last jump at or before time
+		int step = (int)(std::upper_bound(stepTimes.begin(), stepTimes.end(), time) - stepTimes.begin()) - 1;
+		return samples[std::max(0, step)];
+	}
+
+	float index = std::max(0.0f, time * inverseSampleInterval);
+	int i = (int)index;
+	if (i >= (int)samples.size() - 1) {
+		return samples.back();
+	}
+	float t = index - i;
+	return samples[i] + (samples[i + 1] - samples[i]) * t;
+}
+
+bool BakedTrajectory::sample(MovablePoint& mp, float sampleInterval, float maxAllowedError) {
+	lifespan = mp.getLifespan();
+	samples.clear();
+	if (lifespan <= 0) {
+		samples.push_back(mp.compute(sf::Vector2f(0, 0), 0));
+		this->sampleInterval = 0;
+		inverseSampleInterval = 0;
+		maxError = 0;
+		return true;
+	}
+
+	int intervals = std::max(1, (int)std::ceil(lifespan / sampleInterval));
+	this->sampleInterval = lifespan / intervals;
+	inverseSampleInterval = intervals / lifespan;
+
+	samples.reserve(intervals + 1);
+	for (int i = 0; i <= intervals; i++) {
+		samples.push_back(mp.compute(sf::Vector2f(0, 0), i * this->sampleInterval));
+	}
+
+	// Check a few points between every pair of samples, since that's where interpolation can be off
+	maxError = 0;
+	for (int i = 0; i < intervals; i++) {
+		for (float fraction : { 0.25f, 0.5f, 0.75f }) {
+			sf::Vector2f actual = mp.compute(sf::Vector2f(0, 0), (i + fraction) * this->sampleInterval);
+			sf::Vector2f interpolated = samples[i] + (samples[i + 1] - samples[i]) * fraction;
+			float error = std::sqrt((actual.x - interpolated.x) * (actual.x - interpolated.x) + (actual.y - interpolated.y) * (actual.y - interpolated.y));
+			maxError = std::max(maxError, error);
+			if (maxError > maxAllowedError) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+std::shared_ptr<BakedTrajectory> BakedTrajectory::bake(MovablePoint& mp, float maxAllowedError) {
+	std::shared_ptr<BakedTrajectory> baked = std::make_shared<BakedTrajectory>();
+	float sampleInterval = INITIAL_SAMPLE_INTERVAL;
+	while (mp.getLifespan() / sampleInterval < MAX_SAMPLES) {
+		if (baked->sample(mp, sampleInterval, maxAllowedError)) {
+			baked->samples.shrink_to_fit();
+			return baked;
+		}
+		sampleInterval /= 2;
+	}
+	return nullptr;
+}
+
+
+std::shared_ptr<BakedTrajectory> BakedTrajectory::bakeSteps(MovablePoint& mp, const std::vector<float>& stepTimes) {
+	std::shared_ptr<BakedTrajectory> baked = std::make_shared<BakedTrajectory>();
+	baked->lifespan = mp.getLifespan();
+	baked->stepTimes = stepTimes;
+	for (int i = 0; i < stepTimes.size(); i++) {
+		// Sample halfway to the next jump so that which side of a jump mp puts the jump itself on doesn't matter
+		float end = i + 1 < stepTimes.size() ? stepTimes[i + 1] : std::max(stepTimes[i], baked->lifespan);
+		baked->samples.push_back(mp.compute(sf::Vector2f(0, 0), (stepTimes[i] + end) / 2));
+	}
+	return baked;
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <DataStructs/MovablePoint.h>
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 MovablePoint::MovablePoint(float lifespan, bool returnGlobalPositions) 
 	: lifespan(lifespan), returnGlobalPositions(returnGlobalPositions) {
@@ -71,6 +73,15 @@ float AggregatorMP::calculateLifespan() {
 	return lifespan;
 }
 
+void AggregatorMP::addToExpressionTFVBatch(ExpressionTFVBatch& batch, float time) {
+	for (int i = mps.size() - 1; i >= 0; i--) {
+		if (time >= minTimes[i]) {
+			mps[i]->addToExpressionTFVBatch(batch, time - minTimes[i]);
+			return;
+		}
+	}
+}
+
 sf::Vector2f AggregatorMP::evaluate(float time) {
 	for (int i = mps.size() - 1; i >= 0; i--) {
 		if (time >= minTimes[i]) {
@@ -79,17 +90,35 @@ sf::Vector2f AggregatorMP::evaluate(float time) {
 	}
 }
 
-HomingMP::HomingMP(float lifespan, std::shared_ptr<TFV> speed, std::shared_ptr<TFV> homingStrength, uint32_t from, uint32_t to, entt::DefaultRegistry& registry) : MovablePoint(lifespan, true), speed(speed), homingStrength(homingStrength), registry(registry), from(from) {
+void HomingSteeringBatch::clear() {
+	mps.clear();
+	times.clear();
+	fromX.clear();
+	fromY.clear();
+	toX.clear();
+	toY.clear();
+	prevAngles.clear();
+	homingStrengths.clear();
+	distances.clear();
+	angles.clear();
+	offsetX.clear();
+	offsetY.clear();
+}
+
+HomingMP::HomingMP(float lifespan, std::shared_ptr<TFV> speed, std::shared_ptr<TFV> homingStrength, uint32_t from, uint32_t to, entt::DefaultRegistry& registry) : MovablePoint(lifespan, true), speed(speed), homingStrength(homingStrength), registry(registry), from(from),
+	usesRegistry(true), targetsEntity(true), to(to) {
 	angle = std::make_shared<CurrentAngleTFV>(registry, from, to);
 	prevAngle = angle->evaluate(0);
 }
 
-HomingMP::HomingMP(float lifespan, std::shared_ptr<TFV> speed, std::shared_ptr<TFV> homingStrength, uint32_t from, float toX, float toY, entt::DefaultRegistry& registry) : MovablePoint(lifespan, true), speed(speed), homingStrength(homingStrength), registry(registry), from(from) {
+HomingMP::HomingMP(float lifespan, std::shared_ptr<TFV> speed, std::shared_ptr<TFV> homingStrength, uint32_t from, float toX, float toY, entt::DefaultRegistry& registry) : MovablePoint(lifespan, true), speed(speed), homingStrength(homingStrength), registry(registry), from(from),
+	usesRegistry(true), toX(toX), toY(toY) {
 	angle = std::make_shared<CurrentAngleTFV>(registry, from, toX, toY);
 	prevAngle = angle->evaluate(0);
 }
 
-HomingMP::HomingMP(float lifespan, std::shared_ptr<TFV> speed, std::shared_ptr<TFV> homingStrength, float fromX, float fromY, float toX, float toY) : MovablePoint(lifespan, true), speed(speed), homingStrength(homingStrength), registry(registry) {
+HomingMP::HomingMP(float lifespan, std::shared_ptr<TFV> speed, std::shared_ptr<TFV> homingStrength, float fromX, float fromY, float toX, float toY) : MovablePoint(lifespan, true), speed(speed), homingStrength(homingStrength), registry(registry),
+	usesRegistry(false), toX(toX), toY(toY) {
 	angle = std::make_shared<ConstantTFV>(std::atan2(toY - fromY, toX - fromX));
 	prevAngle = angle->evaluate(0);
 }
@@ -100,19 +129,16 @@ sf::Vector2f HomingMP::evaluate(float time) {
 	// can be calculated easily) or in the past in order to account for time lag on various actions. Since this game limits the time
 	// between physics updates to MAX_PHYSICS_DELTA_TIME, the time lag will never exceed MAX_PHYSICS_DELTA_TIME. Knowing this,
 	// and since this MP is time-invariant but still needs to determine past positions, we can cache known positions in only the last
-	// MAX_PHYSICS_DELTA_TIME seconds and discard anything older, since those older positions will never need to be known.
-	// Linear interpolation can be used as a close estimate to calculate past positions that are not exactly at the moment of caching.
-	// eg If time=1 and time=2's positions were cached, to find the position at time=1.3, linearly interpolate between the positions
-	// at time=1 and time=2.
+	// few physics updates in a fixed-size PositionHistory, since older positions will never need to be known.
+	// Linear interpolation is used as a close estimate to calculate past positions that are not exactly at the moment of caching.
 	float deltaTime = time - lastEvaluatedTime;
 	assert(deltaTime <= MAX_PHYSICS_DELTA_TIME + 0.0001f);
 
-	// Note: comparisons are done agianst MAX_PHYSICS_DELTA_TIME + 0.0001f to account for floating point inaccuracies
-
 	if (!registry.has<PositionComponent>(from)) {
 		// Sometimes the game randomly crashes from this and idk why so this is just a safety precaution
 		// TODO: log this
 		// BOOST_LOG_TRIVIAL(error) << "HomingMP failed to find PositionComponent of entity id " << from;
+		hasSteering = false;
 		return sf::Vector2f(0, 0);
 	}
 
@@ -120,57 +146,82 @@ sf::Vector2f HomingMP::evaluate(float time) {
 	if (deltaTime > 0) {
 		lastEvaluatedTime = time;
 
-		// Remove positions older than MAX_PHYSICS_DELTA_TIME
-		auto it = cachedPositions.begin();
-		while (it != cachedPositions.end()) {
-			if (time - it->first > MAX_PHYSICS_DELTA_TIME + 0.0001f) {
-				it = cachedPositions.erase(it);
-			} else {
-				// cachedPositions is always sorted, so break loop as soon as something newer than MAX_PHYSICS_DELTA_TIME is encountered
-				break;
-			}
-		}
-
 		// Calculate new position
-		float radians = lerpRadians(prevAngle, angle->evaluate(time), homingStrength->evaluate(time)); // angle is time-invariant so really anything can be passed in as the time parameter
-		prevAngle = radians;
-		float curSpeed = speed->evaluate(time);
-		auto newPos = sf::Vector2f(fromPos.getX() + std::cos(radians) * curSpeed * deltaTime, fromPos.getY() + std::sin(radians) * curSpeed * deltaTime);
+		sf::Vector2f offset;
+		if (hasSteering && steeringTime == time) {
+			// Already steered by steer()
+			prevAngle = steeringAngle;
+			offset = steeringOffset;
+		} else {
+			float radians = lerpRadians(prevAngle, angle->evaluate(time), homingStrength->evaluate(time)); // angle is time-invariant so really anything can be passed in as the time parameter
+			prevAngle = radians;
+			float curSpeed = speed->evaluate(time);
+			offset = sf::Vector2f(std::cos(radians) * curSpeed * deltaTime, std::sin(radians) * curSpeed * deltaTime);
+		}
+		hasSteering = false;
+		auto newPos = sf::Vector2f(fromPos.getX() + offset.x, fromPos.getY() + offset.y);
 
-		// Add current position to list of cached positions
-		cachedPositions.push_back(std::make_pair(time, newPos));
+		// Add current position to the cache
+		cachedPositions.record(time, newPos);
 
 		return newPos;
-	} else if (deltaTime < 0 && cachedPositions.size() > 0) {
+	} else if (deltaTime < 0 && !cachedPositions.isEmpty()) {
 		// This function call is a request for some past position, so check the cache
-
-		if (cachedPositions.size() == 1) {
-			// Only 1 cached position, so that's the closest possible we can get
-
-			return cachedPositions[0].second;
-		}
-
-		auto it = std::lower_bound(cachedPositions.begin(), cachedPositions.end(), time, CachedPositionSearchComparator()) - 1;
-		if ((*it).first == time) {
-			// Perfect match for a cached time
-			
-			return (*it).second;
-		} else {
-			// The requested time is in-between two cached positions, so linearly interpolate to estimate where this MP was at that time
-
-			auto t1 = (*it).first;
-			auto pos1 = (*it).second;
-			it++;
-			auto t2 = (*it).first;
-			auto pos2 = (*it).second;
-			return sf::Vector2f((pos2.x - pos1.x)*((time - t1) / (t2 - t1)) + pos1.x, (pos2.y - pos1.y)*((time - t1) / (t2 - t1)) + pos1.y);
-		}
+		return cachedPositions.get(time);
 	} else {
 		// deltaTime is 0
 		return sf::Vector2f(fromPos.getX(), fromPos.getY());
 	}
 }
 
+bool HomingMP::addToSteeringBatch(HomingSteeringBatch& batch, float time, float fromX, float fromY, float toX, float toY) {
+	float deltaTime = time - lastEvaluatedTime;
+	if (!usesRegistry || deltaTime <= 0) {
+		return false;
+	}
+
+	batch.mps.push_back(this);
+	batch.times.push_back(time);
+	batch.fromX.push_back(fromX);
+	batch.fromY.push_back(fromY);
+	if (targetsEntity) {
+		batch.toX.push_back(toX);
+		batch.toY.push_back(toY);
+	} else {
+		batch.toX.push_back(this->toX);
+		batch.toY.push_back(this->toY);
+	}
+	batch.prevAngles.push_back(prevAngle);
+	batch.homingStrengths.push_back(homingStrength->evaluate(time));
+	batch.distances.push_back(speed->evaluate(time) * deltaTime);
+	return true;
+}
+
+void HomingMP::steer(HomingSteeringBatch& batch) {
+	int count = batch.size();
+	batch.angles.resize(count);
+	batch.offsetX.resize(count);
+	batch.offsetY.resize(count);
+
+	// No registry access or virtual calls in here, so that the compiler is free to vectorize
+	for (int i = 0; i < count; i++) {
+		float targetAngle = std::atan2(batch.toY[i] - batch.fromY[i], batch.toX[i] - batch.fromX[i]);
+		batch.angles[i] = lerpRadians(batch.prevAngles[i], targetAngle, batch.homingStrengths[i]);
+	}
+	for (int i = 0; i < count; i++) {
+		batch.offsetX[i] = std::cos(batch.angles[i]) * batch.distances[i];
+		batch.offsetY[i] = std::sin(batch.angles[i]) * batch.distances[i];
+	}
+
+	for (int i = 0; i < count; i++) {
+		HomingMP* mp = batch.mps[i];
+		mp->hasSteering = true;
+		mp->steeringTime = batch.times[i];
+		mp->steeringAngle = batch.angles[i];
+		mp->steeringOffset = sf::Vector2f(batch.offsetX[i], batch.offsetY[i]);
+	}
+}
+
 EntityMP::EntityMP(const PositionComponent& entityPosition, float lifespan) 
 	: MovablePoint(lifespan, false), entityPosition(entityPosition) {
 }
@@ -179,37 +230,140 @@ StationaryMP::StationaryMP(sf::Vector2f position, float lifespan)
 	: MovablePoint(lifespan, false), position(position) {
 }
 
+BakedMP::BakedMP(std::shared_ptr<const BakedTrajectory> trajectory, float rotation)
+	: MovablePoint(trajectory->getLifespan(), false), trajectory(trajectory), rotated(rotation != 0),
+	rotationCos(std::cos(rotation)), rotationSin(std::sin(rotation)) {
+}
+
 PolarMP::PolarMP(float lifespan, std::shared_ptr<TFV> distance, std::shared_ptr<TFV> angle) 
 	: MovablePoint(lifespan, false), angle(angle), distance(distance) {
 }
 
+void PolarMP::addToExpressionTFVBatch(ExpressionTFVBatch& batch, float time) {
+	distance->addToExpressionBatch(batch, time);
+	angle->addToExpressionBatch(batch, time);
+}
+
 sf::Vector2f PolarMP::evaluate(float time) {
-	auto a = distance->evaluate(time);
-	auto b = angle->evaluate(time);
-	return sf::Vector2f(distance->evaluate(time) * cos(angle->evaluate(time)), distance->evaluate(time) * sin(angle->evaluate(time)));
+	float d = distance->evaluate(time);
+	float a = angle->evaluate(time);
+	return sf::Vector2f(d * cos(a), d * sin(a));
 }
 
 BezierMP::BezierMP(float lifespan, std::vector<sf::Vector2f> controlPoints) 
-	: MovablePoint(lifespan, false), controlPoints(controlPoints), numControlPoints(controlPoints.size()) {
+	: MovablePoint(lifespan, false), coefficients(computeCoefficients(controlPoints)) {
+}
+
+BezierMP::BezierMP(float lifespan, std::vector<sf::Vector2f> controlPoints, bool constantSpeed, std::shared_ptr<const std::vector<float>> arcLengthTable)
+	: MovablePoint(lifespan, false), coefficients(computeCoefficients(controlPoints)), constantSpeed(constantSpeed), arcLengthTable(arcLengthTable) {
+	if (constantSpeed && !this->arcLengthTable) {
+		this->arcLengthTable = computeArcLengthTable(controlPoints);
+	}
+}
+
+std::shared_ptr<const std::vector<float>> BezierMP::computeArcLengthTable(const std::vector<sf::Vector2f>& controlPoints) {
+	std::vector<sf::Vector2f> coefficients = computeCoefficients(controlPoints);
+
+	// cumulativeLengths[i] is the length of the curve from parameter 0 to parameter i/ARC_LENGTH_SAMPLES
+	std::vector<double> cumulativeLengths(ARC_LENGTH_SAMPLES + 1);
+	cumulativeLengths[0] = 0;
+	sf::Vector2f prev = evaluateCoefficients(coefficients, 0);
+	for (int i = 1; i <= ARC_LENGTH_SAMPLES; i++) {
+		sf::Vector2f cur = evaluateCoefficients(coefficients, (float)i / ARC_LENGTH_SAMPLES);
+		double dx = cur.x - prev.x;
+		double dy = cur.y - prev.y;
+		cumulativeLengths[i] = cumulativeLengths[i - 1] + std::sqrt(dx * dx + dy * dy);
+		prev = cur;
+	}
+	double totalLength = cumulativeLengths[ARC_LENGTH_SAMPLES];
+
+	auto table = std::make_shared<std::vector<float>>(ARC_LENGTH_TABLE_RESOLUTION + 1);
+	if (totalLength <= 0) {
+		// The curve is a single point, so every parameter is as good as any other
+		for (int i = 0; i <= ARC_LENGTH_TABLE_RESOLUTION; i++) {
+			(*table)[i] = (float)i / ARC_LENGTH_TABLE_RESOLUTION;
+		}
+		return table;
+	}
+
+	int sample = 0;
+	for (int i = 0; i <= ARC_LENGTH_TABLE_RESOLUTION; i++) {
+		double targetLength = totalLength * i / ARC_LENGTH_TABLE_RESOLUTION;
+		while (sample < ARC_LENGTH_SAMPLES - 1 && cumulativeLengths[sample + 1] < targetLength) {
+			sample++;
+		}
+		// Interpolate between the two samples surrounding the target length
+		double segmentLength = cumulativeLengths[sample + 1] - cumulativeLengths[sample];
+		double t = segmentLength > 0 ? (targetLength - cumulativeLengths[sample]) / segmentLength : 0;
+		(*table)[i] = (float)((sample + std::max(0.0, std::min(1.0, t))) / ARC_LENGTH_SAMPLES);
+	}
+	return table;
 }
 
 sf::Vector2f BezierMP::evaluate(float time) {
 	// Scale time to be in range [0, 1]
 	time /= lifespan;
 
-	if (numControlPoints == 2) {
-		return controlPoints[0] + time * (controlPoints[1] - controlPoints[0]);
-	} else if (numControlPoints == 3) {
-		float a = 1 - time;
-		return a * a * controlPoints[0] + 2.0f * a * time * controlPoints[1] + time * time * controlPoints[2];
-	} else if (numControlPoints == 4) {
-		float a = 1 - time;
-		return (a * a * a * controlPoints[0]) + (3.0f * a * a * time * controlPoints[1]) + (3.0f * a * time * time * controlPoints[2]) + (time * time * time * controlPoints[3]);
-	} else {
-		sf::Vector2f sum(0, 0);
-		for (int i = 0; i < numControlPoints; i++) {
-			sum += float(binom(numControlPoints - 1, i) * std::pow(1.0f - time, numControlPoints - 1 - i) * std::pow(time, i)) * controlPoints[i];
+	if (constantSpeed) {
+		time = arcLengthFractionToParameter(time);
+	}
+	return evaluateCoefficients(coefficients, time);
+}
+
+std::vector<sf::Vector2f> BezierMP::computeCoefficients(const std::vector<sf::Vector2f>& controlPoints) {
+	// For a curve of degree n, coefficient k is C(n, k) * (sum over i from 0 to k of (-1)^(k - i) * C(k, i) * controlPoints[i])
+	int n = (int)controlPoints.size() - 1;
+	std::vector<sf::Vector2f> coefficients;
+	// Done in double since the sums alternate in sign and lose a lot of precision in float
+	double nChooseK = 1;
+	for (int k = 0; k <= n; k++) {
+		double sumX = 0;
+		double sumY = 0;
+		double kChooseI = 1;
+		for (int i = 0; i <= k; i++) {
+			double sign = ((k - i) % 2 == 0) ? 1 : -1;
+			sumX += sign * kChooseI * controlPoints[i].x;
+			sumY += sign * kChooseI * controlPoints[i].y;
+			kChooseI = kChooseI * (k - i) / (i + 1);
 		}
-		return sum;
+		coefficients.push_back(sf::Vector2f((float)(nChooseK * sumX), (float)(nChooseK * sumY)));
+		nChooseK = nChooseK * (n - k) / (k + 1);
+	}
+	return coefficients;
+}
+
+sf::Vector2f BezierMP::evaluateCoefficients(const std::vector<sf::Vector2f>& coefficients, float u) {
+	const sf::Vector2f* c = coefficients.data();
+	switch (coefficients.size()) {
+	case 0:
+		return sf::Vector2f(0, 0);
+	case 1:
+		return c[0];
+	case 2:
+		return sf::Vector2f(c[0].x + u * c[1].x, c[0].y + u * c[1].y);
+	case 3:
+		// Quadratic
+		return sf::Vector2f(c[0].x + u * (c[1].x + u * c[2].x), c[0].y + u * (c[1].y + u * c[2].y));
+	case 4:
+		// Cubic
+		return sf::Vector2f(c[0].x + u * (c[1].x + u * (c[2].x + u * c[3].x)), c[0].y + u * (c[1].y + u * (c[2].y + u * c[3].y)));
+	default:
+		float x = c[coefficients.size() - 1].x;
+		float y = c[coefficients.size() - 1].y;
+		for (int i = coefficients.size() - 2; i >= 0; i--) {
+			x = x * u + c[i].x;
+			y = y * u + c[i].y;
+		}
+		return sf::Vector2f(x, y);
+	}
+}
+
+float BezierMP::arcLengthFractionToParameter(float fraction) const {
+	const std::vector<float>& table = *arcLengthTable;
+	float index = std::max(0.0f, std::min(1.0f, fraction)) * ARC_LENGTH_TABLE_RESOLUTION;
+	int i = (int)index;
+	if (i >= ARC_LENGTH_TABLE_RESOLUTION) {
+		return table[ARC_LENGTH_TABLE_RESOLUTION];
 	}
+	return table[i] + (table[i + 1] - table[i]) * (index - i);
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <DataStructs/PositionHistory.h>
+
+#include <cmath>
+#include <algorithm>
+
+static sf::Vector2f lerp(const sf::Vector2f& a, const sf::Vector2f& b, float t) {
+	return a + (b - a) * t;
+}
+
+PositionHistory::PositionHistory() {
+}
+
+void PositionHistory::record(float time, sf::Vector2f position) {
+	long long gridIndex = (long long)std::floor(time / POSITION_HISTORY_SAMPLE_INTERVAL);
+
+	if (!hasRecord) {
+		// Nothing is known about the entity before this, so pretend it was always here
+		samples[gridIndex % CAPACITY] = position;
+		newestGridIndex = gridIndex;
+		gridSamplesCount = 1;
+		firstTime = time;
+	} else {
+		// Fill in every grid point between the last record and this one.
+		// Skip grid points that would be overwritten anyway if the entity has been gone for longer than the buffer covers.
+		long long firstNewGridIndex = std::max(newestGridIndex + 1, gridIndex - CAPACITY + 1);
+		float span = time - newestTime;
+		for (long long i = firstNewGridIndex; i <= gridIndex; i++) {
+			float t = span > 0 ? (i * POSITION_HISTORY_SAMPLE_INTERVAL - newestTime) / span : 1;
+			samples[i % CAPACITY] = lerp(newestPosition, position, std::max(0.0f, std::min(1.0f, t)));
+		}
+		if (gridIndex > newestGridIndex) {
+			gridSamplesCount = (int)std::min((long long)CAPACITY, gridSamplesCount + (gridIndex - newestGridIndex));
+			newestGridIndex = gridIndex;
+		}
+	}
+
+	hasRecord = true;
+	newestTime = time;
+	newestPosition = position;
+}
+
+sf::Vector2f PositionHistory::get(float time) const {
+	if (!hasRecord) {
+		return sf::Vector2f(0, 0);
+	}
+	if (time >= newestTime) {
+		return newestPosition;
+	}
+
+	float newestGridTime = newestGridIndex * POSITION_HISTORY_SAMPLE_INTERVAL;
+	if (time >= newestGridTime) {
+		// Between the newest grid sample and the exact newest position
+		float span = newestTime - newestGridTime;
+		return lerp(sampleAt(newestGridIndex), newestPosition, span > 0 ? (time - newestGridTime) / span : 1);
+	}
+
+	long long oldestGridIndex = newestGridIndex - gridSamplesCount + 1;
+	long long gridIndex = (long long)std::floor(time / POSITION_HISTORY_SAMPLE_INTERVAL);
+	if (gridIndex < oldestGridIndex) {
+		return sampleAt(oldestGridIndex);
+	}
+	// gridIndex < newestGridIndex here, so gridIndex + 1 is always a valid sample
+	float t = (time - gridIndex * POSITION_HISTORY_SAMPLE_INTERVAL) / POSITION_HISTORY_SAMPLE_INTERVAL;
+	return lerp(sampleAt(gridIndex), sampleAt(gridIndex + 1), t);
+}
+
+float PositionHistory::getOldestTime() const {
+	long long oldestGridIndex = newestGridIndex - gridSamplesCount + 1;
+	return std::max(firstTime, oldestGridIndex * POSITION_HISTORY_SAMPLE_INTERVAL);
+}
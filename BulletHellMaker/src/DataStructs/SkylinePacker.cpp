@@ -0,0 +1,84 @@
+#include <DataStructs/SkylinePacker.h>
+
+#include <algorithm>
+#include <limits>
+
+SkylinePacker::SkylinePacker(int binWidth, int binHeight) : binWidth(binWidth), binHeight(binHeight) {
+	skyline.push_back(Segment{ 0, 0, binWidth });
+}
+
+bool SkylinePacker::insert(int width, int height, int& x, int& y) {
+	if (width <= 0 || height <= 0) {
+		return false;
+	}
+
+	int bestIndex = -1;
+	int bestTop = std::numeric_limits<int>::max();
+	int bestWidth = std::numeric_limits<int>::max();
+	for (int i = 0; i < skyline.size(); i++) {
+		int fitY = fit(i, width, height);
+		if (fitY < 0) {
+			continue;
+		}
+		// Prefer the lowest top edge, and then the narrowest segment so that wide gaps are kept for wide rectangles
+		if (fitY + height < bestTop || (fitY + height == bestTop && skyline[i].width < bestWidth)) {
+			bestIndex = i;
+			bestTop = fitY + height;
+			bestWidth = skyline[i].width;
+		}
+	}
+	if (bestIndex == -1) {
+		return false;
+	}
+
+	x = skyline[bestIndex].x;
+	y = bestTop - height;
+
+	// Raise the skyline over the new rectangle and cut away the segments it covers
+	skyline.insert(skyline.begin() + bestIndex, Segment{ x, bestTop, width });
+	for (int i = bestIndex + 1; i < skyline.size();) {
+		int overlap = skyline[i - 1].x + skyline[i - 1].width - skyline[i].x;
+		if (overlap <= 0) {
+			break;
+		}
+		if (overlap < skyline[i].width) {
+			skyline[i].x += overlap;
+			skyline[i].width -= overlap;
+			break;
+		}
+		skyline.erase(skyline.begin() + i);
+	}
+	// Merge neighbouring segments at the same height
+	for (int i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		} else {
+			i++;
+		}
+	}
+
+	usedArea += (long long)width * height;
+	return true;
+}
+
+float SkylinePacker::getOccupancy() const {
+	return (float)((double)usedArea / ((long long)binWidth * binHeight));
+}
+
+int SkylinePacker::fit(int segmentIndex, int width, int height) const {
+	if (skyline[segmentIndex].x + width > binWidth) {
+		return -1;
+	}
+	int y = 0;
+	int widthLeft = width;
+	for (int i = segmentIndex; widthLeft > 0; i++) {
+		// The skyline always covers the whole bin, so the check above means this never runs past the last segment
+		y = std::max(y, skyline[i].y);
+		if (y + height > binHeight) {
+			return -1;
+		}
+		widthLeft -= skyline[i].width;
+	}
+	return y;
+}
@@ -0,0 +1,105 @@
+#include <DataStructs/SoundBufferCache.h>
+
+#include <vector>
+
+#include <Util/Logger.h>
+#include <Util/Profiler.h>
+#include <Util/ParallelUtils.h>
+
+SoundBufferCache::SoundBufferCache(std::size_t maxBytes) : maxBytes(maxBytes) {
+}
+
+void SoundBufferCache::preload(const std::set<std::string>& fileNames) {
+	std::vector<std::string> toDecode;
+	for (const std::string& fileName : fileNames) {
+		auto it = entries.find(fileName);
+		if (it == entries.end()) {
+			toDecode.push_back(fileName);
+		} else {
+			// Mark it as recently used so that preloading the rest doesn't evict it
+			recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it->second.recentlyUsedPosition);
+		}
+	}
+	if (toDecode.empty()) {
+		return;
+	}
+
+	struct DecodedSound {
+		bool success = false;
+		std::vector<sf::Int16> samples;
+		unsigned int channelCount = 0;
+		unsigned int sampleRate = 0;
+	};
+	std::vector<DecodedSound> decoded(toDecode.size());
+
+	// Decoding the files is done by worker threads, but creating the SoundBuffers is left to this thread
+	// since that is where the audio device is used
+	parallelFor(toDecode.size(), [&toDecode, &decoded](std::size_t i) {
+		sf::InputSoundFile file;
+		if (!file.openFromFile(toDecode[i])) {
+			return;
+		}
+		DecodedSound& sound = decoded[i];
+		sound.samples.resize(file.getSampleCount());
+		sound.samples.resize(file.read(sound.samples.data(), sound.samples.size()));
+		sound.channelCount = file.getChannelCount();
+		sound.sampleRate = file.getSampleRate();
+		sound.success = true;
+	});
+
+	for (std::size_t i = 0; i < toDecode.size(); i++) {
+		std::shared_ptr<sf::SoundBuffer> buffer = std::make_shared<sf::SoundBuffer>();
+		if (!decoded[i].success || !buffer->loadFromSamples(decoded[i].samples.data(), decoded[i].samples.size(), decoded[i].channelCount, decoded[i].sampleRate)) {
+			L_(lerror) << "Failed to preload sound \"" << toDecode[i] << "\"";
+			continue;
+		}
+		insert(toDecode[i], buffer);
+	}
+	Profiler::addToCounter("Sounds preloaded", toDecode.size());
+	Profiler::setGauge("Sound buffer cache bytes", cachedBytes);
+}
+
+std::shared_ptr<sf::SoundBuffer> SoundBufferCache::get(const std::string& fileName) {
+	auto it = entries.find(fileName);
+	if (it != entries.end()) {
+		recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it->second.recentlyUsedPosition);
+		return it->second.buffer;
+	}
+
+	std::shared_ptr<sf::SoundBuffer> buffer = std::make_shared<sf::SoundBuffer>();
+	if (!buffer->loadFromFile(fileName)) {
+		//TODO: handle audio not being able to be loaded
+		return nullptr;
+	}
+	if (lazilyLoadedFileNames.insert(fileName).second) {
+		L_(lwarning) << "Sound \"" << fileName << "\" was not preloaded";
+	}
+	Profiler::addToCounter("Sounds loaded lazily");
+
+	insert(fileName, buffer);
+	Profiler::setGauge("Sound buffer cache bytes", cachedBytes);
+	return buffer;
+}
+
+void SoundBufferCache::insert(const std::string& fileName, std::shared_ptr<sf::SoundBuffer> buffer) {
+	recentlyUsed.push_front(fileName);
+	Entry entry;
+	entry.buffer = buffer;
+	entry.bytes = buffer->getSampleCount() * sizeof(sf::Int16);
+	entry.recentlyUsedPosition = recentlyUsed.begin();
+	cachedBytes += entry.bytes;
+	entries[fileName] = entry;
+
+	evictToBudget();
+}
+
+void SoundBufferCache::evictToBudget() {
+	// The most recently used buffer is never evicted, even if it alone is over budget
+	while (cachedBytes > maxBytes && recentlyUsed.size() > 1) {
+		auto it = entries.find(recentlyUsed.back());
+		cachedBytes -= it->second.bytes;
+		entries.erase(it);
+		recentlyUsed.pop_back();
+		Profiler::addToCounter("Sounds evicted");
+	}
+}
@@ -2,12 +2,11 @@
 
 #include <algorithm>
 
-SpriteEffectAnimation::SpriteEffectAnimation(std::shared_ptr<sf::Sprite> sprite)
-	: sprite(sprite) {
+SpriteEffectAnimation::SpriteEffectAnimation() {
 }
 
-FlashWhiteSEA::FlashWhiteSEA(std::shared_ptr<sf::Sprite> sprite, float animationDuration, float flashInterval, float flashDuration) 
-	: SpriteEffectAnimation(sprite), flashInterval(flashInterval), flashDuration(flashDuration), animationDuration(animationDuration) {
+FlashWhiteSEA::FlashWhiteSEA(float animationDuration, float flashInterval, float flashDuration) 
+	: flashInterval(flashInterval), flashDuration(flashDuration), animationDuration(animationDuration) {
 	// Load shader
 	if (!shader.loadFromFile("Shaders/tint.frag", sf::Shader::Fragment)) {
 		throw "Could not load Shaders/tint.frag";
@@ -16,7 +15,7 @@ FlashWhiteSEA::FlashWhiteSEA(std::shared_ptr<sf::Sprite> sprite, float animation
 	useShader = true;
 }
 
-void FlashWhiteSEA::update(float deltaTime) {
+void FlashWhiteSEA::update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) {
 	if (done) {
 		return;
 	}
@@ -42,40 +41,52 @@ void FlashWhiteSEA::update(float deltaTime) {
 		flashIntensity = 0.7f * std::min(-2.0f * (t / flashDuration - 0.5f) + 1, -0.3f * (t / flashDuration) + 1);
 	}
 	shader.setUniform("flashColor", sf::Glsl::Vec4(1, 1, 1, flashIntensity));
-	shader.setUniform("textureModulatedColor", sf::Glsl::Vec4(sprite->getColor()));
+	shader.setUniform("textureModulatedColor", sf::Glsl::Vec4(spriteTemplate.getColor() * instance.tint));
 }
 
-FadeAwaySEA::FadeAwaySEA(std::shared_ptr<sf::Sprite> sprite, float minOpacity, float maxOpacity, float animationDuration, bool keepEffectAfterEnding) 
-	: SpriteEffectAnimation(sprite), minOpacity(minOpacity), maxOpacity(maxOpacity), animationDuration(animationDuration), keepEffectAfterEnding(keepEffectAfterEnding) {
+bool FlashWhiteSEA::isDone() const {
+	return done;
+}
+
+FadeAwaySEA::FadeAwaySEA(float minOpacity, float maxOpacity, float animationDuration, bool keepEffectAfterEnding) 
+	: minOpacity(minOpacity), maxOpacity(maxOpacity), animationDuration(animationDuration), keepEffectAfterEnding(keepEffectAfterEnding) {
 	useShader = false;
 }
 
-void FadeAwaySEA::update(float deltaTime) {
+void FadeAwaySEA::update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) {
 	if (time > animationDuration) {
 		if (keepEffectAfterEnding) {
-			auto color = sprite->getColor();
-			sprite->setColor(sf::Color(color.r, color.g, color.b, minOpacity * 255.0f));
+			instance.tint.a = minOpacity * 255.0f;
 		}
 
 		return;
 	}
 
 	time += deltaTime;
-	auto color = sprite->getColor();
-	sprite->setColor(sf::Color(color.r, color.g, color.b, std::max(minOpacity * 255.0f, 255.0f * (-(maxOpacity - minOpacity) / animationDuration * time + maxOpacity))));
+	instance.tint.a = std::max(minOpacity * 255.0f, 255.0f * (-(maxOpacity - minOpacity) / animationDuration * time + maxOpacity));
+}
+
+bool FadeAwaySEA::isDone() const {
+	return time > animationDuration;
 }
 
-ChangeSizeSEA::ChangeSizeSEA(std::shared_ptr<sf::Sprite> sprite, float startScale, float endScale, float animationDuration) 
-	: SpriteEffectAnimation(sprite), startScale(startScale), endScale(endScale), animationDuration(animationDuration) {
+ChangeSizeSEA::ChangeSizeSEA(float startScale, float endScale, float animationDuration) 
+	: startScale(startScale), endScale(endScale), animationDuration(animationDuration) {
 	useShader = false;
 }
 
-void ChangeSizeSEA::update(float deltaTime) {
+void ChangeSizeSEA::update(float deltaTime, const SpriteTemplate& spriteTemplate, SpriteInstance& instance) {
 	if (time > animationDuration) {
 		return;
 	}
 
 	time += deltaTime;
 	float scale = (time / animationDuration)*(endScale - startScale) + startScale;
-	sprite->setScale(scale, scale);
+	// Keep the sprite flipped if it is facing left
+	instance.scale = sf::Vector2f(instance.scale.x < 0 ? -scale : scale, scale);
 }
+
+
+bool ChangeSizeSEA::isDone() const {
+	return time > animationDuration;
+}
\ No newline at end of file
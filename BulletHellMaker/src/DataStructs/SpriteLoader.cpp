@@ -6,6 +6,7 @@
 #include <limits>
 #include <filesystem>
 #include <set>
+#include <chrono>
 
 #include <Constants.h>
 #include <Config.h>
@@ -13,6 +14,9 @@
 #include <Util/TextFileParser.h>
 #include <LevelPack/TextMarshallable.h>
 #include <Util/IOUtils.h>
+#include <Util/ParallelUtils.h>
+#include <Util/Profiler.h>
+#include <DataStructs/SkylinePacker.h>
 
 static const std::string SPRITE_SHEET_NAME_TAG = "SpriteSheetName";
 static const std::string SPRITE_TOPLEFT_COORDS_TAG = "TextureTopLeftCoordinates";
@@ -22,6 +26,9 @@ static const std::string SPRITE_SIZE_TAG = "SpriteSize";
 static const std::string SPRITE_ORIGIN_TAG = "Origin";
 const std::size_t SpriteLoader::BACKGROUNDS_CACHE_MAX_SIZE = 10;
 const std::size_t SpriteLoader::GUI_ELEMENTS_CACHE_MAX_SIZE = 10;
+const int SpriteLoader::ATLAS_SIZE = 2048;
+const int SpriteLoader::ATLAS_PADDING = 2;
+const int SpriteLoader::ATLAS_EXTRUSION = 1;
 
 std::vector<int> extractInts(const std::string& str) {
 	std::vector<int> vect;
@@ -129,7 +136,11 @@ void SpriteSheet::load(const nlohmann::json& j) {
 	}
 }
 
-std::shared_ptr<sf::Sprite> SpriteSheet::getSprite(const std::string& spriteName) {
+std::shared_ptr<const SpriteTemplate> SpriteSheet::getSpriteTemplate(const std::string& spriteName) {
+	auto cached = spriteTemplates.find(spriteName);
+	if (cached != spriteTemplates.end()) {
+		return cached->second;
+	}
 	if (spriteData.find(spriteName) == spriteData.end()) {
 		// Missing sprite
 		return nullptr;
@@ -137,17 +148,34 @@ std::shared_ptr<sf::Sprite> SpriteSheet::getSprite(const std::string& spriteName
 	std::shared_ptr<SpriteData> data = spriteData.at(spriteName);
 	ComparableIntRect area = data->getArea();
 
-	// Create sprite
-	std::shared_ptr<sf::Sprite> sprite = std::make_shared<sf::Sprite>();
-	sprite->setTexture(texture);
-	sprite->setTextureRect(area);
-	sprite->setColor(data->getColor());
-	sprite->setScale((float)data->getSpriteWidth() / area.width * globalSpriteScale, (float)data->getSpriteHeight() / area.height * globalSpriteScale);
-	sprite->setOrigin(data->getSpriteOriginX(), data->getSpriteOriginY());
-	return sprite;
+	// Create sprite template
+	const sf::Texture* spriteTexture = &texture;
+	sf::IntRect textureRect = area;
+	auto atlasRegion = atlasRegions.find(spriteName);
+	if (atlasRegion != atlasRegions.end()) {
+		spriteTexture = atlasRegion->second.first.get();
+		textureRect = atlasRegion->second.second;
+	}
+	sf::Vector2f scale((float)data->getSpriteWidth() / area.width * globalSpriteScale, (float)data->getSpriteHeight() / area.height * globalSpriteScale);
+	std::shared_ptr<const SpriteTemplate> spriteTemplate = std::make_shared<SpriteTemplate>(spriteTexture, textureRect, 
+		sf::Vector2f(data->getSpriteOriginX(), data->getSpriteOriginY()), scale, data->getColor());
+	spriteTemplates[spriteName] = spriteTemplate;
+	return spriteTemplate;
 }
 
-std::unique_ptr<Animation> SpriteSheet::getAnimation(const std::string& animationName, bool loop) {
+std::shared_ptr<sf::Sprite> SpriteSheet::getSprite(const std::string& spriteName) {
+	std::shared_ptr<const SpriteTemplate> spriteTemplate = getSpriteTemplate(spriteName);
+	if (!spriteTemplate) {
+		return nullptr;
+	}
+	return spriteTemplate->createSprite();
+}
+
+std::shared_ptr<const AnimationClip> SpriteSheet::getAnimationClip(const std::string& animationName) {
+	auto cached = animationClips.find(animationName);
+	if (cached != animationClips.end()) {
+		return cached->second;
+	}
 	if (animationData.find(animationName) == animationData.end()) {
 		// Missing animation
 		return nullptr;
@@ -155,15 +183,21 @@ std::unique_ptr<Animation> SpriteSheet::getAnimation(const std::string& animatio
 	std::shared_ptr<AnimationData> data = animationData.at(animationName);
 
 	// Animation has not been loaded yet
-	if (animationSprites.find(animationName) == animationSprites.end()) {
-		std::vector<std::pair<float, std::shared_ptr<sf::Sprite>>> sprites;
-		for (auto p : data->getSpriteInfo()) {
-			sprites.push_back(std::make_pair(p.first, getSprite(p.second)));
-		}
-		animationSprites[animationName] = sprites;
+	std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>> sprites;
+	for (auto p : data->getSpriteInfo()) {
+		sprites.push_back(std::make_pair(p.first, getSpriteTemplate(p.second)));
 	}
+	std::shared_ptr<const AnimationClip> clip = std::make_shared<AnimationClip>(animationName, sprites);
+	animationClips[animationName] = clip;
+	return clip;
+}
 
-	return std::make_unique<Animation>(animationName, animationSprites[animationName], loop);
+std::unique_ptr<Animation> SpriteSheet::getAnimation(const std::string& animationName, bool loop) {
+	std::shared_ptr<const AnimationClip> clip = getAnimationClip(animationName);
+	if (!clip) {
+		return nullptr;
+	}
+	return std::make_unique<Animation>(clip, loop);
 }
 
 std::shared_ptr<SpriteData> SpriteSheet::getSpriteData(std::string spriteName) const {
@@ -184,6 +218,7 @@ bool SpriteSheet::hasAnimationData(std::string animationName) const {
 
 void SpriteSheet::insertSprite(const std::string& spriteName, std::shared_ptr<SpriteData> sprite) {
 	spriteData[spriteName] = sprite;
+	spriteTemplates.erase(spriteName);
 }
 
 void SpriteSheet::insertAnimation(const std::string & animationName, std::shared_ptr<AnimationData> animation) {
@@ -193,13 +228,14 @@ void SpriteSheet::insertAnimation(const std::string & animationName, std::shared
 void SpriteSheet::deleteSprite(const std::string& spriteName) {
 	if (hasSpriteData(spriteName)) {
 		spriteData.erase(spriteName);
+		spriteTemplates.erase(spriteName);
 	}
 }
 
 void SpriteSheet::deleteAnimation(const std::string& animationName) {
 	if (hasAnimationData(animationName)) {
 		animationData.erase(animationName);
-		animationSprites.erase(animationName);
+		animationClips.erase(animationName);
 	}
 }
 
@@ -210,17 +246,32 @@ bool SpriteSheet::loadTexture(const std::string& spriteSheetFilePath) {
 	return true;
 }
 
+bool SpriteSheet::loadTexture(const sf::Image& image) {
+	return texture.loadFromImage(image);
+}
+
 void SpriteSheet::unloadAnimation(const std::string& animationName) {
-	animationSprites.erase(animationName);
+	animationClips.erase(animationName);
+}
+
+void SpriteSheet::setAtlasRegion(const std::string& spriteName, std::shared_ptr<sf::Texture> atlasTexture, sf::IntRect area) {
+	atlasRegions[spriteName] = std::make_pair(atlasTexture, area);
+	spriteTemplates.erase(spriteName);
+	// Loaded animations still use the old sprites
+	animationClips.clear();
+}
+
+void SpriteSheet::clearAtlasRegions() {
+	atlasRegions.clear();
+	spriteTemplates.clear();
+	animationClips.clear();
 }
 
 void SpriteSheet::setGlobalSpriteScale(float scale) {
 	globalSpriteScale = scale;
-	for (auto it = spriteData.begin(); it != spriteData.end(); it++) {
-		ComparableIntRect area = it->second->getArea();
-		getSprite(it->first)->setScale((float)it->second->getSpriteWidth() / area.width * globalSpriteScale, (float)it->second->getSpriteHeight() / area.height * globalSpriteScale);
-
-	}
+	// Sprites fetched afterwards are created with the new scale
+	spriteTemplates.clear();
+	animationClips.clear();
 }
 
 void SpriteSheet::markFailedImageLoad() {
@@ -242,6 +293,7 @@ void SpriteSheet::renameSprite(std::string oldSpriteName, std::string newSpriteN
 
 	std::shared_ptr<SpriteData> data = spriteData[oldSpriteName];
 	spriteData.erase(oldSpriteName);
+	spriteTemplates.erase(oldSpriteName);
 	data->setSpriteName(newSpriteName);
 	spriteData[newSpriteName] = data;
 }
@@ -403,30 +455,333 @@ void SpriteLoader::saveMetadataFiles() {
 }
 
 SpriteLoader::LoadMetrics SpriteLoader::loadFromSpriteSheetsFolder() {
-	spriteSheets.clear();
+	std::shared_future<LoadMetrics> loadMetrics = loadFromSpriteSheetsFolderAsync();
+	uploadDecodedSpriteSheets(true);
+	return loadMetrics.get();
+}
+
+SpriteLoader::LoadMetrics SpriteLoader::loadFromMetadata(const nlohmann::json& spriteSheetsMetadata) {
+	std::shared_future<LoadMetrics> loadMetrics = loadFromMetadataAsync(spriteSheetsMetadata);
+	uploadDecodedSpriteSheets(true);
+	return loadMetrics.get();
+}
 
-	LoadMetrics loadMetrics;
+std::shared_future<SpriteLoader::LoadMetrics> SpriteLoader::loadFromSpriteSheetsFolderAsync() {
+	std::shared_future<LoadMetrics> loadMetrics = beginAsyncLoad();
 
 	std::string spriteSheetsFolderPath = format(RELATIVE_LEVEL_PACK_SPRITE_SHEETS_FOLDER_PATH, levelPackName.c_str());
 	std::vector<std::pair<std::string, std::string>> spriteSheetPairs = findAllSpriteSheets(spriteSheetsFolderPath);
 	for (std::pair<std::string, std::string> pair : spriteSheetPairs) {
+		const std::string& spriteSheetImageFileName = pair.second;
 		if (pair.first.size() == 0) {
-			L_(linfo) << "Loading sprite sheet image file \"" << pair.second << "\" with no metafile";
+			L_(linfo) << "Loading sprite sheet image file \"" << spriteSheetImageFileName << "\" with no metafile";
 		} else {
-			L_(linfo) << "Loading sprite sheet image file \"" << pair.second << "\" with metafile \"" << pair.first << "\"";
+			L_(linfo) << "Loading sprite sheet image file \"" << spriteSheetImageFileName << "\" with metafile \"" << pair.first << "\"";
 		}
+		pendingLoadMetrics.spriteSheetsTotal++;
 
-		bool loadIsSuccessful = loadSpriteSheet(pair.first, pair.second);
-		if (!loadIsSuccessful) {
+		// Sprite sheet name is the name of the image file
+		std::shared_ptr<SpriteSheet> sheet = std::make_shared<SpriteSheet>(spriteSheetImageFileName);
+
+		// Make sure image file exists
+		if (!fileExists(formatPathToSpriteSheetImage(spriteSheetImageFileName))) {
+			L_(lerror) << "Image file \"" << spriteSheetImageFileName << "\" does not exist.";
+			L_(lerror) << "Failed to load sprite sheet";
+			pendingLoadMetrics.spriteSheetsFailed++;
+			continue;
+		}
+
+		std::ifstream metafile(format(RELATIVE_LEVEL_PACK_SPRITE_SHEETS_FOLDER_PATH + "\\%s", levelPackName.c_str(), pair.first.c_str()));
+		try {
+			if (metafile) {
+				// If metafile can be opened, load the SpriteSheet using it
+				nlohmann::json j;
+				metafile >> j;
+				sheet->load(j);
+			}
+			queueSpriteSheetImage(sheet);
+		} catch (const std::exception& ex) {
+			L_(lerror) << "Exception when loading image file \"" << spriteSheetImageFileName << "\": " << ex.what();
 			L_(lerror) << "Failed to load sprite sheet";
-			loadMetrics.spriteSheetsFailed++;
+
+			// If some exception occurred, mark the SpriteSheet as having a failed metafile load
+			sheet->markFailedMetafileLoad();
+			spriteSheets[spriteSheetImageFileName] = sheet;
+			pendingLoadMetrics.spriteSheetsFailed++;
+		}
+		metafile.close();
+	}
+
+	startDecodingImages();
+	completeAsyncLoadIfDone();
+	return loadMetrics;
+}
+
+std::shared_future<SpriteLoader::LoadMetrics> SpriteLoader::loadFromMetadataAsync(const nlohmann::json& spriteSheetsMetadata) {
+	std::shared_future<LoadMetrics> loadMetrics = beginAsyncLoad();
+
+	for (auto it = spriteSheetsMetadata.begin(); it != spriteSheetsMetadata.end(); it++) {
+		const std::string& spriteSheetImageFileName = it.key();
+		pendingLoadMetrics.spriteSheetsTotal++;
+
+		if (!fileExists(formatPathToSpriteSheetImage(spriteSheetImageFileName))) {
+			L_(lerror) << "Image file \"" << spriteSheetImageFileName << "\" does not exist.";
+			pendingLoadMetrics.spriteSheetsFailed++;
+			continue;
+		}
+
+		std::shared_ptr<SpriteSheet> sheet = std::make_shared<SpriteSheet>(spriteSheetImageFileName);
+		try {
+			sheet->load(it.value());
+			queueSpriteSheetImage(sheet);
+		} catch (const std::exception& ex) {
+			L_(lerror) << "Exception when loading image file \"" << spriteSheetImageFileName << "\": " << ex.what();
+			sheet->markFailedMetafileLoad();
+			spriteSheets[spriteSheetImageFileName] = sheet;
+			pendingLoadMetrics.spriteSheetsFailed++;
 		}
-		loadMetrics.spriteSheetsTotal++;
 	}
 
+	startDecodingImages();
+	completeAsyncLoadIfDone();
 	return loadMetrics;
 }
 
+int SpriteLoader::uploadDecodedSpriteSheets(bool wait) {
+	for (auto it = pendingSpriteSheets.begin(); it != pendingSpriteSheets.end();) {
+		if (!wait && it->decodedImage.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			it++;
+			continue;
+		}
+		finishLoadingSpriteSheet(*it);
+		it = pendingSpriteSheets.erase(it);
+	}
+	completeAsyncLoadIfDone();
+	return pendingSpriteSheets.size();
+}
+
+void SpriteLoader::waitForSpriteSheet(const std::string& spriteSheetName) {
+	for (auto it = pendingSpriteSheets.begin(); it != pendingSpriteSheets.end(); it++) {
+		if (it->sheet->getName() == spriteSheetName) {
+			finishLoadingSpriteSheet(*it);
+			pendingSpriteSheets.erase(it);
+			completeAsyncLoadIfDone();
+			return;
+		}
+	}
+}
+
+std::shared_future<SpriteLoader::LoadMetrics> SpriteLoader::beginAsyncLoad() {
+	uploadDecodedSpriteSheets(true);
+
+	spriteSheets.clear();
+	pendingLoadMetrics = LoadMetrics();
+	pendingLoadPromise = std::make_shared<std::promise<LoadMetrics>>();
+	return pendingLoadPromise->get_future().share();
+}
+
+void SpriteLoader::queueSpriteSheetImage(std::shared_ptr<SpriteSheet> sheet) {
+	std::shared_ptr<std::promise<DecodedImage>> decodedImage = std::make_shared<std::promise<DecodedImage>>();
+	queuedImages.push_back(std::make_pair(formatPathToSpriteSheetImage(sheet->getName()), decodedImage));
+	pendingSpriteSheets.push_back(PendingSpriteSheet{ sheet, decodedImage->get_future() });
+	spriteSheets[sheet->getName()] = sheet;
+}
+
+void SpriteLoader::startDecodingImages() {
+	if (queuedImages.empty()) {
+		return;
+	}
+
+	// The worker threads only touch their own copy of the queue, so the SpriteLoader can be changed while they run
+	std::vector<std::pair<std::string, std::shared_ptr<std::promise<DecodedImage>>>> images;
+	images.swap(queuedImages);
+	decodeTask = std::async(std::launch::async, [images]() {
+		parallelFor(images.size(), [&images](std::size_t i) {
+			auto start = std::chrono::steady_clock::now();
+			DecodedImage decoded;
+			std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+			if (image->loadFromFile(images[i].first)) {
+				decoded.image = image;
+			}
+			decoded.decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			images[i].second->set_value(decoded);
+		});
+	});
+}
+
+void SpriteLoader::finishLoadingSpriteSheet(PendingSpriteSheet& pending) {
+	DecodedImage decoded = pending.decodedImage.get();
+	const std::string& spriteSheetImageFileName = pending.sheet->getName();
+	SpriteSheetLoadTimes& loadTimes = pendingLoadMetrics.spriteSheetLoadTimes[spriteSheetImageFileName];
+	loadTimes.decodeSeconds = decoded.decodeSeconds;
+	Profiler::addTime("Sprite sheet decode", decoded.decodeSeconds);
+
+	auto start = std::chrono::steady_clock::now();
+	if (!decoded.image || !pending.sheet->loadTexture(*decoded.image)) {
+		L_(lerror) << "Image file \"" << spriteSheetImageFileName << "\" failed to load.";
+
+		// If image couldn't be loaded, mark the SpriteSheet as having a failed image load
+		pending.sheet->markFailedImageLoad();
+		return;
+	}
+	loadTimes.uploadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	Profiler::addTime("Sprite sheet upload", loadTimes.uploadSeconds);
+	L_(ldebug) << "Sprite sheet \"" << spriteSheetImageFileName << "\" decoded in " << loadTimes.decodeSeconds << "s and uploaded in "
+		<< loadTimes.uploadSeconds << "s";
+}
+
+void SpriteLoader::completeAsyncLoadIfDone() {
+	if (pendingLoadPromise && pendingSpriteSheets.empty()) {
+		pendingLoadPromise->set_value(pendingLoadMetrics);
+		pendingLoadPromise = nullptr;
+	}
+}
+
+SpriteLoader::AtlasMetrics SpriteLoader::buildAtlases(const std::vector<Animatable>& animatables) {
+	auto start = std::chrono::steady_clock::now();
+	AtlasMetrics atlasMetrics;
+	clearAtlases();
+
+	// Find every sprite that has to be packed, grouped by sprite sheet
+	std::map<std::string, std::set<std::string>> spriteNames;
+	for (const Animatable& animatable : animatables) {
+		auto it = spriteSheets.find(animatable.getSpriteSheetName());
+		if (animatable.getAnimatableName() == "" || it == spriteSheets.end()) {
+			continue;
+		}
+		if (animatable.isSprite()) {
+			spriteNames[it->first].insert(animatable.getAnimatableName());
+		} else if (it->second->hasAnimationData(animatable.getAnimatableName())) {
+			for (std::pair<float, std::string> spriteInfo : it->second->getAnimationData(animatable.getAnimatableName())->getSpriteInfo()) {
+				spriteNames[it->first].insert(spriteInfo.second);
+			}
+		}
+	}
+
+	struct Frame {
+		std::shared_ptr<SpriteSheet> sheet;
+		std::string spriteName;
+		sf::IntRect area;
+		// Index into images
+		int imageIndex;
+	};
+	std::vector<sf::Image> images;
+	std::vector<Frame> frames;
+	for (const std::pair<std::string, std::set<std::string>>& sheetSpriteNames : spriteNames) {
+		waitForSpriteSheet(sheetSpriteNames.first);
+		std::shared_ptr<SpriteSheet> sheet = spriteSheets[sheetSpriteNames.first];
+		if (sheet->isFailedImageLoad()) {
+			continue;
+		}
+
+		// The decoded image isn't kept after it is uploaded, so read it back
+		images.push_back(sheet->getTexture()->copyToImage());
+		sf::Vector2u imageSize = images.back().getSize();
+		for (const std::string& spriteName : sheetSpriteNames.second) {
+			std::shared_ptr<SpriteData> data = sheet->getSpriteData(spriteName);
+			if (!data) {
+				continue;
+			}
+			sf::IntRect area = data->getArea();
+			if (area.left < 0 || area.top < 0 || area.width <= 0 || area.height <= 0
+				|| area.left + area.width > (int)imageSize.x || area.top + area.height > (int)imageSize.y
+				|| area.width + ATLAS_PADDING * 2 > ATLAS_SIZE || area.height + ATLAS_PADDING * 2 > ATLAS_SIZE) {
+
+				atlasMetrics.spritesSkipped++;
+				continue;
+			}
+			frames.push_back(Frame{ sheet, spriteName, area, (int)images.size() - 1 });
+		}
+	}
+	if (frames.empty()) {
+		return atlasMetrics;
+	}
+
+	// Packing the tallest sprites first leaves fewer gaps under the skyline
+	std::sort(frames.begin(), frames.end(), [](const Frame& a, const Frame& b) {
+		return a.area.height == b.area.height ? a.area.width > b.area.width : a.area.height > b.area.height;
+	});
+
+	int atlasSize = std::min(ATLAS_SIZE, (int)sf::Texture::getMaximumSize());
+	std::vector<SkylinePacker> packers;
+	std::vector<sf::Image> atlasImages;
+	std::vector<std::pair<int, sf::IntRect>> frameAtlasAreas;
+	long long spritesArea = 0;
+	for (const Frame& frame : frames) {
+		int x = 0, y = 0;
+		int atlasIndex = 0;
+		while (atlasIndex < packers.size() && !packers[atlasIndex].insert(frame.area.width + ATLAS_PADDING * 2, frame.area.height + ATLAS_PADDING * 2, x, y)) {
+			atlasIndex++;
+		}
+		if (atlasIndex == packers.size()) {
+			packers.push_back(SkylinePacker(atlasSize, atlasSize));
+			atlasImages.push_back(sf::Image());
+			atlasImages.back().create(atlasSize, atlasSize, sf::Color::Transparent);
+			if (!packers.back().insert(frame.area.width + ATLAS_PADDING * 2, frame.area.height + ATLAS_PADDING * 2, x, y)) {
+				// Only possible if the graphics card's maximum texture size is smaller than ATLAS_SIZE
+				packers.pop_back();
+				atlasImages.pop_back();
+				frameAtlasAreas.push_back(std::make_pair(-1, sf::IntRect()));
+				atlasMetrics.spritesSkipped++;
+				continue;
+			}
+		}
+
+		// Copy the sprite, then repeat its edge pixels into the padding around it
+		sf::Image& atlasImage = atlasImages[atlasIndex];
+		const sf::Image& image = images[frame.imageIndex];
+		int left = x + ATLAS_PADDING;
+		int top = y + ATLAS_PADDING;
+		atlasImage.copy(image, left, top, frame.area);
+		for (int dy = -ATLAS_EXTRUSION; dy < frame.area.height + ATLAS_EXTRUSION; dy++) {
+			for (int dx = -ATLAS_EXTRUSION; dx < frame.area.width + ATLAS_EXTRUSION; dx++) {
+				if (dx >= 0 && dx < frame.area.width && dy >= 0 && dy < frame.area.height) {
+					continue;
+				}
+				int sourceX = frame.area.left + std::max(0, std::min(dx, frame.area.width - 1));
+				int sourceY = frame.area.top + std::max(0, std::min(dy, frame.area.height - 1));
+				atlasImage.setPixel(left + dx, top + dy, image.getPixel(sourceX, sourceY));
+			}
+		}
+		frameAtlasAreas.push_back(std::make_pair(atlasIndex, sf::IntRect(left, top, frame.area.width, frame.area.height)));
+		spritesArea += (long long)frame.area.width * frame.area.height;
+	}
+
+	for (const sf::Image& atlasImage : atlasImages) {
+		std::shared_ptr<sf::Texture> atlasTexture = std::make_shared<sf::Texture>();
+		if (!atlasTexture->loadFromImage(atlasImage)) {
+			L_(lerror) << "Failed to create a texture atlas; sprites will be drawn from their sprite sheets";
+			clearAtlases();
+			return AtlasMetrics();
+		}
+		atlasTextures.push_back(atlasTexture);
+	}
+	for (int i = 0; i < frames.size(); i++) {
+		if (frameAtlasAreas[i].first >= 0) {
+			frames[i].sheet->setAtlasRegion(frames[i].spriteName, atlasTextures[frameAtlasAreas[i].first], frameAtlasAreas[i].second);
+			atlasMetrics.spritesPacked++;
+		}
+	}
+
+	atlasMetrics.atlasesCount = atlasTextures.size();
+	if (atlasMetrics.atlasesCount > 0) {
+		atlasMetrics.occupancy = (float)((double)spritesArea / ((long long)atlasSize * atlasSize * atlasMetrics.atlasesCount));
+	}
+	atlasMetrics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	L_(linfo) << "Packed " << atlasMetrics.spritesPacked << " sprites into " << atlasMetrics.atlasesCount << " texture atlases with "
+		<< (atlasMetrics.occupancy * 100) << "% occupancy in " << atlasMetrics.seconds << "s; " << atlasMetrics.spritesSkipped << " sprites skipped";
+	Profiler::setGauge("Texture atlas occupancy", atlasMetrics.occupancy);
+	Profiler::addTime("Texture atlas build", atlasMetrics.seconds);
+	return atlasMetrics;
+}
+
+void SpriteLoader::clearAtlases() {
+	for (std::pair<std::string, std::shared_ptr<SpriteSheet>> spriteSheet : spriteSheets) {
+		spriteSheet.second->clearAtlasRegions();
+	}
+	atlasTextures.clear();
+}
+
 std::shared_ptr<sf::Texture> SpriteLoader::getGuiElementTexture(const std::string& guiElementFileName) {
 	std::string filePath = format(RELATIVE_LEVEL_PACK_GUI_FOLDER_PATH + "\\%s", levelPackName.c_str(), guiElementFileName.c_str());
 	if (!fileExists(filePath)) {
@@ -454,6 +809,20 @@ std::shared_ptr<sf::Texture> SpriteLoader::getGuiElementTexture(const std::strin
 	return guiElement;
 }
 
+std::shared_ptr<const SpriteTemplate> SpriteLoader::getSpriteTemplate(const std::string& spriteName, const std::string& spriteSheetName) {
+	auto spriteSheet = spriteSheets.find(spriteSheetName);
+	if (spriteSheet == spriteSheets.end()) {
+		// Missing sprite sheet
+		return getMissingSpriteTemplate();
+	}
+	std::shared_ptr<const SpriteTemplate> spriteTemplate = spriteSheet->second->getSpriteTemplate(spriteName);
+	if (spriteTemplate) {
+		return spriteTemplate;
+	} else {
+		return getMissingSpriteTemplate();
+	}
+}
+
 std::shared_ptr<sf::Sprite> SpriteLoader::getSprite(const std::string& spriteName, const std::string& spriteSheetName) {
 	if (spriteSheets.find(spriteSheetName) == spriteSheets.end()) {
 		// Missing sprite sheet
@@ -467,6 +836,15 @@ std::shared_ptr<sf::Sprite> SpriteLoader::getSprite(const std::string& spriteNam
 	}
 }
 
+std::shared_ptr<const AnimationClip> SpriteLoader::getAnimationClip(const std::string& animationName, const std::string& spriteSheetName) {
+	auto spriteSheet = spriteSheets.find(spriteSheetName);
+	if (spriteSheet == spriteSheets.end()) {
+		// Missing sprite sheet
+		return nullptr;
+	}
+	return spriteSheet->second->getAnimationClip(animationName);
+}
+
 std::unique_ptr<Animation> SpriteLoader::getAnimation(const std::string & animationName, const std::string & spriteSheetName, bool loop) {
 	if (spriteSheets.find(spriteSheetName) == spriteSheets.end()) {
 		// Missing sprite sheet
@@ -518,6 +896,15 @@ const std::shared_ptr<sf::Sprite> SpriteLoader::getMissingSprite() {
 	return sprite;
 }
 
+std::shared_ptr<const SpriteTemplate> SpriteLoader::getMissingSpriteTemplate() {
+	if (!missingSpriteTemplate) {
+		// Same as getMissingSprite()
+		missingSpriteTemplate = std::make_shared<SpriteTemplate>(missingSpriteTexture.get(), missingSprite->getTextureRect(), sf::Vector2f(1, 1), 
+			sf::Vector2f(50.0f * globalSpriteScale, 50.0f * globalSpriteScale), missingSprite->getColor());
+	}
+	return missingSpriteTemplate;
+}
+
 bool SpriteLoader::loadSpriteSheet(const std::string& spriteSheetName) {
 	std::string spriteSheetMetafileName = spriteSheetName + LEVEL_PACK_SERIALIZED_DATA_FORMAT;
 	return loadSpriteSheet(spriteSheetMetafileName, spriteSheetName);
@@ -537,6 +924,7 @@ void SpriteLoader::updateSpriteSheet(std::shared_ptr<SpriteSheet> spriteSheet) {
 
 void SpriteLoader::setGlobalSpriteScale(float scale) {
 	this->globalSpriteScale = scale;
+	missingSpriteTemplate = nullptr;
 	for (auto it = spriteSheets.begin(); it != spriteSheets.end(); it++) {
 		it->second->setGlobalSpriteScale(scale);
 	}
@@ -0,0 +1,17 @@
+#include <DataStructs/SpriteTemplate.h>
+
+SpriteTemplate::SpriteTemplate(const sf::Texture* texture, sf::IntRect textureRect, sf::Vector2f origin, sf::Vector2f scale, sf::Color color)
+	: texture(texture), textureRect(textureRect), origin(origin), scale(scale), color(color) {
+}
+
+std::shared_ptr<sf::Sprite> SpriteTemplate::createSprite() const {
+	std::shared_ptr<sf::Sprite> sprite = std::make_shared<sf::Sprite>();
+	if (texture) {
+		sprite->setTexture(*texture);
+	}
+	sprite->setTextureRect(textureRect);
+	sprite->setOrigin(origin);
+	sprite->setScale(scale);
+	sprite->setColor(color);
+	return sprite;
+}
@@ -1,8 +1,109 @@
 #include <DataStructs/SymbolTable.h>
 
+#include <algorithm>
+#include <cstring>
+
+std::mutex SymbolInterner::mutex;
+std::unordered_map<std::string, SymbolID> SymbolInterner::ids;
+
+thread_local std::map<std::vector<std::pair<SymbolID, uint32_t>>, exprtk::symbol_table<float>> ExprtkSymbolTableCache::cache;
+
+namespace {
+	/*
+	Returns the index of the symbol with some SymbolID in ids, or -1 if it doesn't exist.
+	*/
+	int indexOfID(const std::vector<SymbolID>& ids, SymbolID id) {
+		if (id < 0) {
+			return -1;
+		}
+		// Symbol tables are small, so a linear scan over ints beats anything fancier
+		for (int i = 0; i < ids.size(); i++) {
+			if (ids[i] == id) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/*
+	Sets the definition of some symbol in a flat symbol table, keeping it sorted by symbol name.
+	*/
+	template<typename Definition>
+	void setSorted(std::vector<std::pair<std::string, Definition>>& symbols, std::vector<SymbolID>& ids, const std::string& symbol, const Definition& definition) {
+		SymbolID id = SymbolInterner::intern(symbol);
+		int index = indexOfID(ids, id);
+		if (index != -1) {
+			symbols[index].second = definition;
+			return;
+		}
+		auto it = std::lower_bound(symbols.begin(), symbols.end(), symbol, [](const std::pair<std::string, Definition>& a, const std::string& b) {
+			return a.first < b;
+		});
+		int insertIndex = it - symbols.begin();
+		symbols.insert(it, std::make_pair(symbol, definition));
+		ids.insert(ids.begin() + insertIndex, id);
+	}
+
+	/*
+	Removes some symbol from a flat symbol table.
+	*/
+	template<typename Definition>
+	void removeSorted(std::vector<std::pair<std::string, Definition>>& symbols, std::vector<SymbolID>& ids, const std::string& symbol) {
+		int index = indexOfID(ids, SymbolInterner::find(symbol));
+		if (index != -1) {
+			symbols.erase(symbols.begin() + index);
+			ids.erase(ids.begin() + index);
+		}
+	}
+}
+
+SymbolID SymbolInterner::intern(const std::string& symbol) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = ids.find(symbol);
+	if (it != ids.end()) {
+		return it->second;
+	}
+	SymbolID id = ids.size();
+	ids[symbol] = id;
+	return id;
+}
+
+SymbolID SymbolInterner::find(const std::string& symbol) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = ids.find(symbol);
+	return it == ids.end() ? -1 : it->second;
+}
+
+exprtk::symbol_table<float> ExprtkSymbolTableCache::get(const std::vector<Binding>& bindings) {
+	std::vector<std::pair<SymbolID, uint32_t>> key;
+	key.reserve(bindings.size());
+	for (const Binding& binding : bindings) {
+		uint32_t bits;
+		std::memcpy(&bits, &binding.value, sizeof(bits));
+		key.push_back(std::make_pair(binding.id, bits));
+	}
+
+	auto it = cache.find(key);
+	if (it != cache.end()) {
+		return it->second;
+	}
+
+	exprtk::symbol_table<float> table;
+	for (const Binding& binding : bindings) {
+		// add_constant takes a non-const reference but copies the value
+		float value = binding.value;
+		table.add_constant(binding.symbol, value);
+	}
+	if (cache.size() >= MAX_CACHED_SYMBOL_TABLES) {
+		cache.clear();
+	}
+	cache[key] = table;
+	return table;
+}
+
 std::string ExprSymbolTable::format() const {
     std::string res;
-    for (auto it = map.begin(); it != map.end(); it++) {
+    for (auto it = symbols.begin(); it != symbols.end(); it++) {
         res += formatString(it->first) + formatString(it->second.expressionStr);
     }
     return res;
@@ -10,16 +111,17 @@ std::string ExprSymbolTable::format() const {
 
 void ExprSymbolTable::load(std::string formattedString) {
     auto items = split(formattedString, TextMarshallable::DELIMITER);
-    map.clear();
+    symbols.clear();
+    ids.clear();
     for (int i = 0; i < items.size(); i += 2) {
-        map[items.at(i)] = { items.at(i + 1) };
+        setSymbol(items.at(i), items.at(i + 1));
     }
 }
 
 nlohmann::json ExprSymbolTable::toJson() {
     nlohmann::json j;
 
-    for (auto it = map.begin(); it != map.end(); it++) {
+    for (auto it = symbols.begin(); it != symbols.end(); it++) {
         j[it->first] = it->second.expressionStr;
     }
 
@@ -27,70 +129,66 @@ nlohmann::json ExprSymbolTable::toJson() {
 }
 
 void ExprSymbolTable::load(const nlohmann::json& j) {
-    map.clear();
+    symbols.clear();
+    ids.clear();
     for (auto item : j.items()) {
-        map[item.key()] = { item.value() };
+        setSymbol(item.key(), item.value());
     }
 }
 
 void ExprSymbolTable::setSymbol(std::string symbol, std::string expressionStr) {
-    map[symbol] = { expressionStr };
+    setSorted(symbols, ids, symbol, ExprSymbolDefinition{ expressionStr });
 }
 
 void ExprSymbolTable::removeSymbol(std::string symbol) {
-    map.erase(symbol);
+    removeSorted(symbols, ids, symbol);
 }
 
-exprtk::symbol_table<float> ExprSymbolTable::toLowerLevelSymbolTable(std::vector<exprtk::symbol_table<float>> higherLevelSymbolTables) {
-    exprtk::expression<float> expression = exprtk::expression<float>();
-    for (int i = higherLevelSymbolTables.size() - 1; i >= 0; i--) {
-        expression.register_symbol_table(higherLevelSymbolTables[i]);
-    }
-
-    exprtk::parser<float> parser;
-    exprtk::symbol_table<float> table;
-    for (auto it = map.begin(); it != map.end(); it++) {
-        parser.compile(it->second.expressionStr, expression);
-        float value = expression.value();
-        table.add_constant(it->first, value);
-    }
-    return std::move(table);
+exprtk::symbol_table<float> ExprSymbolTable::toLowerLevelSymbolTable(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) const {
+    ExpressionCompiler compiler(higherLevelSymbolTables);
+    return toLowerLevelSymbolTable(compiler);
 }
 
-exprtk::symbol_table<float> ExprSymbolTable::toLowerLevelSymbolTable(exprtk::expression<float> expression) {
-    exprtk::parser<float> parser;
-    exprtk::symbol_table<float> table;
-    for (auto it = map.begin(); it != map.end(); it++) {
-        parser.compile(it->second.expressionStr, expression);
-        float value = expression.value();
-        table.add_constant(it->first, value);
+exprtk::symbol_table<float> ExprSymbolTable::toLowerLevelSymbolTable(ExpressionCompiler& compiler) const {
+    std::vector<ExprtkSymbolTableCache::Binding> bindings;
+    bindings.reserve(symbols.size());
+    for (int i = 0; i < symbols.size(); i++) {
+        bindings.push_back({ symbols[i].first, ids[i], compiler.evaluate(symbols[i].second.expressionStr) });
     }
-    return table;
+    return ExprtkSymbolTableCache::get(bindings);
 }
 
-std::map<std::string, ExprSymbolDefinition>::const_iterator ExprSymbolTable::getIteratorBegin() {
-    return map.begin();
+std::vector<std::pair<std::string, ExprSymbolDefinition>>::const_iterator ExprSymbolTable::getIteratorBegin() {
+    return symbols.begin();
 }
 
-std::map<std::string, ExprSymbolDefinition>::const_iterator ExprSymbolTable::getIteratorEnd() {
-    return map.end();
+std::vector<std::pair<std::string, ExprSymbolDefinition>>::const_iterator ExprSymbolTable::getIteratorEnd() {
+    return symbols.end();
 }
 
 ExprSymbolDefinition ExprSymbolTable::getSymbolDefinition(std::string symbol) const {
-    return map.at(symbol);
+    int index = indexOf(symbol);
+    if (index == -1) {
+        throw std::out_of_range("Symbol \"" + symbol + "\" does not exist");
+    }
+    return symbols[index].second;
 }
 
 bool ExprSymbolTable::hasSymbol(std::string symbol) const {
-    return map.find(symbol) != map.end();
+    return indexOf(symbol) != -1;
 }
 
 bool ExprSymbolTable::isEmpty() const {
-    return map.size() == 0;
+    return symbols.empty();
+}
+
+int ExprSymbolTable::indexOf(const std::string& symbol) const {
+    return indexOfID(ids, SymbolInterner::find(symbol));
 }
 
 std::string ValueSymbolTable::format() const {
     std::string res;
-    for (auto it = map.begin(); it != map.end(); it++) {
+    for (auto it = symbols.begin(); it != symbols.end(); it++) {
         res += formatString(it->first) + tos(it->second.value) + formatBool(it->second.redelegated);
     }
     return res;
@@ -98,16 +196,17 @@ std::string ValueSymbolTable::format() const {
 
 void ValueSymbolTable::load(std::string formattedString) {
     auto items = split(formattedString, TextMarshallable::DELIMITER);
-    map.clear();
+    symbols.clear();
+    ids.clear();
     for (int i = 0; i < items.size(); i += 3) {
-        map[items.at(i)] = { std::stof(items.at(i + 1)), unformatBool(items.at(i + 2)) };
+        setSymbol(items.at(i), std::stof(items.at(i + 1)), unformatBool(items.at(i + 2)));
     }
 }
 
 nlohmann::json ValueSymbolTable::toJson() {
     nlohmann::json j;
 
-    for (auto it = map.begin(); it != map.end(); it++) {
+    for (auto it = symbols.begin(); it != symbols.end(); it++) {
         j[it->first] = nlohmann::json{ {"value", it->second.value}, {"redelegated", it->second.redelegated} };
     }
 
@@ -115,7 +214,8 @@ nlohmann::json ValueSymbolTable::toJson() {
 }
 
 void ValueSymbolTable::load(const nlohmann::json& j) {
-    map.clear();
+    symbols.clear();
+    ids.clear();
     for (auto item : j.items()) {
         float value;
         bool redelegated;
@@ -123,61 +223,60 @@ void ValueSymbolTable::load(const nlohmann::json& j) {
         item.value().at("value").get_to(value);
         item.value().at("redelegated").get_to(redelegated);
 
-        map[item.key()] = { value, redelegated };
+        setSymbol(item.key(), value, redelegated);
     }
 }
 
 void ValueSymbolTable::setSymbol(std::string symbol, float value, bool redelegated) {
-    map[symbol] = { value, redelegated };
+    setSorted(symbols, ids, symbol, ValueSymbolDefinition{ value, redelegated });
 }
 
 void ValueSymbolTable::removeSymbol(std::string symbol) {
-    map.erase(symbol);
+    removeSorted(symbols, ids, symbol);
 }
 
 exprtk::symbol_table<float> ValueSymbolTable::toExprtkSymbolTable() const {
-    exprtk::symbol_table<float> table;
-    for (auto it = map.begin(); it != map.end(); it++) {
-        // Add as constants so that the symbol_table is still valid even after the floats go out of scope
-
-        if (!it->second.redelegated) {
-            table.add_constant(it->first, it->second.value);
+    std::vector<ExprtkSymbolTableCache::Binding> bindings;
+    for (int i = 0; i < symbols.size(); i++) {
+        if (!symbols[i].second.redelegated) {
+            bindings.push_back({ symbols[i].first, ids[i], symbols[i].second.value });
         }
     }
-    return table;
+    return ExprtkSymbolTableCache::get(bindings);
 }
 
 exprtk::symbol_table<float> ValueSymbolTable::toZeroFilledSymbolTable() const {
-    exprtk::symbol_table<float> table;
-    for (auto it = map.begin(); it != map.end(); it++) {
-        // Add as constants so that the symbol_table is still valid even after the floats go out of scope
-
-        if (it->second.redelegated) {
-            float zero = 0;
-            table.add_constant(it->first, zero);
-        } else {
-            table.add_constant(it->first, it->second.value);
-        }
+    std::vector<ExprtkSymbolTableCache::Binding> bindings;
+    for (int i = 0; i < symbols.size(); i++) {
+        bindings.push_back({ symbols[i].first, ids[i], symbols[i].second.redelegated ? 0 : symbols[i].second.value });
     }
-    return table;
+    return ExprtkSymbolTableCache::get(bindings);
 }
 
-std::map<std::string, ValueSymbolDefinition>::const_iterator ValueSymbolTable::getIteratorBegin() {
-    return map.begin();
+std::vector<std::pair<std::string, ValueSymbolDefinition>>::const_iterator ValueSymbolTable::getIteratorBegin() {
+    return symbols.begin();
 }
 
-std::map<std::string, ValueSymbolDefinition>::const_iterator ValueSymbolTable::getIteratorEnd() {
-    return map.end();
+std::vector<std::pair<std::string, ValueSymbolDefinition>>::const_iterator ValueSymbolTable::getIteratorEnd() {
+    return symbols.end();
 }
 
 ValueSymbolDefinition ValueSymbolTable::getSymbolDefinition(std::string symbol) const {
-    return map.at(symbol);
+    int index = indexOf(symbol);
+    if (index == -1) {
+        throw std::out_of_range("Symbol \"" + symbol + "\" does not exist");
+    }
+    return symbols[index].second;
 }
 
 bool ValueSymbolTable::hasSymbol(std::string symbol) const {
-    return map.find(symbol) != map.end();
+    return indexOf(symbol) != -1;
 }
 
 bool ValueSymbolTable::isEmpty() const {
-    return map.size() == 0;
+    return symbols.empty();
+}
+
+int ValueSymbolTable::indexOf(const std::string& symbol) const {
+    return indexOfID(ids, SymbolInterner::find(symbol));
 }
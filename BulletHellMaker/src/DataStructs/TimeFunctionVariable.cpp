@@ -2,6 +2,37 @@
 
 #include <Game/Components/HitboxComponent.h>
 #include <Game/Components/PositionComponent.h>
+#include <LevelPack/ExpressionCompiler.h>
+#include <Util/Logger.h>
+
+void ExpressionTFVBatch::run() {
+	// Group entries by ExpressionTFV, with each group's times in ascending order
+	std::sort(entries.begin(), entries.end());
+
+	int i = 0;
+	while (i < entries.size()) {
+		ExpressionTFV* tfv = entries[i].first;
+		times.clear();
+		for (; i < entries.size() && entries[i].first == tfv; i++) {
+			// Entities spawned together are usually at the same time, so each time only needs to be evaluated once
+			if (times.empty() || times.back() != entries[i].second) {
+				times.push_back(entries[i].second);
+			}
+		}
+		results.resize(times.size());
+		tfv->evaluateBatch(times.data(), results.data(), times.size());
+		tfv->setBatchResults(times.data(), results.data(), times.size());
+		evaluatedTFVs.push_back(tfv);
+	}
+}
+
+void ExpressionTFVBatch::clear() {
+	for (ExpressionTFV* tfv : evaluatedTFVs) {
+		tfv->clearBatchResults();
+	}
+	evaluatedTFVs.clear();
+	entries.clear();
+}
 
 TFV::TFV() {
 }
@@ -654,6 +685,175 @@ void PiecewiseTFV::recalculateMaxTimes(float totalLifespan) {
 	}
 }
 
+int PiecewiseTFV::getSegmentIndex(float time) const {
+	if (segments.size() == 0) {
+		return -1;
+	}
+
+	int l = 0;
+	int h = segments.size(); // Not n - 1
+	while (l < h) {
+		int mid = (l + h) / 2;
+		if (time <= segments[mid].first) {
+			h = mid;
+		} else {
+			l = mid + 1;
+		}
+	}
+
+	int i;
+	for (i = std::max(0, l - 1); i < segments.size(); i++) {
+		if (i >= 0 && time < segments[i].first) {
+			i--;
+			break;
+		}
+	}
+	return std::min(i, (int)segments.size() - 1);
+}
+
+void PiecewiseTFV::addToExpressionBatch(ExpressionTFVBatch& batch, float time) {
+	int i = getSegmentIndex(time);
+	if (i != -1) {
+		segments[i].second->addToExpressionBatch(batch, time - segments[i].first);
+	}
+}
+
+void PiecewiseTFV::bindSymbols(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
+	for (auto& segment : segments) {
+		segment.second->bindSymbols(symbolTables);
+	}
+}
+
+ExpressionTFV::ExpressionTFV() {
+}
+
+ExpressionTFV::ExpressionTFV(std::string expressionStr, float maxTime)
+	: TFV(maxTime), expressionStr(expressionStr) {
+}
+
+ExpressionTFV::ExpressionTFV(const ExpressionTFV& copy)
+	: TFV(copy.maxTime), expressionStr(copy.expressionStr), boundSymbolTables(copy.boundSymbolTables) {
+	if (copy.compiled) {
+		compile();
+	}
+}
+
+ExpressionTFV& ExpressionTFV::operator=(const ExpressionTFV& other) {
+	if (this == &other) {
+		return *this;
+	}
+	maxTime = other.maxTime;
+	expressionStr = other.expressionStr;
+	boundSymbolTables = other.boundSymbolTables;
+	batchResults.clear();
+	compiled = false;
+	if (other.compiled) {
+		compile();
+	}
+	return *this;
+}
+
+std::shared_ptr<TFV> ExpressionTFV::clone() {
+	return std::make_shared<ExpressionTFV>(*this);
+}
+
+std::string ExpressionTFV::format() const {
+	return formatString("ExpressionTFV") + formatString(expressionStr) + tos(maxTime);
+}
+
+void ExpressionTFV::load(std::string formattedString) {
+	auto items = split(formattedString, TextMarshallable::DELIMITER);
+	setExpressionStr(items.at(1));
+	maxTime = std::stof(items.at(2));
+}
+
+nlohmann::json ExpressionTFV::toJson() {
+	return {
+		{"className", "ExpressionTFV"},
+		{"maxTime", maxTime},
+		{"expression", expressionStr}
+	};
+}
+
+void ExpressionTFV::load(const nlohmann::json& j) {
+	j.at("maxTime").get_to(maxTime);
+	std::string newExpressionStr;
+	j.at("expression").get_to(newExpressionStr);
+	setExpressionStr(newExpressionStr);
+}
+
+float ExpressionTFV::evaluate(float time) {
+	if (!batchResults.empty()) {
+		auto it = std::lower_bound(batchResults.begin(), batchResults.end(), time, [](const std::pair<float, float>& a, float b) {
+			return a.first < b;
+		});
+		if (it != batchResults.end() && it->first == time) {
+			return it->second;
+		}
+	}
+
+	if (!compiled) {
+		compile();
+	}
+	t = time;
+	return expression.value();
+}
+
+void ExpressionTFV::evaluateBatch(const float* times, float* results, int count) {
+	if (!compiled) {
+		compile();
+	}
+	for (int i = 0; i < count; i++) {
+		t = times[i];
+		results[i] = expression.value();
+	}
+}
+
+void ExpressionTFV::bindSymbols(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
+	boundSymbolTables = symbolTables;
+	compiled = false;
+	batchResults.clear();
+}
+
+void ExpressionTFV::setBatchResults(const float* times, const float* results, int count) {
+	batchResults.clear();
+	for (int i = 0; i < count; i++) {
+		batchResults.push_back(std::make_pair(times[i], results[i]));
+	}
+}
+
+void ExpressionTFV::clearBatchResults() {
+	batchResults.clear();
+}
+
+void ExpressionTFV::setExpressionStr(std::string expressionStr) {
+	this->expressionStr = expressionStr;
+	compiled = false;
+	batchResults.clear();
+}
+
+bool ExpressionTFV::operator==(const TFV& other) const {
+	const ExpressionTFV& derived = dynamic_cast<const ExpressionTFV&>(other);
+	return expressionStr == derived.expressionStr;
+}
+
+void ExpressionTFV::compile() {
+	timeSymbolTable = exprtk::symbol_table<float>();
+	timeSymbolTable.add_variable("t", t);
+
+	expression = exprtk::expression<float>();
+	expression.register_symbol_table(timeSymbolTable);
+	for (int i = boundSymbolTables.size() - 1; i >= 0; i--) {
+		expression.register_symbol_table(boundSymbolTables[i]);
+	}
+
+	exprtk::parser<float>& parser = ExpressionCompiler::getParser();
+	if (!parser.compile(expressionStr, expression)) {
+		L_(lwarning) << "Unable to compile ExpressionTFV expression \"" << expressionStr << "\"; it will evaluate to 0";
+		parser.compile("0", expression);
+	}
+	compiled = true;
+}
 
 std::shared_ptr<TFV> TFVFactory::create(std::string formattedString) {
 	auto name = split(formattedString, TextMarshallable::DELIMITER)[0];
@@ -685,6 +885,9 @@ std::shared_ptr<TFV> TFVFactory::create(std::string formattedString) {
 	else if (name == "PiecewiseTFV") {
 		ptr = std::make_shared<PiecewiseTFV>();
 	}
+	else if (name == "ExpressionTFV") {
+		ptr = std::make_shared<ExpressionTFV>();
+	}
 	ptr->load(formattedString);
 	return std::move(ptr);
 }
@@ -713,6 +916,8 @@ std::shared_ptr<TFV> TFVFactory::create(const nlohmann::json& j) {
 			ptr = std::make_shared<TranslationWrapperTFV>();
 		} else if (name == "PiecewiseTFV") {
 			ptr = std::make_shared<PiecewiseTFV>();
+		} else if (name == "ExpressionTFV") {
+			ptr = std::make_shared<ExpressionTFV>();
 		}
 		ptr->load(j);
 		return std::move(ptr);
@@ -15,9 +15,11 @@ bool AnimatablePicture::updateTime(tgui::Duration elapsedTime) {
 	bool ret = tgui::Widget::updateTime(elapsedTime);
 
 	if (animation) {
-		std::shared_ptr<sf::Sprite> prevSprite = curSprite;
-		setCurSprite(animation->update(elapsedTime.asSeconds()));
-		if (curSprite != prevSprite) {
+		std::shared_ptr<const SpriteTemplate> frame = animation->update(elapsedTime.asSeconds());
+		if (frame != curFrame) {
+			curFrame = frame;
+			// The frame is shared with the game, so this widget resizes its own copy of it
+			setCurSprite(frame ? frame->createSprite() : nullptr);
 			resizeCurSpriteToFitWidget();
 			return true;
 		}
@@ -52,6 +54,7 @@ void AnimatablePicture::setAnimation(SpriteLoader& spriteLoader, const std::stri
 	std::unique_ptr<Animation> animation = spriteLoader.getAnimation(animationName, spriteSheetName, true);
 	if (animation) {
 		this->animation = std::move(animation);
+		curFrame = nullptr;
 	} else {
 		setSpriteToMissingSprite(spriteLoader);
 	}
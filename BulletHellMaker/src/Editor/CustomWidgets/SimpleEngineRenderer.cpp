@@ -1,5 +1,7 @@
 #include <Editor/CustomWidgets/SimpleEngineRenderer.h>
 
+#include <DataStructs/BakedTrajectory.h>
+
 SimpleEngineRenderer::SimpleEngineRenderer(sf::RenderWindow& parentWindow, bool userControlledView, bool useDebugRenderSystem) 
 	: parentWindow(parentWindow), paused(true), userControlledView(userControlledView), useDebugRenderSystem(useDebugRenderSystem) {
 
@@ -104,6 +106,7 @@ void SimpleEngineRenderer::loadLevelPack(std::string name, std::shared_ptr<Sprit
 	renderSystem = std::make_unique<RenderSystem>(registry, parentWindow, *this->spriteLoader, 1.0f);
 	collisionSystem = std::make_unique<CollisionSystem>(*levelPack, *queue, *this->spriteLoader, registry, MAP_WIDTH, MAP_HEIGHT);
 	despawnSystem = std::make_unique<DespawnSystem>(registry);
+	offScreenSystem = std::make_unique<OffScreenSystem>(registry, MAP_WIDTH, MAP_HEIGHT);
 	enemySystem = std::make_unique<EnemySystem>(*queue, *this->spriteLoader, *levelPack, registry);
 	spriteAnimationSystem = std::make_unique<SpriteAnimationSystem>(*this->spriteLoader, registry);
 	shadowTrailSystem = std::make_unique<ShadowTrailSystem>(*queue, registry);
@@ -124,6 +127,7 @@ void SimpleEngineRenderer::loadLevel(int levelIndex) {
 
 void SimpleEngineRenderer::loadLevel(std::shared_ptr<Level> level) {
 	std::lock_guard<std::mutex> lock(registryMutex);
+	BakedTrajectory::clearCache();
 
 	// Remove all existing entities from the registry
 	registry.reset();
@@ -202,6 +206,7 @@ void SimpleEngineRenderer::physicsUpdate(float deltaTime) {
 		registry.get<LevelManagerTag>().update(*queue, *spriteLoader, registry, deltaTime);
 		queue->executeAll();
 
+		offScreenSystem->update(deltaTime);
 		despawnSystem->update(deltaTime);
 		queue->executeAll();
 
@@ -159,6 +159,17 @@ This might take a while to load the first time."));
 			onValueChange.emit(this, oldTFV, tfv);
 			selectSegment(selectedSegmentIndex);
 			populateSegmentList();
+		}),
+		std::make_pair("Expression", [this]() {
+			std::lock_guard<std::recursive_mutex> lock(tfvMutex);
+
+			std::shared_ptr<TFV> newTFV = std::make_shared<ExpressionTFV>();
+			float oldStartTime = tfv->getSegment(selectedSegmentIndex).first;
+			int selectedSegmentIndex = this->selectedSegmentIndex;
+			tfv->changeSegment(selectedSegmentIndex, newTFV, tfvLifespan);
+			onValueChange.emit(this, oldTFV, tfv);
+			selectSegment(selectedSegmentIndex);
+			populateSegmentList();
 		})
 		});
 	segmentTypePopup->setToolTip(createToolTip("Linear - Straight line, of form y = A + (B - A)(x / T).\n\
@@ -167,7 +178,8 @@ Sine wave - Sine function, of form y = A*sin(x*2*pi/T + P) + C.\n\
 Distance from acceleration - Standard distance formula, of form y = C + V*x + 0.5*A*(T^2).\n\
 Dampened start - A curve whose value changes slowly at the beginning, of form y = (B - A) / T^(0.08*D + 1) * x^(0.08f*D + 1) + A.\n\
 Dampened end - A curve whose value changes slowly at the end, of form y = (B - A) / T^(0.08*D + 1) * (T - x)^(0.08f*D + 1) + B.\n\
-Double dampened - An S-shaped curve, of form y = DampenedStart(x, A, B, D, T/2) if x <= T/2; y = DampenedEnd(x, A, B, D, T/2) if x > T/2.\
+Double dampened - An S-shaped curve, of form y = DampenedStart(x, A, B, D, T/2) if x <= T/2; y = DampenedEnd(x, A, B, D, T/2) if x > T/2.\n\
+Expression - Any expression of t, the time in seconds since the start of the segment.\
 The evaluation of this value will return the currently active segment's evaluation at time t-T0, where T0 is the start time of the segment. In every equation above, T is the lifespan in seconds of the segment."));
 	segmentTypePopup->setPosition(tgui::bindLeft(changeSegmentType), tgui::bindTop(changeSegmentType));
 
@@ -191,6 +203,7 @@ a start time of t=0."));
 	tfvFloat3Label = tgui::Label::create();
 	tfvFloat4Label = tgui::Label::create();
 	tfvInt1Label = tgui::Label::create();
+	tfvExpressionLabel = tgui::Label::create();
 	startTimeLabel = tgui::Label::create();
 	startTimeLabel->setText("Start time");
 	startTimeLabel->setTextSize(TEXT_SIZE);
@@ -199,11 +212,16 @@ a start time of t=0."));
 	tfvFloat3Label->setTextSize(TEXT_SIZE);
 	tfvFloat4Label->setTextSize(TEXT_SIZE);
 	tfvInt1Label->setTextSize(TEXT_SIZE);
+	tfvExpressionLabel->setTextSize(TEXT_SIZE);
+	tfvExpressionLabel->setText("Expression");
+	tfvExpressionLabel->setToolTip(createToolTip("The value of this segment as an expression of t, the time in seconds since the start of this segment. \
+An expression that can't be compiled evaluates to 0."));
 	add(tfvFloat1Label);
 	add(tfvFloat2Label);
 	add(tfvFloat3Label);
 	add(tfvFloat4Label);
 	add(tfvInt1Label);
+	add(tfvExpressionLabel);
 	add(startTimeLabel);
 
 	tfvFloat1EditBox = NumericalEditBoxWithLimits::create();
@@ -216,6 +234,7 @@ a start time of t=0."));
 	tfvFloat4EditBox->setIntegerMode(false);
 	tfvInt1EditBox = NumericalEditBoxWithLimits::create();
 	tfvInt1EditBox->setIntegerMode(true);
+	tfvExpressionEditBox = EditBox::create();
 	startTime = SliderWithEditBox::create();
 	startTime->setIntegerMode(false);
 	startTime->setStep(MAX_PHYSICS_DELTA_TIME);
@@ -320,6 +339,15 @@ a start time of t=0."));
 			onValueChange.emit(this, oldTFV, tfv);
 		}
 	});
+	tfvExpressionEditBox->onValueChange.connect([this](tgui::String value) {
+		if (ignoreSignals) return;
+
+		if (dynamic_cast<ExpressionTFV*>(selectedSegment.get()) != nullptr) {
+			auto ptr = dynamic_cast<ExpressionTFV*>(selectedSegment.get());
+			ptr->setExpressionStr(static_cast<std::string>(value));
+			onValueChange.emit(this, oldTFV, tfv);
+		}
+	});
 	startTime->onValueChange.connect([this](float value) {
 		if (ignoreSignals) return;
 
@@ -336,12 +364,14 @@ a start time of t=0."));
 	tfvFloat3EditBox->setTextSize(TEXT_SIZE);
 	tfvFloat4EditBox->setTextSize(TEXT_SIZE);
 	tfvInt1EditBox->setTextSize(TEXT_SIZE);
+	tfvExpressionEditBox->setTextSize(TEXT_SIZE);
 	startTime->setTextSize(TEXT_SIZE);
 	add(tfvFloat1EditBox);
 	add(tfvFloat2EditBox);
 	add(tfvFloat3EditBox);
 	add(tfvFloat4EditBox);
 	add(tfvInt1EditBox);
+	add(tfvExpressionEditBox);
 	add(startTime);
 
 	showGraph->setSize(100, TEXT_BUTTON_HEIGHT);
@@ -365,6 +395,7 @@ a start time of t=0."));
 		tfvFloat3EditBox->setSize(newSize.x - (segmentListRightBoundary + GUI_PADDING_X * 2), TEXT_BOX_HEIGHT);
 		tfvFloat4EditBox->setSize(newSize.x - (segmentListRightBoundary + GUI_PADDING_X * 2), TEXT_BOX_HEIGHT);
 		tfvInt1EditBox->setSize(newSize.x - (segmentListRightBoundary + GUI_PADDING_X * 2), TEXT_BOX_HEIGHT);
+		tfvExpressionEditBox->setSize(newSize.x - (segmentListRightBoundary + GUI_PADDING_X * 2), TEXT_BOX_HEIGHT);
 
 		startTimeLabel->setPosition(segmentListRightBoundary, tgui::bindTop(segmentList));
 		startTime->setPosition(segmentListRightBoundary, startTimeLabel->getPosition().y + startTimeLabel->getSize().y + GUI_LABEL_PADDING_Y);
@@ -384,6 +415,9 @@ a start time of t=0."));
 		tfvInt1Label->setPosition(segmentListRightBoundary, tgui::bindBottom(tfvFloat2EditBox) + GUI_PADDING_Y);
 		tfvInt1EditBox->setPosition(segmentListRightBoundary, tgui::bindBottom(tfvInt1Label) + GUI_LABEL_PADDING_Y);
 
+		tfvExpressionLabel->setPosition(segmentListRightBoundary, tgui::bindBottom(startTime) + GUI_PADDING_Y);
+		tfvExpressionEditBox->setPosition(segmentListRightBoundary, tgui::bindBottom(tfvExpressionLabel) + GUI_LABEL_PADDING_Y);
+
 		segmentList->setSize(segmentList->getSize().x, 200);
 
 		float buttonWidth = (segmentList->getSize().x - GUI_PADDING_X * 2) / 3.0f;
@@ -492,7 +526,7 @@ void TFVGroup::deselectSegment() {
 	deleteSegment->setEnabled(false);
 	changeSegmentType->setEnabled(false);
 	segmentList->deselectItem();
-	bool f1 = false, f2 = false, f3 = false, f4 = false, i1 = false;
+	bool f1 = false, f2 = false, f3 = false, f4 = false, i1 = false, e1 = false;
 	tfvFloat1Label->setVisible(f1);
 	tfvFloat1EditBox->setVisible(f1);
 	tfvFloat2Label->setVisible(f2);
@@ -503,6 +537,8 @@ void TFVGroup::deselectSegment() {
 	tfvFloat4EditBox->setVisible(f4);
 	tfvInt1Label->setVisible(i1);
 	tfvInt1EditBox->setVisible(i1);
+	tfvExpressionLabel->setVisible(e1);
+	tfvExpressionEditBox->setVisible(e1);
 	startTimeLabel->setVisible(false);
 	startTime->setVisible(false);
 }
@@ -525,7 +561,7 @@ void TFVGroup::selectSegment(int index) {
 	segmentList->setSelectedItemById(std::to_string(index));
 
 	// whether to use tfvFloat1EditBox, tfvFloat2EditBox, ...
-	bool f1 = false, f2 = false, f3 = false, f4 = false, i1 = false;
+	bool f1 = false, f2 = false, f3 = false, f4 = false, i1 = false, e1 = false;
 
 	if (dynamic_cast<LinearTFV*>(selectedSegment.get()) != nullptr) {
 		f1 = f2 = true;
@@ -625,6 +661,11 @@ void TFVGroup::selectSegment(int index) {
 		tfvFloat1EditBox->setValue(ptr->getStartValue());
 		tfvFloat2EditBox->setValue(ptr->getEndValue());
 		tfvInt1EditBox->setValue(ptr->getDampeningFactor());
+	} else if (dynamic_cast<ExpressionTFV*>(selectedSegment.get()) != nullptr) {
+		e1 = true;
+
+		auto ptr = dynamic_cast<ExpressionTFV*>(selectedSegment.get());
+		tfvExpressionEditBox->setText(ptr->getExpressionStr());
 	} else {
 		// You missed a case
 		assert(false);
@@ -643,6 +684,8 @@ void TFVGroup::selectSegment(int index) {
 	tfvFloat4EditBox->setVisible(f4);
 	tfvInt1Label->setVisible(i1);
 	tfvInt1EditBox->setVisible(i1);
+	tfvExpressionLabel->setVisible(e1);
+	tfvExpressionEditBox->setVisible(e1);
 	startTimeLabel->setVisible(true);
 	startTime->setVisible(true);
 
@@ -656,6 +699,7 @@ void TFVGroup::selectSegment(int index) {
 	tfvFloat3EditBox->setCaretPosition(0);
 	tfvFloat4EditBox->setCaretPosition(0);
 	tfvInt1EditBox->setCaretPosition(0);
+	tfvExpressionEditBox->setCaretPosition(0);
 
 	ignoreSignals = false;
 }
@@ -99,6 +99,14 @@ EditorMovablePointPanel::EditorMovablePointPanel(MainEditorWindow& mainEditorWin
 		empiPierceResetTimeLabel = tgui::Label::create();
 		empiPierceResetTime = EditBox::create();
 
+		empiContinuousCollision = tgui::CheckBox::create("Continuous collision");
+
+		empiCapsuleEndXLabel = tgui::Label::create();
+		empiCapsuleEndX = NumericalEditBoxWithLimits::create();
+		empiCapsuleEndYLabel = tgui::Label::create();
+		empiCapsuleEndY = NumericalEditBoxWithLimits::create();
+		empiConvertChainToCapsule = tgui::Button::create();
+
 		empiSoundSettingsLabel = tgui::Label::create();
 		empiSoundSettings = SoundSettingsGroup::create(format(RELATIVE_LEVEL_PACK_SOUND_FOLDER_PATH, levelPack->getName().c_str()));
 
@@ -146,6 +154,16 @@ Each enemy/player can be hit at most every \"Pierce reset time\" seconds by the
 so this should be considered as well."));
 		empiPierceResetTimeLabel->setToolTip(createToolTip("Minimum number of seconds after this bullet hits a player/enemy that it can hit the same player/enemy again. \
 Players also have a custom invulnerability time every time they take damage, so this should be considered as well."));
+		empiContinuousCollision->setToolTip(createToolTip("If this is checked, this bullet can hit anything along the path it travelled since the last physics update instead of \
+only where it ended up. Bullets that move more than their own radius in a single physics update always do this, so this is only needed for bullets that \
+must never pass through even the smallest hitboxes."));
+		empiCapsuleEndXLabel->setToolTip(createToolTip("If the laser end is not (0, 0), this bullet's hitbox is a capsule around the line from this bullet's position \
+to the laser end, relative to this bullet, instead of a circle. This makes a whole laser beam a single bullet. The line rotates along with this \
+bullet's sprite and the sprite is stretched to cover the line."));
+		empiCapsuleEndYLabel->setToolTip(createToolTip("See \"Laser end X\"."));
+		empiConvertChainToCapsule->setToolTip(createToolTip("Replaces a laser made of a chain of identical bullets attached to this movable point with a single bullet. \
+The chain's bullets must never rotate and must be attached to this movable point at plain-number spawn positions that lie on a straight line. The bullet at one end of the chain \
+becomes a laser that reaches the other end, and the rest of the chain is deleted."));
 		empiSoundSettingsLabel->setToolTip(createToolTip("Settings for the sound to be played when this movable point is spawned."));
 		empiBulletModelLabel->setToolTip(createToolTip("The movable point model that this movable point will use. This is purely for convenience by allowing this movable point to \
 use the radius, despawn time, shadow settings, sprites and animations, damage, and/or sound settings of some user-defined model such that whenever the model is updated, this movable \
@@ -194,6 +212,12 @@ point will update only the values it wants to inherit to match the model."));
 		empiOnCollisionAction->setTextSize(TEXT_SIZE);
 		empiPierceResetTimeLabel->setTextSize(TEXT_SIZE);
 		empiPierceResetTime->setTextSize(TEXT_SIZE);
+		empiContinuousCollision->setTextSize(TEXT_SIZE);
+		empiCapsuleEndXLabel->setTextSize(TEXT_SIZE);
+		empiCapsuleEndX->setTextSize(TEXT_SIZE);
+		empiCapsuleEndYLabel->setTextSize(TEXT_SIZE);
+		empiCapsuleEndY->setTextSize(TEXT_SIZE);
+		empiConvertChainToCapsule->setTextSize(TEXT_SIZE);
 		empiBulletModelLabel->setTextSize(TEXT_SIZE);
 		empiBulletModel->setTextSize(TEXT_SIZE);
 		empiInheritRadius->setTextSize(TEXT_SIZE);
@@ -221,6 +245,9 @@ point will update only the values it wants to inherit to match the model."));
 		empiDamageLabel->setText("Damage");
 		empiOnCollisionActionLabel->setText("On-collision action");
 		empiPierceResetTimeLabel->setText("Seconds between piercing hits");
+		empiCapsuleEndXLabel->setText("Laser end X");
+		empiCapsuleEndYLabel->setText("Laser end Y");
+		empiConvertChainToCapsule->setText("Convert attached bullet chain to laser");
 		empiBulletModelLabel->setText("Movable point model");
 		empiInheritRadius->setText("Inherit radius");
 		empiInheritDespawnTime->setText("Inherit despawn time");
@@ -338,6 +365,9 @@ point will update only the values it wants to inherit to match the model."));
 				this->ignoreSignals = true;
 				isBullet->setChecked(value);
 				empiOnCollisionAction->setEnabled(this->emp->getIsBullet());
+				empiContinuousCollision->setEnabled(this->emp->getIsBullet());
+				empiCapsuleEndX->setEnabled(this->emp->getIsBullet());
+				empiCapsuleEndY->setEnabled(this->emp->getIsBullet());
 				empiHitboxRadius->setEnabled((!this->emp->getInheritRadius() || this->emp->getBulletModelID() < 0) && this->emp->getIsBullet());
 				empiDamage->setEnabled((!this->emp->getInheritDamage() || this->emp->getBulletModelID() < 0) && this->emp->getIsBullet());
 				empiPierceResetTimeLabel->setVisible(this->emp->getOnCollisionAction() == BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY && this->emp->getIsBullet());
@@ -351,6 +381,9 @@ point will update only the values it wants to inherit to match the model."));
 				this->ignoreSignals = true;
 				isBullet->setChecked(oldValue);
 				empiOnCollisionAction->setEnabled(this->emp->getIsBullet());
+				empiContinuousCollision->setEnabled(this->emp->getIsBullet());
+				empiCapsuleEndX->setEnabled(this->emp->getIsBullet());
+				empiCapsuleEndY->setEnabled(this->emp->getIsBullet());
 				empiHitboxRadius->setEnabled((!this->emp->getInheritRadius() || this->emp->getBulletModelID() < 0) && this->emp->getIsBullet());
 				empiDamage->setEnabled((!this->emp->getInheritDamage() || this->emp->getBulletModelID() < 0) && this->emp->getIsBullet());
 				empiPierceResetTimeLabel->setVisible(this->emp->getOnCollisionAction() == BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY && this->emp->getIsBullet());
@@ -697,6 +730,113 @@ point will update only the values it wants to inherit to match the model."));
 				ignoreSignals = false;
 			}));
 		});
+		empiContinuousCollision->onChange.connect([this](bool value) {
+			if (ignoreSignals) {
+				return;
+			}
+
+			bool oldValue = this->emp->getContinuousCollision();
+			undoStack.execute(UndoableCommand(
+				[this, value]() {
+				this->emp->setContinuousCollision(value);
+				onEMPModify.emit(this, this->emp);
+
+				ignoreSignals = true;
+				empiContinuousCollision->setChecked(value);
+				ignoreSignals = false;
+			},
+				[this, oldValue]() {
+				this->emp->setContinuousCollision(oldValue);
+				onEMPModify.emit(this, this->emp);
+
+				ignoreSignals = true;
+				empiContinuousCollision->setChecked(oldValue);
+				ignoreSignals = false;
+			}));
+		});
+		empiCapsuleEndX->onValueChange.connect([this](float value) {
+			if (ignoreSignals) {
+				return;
+			}
+
+			float oldValue = this->emp->getCapsuleEndX();
+			undoStack.execute(UndoableCommand(
+				[this, value]() {
+				this->emp->setCapsuleEnd(value, this->emp->getCapsuleEndY());
+				onEMPModify.emit(this, this->emp);
+
+				ignoreSignals = true;
+				empiCapsuleEndX->setValue(value);
+				ignoreSignals = false;
+			},
+				[this, oldValue]() {
+				this->emp->setCapsuleEnd(oldValue, this->emp->getCapsuleEndY());
+				onEMPModify.emit(this, this->emp);
+
+				ignoreSignals = true;
+				empiCapsuleEndX->setValue(oldValue);
+				ignoreSignals = false;
+			}));
+		});
+		empiCapsuleEndY->onValueChange.connect([this](float value) {
+			if (ignoreSignals) {
+				return;
+			}
+
+			float oldValue = this->emp->getCapsuleEndY();
+			undoStack.execute(UndoableCommand(
+				[this, value]() {
+				this->emp->setCapsuleEnd(this->emp->getCapsuleEndX(), value);
+				onEMPModify.emit(this, this->emp);
+
+				ignoreSignals = true;
+				empiCapsuleEndY->setValue(value);
+				ignoreSignals = false;
+			},
+				[this, oldValue]() {
+				this->emp->setCapsuleEnd(this->emp->getCapsuleEndX(), oldValue);
+				onEMPModify.emit(this, this->emp);
+
+				ignoreSignals = true;
+				empiCapsuleEndY->setValue(oldValue);
+				ignoreSignals = false;
+			}));
+		});
+		empiConvertChainToCapsule->onPress.connect([this]() {
+			if (this->emp->getChildrenChain().empty()) {
+				return;
+			}
+
+			// The chain as it was before the last conversion, each with its index in the EMP's children at the time,
+			// so that the conversion can be undone
+			auto chain = std::make_shared<std::vector<std::pair<int, std::shared_ptr<EditorMovablePoint>>>>();
+			undoStack.execute(UndoableCommand(
+				[this, chain]() {
+				auto children = this->emp->getChildren();
+				chain->clear();
+				for (auto link : this->emp->convertChildrenChainToCapsule()) {
+					chain->push_back(std::make_pair(std::find(children.begin(), children.end(), link) - children.begin(), link));
+				}
+				updateAllWidgetValues();
+				onEMPModify.emit(this, this->emp);
+			},
+				[this, chain]() {
+				if (chain->empty()) {
+					return;
+				}
+				chain->front().second->setCapsuleEnd(0, 0);
+				// Reinserting in increasing order of index puts every removed link back exactly where it was
+				std::vector<std::pair<int, std::shared_ptr<EditorMovablePoint>>> removedLinks(chain->begin() + 1, chain->end());
+				std::sort(removedLinks.begin(), removedLinks.end(), [](auto& a, auto& b) {
+					return a.first < b.first;
+				});
+				for (auto& link : removedLinks) {
+					this->emp->insertChild(link.first, link.second);
+				}
+				updateAllWidgetValues();
+				onEMPModify.emit(this, this->emp);
+			}));
+		});
 		empiSoundSettings->onValueChange.connect([this](SoundSettings value) {
 			if (ignoreSignals) {
 				return;
@@ -1146,8 +1286,14 @@ point will update only the values it wants to inherit to match the model."));
 		empiOnCollisionAction->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiOnCollisionActionLabel) + GUI_LABEL_PADDING_Y);
 		empiPierceResetTimeLabel->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiOnCollisionAction) + GUI_PADDING_Y);
 		empiPierceResetTime->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiPierceResetTimeLabel) + GUI_LABEL_PADDING_Y);
-
-		empiDespawnTimeLabel->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiPierceResetTime) + GUI_PADDING_Y * 2);
+		empiContinuousCollision->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiPierceResetTime) + GUI_PADDING_Y);
+		empiCapsuleEndXLabel->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiContinuousCollision) + GUI_PADDING_Y);
+		empiCapsuleEndX->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiCapsuleEndXLabel) + GUI_LABEL_PADDING_Y);
+		empiCapsuleEndYLabel->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiCapsuleEndX) + GUI_PADDING_Y);
+		empiCapsuleEndY->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiCapsuleEndYLabel) + GUI_LABEL_PADDING_Y);
+		empiConvertChainToCapsule->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiCapsuleEndY) + GUI_PADDING_Y);
+
+		empiDespawnTimeLabel->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiConvertChainToCapsule) + GUI_PADDING_Y * 2);
 		empiDespawnTime->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiDespawnTimeLabel) + GUI_LABEL_PADDING_Y);
 		empiSpawnTypeLabel->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiDespawnTime) + GUI_PADDING_Y * 2);
 		empiSpawnType->setPosition(tgui::bindLeft(id), tgui::bindBottom(empiSpawnTypeLabel) + GUI_LABEL_PADDING_Y);
@@ -1188,6 +1334,10 @@ point will update only the values it wants to inherit to match the model."));
 		empiDamage->setSize(fillWidth, TEXT_BOX_HEIGHT);
 		empiOnCollisionAction->setSize(fillWidth, TEXT_BOX_HEIGHT);
 		empiPierceResetTime->setSize(fillWidth, TEXT_BOX_HEIGHT);
+		empiContinuousCollision->setSize(CHECKBOX_SIZE, CHECKBOX_SIZE);
+		empiCapsuleEndX->setSize(fillWidth, TEXT_BOX_HEIGHT);
+		empiCapsuleEndY->setSize(fillWidth, TEXT_BOX_HEIGHT);
+		empiConvertChainToCapsule->setSize(fillWidth, TEXT_BUTTON_HEIGHT);
 		empiBulletModel->setSize(fillWidth, TEXT_BOX_HEIGHT);
 		empiInheritRadius->setSize(CHECKBOX_SIZE, CHECKBOX_SIZE);
 		empiInheritDespawnTime->setSize(CHECKBOX_SIZE, CHECKBOX_SIZE);
@@ -1228,6 +1378,12 @@ point will update only the values it wants to inherit to match the model."));
 		propertiesPanel->add(empiOnCollisionAction);
 		propertiesPanel->add(empiPierceResetTimeLabel);
 		propertiesPanel->add(empiPierceResetTime);
+		propertiesPanel->add(empiContinuousCollision);
+		propertiesPanel->add(empiCapsuleEndXLabel);
+		propertiesPanel->add(empiCapsuleEndX);
+		propertiesPanel->add(empiCapsuleEndYLabel);
+		propertiesPanel->add(empiCapsuleEndY);
+		propertiesPanel->add(empiConvertChainToCapsule);
 		propertiesPanel->add(empiSoundSettingsLabel);
 		propertiesPanel->add(empiSoundSettings);
 		propertiesPanel->add(empiBulletModelLabel);
@@ -1383,6 +1539,9 @@ void EditorMovablePointPanel::updateAllWidgetValues() {
 	empiDamage->setText(emp->getRawDamage());
 	empiOnCollisionAction->setSelectedItemById(getID(emp->getOnCollisionAction()));
 	empiPierceResetTime->setText(emp->getRawPierceResetTime());
+	empiContinuousCollision->setChecked(emp->getContinuousCollision());
+	empiCapsuleEndX->setValue(emp->getCapsuleEndX());
+	empiCapsuleEndY->setValue(emp->getCapsuleEndY());
 	empiSoundSettings->initSettings(emp->getSoundSettings());
 	if (emp->getBulletModelID() >= 0) {
 		empiBulletModel->setSelectedItemById(std::to_string(emp->getBulletModelID()));
@@ -1400,6 +1559,10 @@ void EditorMovablePointPanel::updateAllWidgetValues() {
 
 	empiSpawnTypeTime->setEnabled(!emp->isMainEMP());
 	empiOnCollisionAction->setEnabled(emp->getIsBullet());
+	empiContinuousCollision->setEnabled(emp->getIsBullet());
+	empiCapsuleEndX->setEnabled(emp->getIsBullet());
+	empiCapsuleEndY->setEnabled(emp->getIsBullet());
+	empiConvertChainToCapsule->setEnabled(!emp->getChildrenChain().empty());
 	empiHitboxRadius->setEnabled((!emp->getInheritRadius() || this->emp->getBulletModelID() < 0) && emp->getIsBullet());
 	empiDespawnTime->setEnabled(!emp->getInheritDespawnTime() || this->emp->getBulletModelID() < 0);
 	empiShadowTrailInterval->setEnabled(!emp->getInheritShadowTrailInterval() || this->emp->getBulletModelID() < 0);
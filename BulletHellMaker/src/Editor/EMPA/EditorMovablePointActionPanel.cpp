@@ -55,6 +55,7 @@ EditorMovablePointActionPanel::EditorMovablePointActionPanel(EditorWindow& paren
 	empaiHomingSpeedLabel = tgui::Label::create();
 	empaiHomingSpeed = TFVGroup::create(parentWindow, clipboard);
 	empaiEditBezierControlPoints = tgui::Button::create();
+	empaiBezierConstantSpeed = tgui::CheckBox::create("Constant speed");
 	empaiXLabel = tgui::Label::create();
 	empaiX = EditBox::create();
 	empaiYLabel = tgui::Label::create();
@@ -73,6 +74,7 @@ EditorMovablePointActionPanel::EditorMovablePointActionPanel(EditorWindow& paren
 	empaiHomingStrengthLabel->setTextSize(TEXT_SIZE);
 	empaiHomingSpeedLabel->setTextSize(TEXT_SIZE);
 	empaiEditBezierControlPoints->setTextSize(TEXT_SIZE);
+	empaiBezierConstantSpeed->setTextSize(TEXT_SIZE);
 	empaiXLabel->setTextSize(TEXT_SIZE);
 	empaiYLabel->setTextSize(TEXT_SIZE);
 	empaiX->setTextSize(TEXT_SIZE);
@@ -85,6 +87,8 @@ EditorMovablePointActionPanel::EditorMovablePointActionPanel(EditorWindow& paren
 	empaiPolarDistanceLabel->setToolTip(createToolTip("Distance in polar coordinates as a function of time."));
 	empaiPolarAngleLabel->setToolTip(createToolTip("Angle in polar coordinates as a function of time."));
 	empaiBezierControlPointsLabel->setToolTip(createToolTip("Control points used for movement using a bezier curve."));
+	empaiBezierConstantSpeed->setToolTip(createToolTip("If this is checked, the mover will travel along the bezier curve at a constant speed. \
+Otherwise, the mover will move faster along parts of the curve where control points are farther apart."));
 	empaiAngleOffsetLabel->setToolTip(createToolTip("This action's path will be rotated counter-clockwise around the action's initial position by this angle."));
 	empaiHomingStrengthLabel->setToolTip(createToolTip("How quickly the mover rotates towards the target as a function of time. This function should return values in range (0, 1]. \
 For reference, a value of 0.02 is moderately strong homing strength and a value of 1.0 creates a straight line path to the target."));
@@ -256,6 +260,31 @@ For reference, a value of 0.02 is moderately strong homing strength and a value
 			onEMPAModify.emit(this, this->empa);
 		}));
 	});
+	empaiBezierConstantSpeed->onChange.connect([this](bool value) {
+		if (ignoreSignals) {
+			return;
+		}
+
+		MoveCustomBezierEMPA* concreteEMPA = dynamic_cast<MoveCustomBezierEMPA*>(this->empa.get());
+		bool oldValue = concreteEMPA->getConstantSpeed();
+		undoStack.execute(UndoableCommand([this, value]() {
+			dynamic_cast<MoveCustomBezierEMPA*>(this->empa.get())->setConstantSpeed(value);
+
+			ignoreSignals = true;
+			this->empaiBezierConstantSpeed->setChecked(value);
+			ignoreSignals = false;
+
+			onEMPAModify.emit(this, this->empa);
+		}, [this, oldValue]() {
+			dynamic_cast<MoveCustomBezierEMPA*>(this->empa.get())->setConstantSpeed(oldValue);
+
+			ignoreSignals = true;
+			this->empaiBezierConstantSpeed->setChecked(oldValue);
+			ignoreSignals = false;
+
+			onEMPAModify.emit(this, this->empa);
+		}));
+	});
 	empaiAngleOffset->onValueChange.connect([this](std::shared_ptr<EMPAAngleOffset> oldOffset, std::shared_ptr<EMPAAngleOffset> updatedOffset) {
 		if (ignoreSignals) {
 			return;
@@ -574,6 +603,7 @@ For reference, a value of 0.02 is moderately strong homing strength and a value
 		empaiHomingStrength->setSize(empaiAreaWidth - GUI_PADDING_X * 2, 0);
 		empaiHomingSpeed->setSize(empaiAreaWidth - GUI_PADDING_X * 2, 0);
 		empaiEditBezierControlPoints->setSize(empaiAreaWidth - GUI_PADDING_X * 2, TEXT_BOX_HEIGHT);
+		empaiBezierConstantSpeed->setSize(CHECKBOX_SIZE, CHECKBOX_SIZE);
 		empaiX->setSize(empaiAreaWidth - GUI_PADDING_X * 2, TEXT_BOX_HEIGHT);
 		empaiY->setSize(empaiAreaWidth - GUI_PADDING_X * 2, TEXT_BOX_HEIGHT);
 		empaiXYManualSet->setSize(empaiAreaWidth - GUI_PADDING_X * 2, TEXT_BOX_HEIGHT);
@@ -591,6 +621,7 @@ For reference, a value of 0.02 is moderately strong homing strength and a value
 		empaiBezierControlPointsLabel->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiAngleOffset) + GUI_PADDING_Y);
 		empaiBezierControlPoints->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiBezierControlPointsLabel) + GUI_LABEL_PADDING_Y);
 		empaiEditBezierControlPoints->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiBezierControlPoints) + GUI_PADDING_Y);
+		empaiBezierConstantSpeed->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiEditBezierControlPoints) + GUI_PADDING_Y);
 		empaiXLabel->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiDuration) + GUI_PADDING_Y);
 		empaiX->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiXLabel) + GUI_LABEL_PADDING_Y);
 		empaiYLabel->setPosition(GUI_PADDING_X, tgui::bindBottom(empaiX) + GUI_PADDING_Y);
@@ -628,6 +659,7 @@ For reference, a value of 0.02 is moderately strong homing strength and a value
 	add(empaiHomingSpeedLabel);
 	add(empaiHomingSpeed);
 	add(empaiEditBezierControlPoints);
+	add(empaiBezierConstantSpeed);
 	add(empaiXLabel);
 	add(empaiX);
 	add(empaiYLabel);
@@ -770,6 +802,9 @@ all evaluations of the angle component of this polar movement action."));
 		empaiHomingSpeed->setVisible(false);
 		empaiInfo->setText("Bezier movement action");
 		updateEmpaiBezierControlPoints();
+		ignoreSignals = true;
+		empaiBezierConstantSpeed->setChecked(concreteEMPA->getConstantSpeed());
+		ignoreSignals = false;
 
 		bezierControlPointsMarkerPlacer->setMovementDuration(concreteEMPA->getTime());
 
@@ -868,6 +903,7 @@ will then be rotated about the first control point (0, 0) when this movement act
 	empaiPolarDistanceLabel->setVisible(empaiPolarDistance->isVisible());
 	empaiPolarAngleLabel->setVisible(empaiPolarAngle->isVisible());
 	empaiBezierControlPointsLabel->setVisible(empaiBezierControlPoints->isVisible());
+	empaiBezierConstantSpeed->setVisible(empaiEditBezierControlPoints->isVisible());
 	empaiAngleOffsetLabel->setVisible(empaiAngleOffset->isVisible());
 	empaiHomingStrengthLabel->setVisible(empaiHomingStrength->isVisible());
 	empaiHomingSpeedLabel->setVisible(empaiHomingSpeed->isVisible());
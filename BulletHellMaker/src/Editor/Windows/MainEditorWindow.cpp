@@ -1,6 +1,7 @@
 #include <Editor/Windows/MainEditorWindow.h>
 
 #include <Mutex.h>
+#include <Config.h>
 #include <Constants.h>
 #include <GuiConfig.h>
 #include <Editor/Util/EditorUtils.h>
@@ -119,8 +120,10 @@ void MainEditorWindow::loadLevelPack(std::string levelPackName) {
 		levelPack = std::make_shared<LevelPack>(*audioPlayer, levelPackName);
 		LevelPack::LoadMetrics levelPackLoadMetrics = levelPack->load();
 
+		// Every sprite sheet is needed right away, so finish the load that the level pack started
 		spriteLoader = levelPack->getSpriteLoader();
-		SpriteLoader::LoadMetrics spriteLoaderLoadMetrics = spriteLoader->loadFromSpriteSheetsFolder();
+		spriteLoader->uploadDecodedSpriteSheets(true);
+		SpriteLoader::LoadMetrics spriteLoaderLoadMetrics = levelPack->getSpriteSheetsLoad().get();
 
 		// Display load metrics
 		std::string combinedMetrics = format("Loaded level pack name \"%s\".\n\n", levelPackName.c_str()) + levelPackLoadMetrics.formatForUser() 
@@ -1146,7 +1149,7 @@ void MainEditorWindow::saveSpriteSheetChanges(std::set<std::string> spriteSheetN
 	if (spriteSheetNames.size() > 0) {
 		for (std::string spriteSheetName : spriteSheetNames) {
 			if (unsavedSpriteSheets.find(spriteSheetName) != unsavedSpriteSheets.end()) {
-				levelPack->getSpriteLoader()->updateSpriteSheet(unsavedSpriteSheets.at(spriteSheetName));
+				levelPack->updateSpriteSheet(unsavedSpriteSheets.at(spriteSheetName));
 				unsavedSpriteSheets.erase(spriteSheetName);
 			}
 		}
@@ -1179,7 +1182,7 @@ void MainEditorWindow::saveAllChanges() {
 
 	if (unsavedSpriteSheets.size() > 0) {
 		for (std::pair<std::string, std::shared_ptr<SpriteSheet>> changes : unsavedSpriteSheets) {
-			levelPack->getSpriteLoader()->updateSpriteSheet(changes.second);
+			levelPack->updateSpriteSheet(changes.second);
 		}
 		unsavedSpriteSheets.clear();
 		spriteSheetsListPanel->reloadListOnly();
@@ -1233,7 +1236,26 @@ bool MainEditorWindow::hasUnsavedChanges() {
 	// TODO: add to this
 	return unsavedAttacks.size() > 0 || unsavedAttackPatterns.size() > 0
 		|| unsavedBulletModels.size() > 0 || unsavedEnemies.size() > 0
-		|| unsavedEnemyPhases.size() > 0;
+		|| unsavedEnemyPhases.size() > 0 || unsavedSpriteSheets.size() > 0;
+}
+
+void MainEditorWindow::exportCookedLevelPack() {
+	if (!loadedEditableLevelPack) {
+		return;
+	}
+
+	// Save first, since the next save would delete a cooked file that doesn't match the level pack's files
+	LevelPack::SaveMetrics saveMetrics = levelPack->save();
+	if (saveMetrics.filesFailed > 0) {
+		showPopupMessageWindow(format("Failed to save %d files of level pack \"%s\", so it was not exported.", saveMetrics.filesFailed, levelPack->getName().c_str()), nullptr);
+		return;
+	}
+	if (levelPack->cook()) {
+		showPopupMessageWindow(format("Exported level pack \"%s\" to \"%s\".", levelPack->getName().c_str(),
+			format(RELATIVE_LEVEL_PACK_COOKED_FILE_PATH, levelPack->getName().c_str()).c_str()), nullptr);
+	} else {
+		showPopupMessageWindow(format("Failed to export level pack \"%s\".", levelPack->getName().c_str()), nullptr);
+	}
 }
 
 void MainEditorWindow::openPreviewWindow() {
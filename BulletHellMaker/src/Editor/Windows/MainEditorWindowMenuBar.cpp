@@ -21,6 +21,16 @@ MainEditorWindowMenuBar::MainEditorWindowMenuBar(MainEditorWindow& mainEditorWin
 		}
 	});
 
+	addMenuItem("File", "Export cooked level pack");
+	connectMenuItem("File", "Export cooked level pack", [this]() {
+		if (this->mainEditorWindow.hasUnsavedChanges()) {
+			this->mainEditorWindow.promptConfirmation("Save all unsaved changes to this level pack before exporting it?", this, true)->sink()
+				.connect<MainEditorWindowMenuBar, &MainEditorWindowMenuBar::onExportLevelPackWhileUnsavedChangesExistConfirmation>(this);
+		} else {
+			this->mainEditorWindow.exportCookedLevelPack();
+		}
+	});
+
 	addMenuItem("File", "Reload sprites/animations");
 	connectMenuItem("File", "Reload sprites/animations", [this]() {
 		this->mainEditorWindow.reloadSpriteLoader();
@@ -66,3 +76,13 @@ void MainEditorWindowMenuBar::onOpenLevelPackWhileUnsavedChangesExistConfirmatio
 	}
 	// Do nothing on cancel
 }
+
+void MainEditorWindowMenuBar::onExportLevelPackWhileUnsavedChangesExistConfirmation(EDITOR_WINDOW_CONFIRMATION_PROMPT_CHOICE choice) {
+	if (choice == EDITOR_WINDOW_CONFIRMATION_PROMPT_CHOICE::YES) {
+		mainEditorWindow.saveAllChanges();
+		mainEditorWindow.exportCookedLevelPack();
+	} else if (choice == EDITOR_WINDOW_CONFIRMATION_PROMPT_CHOICE::NO) {
+		mainEditorWindow.exportCookedLevelPack();
+	}
+	// Do nothing on cancel
+}
@@ -1,6 +1,10 @@
 #include <Game/AudioPlayer.h>
 
 #include <algorithm>
+#include <chrono>
+
+#include <Constants.h>
+#include <Util/Profiler.h>
 
 //TODO: move these into some settings class
 float masterVolume = 0.8f;
@@ -130,11 +134,18 @@ bool MusicSettings::operator==(const AudioSettings& other) const {
 		&& loopLengthMilliseconds == derived.loopLengthMilliseconds && transitionTime == derived.transitionTime;
 }
 
+AudioPlayer::AudioPlayer() : soundBuffers(SOUND_BUFFER_CACHE_MAX_BYTES), voices(MAX_SOUND_VOICES) {
+}
+
 void AudioPlayer::update(float deltaTime) {
-	// Check if any sounds are done playing and remove it from the queue of sounds being played
-	while (!currentSounds.empty() && currentSounds.front()->getStatus() == sf::Sound::Status::Stopped) {
-		currentSounds.pop();
-	}
+	// Plays from now on can no longer be coalesced with the ones from the last update
+	updateCount++;
+
+	updateMusic(deltaTime);
+}
+
+void AudioPlayer::updateMusic(float deltaTime) {
+	collectPrefetchedMusic();
 
 	// Update music transitioning
 	if (timeSinceMusicTransitionStart <= musicTransitionTime) {
@@ -160,28 +171,84 @@ void AudioPlayer::update(float deltaTime) {
 	}
 }
 
-void AudioPlayer::playSound(const SoundSettings& soundSettings) {
+void AudioPlayer::playSound(const SoundSettings& soundSettings, int priority) {
 	if (soundSettings.isDisabled() || soundSettings.getFileName() == "") return;
 
-	// Check if the sound's SoundBuffer already exists
-	if (soundBuffers.find(soundSettings.getFileName()) == soundBuffers.end()) {
-		sf::SoundBuffer buffer;
-		if (!buffer.loadFromFile(soundSettings.getFileName())) {
-			//TODO: handle audio not being able to be loaded
-			return;
+	std::shared_ptr<sf::SoundBuffer> buffer = soundBuffers.get(soundSettings.getFileName());
+	if (!buffer) {
+		return;
+	}
+
+	Voice* freeVoice = nullptr;
+	// Oldest playing voice of the same sound
+	Voice* oldestSame = nullptr;
+	int sameCount = 0;
+	// Oldest voice out of the ones with the lowest priority
+	Voice* weakest = nullptr;
+	for (Voice& voice : voices) {
+		if (voice.sound.getStatus() == sf::Sound::Status::Stopped) {
+			if (!freeVoice) {
+				freeVoice = &voice;
+			}
+			continue;
+		}
+
+		if (voice.fileName == soundSettings.getFileName()) {
+			// Identical plays in the same update would just be the same sound stacked on top of itself, so make the first one louder instead
+			if (voice.startUpdate == updateCount && voice.pitch == soundSettings.getPitch()) {
+				voice.plays++;
+				voice.volume = std::max(voice.volume, soundSettings.getVolume());
+				voice.sound.setVolume(std::min(100.0f, voice.volume * (1 + COALESCED_SOUND_VOLUME_BOOST * (voice.plays - 1))) * masterVolume * soundVolume);
+				voice.priority = std::max(voice.priority, priority);
+				coalescedSoundCount++;
+				return;
+			}
+
+			sameCount++;
+			if (!oldestSame || voice.startUpdate < oldestSame->startUpdate) {
+				oldestSame = &voice;
+			}
+		}
+		if (!weakest || voice.priority < weakest->priority || (voice.priority == weakest->priority && voice.startUpdate < weakest->startUpdate)) {
+			weakest = &voice;
 		}
-		soundBuffers[soundSettings.getFileName()] = std::move(buffer);
 	}
-	std::unique_ptr<sf::Sound> sound = std::make_unique<sf::Sound>();
-	sound->setBuffer(soundBuffers[soundSettings.getFileName()]);
-	sound->setVolume(soundSettings.getVolume() * masterVolume * soundVolume);
-	sound->setPitch(soundSettings.getPitch());
-	sound->play();
-	currentSounds.push(std::move(sound));
+
+	Voice* chosen = freeVoice;
+	if (sameCount >= MAX_VOICES_PER_SOUND) {
+		chosen = oldestSame->priority <= priority ? oldestSame : nullptr;
+	} else if (!chosen && weakest && weakest->priority <= priority) {
+		chosen = weakest;
+	}
+	if (!chosen) {
+		droppedSoundCount++;
+		return;
+	}
+	if (chosen->sound.getStatus() != sf::Sound::Status::Stopped) {
+		chosen->sound.stop();
+		stolenVoiceCount++;
+	}
+
+	chosen->fileName = soundSettings.getFileName();
+	chosen->pitch = soundSettings.getPitch();
+	chosen->volume = soundSettings.getVolume();
+	chosen->priority = priority;
+	chosen->startUpdate = updateCount;
+	chosen->plays = 1;
+	chosen->buffer = buffer;
+	chosen->sound.setBuffer(*buffer);
+	chosen->sound.setVolume(soundSettings.getVolume() * masterVolume * soundVolume);
+	chosen->sound.setPitch(soundSettings.getPitch());
+	chosen->sound.play();
+}
+
+void AudioPlayer::preloadSounds(const std::set<std::string>& fileNames) {
+	soundBuffers.preload(fileNames);
 }
 
 std::shared_ptr<sf::Music> AudioPlayer::playMusic(const MusicSettings& musicSettings) {
 	if (musicSettings.isDisabled() || musicSettings.getFileName() == "") return nullptr;
+	ProfilerTimer timer("Music transitions");
 
 	// Fade-out anything currently being played
 	if (currentMusic && currentMusic->getStatus() == sf::SoundSource::Status::Playing) {
@@ -193,10 +260,30 @@ std::shared_ptr<sf::Music> AudioPlayer::playMusic(const MusicSettings& musicSett
 		std::get<3>(t) = 0;
 	}
 
-	std::shared_ptr<sf::Music> music = std::make_shared<sf::Music>();
-	if (!music->openFromFile(musicSettings.getFileName())) {
-		//TODO: handle audio not being able to be loaded
-		return nullptr;
+	std::shared_ptr<sf::Music> music;
+	// A prefetch still in progress is nearly done, so wait for it rather than open the file a second time
+	auto pending = pendingMusic.find(musicSettings.getFileName());
+	if (pending != pendingMusic.end()) {
+		std::shared_ptr<sf::Music> opened = pending->second.get();
+		pendingMusic.erase(pending);
+		if (opened) {
+			prefetchedMusic[musicSettings.getFileName()] = opened;
+		}
+	}
+	auto prefetched = prefetchedMusic.find(musicSettings.getFileName());
+	if (prefetched != prefetchedMusic.end()) {
+		music = prefetched->second;
+		prefetchedMusic.erase(prefetched);
+		musicPrefetchHitCount++;
+		Profiler::addToCounter("Music prefetch hits");
+	} else {
+		music = std::make_shared<sf::Music>();
+		if (!music->openFromFile(musicSettings.getFileName())) {
+			//TODO: handle audio not being able to be loaded
+			return nullptr;
+		}
+		musicPrefetchMissCount++;
+		Profiler::addToCounter("Music prefetch misses");
 	}
 	music->setVolume(musicSettings.getVolume() * masterVolume * musicVolume);
 	if (musicSettings.getLoop()) {
@@ -210,13 +297,14 @@ std::shared_ptr<sf::Music> AudioPlayer::playMusic(const MusicSettings& musicSett
 	currentlyFading.push_back(std::make_tuple(music, VOLUME_CHANGE_STATUS::INCREASING, 0, musicSettings.getVolume()));
 	musicTransitionTime = musicSettings.getTransitionTime();
 	timeSinceMusicTransitionStart = 0;
-	update(0);
+	updateMusic(0);
 
 	return music;
 }
 
 void AudioPlayer::playMusic(std::shared_ptr<sf::Music> music, const MusicSettings& musicSettings) {
 	if (!music || musicSettings.isDisabled() || musicSettings.getFileName() == "") return;
+	ProfilerTimer timer("Music transitions");
 
 	// Fade-out anything currently being played
 	if (currentMusic && currentMusic->getStatus() == sf::SoundSource::Status::Playing) {
@@ -236,9 +324,50 @@ void AudioPlayer::playMusic(std::shared_ptr<sf::Music> music, const MusicSetting
 	currentlyFading.push_back(std::make_tuple(music, VOLUME_CHANGE_STATUS::INCREASING, 0, musicSettings.getVolume()));
 	musicTransitionTime = musicSettings.getTransitionTime();
 	timeSinceMusicTransitionStart = 0;
-	update(0);
+	updateMusic(0);
 }
 
 bool AudioSettings::operator==(const AudioSettings& other) const {
 	return fileName == other.fileName && volume == other.volume && pitch == other.pitch && disabled == other.disabled;
 }
+
+void AudioPlayer::prefetchMusic(const MusicSettings& musicSettings) {
+	std::string fileName = musicSettings.getFileName();
+	if (musicSettings.isDisabled() || fileName == "" || prefetchedMusic.find(fileName) != prefetchedMusic.end()
+		|| pendingMusic.find(fileName) != pendingMusic.end()) return;
+
+	// Opening reads and decodes the start of the file, so it's done off the game thread
+	pendingMusic[fileName] = std::async(std::launch::async, [fileName]() {
+		std::shared_ptr<sf::Music> music = std::make_shared<sf::Music>();
+		if (!music->openFromFile(fileName)) {
+			// Leave it to playMusic() to fail
+			return std::shared_ptr<sf::Music>();
+		}
+		return music;
+	});
+}
+
+void AudioPlayer::clearPrefetchedMusic() {
+	prefetchedMusic.clear();
+	for (auto& pending : pendingMusic) {
+		discardedMusic.push_back(std::move(pending.second));
+	}
+	pendingMusic.clear();
+}
+
+void AudioPlayer::collectPrefetchedMusic() {
+	for (auto it = pendingMusic.begin(); it != pendingMusic.end();) {
+		if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			it++;
+			continue;
+		}
+		std::shared_ptr<sf::Music> music = it->second.get();
+		if (music) {
+			prefetchedMusic[it->first] = music;
+		}
+		it = pendingMusic.erase(it);
+	}
+	discardedMusic.erase(std::remove_if(discardedMusic.begin(), discardedMusic.end(), [](const std::future<std::shared_ptr<sf::Music>>& music) {
+		return music.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), discardedMusic.end());
+}
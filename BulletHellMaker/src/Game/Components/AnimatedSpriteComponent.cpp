@@ -0,0 +1,9 @@
+#include <Game/Components/AnimatedSpriteComponent.h>
+
+#include <Game/Components/SpriteComponent.h>
+
+void AnimatedSpriteComponent::markIfAnimated(entt::DefaultRegistry& registry, uint32_t entity) {
+	if (!registry.has<AnimatedSpriteComponent>(entity) && registry.get<SpriteComponent>(entity).isAnimated()) {
+		registry.assign<AnimatedSpriteComponent>(entity);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <Game/Components/EnemyComponent.h>
 
+#include <limits>
+#include <algorithm>
+
 #include <DataStructs/SpriteLoader.h>
 #include <LevelPack/LevelPack.h>
 #include <LevelPack/Enemy.h>
@@ -15,14 +18,35 @@ EnemyComponent::EnemyComponent(std::shared_ptr<EditorEnemy> enemyData, std::shar
 	: enemyData(enemyData), spawnInfo(spawnInfo), enemyID(enemyID) {
 }
 
-void EnemyComponent::update(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity, float deltaTime) {
+void EnemyComponent::updateTime(float deltaTime) {
 	timeSinceSpawned += deltaTime;
 	timeSincePhase += deltaTime;
 	timeSinceAttackPattern += deltaTime;
+}
 
+void EnemyComponent::checkAttacksAndAttackPatterns(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity) {
 	checkAttacks(queue, spriteLoader, levelPack, registry, entity);
 	checkAttackPatterns(queue, spriteLoader, levelPack, registry, entity);
-	checkPhases(queue, spriteLoader, levelPack, registry, entity);
+	// The next attack or attack pattern is almost always different now
+	scheduleChanged = true;
+}
+
+float EnemyComponent::getTimeUntilNextAttackOrAttackPattern(const LevelPack& levelPack) const {
+	float timeUntilNext = std::numeric_limits<float>::infinity();
+	if (currentAttackPattern && currentAttackIndex + 1 < currentAttackPattern->getAttacksCount()) {
+		timeUntilNext = std::get<0>(currentAttackPattern->getAttackData(currentAttackIndex + 1)) - timeSinceAttackPattern;
+	}
+	if (currentPhase && checkNextAttackPattern) {
+		timeUntilNext = std::min(timeUntilNext, std::get<0>(currentPhase->getAttackPatternData(levelPack, currentAttackPatternIndex + 1)) - timeSincePhase);
+	}
+	return timeUntilNext;
+}
+
+float EnemyComponent::getTimeUntilNextPhaseCheck() const {
+	if (!nextPhaseConditionEvaluated) {
+		return std::numeric_limits<float>::infinity();
+	}
+	return nextPhaseCheckTime - timeSincePhase;
 }
 
 std::shared_ptr<DeathAction> EnemyComponent::getCurrentDeathAnimationAction() {
@@ -42,9 +66,16 @@ void EnemyComponent::checkPhases(EntityCreationQueue& queue, SpriteLoader& sprit
 	// Check if entity can continue to next phase
 	// While loop so that enemy can skip phases
 	while (currentPhaseIndex + 1 < enemyData->getPhasesCount()) {
+		if (!nextPhaseConditionMayHaveChanged(registry, entity)) {
+			break;
+		}
+
 		auto nextPhaseData = enemyData->getPhaseData(currentPhaseIndex + 1);
 		// Check if condition for next phase is satisfied
 		if (std::get<0>(nextPhaseData)->satisfied(registry, entity)) {
+			nextPhaseConditionEvaluated = false;
+			phaseCheckDue = false;
+
 			// Current phase ends, so call its ending EnemyPhaseAction
 			if (currentPhase && currentPhase->getPhaseEndAction()) {
 				currentPhase->getPhaseEndAction()->execute(registry, entity);
@@ -100,14 +131,35 @@ void EnemyComponent::checkPhases(EntityCreationQueue& queue, SpriteLoader& sprit
 			if (currentPhase->getPlayMusic()) {
 				levelPack.playMusic(currentPhase->getMusicSettings());
 			}
+			// Start opening the next phase's music in the background so that the next phase change only has to start playing it
+			if (currentPhaseIndex + 1 < enemyData->getPhasesCount()) {
+				std::shared_ptr<EditorEnemyPhase> nextPhase = levelPack.getEnemyPhase(std::get<1>(enemyData->getPhaseData(currentPhaseIndex + 1)));
+				if (nextPhase->getPlayMusic()) {
+					levelPack.prefetchMusic(nextPhase->getMusicSettings());
+				}
+			}
 
 			checkAttackPatterns(queue, spriteLoader, levelPack, registry, entity);
+			scheduleChanged = true;
 		} else {
+			// Remember the condition's inputs so it isn't evaluated again until one of them changes
+			nextPhaseConditionEvaluated = true;
+			phaseCheckDue = false;
+			phaseScheduleChanged = true;
+			nextPhaseCheckTime = std::get<0>(nextPhaseData)->getEarliestSatisfiedTime();
+			nextPhaseCheckHealthChangeCount = registry.get<HealthComponent>(entity).getChangeCount();
+			nextPhaseCheckEnemiesAliveCount = registry.get<LevelManagerTag>().getEnemiesAliveCount();
 			break;
 		}
 	}
 }
 
+bool EnemyComponent::nextPhaseConditionMayHaveChanged(entt::DefaultRegistry& registry, uint32_t entity) const {
+	return !nextPhaseConditionEvaluated || phaseCheckDue
+		|| registry.get<HealthComponent>(entity).getChangeCount() != nextPhaseCheckHealthChangeCount
+		|| registry.get<LevelManagerTag>().getEnemiesAliveCount() != nextPhaseCheckEnemiesAliveCount;
+}
+
 void EnemyComponent::checkAttackPatterns(EntityCreationQueue& queue, SpriteLoader& spriteLoader, const LevelPack& levelPack, entt::DefaultRegistry& registry, uint32_t entity) {
 	// Attack patterns loop, so entity can always continue to the next attack pattern
 	while (currentPhase && checkNextAttackPattern) {
@@ -27,6 +27,7 @@ std::shared_ptr<entt::SigH<void(int, int)>> HealthComponent::getHPChangeSignal()
 }
 
 void HealthComponent::onHealthChange() {
+	changeCount++;
 	if (onHealthChangeSignal) {
 		onHealthChangeSignal->publish(health, maxHealth);
 	}
@@ -42,8 +43,10 @@ int HealthComponent::getMaxHealth() const {
 
 void HealthComponent::setHealth(int health) { 
 	this->health = health;
+	changeCount++;
 }
 
 void HealthComponent::setMaxHealth(int maxHealth) { 
 	this->maxHealth = maxHealth;
+	changeCount++;
 }
\ No newline at end of file
@@ -1,23 +1,18 @@
 #include <Game/Components/HitboxComponent.h>
 
+#include <cmath>
+
 #include <Util/MathUtils.h>
 #include <LevelPack/Animatable.h>
+#include <Game/Components/PositionComponent.h>
 
 HitboxComponent::HitboxComponent(ROTATION_TYPE rotationType, float radius, float x, float y) 
 	: rotationType(rotationType), radius(radius), x(x), y(y), unrotatedX(x), unrotatedY(y) {
+	rotationInvariant = rotationType == ROTATION_TYPE::LOCK_ROTATION || (unrotatedX == 0 && unrotatedY == 0);
 }
 
-HitboxComponent::HitboxComponent(float radius, std::shared_ptr<sf::Sprite> sprite) 
-	: radius(radius) {
-	rotate(sprite);
-
-	// Rotate sprite to angle 0 to find unrotatedX/Y, then rotate sprite back
-	auto oldAngle = sprite->getRotation();
-	sprite->setRotation(0);
-	auto transformed = sprite->getTransform().transformPoint(sprite->getOrigin());
-	unrotatedX = transformed.x;
-	unrotatedY = transformed.y;
-	sprite->setRotation(oldAngle);
+HitboxComponent::HitboxComponent(float radius) 
+	: radius(radius), unrotatedX(0), unrotatedY(0), rotationInvariant(true) {
 }
 
 void HitboxComponent::update(float deltaTime) {
@@ -28,8 +23,12 @@ void HitboxComponent::disable(float time) {
 	hitboxDisabledTimeLeft = std::max(time, hitboxDisabledTimeLeft);
 }
 
+void HitboxComponent::disablePermanently() {
+	permanentlyDisabled = true;
+}
+
 bool HitboxComponent::isDisabled() const {
-	return hitboxDisabledTimeLeft > 0 || radius <= 0;
+	return permanentlyDisabled || hitboxDisabledTimeLeft > 0 || radius <= 0;
 }
 
 void HitboxComponent::setRadius(float radius) {
@@ -37,41 +36,93 @@ void HitboxComponent::setRadius(float radius) {
 }
 
 void HitboxComponent::rotate(float angle) {
-	if (unrotatedX == unrotatedY == 0) return;
+	if (rotationInvariant) return;
+
+	if (rotationType == ROTATION_TYPE::ROTATE_WITH_MOVEMENT) {
+		rotate(angle, std::sin(angle), std::cos(angle));
+	} else {
+		// sin and cos are only used by ROTATE_WITH_MOVEMENT
+		rotate(angle, 0, 1);
+	}
+}
+
+void HitboxComponent::rotate(float angle, float sin, float cos) {
+	if (rotationInvariant) return;
 
 	if (rotationType == ROTATION_TYPE::ROTATE_WITH_MOVEMENT) {
-		float sin = std::sin(angle);
-		float cos = std::cos(angle);
 		x = unrotatedX * cos - unrotatedY * sin;
 		y = unrotatedX * sin + unrotatedY * cos;
+		capsuleHalfX = unrotatedCapsuleHalfX * cos - unrotatedCapsuleHalfY * sin;
+		capsuleHalfY = unrotatedCapsuleHalfX * sin + unrotatedCapsuleHalfY * cos;
 	} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION) {
 		// Do nothing
 	} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION_AND_FACE_HORIZONTAL_MOVEMENT) {
 		// Flip across y-axis if facing left
 		if (angle < -PI / 2.0f || angle > PI / 2.0f) {
 			y = -unrotatedY;
+			capsuleHalfY = -unrotatedCapsuleHalfY;
 		} else if (angle > -PI / 2.0f && angle < PI / 2.0f) {
 			y = unrotatedY;
+			capsuleHalfY = unrotatedCapsuleHalfY;
 		}
 		// Do nothing (maintain last value) if angle is a perfect 90 or -90 degree angle
 	}
 }
 
-void HitboxComponent::rotate(std::shared_ptr<sf::Sprite> sprite) {
-	if (unrotatedX == unrotatedY == 0) return;
+void HitboxComponent::setCapsule(float startX, float startY, float endX, float endY) {
+	capsule = true;
+	unrotatedX = (startX + endX) / 2.0f;
+	unrotatedY = (startY + endY) / 2.0f;
+	unrotatedCapsuleHalfX = (endX - startX) / 2.0f;
+	unrotatedCapsuleHalfY = (endY - startY) / 2.0f;
+	x = unrotatedX;
+	y = unrotatedY;
+	capsuleHalfX = unrotatedCapsuleHalfX;
+	capsuleHalfY = unrotatedCapsuleHalfY;
+	rotationInvariant = rotationType == ROTATION_TYPE::LOCK_ROTATION;
+}
 
-	auto oldPos = sprite->getPosition();
-	sprite->setPosition(0, 0);
-	auto transformed = sprite->getTransform().transformPoint(sprite->getOrigin());
-	x = transformed.x;
-	y = transformed.y;
-	sprite->setPosition(oldPos);
+bool HitboxComponent::updateSweep(const PositionComponent& position) {
+	if (capsule) {
+		// A capsule is usually far longer than the distance it moves in one update,
+		// so it doesn't need to be swept
+		sweeping = false;
+		return false;
+	}
+
+	sf::Vector2f current(position.getX(), position.getY());
+	sweepStart = hasLastPosition ? lastPosition : current;
+	lastPosition = current;
+	hasLastPosition = true;
+
+	float dx = current.x - sweepStart.x;
+	float dy = current.y - sweepStart.y;
+	float distanceSquared = dx * dx + dy * dy;
+	sweeping = distanceSquared > 0 && (continuousCollision || distanceSquared > radius * radius);
+	return sweeping;
+}
+
+void HitboxComponent::resetSweep() {
+	hasLastPosition = false;
+	sweeping = false;
+}
+
+bool HitboxComponent::updateLargeObject(float largeObjectMinRadius) {
+	bool wasLargeObject = largeObject;
+	bool wasKnown = largeObjectKnown;
+	largeObject = radius >= largeObjectMinRadius;
+	largeObjectKnown = true;
+	return !wasKnown || largeObject != wasLargeObject;
 }
 
 float HitboxComponent::getRadius() const { 
 	return radius;
 }
 
+float HitboxComponent::getBoundingRadius() const {
+	return radius + std::sqrt(capsuleHalfX * capsuleHalfX + capsuleHalfY * capsuleHalfY);
+}
+
 float HitboxComponent::getX() const { 
 	return x;
 }
@@ -6,6 +6,7 @@
 #include <LevelPack/Level.h>
 #include <Game/EntityCreationQueue.h>
 #include <Game/GameInstance.h>
+#include <Constants.h>
 
 LevelManagerTag::LevelManagerTag(LevelPack* levelPack, std::shared_ptr<Level> level, GameInstance* gameInstance) : levelPack(levelPack), level(level), gameInstance(gameInstance) {
 }
@@ -24,11 +25,18 @@ void LevelManagerTag::update(EntityCreationQueue& queue, SpriteLoader& spriteLoa
 	timeSinceStartOfLevel += deltaTime;
 	timeSinceLastEnemySpawn += deltaTime;
 
+	// EPSILON so that floating point error in getEarliestConditionSatisfiedTime() can only make the check early, never late
+	if (!nextEventConditionDirty && timeSinceStartOfLevel + EPSILON < nextEventCheckTime) {
+		return;
+	}
+	nextEventConditionDirty = false;
+
 	while (currentLevelEventsIndex + 1 < level->getEventsCount()) {
 		if (level->conditionSatisfied(currentLevelEventsIndex + 1, registry)) {
 			level->executeEvent(currentLevelEventsIndex + 1, spriteLoader, *levelPack, registry, queue);
 			currentLevelEventsIndex++;
 		} else {
+			nextEventCheckTime = level->getEarliestConditionSatisfiedTime(currentLevelEventsIndex + 1, registry);
 			break;
 		}
 	}
@@ -72,11 +80,18 @@ std::shared_ptr<entt::SigH<void(uint32_t)>> LevelManagerTag::getEnemySpawnSignal
 
 void LevelManagerTag::onEnemySpawn(uint32_t enemy) {
 	timeSinceLastEnemySpawn = 0;
+	enemiesAliveCount++;
+	nextEventConditionDirty = true;
 	if (enemySpawnSignal) {
 		enemySpawnSignal->publish(enemy);
 	}
 }
 
+void LevelManagerTag::onEnemyDespawn(uint32_t enemy) {
+	enemiesAliveCount--;
+	nextEventConditionDirty = true;
+}
+
 void LevelManagerTag::addPoints(int amount) {
 	points += amount;
 	onPointsChange();
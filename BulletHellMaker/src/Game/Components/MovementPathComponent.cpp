@@ -1,6 +1,9 @@
 #include <Game/Components/MovementPathComponent.h>
 
+#include <algorithm>
+
 #include <Game/Components/PositionComponent.h>
+#include <Game/Components/HitboxComponent.h>
 #include <Game/EntityCreationQueue.h>
 #include <LevelPack/EditorMovablePoint.h>
 #include <LevelPack/EditorMovablePointAction.h>
@@ -8,7 +11,7 @@
 
 MovementPathComponent::MovementPathComponent(EntityCreationQueue& queue, uint32_t self, entt::DefaultRegistry& registry, uint32_t entity, 
 	std::shared_ptr<EMPSpawnType> spawnType, std::vector<std::shared_ptr<EMPAction>> actions, float initialTime) 
-	: actions(actions), time(initialTime) {
+	: actions(actions), time(initialTime), lifetime(initialTime) {
 	initialSpawn(registry, entity, spawnType, actions);
 	// Can call update with deltaTime of 0 because time was initialized to initialTime already
 	update(queue, registry, self, registry.get<PositionComponent>(self), 0);
@@ -16,7 +19,7 @@ MovementPathComponent::MovementPathComponent(EntityCreationQueue& queue, uint32_
 
 MovementPathComponent::MovementPathComponent(EntityCreationQueue& queue, uint32_t self, entt::DefaultRegistry& registry, uint32_t entity, 
 	MPSpawnInformation spawnInfo, std::vector<std::shared_ptr<EMPAction>> actions, float initialTime) 
-	: actions(actions), time(initialTime) {
+	: actions(actions), time(initialTime), lifetime(initialTime) {
 	initialSpawn(registry, entity, spawnInfo, actions);
 	// Can call update with deltaTime of 0 because time was initialized to initialTime already
 	update(queue, registry, self, registry.get<PositionComponent>(self), 0);
@@ -24,6 +27,7 @@ MovementPathComponent::MovementPathComponent(EntityCreationQueue& queue, uint32_
 
 void MovementPathComponent::update(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, PositionComponent& entityPosition, float deltaTime) {
 	time += deltaTime;
+	lifetime += deltaTime;
 	sf::Vector2f tempReference(0, 0);
 	// While loop for actions with lifespan of 0 like DetachFromParent 
 	while (currentActionsIndex < actions.size() && time >= path->getLifespan()) {
@@ -36,8 +40,8 @@ void MovementPathComponent::update(EntityCreationQueue& queue, entt::DefaultRegi
 		}
 
 		time -= path->getLifespan();
-		previousPaths.push_back(path);
 		path = actions[currentActionsIndex]->execute(queue, registry, entity, time);
+		homingPath = dynamic_cast<HomingMP*>(path.get());
 		currentActionsIndex++;
 
 		tempReference.x = entityPosition.getX();
@@ -60,61 +64,36 @@ void MovementPathComponent::update(EntityCreationQueue& queue, entt::DefaultRegi
 			entityPosition.setPosition(path->compute(tempReference, path->getLifespan()));
 		}
 	}
+
+	positionHistory.record(lifetime, sf::Vector2f(entityPosition.getX(), entityPosition.getY()));
 }
 
 sf::Vector2f MovementPathComponent::getPreviousPosition(entt::DefaultRegistry& registry, float secondsAgo) const {
-	// This function assumes that if a reference entity has no MovementPathComponent, it has stayed in the same position its entire lifespan
-
-	float curTime = time - secondsAgo;
-	// Account for float inaccuracies
-	if (curTime >= -0.0001f) {
-		// this component's entity was on the same path [secondsAgo] seconds ago
-
-		// curTime was probably supposed to be 0 but ended up being < 0 from float inaccuracies, so set it to 0
-		if (curTime < 0) {
-			curTime = 0;
-		}
+	float pastLifetime = lifetime - secondsAgo;
+	if (!positionHistory.isEmpty() && pastLifetime >= positionHistory.getOldestTime()) {
+		return positionHistory.get(pastLifetime);
+	}
 
-		if (useReferenceEntity) {
-			if (registry.has<MovementPathComponent>(referenceEntity)) {
-				auto pos = registry.get<MovementPathComponent>(referenceEntity).getPreviousPosition(registry, secondsAgo);
-				return path->compute(sf::Vector2f(pos.x, pos.y), curTime);
-			} else {
-				auto& pos = registry.get<PositionComponent>(referenceEntity);
-				return path->compute(sf::Vector2f(pos.getX(), pos.getY()), curTime);
-			}
+	// The history doesn't go back that far, so compute it from the current path.
+	// Previous paths are not kept, so anything before the current path began clamps to its start.
+	float pathTime = std::max(0.0f, time - secondsAgo);
+	if (useReferenceEntity) {
+		// This function assumes that if a reference entity has no MovementPathComponent, it has stayed in the same position its entire lifespan
+		if (registry.has<MovementPathComponent>(referenceEntity)) {
+			return path->compute(registry.get<MovementPathComponent>(referenceEntity).getPreviousPosition(registry, secondsAgo), pathTime);
 		} else {
-			return path->compute(sf::Vector2f(0, 0), curTime);
+			auto& pos = registry.get<PositionComponent>(referenceEntity);
+			return path->compute(sf::Vector2f(pos.getX(), pos.getY()), pathTime);
 		}
 	} else {
-		int curPathIndex = previousPaths.size();
-		while (curTime < 0 && curPathIndex - 1 >= 0) {
-			assert(curPathIndex - 1 >= 0 && "Somehow looking back in the past too far");
-			curTime += previousPaths[curPathIndex - 1]->getLifespan();
-			curPathIndex--;
-		}
-
-		if (useReferenceEntity) {
-			if (registry.has<MovementPathComponent>(referenceEntity)) {
-				auto pos = registry.get<MovementPathComponent>(referenceEntity).getPreviousPosition(registry, secondsAgo);
-				return previousPaths[curPathIndex]->compute(sf::Vector2f(pos.x, pos.y), curTime);
-			} else {
-				auto& pos = registry.get<PositionComponent>(referenceEntity);
-				return previousPaths[curPathIndex]->compute(sf::Vector2f(pos.getX(), pos.getY()), curTime);
-			}
-		} else {
-			return previousPaths[curPathIndex]->compute(sf::Vector2f(0, 0), curTime);
-		}
+		return path->compute(sf::Vector2f(0, 0), pathTime);
 	}
 }
 
 void MovementPathComponent::setPath(EntityCreationQueue& queue, entt::DefaultRegistry& registry, uint32_t entity, PositionComponent& entityPosition, std::shared_ptr<MovablePoint> newPath, float timeLag) {
-	// Put old path into history
-
-	// Since the old path ended unexpectedly, change its lifespan
-	path->setLifespan(time - timeLag);
-	previousPaths.push_back(path);
 	path = newPath;
+	homingPath = dynamic_cast<HomingMP*>(path.get());
+	resetHitboxSweep(registry, entity);
 
 	time = timeLag;
 	update(queue, registry, entity, entityPosition, 0);
@@ -137,9 +116,16 @@ void MovementPathComponent::initialSpawn(entt::DefaultRegistry& registry, uint32
 	path = std::make_shared<StationaryMP>(spawnInfo.position, 0);
 }
 
-void MovementPathComponent::setReferenceEntity(uint32_t reference) {
+void MovementPathComponent::setReferenceEntity(entt::DefaultRegistry& registry, uint32_t entity, uint32_t reference) {
 	useReferenceEntity = true;
 	referenceEntity = reference;
+	resetHitboxSweep(registry, entity);
+}
+
+void MovementPathComponent::resetHitboxSweep(entt::DefaultRegistry& registry, uint32_t entity) {
+	if (registry.has<HitboxComponent>(entity)) {
+		registry.get<HitboxComponent>(entity).resetSweep();
+	}
 }
 
 bool MovementPathComponent::usesReferenceEntity() const { 
@@ -154,6 +140,10 @@ std::shared_ptr<MovablePoint> MovementPathComponent::getPath() const {
 	return path;
 }
 
+HomingMP* MovementPathComponent::getHomingPath() const {
+	return homingPath;
+}
+
 float MovementPathComponent::getTime() const { 
 	return time;
 }
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include <Game/Components/OffScreenComponent.h>
+
+OffScreenComponent::OffScreenComponent(OffScreenPolicy policy) : action(policy.getAction()), margin(policy.getMargin()) {
+}
+
+OFF_SCREEN_ACTION OffScreenComponent::getAction() const {
+	return action;
+}
+
+float OffScreenComponent::getMargin() const {
+	return margin;
+}
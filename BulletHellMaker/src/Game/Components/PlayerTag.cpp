@@ -5,6 +5,7 @@
 #include <LevelPack/Attack.h>
 #include <LevelPack/AttackPattern.h>
 #include <Game/Components/SpriteComponent.h>
+#include <Game/Components/AnimatedSpriteComponent.h>
 #include <Game/Components/HitboxComponent.h>
 #include <Game/EntityCreationQueue.h>
 #include <DataStructs/SpriteLoader.h>
@@ -110,7 +111,8 @@ void PlayerTag::activateBomb(entt::DefaultRegistry& registry, uint32_t self) {
 		// Make player invincible for some time
 		registry.get<HitboxComponent>(self).disable(bombInvincibilityTime);
 		auto& sprite = registry.get<SpriteComponent>(self);
-		sprite.setEffectAnimation(std::make_unique<FlashWhiteSEA>(sprite.getSprite(), bombInvincibilityTime));
+		sprite.setEffectAnimation(std::make_unique<FlashWhiteSEA>(bombInvincibilityTime));
+		AnimatedSpriteComponent::markIfAnimated(registry, self);
 	}
 }
 
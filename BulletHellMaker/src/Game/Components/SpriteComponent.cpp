@@ -1,5 +1,7 @@
 #include <Game/Components/SpriteComponent.h>
 
+#include <cmath>
+
 #include <Util/MathUtils.h>
 #include <LevelPack/Animatable.h>
 #include <DataStructs/SpriteEffectAnimation.h>
@@ -13,68 +15,46 @@ SpriteComponent::SpriteComponent(SpriteLoader& spriteLoader, Animatable animatab
 	: renderLayer(renderLayer), subLayer(subLayer) {
 	setAnimatable(spriteLoader, animatable, loopAnimatable);
 	if (animatable.isSprite()) {
-		originalSprite = sprite;
+		originalSpriteTemplate = spriteTemplate;
 	}
 }
-SpriteComponent::SpriteComponent(ROTATION_TYPE rotationType, std::shared_ptr<sf::Sprite> sprite, int renderLayer, float subLayer) 
-	: renderLayer(renderLayer), subLayer(subLayer), rotationType(rotationType), sprite(sprite), originalSprite(sprite) {
+SpriteComponent::SpriteComponent(ROTATION_TYPE rotationType, std::shared_ptr<const SpriteTemplate> spriteTemplate, SpriteInstance instance, int renderLayer, float subLayer) 
+	: renderLayer(renderLayer), subLayer(subLayer), rotationType(rotationType), spriteTemplate(spriteTemplate), originalSpriteTemplate(spriteTemplate), 
+	instance(instance), tint(instance.tint) {
 }
 
 void SpriteComponent::update(float deltaTime) {
-	if (animation != nullptr) {
-		auto newSprite = animation->update(deltaTime);
+	if (animation.hasClip() && !animation.isDone()) {
+		const std::shared_ptr<const SpriteTemplate>& newSprite = animation.update(deltaTime);
 		if (newSprite == nullptr) {
 			// Animation is finished, so revert back to original sprite
-			if (originalSprite) {
-				updateSprite(*originalSprite);
-			} else {
-				updateSprite(nullptr);
-			}
+			updateSprite(originalSpriteTemplate);
 		} else {
 			updateSprite(newSprite);
 		}
 	}
-	if (sprite) {
-		if (effectAnimation != nullptr) {
-			effectAnimation->update(deltaTime);
+	if (effectAnimation != nullptr) {
+		if (spriteTemplate) {
+			effectAnimation->update(deltaTime, *spriteTemplate, instance);
 		}
-
-		// Rotate sprite
-		if (rotationType == ROTATION_TYPE::ROTATE_WITH_MOVEMENT) {
-			// Negative because SFML uses clockwise rotation
-			sprite->setRotation(-rotationAngle * 180.0 / PI);
-		} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION) {
-			// Do nothing
-		} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION_AND_FACE_HORIZONTAL_MOVEMENT) {
-			// Flip across y-axis if facing left
-			auto curScale = sprite->getScale();
-			if (rotationAngle < -PI / 2.0f || rotationAngle > PI / 2.0f) {
-				lastFacedRight = false;
-				if (curScale.x > 0) {
-					sprite->setScale(-1.0f * curScale.x, curScale.y);
-				}
-			} else if (rotationAngle > -PI / 2.0f && rotationAngle < PI / 2.0f) {
-				lastFacedRight = true;
-				if (curScale.x < 0) {
-					sprite->setScale(-1.0f * curScale.x, curScale.y);
-				}
-			} else if ((lastFacedRight && curScale.x < 0) || (!lastFacedRight && curScale.x > 0)) {
-				sprite->setScale(-1.0f * curScale.x, curScale.y);
-			}
-			// Do nothing (maintain last values) if angle is a perfect 90 or -90 degree angle
+		if (effectAnimation->isDone()) {
+			// Whatever the effect did to the sprite instance stays
+			effectAnimation = nullptr;
 		}
 	}
 }
 
 bool SpriteComponent::animationIsDone() const {
-	if (animation) {
-		return animation->isDone();
-	}
-	return true;
+	return !animation.hasClip() || animation.isDone();
+}
+
+bool SpriteComponent::isAnimated() const {
+	return !animationIsDone() || effectAnimation != nullptr;
 }
 
 void SpriteComponent::rotate(float angle) { 
 	rotationAngle = angle;
+	applyRotation();
 }
 
 int SpriteComponent::getRenderLayer() const { 
@@ -85,8 +65,22 @@ float SpriteComponent::getSubLayer() const {
 	return subLayer;
 }
 
-const std::shared_ptr<sf::Sprite> SpriteComponent::getSprite() const { 
-	return sprite;
+sf::Transform SpriteComponent::getTransform() const {
+	// Same as sf::Transformable::getTransform()
+	sf::Vector2f origin = spriteTemplate->getOrigin();
+	sf::Vector2f scale(spriteTemplate->getScale().x * instance.scale.x, spriteTemplate->getScale().y * instance.scale.y);
+	if (stretched) {
+		const sf::IntRect& textureRect = spriteTemplate->getTextureRect();
+		origin = sf::Vector2f(std::abs(textureRect.width) / 2.0f, std::abs(textureRect.height) / 2.0f);
+		scale.x = scale.x < 0 ? -stretchScaleX : stretchScaleX;
+	}
+	sf::Transform transform;
+	transform.translate(instance.position).rotate(instance.rotation).scale(scale).translate(-origin);
+	return transform;
+}
+
+sf::Color SpriteComponent::getColor() const {
+	return spriteTemplate->getColor() * instance.tint;
 }
 
 void SpriteComponent::setAnimatable(SpriteLoader& spriteLoader, Animatable animatable, bool loopAnimatable) {
@@ -94,30 +88,35 @@ void SpriteComponent::setAnimatable(SpriteLoader& spriteLoader, Animatable anima
 
 	if (animatable.isSprite()) {
 		// Cancel current animation
-		setAnimation(nullptr);
-		updateSprite(spriteLoader.getSprite(animatable.getAnimatableName(), animatable.getSpriteSheetName()));
+		setAnimation(Animation());
+		updateSprite(spriteLoader.getSpriteTemplate(animatable.getAnimatableName(), animatable.getSpriteSheetName()));
 	} else {
-		std::unique_ptr<Animation> animation = spriteLoader.getAnimation(animatable.getAnimatableName(), animatable.getSpriteSheetName(), loopAnimatable);
-		if (animation) {
-			setAnimation(std::move(animation));
+		std::shared_ptr<const AnimationClip> clip = spriteLoader.getAnimationClip(animatable.getAnimatableName(), animatable.getSpriteSheetName());
+		if (clip) {
+			setAnimation(Animation(clip, loopAnimatable));
 		} else {
 			// Default to missing sprite
-			setAnimation(nullptr);
-			updateSprite(spriteLoader.getMissingSprite());
+			setAnimation(Animation());
+			updateSprite(spriteLoader.getMissingSpriteTemplate());
 		}
 	}
+	applyRotation();
 }
 
 void SpriteComponent::setEffectAnimation(std::unique_ptr<SpriteEffectAnimation> effectAnimation) { 
 	this->effectAnimation = std::move(effectAnimation);
+	// Effect animations only change the tint and scale; the direction the sprite is facing is kept
+	instance.tint = tint;
+	instance.scale = sf::Vector2f(instance.scale.x < 0 ? -1.0f : 1.0f, 1.0f);
 }
 
-void SpriteComponent::setRotation(float angle) { 
-	sprite->setRotation(angle);
+void SpriteComponent::setPosition(float x, float y) {
+	instance.position = sf::Vector2f(x, y);
 }
 
-void SpriteComponent::setScale(float x, float y) { 
-	sprite->setScale(x, y);
+void SpriteComponent::setTint(sf::Color tint) {
+	this->tint = tint;
+	instance.tint = tint;
 }
 
 bool SpriteComponent::usesShader() const {
@@ -144,32 +143,74 @@ float SpriteComponent::getInheritedRotationAngle() const {
 	return rotationAngle;
 }
 
-void SpriteComponent::updateSprite(sf::Sprite newSprite) { 
-	*sprite = newSprite;
+void SpriteComponent::setStretch(float startX, float startY, float endX, float endY, float radius) {
+	stretched = true;
+	stretchX = (startX + endX) / 2.0f;
+	stretchY = (startY + endY) / 2.0f;
+	stretchAngle = std::atan2(endY - startY, endX - startX);
+	stretchLength = distance(startX, startY, endX, endY) + radius * 2;
+	applyRotation();
+}
+
+sf::Vector2f SpriteComponent::applyStretch(float resolutionMultiplier) {
+	// Animations can change the size of the texture rect every frame, so the scale is found every time.
+	// getTransform() also centers the origin of stretched sprites.
+	stretchScaleX = stretchLength * resolutionMultiplier / std::abs(spriteTemplate->getTextureRect().width);
+
+	// Same as HitboxComponent::rotate()
+	if (rotationType == ROTATION_TYPE::ROTATE_WITH_MOVEMENT) {
+		float sin = std::sin(rotationAngle);
+		float cos = std::cos(rotationAngle);
+		return sf::Vector2f(stretchX * cos - stretchY * sin, stretchX * sin + stretchY * cos);
+	} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION_AND_FACE_HORIZONTAL_MOVEMENT && !lastFacedRight) {
+		return sf::Vector2f(stretchX, -stretchY);
+	}
+	return sf::Vector2f(stretchX, stretchY);
 }
 
-void SpriteComponent::updateSprite(std::shared_ptr<sf::Sprite> newSprite) {
+void SpriteComponent::updateSprite(std::shared_ptr<const SpriteTemplate> newSprite) {
 	if (!newSprite) {
 		return;
 	}
-	
-	if (!sprite) {
-		// SpriteEffectAnimations can change SpriteComponent's Sprite, so create a new Sprite object to avoid 
-		// accidentally modifying the parameter Sprite pointer's object
-		sprite = std::make_shared<sf::Sprite>(*newSprite);
-		if (effectAnimation != nullptr) {
-			effectAnimation->setSpritePointer(sprite);
-		}
-	} else {
-		updateSprite(*newSprite);
-	}
+	// SpriteTemplates are shared and never modified, so nothing needs to be copied
+	spriteTemplate = std::move(newSprite);
 }
 
-void SpriteComponent::setAnimation(std::unique_ptr<Animation> animation) {
-	if (animation) {
-		this->animation = std::move(animation);
-	} else {
-		this->animation = nullptr;
-	}
+void SpriteComponent::setAnimation(Animation animation) {
+	this->animation = std::move(animation);
 	update(0);
+}
+
+void SpriteComponent::applyRotation() {
+	if (rotationType == ROTATION_TYPE::ROTATE_WITH_MOVEMENT) {
+		// Negative because SFML uses clockwise rotation
+		instance.rotation = -(rotationAngle + stretchAngle) * 180.0 / PI;
+	} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION) {
+		if (stretched) {
+			instance.rotation = -stretchAngle * 180.0 / PI;
+		}
+	} else if (rotationType == ROTATION_TYPE::LOCK_ROTATION_AND_FACE_HORIZONTAL_MOVEMENT) {
+		// Flip across y-axis if facing left
+		sf::Vector2f& curScale = instance.scale;
+		if (rotationAngle < -PI / 2.0f || rotationAngle > PI / 2.0f) {
+			lastFacedRight = false;
+			if (curScale.x > 0) {
+				curScale.x *= -1.0f;
+			}
+		} else if (rotationAngle > -PI / 2.0f && rotationAngle < PI / 2.0f) {
+			lastFacedRight = true;
+			if (curScale.x < 0) {
+				curScale.x *= -1.0f;
+			}
+		} else if ((lastFacedRight && curScale.x < 0) || (!lastFacedRight && curScale.x > 0)) {
+			curScale.x *= -1.0f;
+		}
+		// Do nothing (maintain last values) if angle is a perfect 90 or -90 degree angle
+
+		if (stretched) {
+			// HitboxComponent mirrors its segment across the x-axis when facing left. Flipping the sprite's
+			// scale already turns it around, so only the direction of rotation changes.
+			instance.rotation = (lastFacedRight ? -stretchAngle : stretchAngle) * 180.0 / PI;
+		}
+	}
 }
\ No newline at end of file
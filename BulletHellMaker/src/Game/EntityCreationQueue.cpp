@@ -13,10 +13,43 @@
 #include <Constants.h>
 #include <DataStructs/MovablePoint.h>
 #include <LevelPack/LevelPack.h>
+#include <LevelPack/Level.h>
+#include <Util/Profiler.h>
 
 EntityCreationCommand::EntityCreationCommand(entt::DefaultRegistry& registry)
 	: registry(registry) {}
 
+/*
+Gives a bullet an OffScreenComponent if its EMP's or the current level's off-screen policy does anything.
+*/
+static void assignOffScreenComponent(entt::DefaultRegistry& registry, uint32_t bullet, const std::shared_ptr<EditorMovablePoint>& emp) {
+	OffScreenPolicy policy;
+	if (emp->getOverridesOffScreenPolicy()) {
+		policy = emp->getOffScreenPolicy();
+	} else if (registry.has<LevelManagerTag>() && registry.get<LevelManagerTag>().getLevel()) {
+		policy = registry.get<LevelManagerTag>().getLevel()->getOffScreenPolicy();
+	}
+
+	if (policy.getAction() != OFF_SCREEN_ACTION::KEEP) {
+		registry.assign<OffScreenComponent>(bullet, policy);
+	}
+}
+
+/*
+Gives a bullet its HitboxComponent. Capsule bullets also get their sprite stretched over the capsule.
+*/
+static void assignBulletHitboxComponent(entt::DefaultRegistry& registry, uint32_t bullet, const std::shared_ptr<EditorMovablePoint>& emp, SpriteComponent& sprite) {
+	if (emp->isCapsule()) {
+		auto& hitbox = registry.assign<HitboxComponent>(bullet, sprite.getRotationType(), emp->getHitboxRadius(), 0, 0);
+		hitbox.setCapsule(0, 0, emp->getCapsuleEndX(), emp->getCapsuleEndY());
+		if (sprite.hasSprite()) {
+			sprite.setStretch(0, 0, emp->getCapsuleEndX(), emp->getCapsuleEndY(), emp->getHitboxRadius());
+		}
+	} else {
+		registry.assign<HitboxComponent>(bullet, emp->getHitboxRadius());
+	}
+}
+
 
 EMPSpawnFromEnemyCommand::EMPSpawnFromEnemyCommand(entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, std::shared_ptr<EditorMovablePoint> emp, bool isMainEMP, uint32_t entity, float timeLag, int attackID, int attackPatternID, int enemyID, int enemyPhaseID, bool playAttackAnimation) :
 	EntityCreationCommand(registry), spriteLoader(spriteLoader), emp(emp), isMainEMP(isMainEMP), playAttackAnimation(playAttackAnimation),
@@ -24,9 +57,13 @@ EMPSpawnFromEnemyCommand::EMPSpawnFromEnemyCommand(entt::DefaultRegistry& regist
 }
 
 void EMPSpawnFromEnemyCommand::execute(EntityCreationQueue& queue) {
+	// Average time to spawn a bullet, logged along with the rest of the level's stats
+	ProfilerTimer timer("Bullet spawn");
+
 	// Change AnimatableSetComponent state to attack state
 	if (playAttackAnimation) {
 		registry.get<AnimatableSetComponent>(entity).changeState(AnimatableSetComponent::ENTITY_ANIMATION_STATE::ATTACKING, spriteLoader, registry.get<SpriteComponent>(entity));
+		AnimatedSpriteComponent::markIfAnimated(registry, entity);
 	}
 
 	// Create the entity
@@ -64,7 +101,7 @@ void EMPSpawnFromEnemyCommand::execute(EntityCreationQueue& queue) {
 		auto& sprite = registry.assign<SpriteComponent>(bullet, spriteLoader, emp->getBaseSprite(), true, ENEMY_BULLET_LAYER, registry.get<LevelManagerTag>().getTimeSinceStartOfLevel() - timeLag);
 		sprite.setAnimatable(spriteLoader, animatable, emp->getLoopAnimation());
 		if (emp->getIsBullet()) {
-			registry.assign<HitboxComponent>(bullet, emp->getHitboxRadius(), sprite.getSprite());
+			assignBulletHitboxComponent(registry, bullet, emp, sprite);
 		} else {
 			registry.assign<HitboxComponent>(bullet, ROTATION_TYPE::LOCK_ROTATION, 0, 0, 0);
 		}
@@ -72,14 +109,17 @@ void EMPSpawnFromEnemyCommand::execute(EntityCreationQueue& queue) {
 		Animatable animatable = emp->getAnimatable();
 		auto& sprite = registry.assign<SpriteComponent>(bullet, spriteLoader, animatable, emp->getLoopAnimation(), ENEMY_BULLET_LAYER, registry.get<LevelManagerTag>().getTimeSinceStartOfLevel() - timeLag);
 		if (emp->getIsBullet()) {
-			registry.assign<HitboxComponent>(bullet, emp->getHitboxRadius(), sprite.getSprite());
+			assignBulletHitboxComponent(registry, bullet, emp, sprite);
 		} else {
 			registry.assign<HitboxComponent>(bullet, ROTATION_TYPE::LOCK_ROTATION, 0, 0, 0);
 		}
 	}
+	AnimatedSpriteComponent::markIfAnimated(registry, bullet);
 
 	if (emp->getIsBullet()) {
 		registry.assign<EnemyBulletComponent>(bullet, attackID, attackPatternID, enemyID, enemyPhaseID, emp->getDamage(), emp->getOnCollisionAction(), emp->getPierceResetTime());
+		registry.get<HitboxComponent>(bullet).setContinuousCollision(emp->getContinuousCollision());
+		assignOffScreenComponent(registry, bullet, emp);
 	}
 
 	registry.assign<MovementPathComponent>(bullet, queue, bullet, registry, entity, emp->getSpawnType(), emp->getActions(), timeLag);
@@ -114,9 +154,13 @@ EMPSpawnFromPlayerCommand::EMPSpawnFromPlayerCommand(entt::DefaultRegistry& regi
 }
 
 void EMPSpawnFromPlayerCommand::execute(EntityCreationQueue& queue) {
+	// Average time to spawn a bullet, logged along with the rest of the level's stats
+	ProfilerTimer timer("Bullet spawn");
+
 	// Change AnimatableSetComponent state to attack state
 	if (playAttackAnimation) {
 		registry.get<AnimatableSetComponent>(entity).changeState(AnimatableSetComponent::ENTITY_ANIMATION_STATE::ATTACKING, spriteLoader, registry.get<SpriteComponent>(entity));
+		AnimatedSpriteComponent::markIfAnimated(registry, entity);
 	}
 	
 	// Create the entity
@@ -154,7 +198,7 @@ void EMPSpawnFromPlayerCommand::execute(EntityCreationQueue& queue) {
 		auto& sprite = registry.assign<SpriteComponent>(bullet, spriteLoader, emp->getBaseSprite(), true, PLAYER_BULLET_LAYER, registry.get<LevelManagerTag>().getTimeSinceStartOfLevel() - timeLag);
 		sprite.setAnimatable(spriteLoader, animatable, emp->getLoopAnimation());
 		if (emp->getIsBullet()) {
-			registry.assign<HitboxComponent>(bullet, emp->getHitboxRadius(), sprite.getSprite());
+			assignBulletHitboxComponent(registry, bullet, emp, sprite);
 		} else {
 			registry.assign<HitboxComponent>(bullet, ROTATION_TYPE::LOCK_ROTATION, 0, 0, 0);
 		}
@@ -163,14 +207,17 @@ void EMPSpawnFromPlayerCommand::execute(EntityCreationQueue& queue) {
 		Animatable animatable = emp->getAnimatable();
 		auto& sprite = registry.assign<SpriteComponent>(bullet, spriteLoader, animatable, emp->getLoopAnimation(), PLAYER_BULLET_LAYER, registry.get<LevelManagerTag>().getTimeSinceStartOfLevel() - timeLag);
 		if (emp->getIsBullet()) {
-			registry.assign<HitboxComponent>(bullet, emp->getHitboxRadius(), sprite.getSprite());
+			assignBulletHitboxComponent(registry, bullet, emp, sprite);
 		} else {
 			registry.assign<HitboxComponent>(bullet, ROTATION_TYPE::LOCK_ROTATION, 0, 0, 0);
 		}
 	}
+	AnimatedSpriteComponent::markIfAnimated(registry, bullet);
 
 	if (emp->getIsBullet()) {
 		registry.assign<PlayerBulletComponent>(bullet, attackID, attackPatternID, emp->getDamage(), emp->getOnCollisionAction(), emp->getPierceResetTime());
+		registry.get<HitboxComponent>(bullet).setContinuousCollision(emp->getContinuousCollision());
+		assignOffScreenComponent(registry, bullet, emp);
 	}
 
 	registry.assign<MovementPathComponent>(bullet, queue, bullet, registry, entity, emp->getSpawnType(), emp->getActions(), timeLag);
@@ -211,7 +258,7 @@ void EMPADetachFromParentCommand::execute(EntityCreationQueue& queue) {
 	registry.assign<PositionComponent>(reference, lastPosX, lastPosY);
 	// Reference despawns when the entity executing this action despawns
 	registry.assign<DespawnComponent>(reference, registry, entity, reference);
-	mpc.setReferenceEntity(reference);
+	mpc.setReferenceEntity(registry, entity, reference);
 	// Update position
 	registry.get<PositionComponent>(entity).setPosition(mpc.getPath()->compute(sf::Vector2f(lastPosX, lastPosY), mpc.getTime()));
 }
@@ -256,7 +303,7 @@ void CreateMovementReferenceEntityCommand::execute(EntityCreationQueue& queue) {
 			// Reference despawns when the entity executing this action despawns
 			registry.assign<DespawnComponent>(reference, registry, entity, reference);
 
-			mpc.setReferenceEntity(reference);
+			mpc.setReferenceEntity(registry, entity, reference);
 		}
 	} else {
 		// If the entity has no reference, create a new simple reference for it
@@ -269,7 +316,7 @@ void CreateMovementReferenceEntityCommand::execute(EntityCreationQueue& queue) {
 		// Reference despawns when the entity executing this action despawns
 		registry.assign<DespawnComponent>(reference, registry, entity, reference);
 
-		mpc.setReferenceEntity(reference);
+		mpc.setReferenceEntity(registry, entity, reference);
 	}
 
 	// Update position
@@ -304,23 +351,26 @@ void SpawnEnemyCommand::execute(EntityCreationQueue & queue) {
 	registry.assign<AnimatableSetComponent>(enemy);
 	registry.assign<ShadowTrailComponent>(enemy, 0, 0);
 
-	registry.get<LevelManagerTag>().onEnemySpawn(enemy);
+	auto& levelManager = registry.get<LevelManagerTag>();
+	registry.get<DespawnComponent>(enemy).getDespawnSignal()->sink().connect<LevelManagerTag, &LevelManagerTag::onEnemyDespawn>(&levelManager);
+	levelManager.onEnemySpawn(enemy);
 }
 
 int SpawnEnemyCommand::getEntitiesQueuedCount() {
 	return 1;
 }
 
-SpawnShadowTrailCommand::SpawnShadowTrailCommand(entt::DefaultRegistry& registry, sf::Sprite sprite, float x, float y, float shadowRotationAngle, float shadowLifespan)
-	: EntityCreationCommand(registry), sprite(sprite), x(x), y(y), angle(shadowRotationAngle), shadowLifespan(shadowLifespan) {
+SpawnShadowTrailCommand::SpawnShadowTrailCommand(entt::DefaultRegistry& registry, std::shared_ptr<const SpriteTemplate> spriteTemplate, SpriteInstance spriteInstance, float x, float y, float shadowRotationAngle, float shadowLifespan)
+	: EntityCreationCommand(registry), spriteTemplate(spriteTemplate), spriteInstance(spriteInstance), x(x), y(y), angle(shadowRotationAngle), shadowLifespan(shadowLifespan) {
 }
 
 void SpawnShadowTrailCommand::execute(EntityCreationQueue & queue) {
 	auto shadow = registry.create();
 	registry.assign<PositionComponent>(shadow, x, y);
-	// Make a copy of the sprite to be the shadow's sprite
-	auto& spriteComponent = registry.assign<SpriteComponent>(shadow, ROTATION_TYPE::LOCK_ROTATION, std::make_shared<sf::Sprite>(sprite), SHADOW_LAYER, registry.get<LevelManagerTag>().getTimeSinceStartOfLevel());
-	spriteComponent.setEffectAnimation(std::make_unique<FadeAwaySEA>(spriteComponent.getSprite(), 0, SHADOW_TRAIL_MAX_OPACITY, shadowLifespan));
+	// Show the sprite as it looked when the shadow was queued
+	auto& spriteComponent = registry.assign<SpriteComponent>(shadow, ROTATION_TYPE::LOCK_ROTATION, spriteTemplate, spriteInstance, SHADOW_LAYER, registry.get<LevelManagerTag>().getTimeSinceStartOfLevel());
+	spriteComponent.setEffectAnimation(std::make_unique<FadeAwaySEA>(0, SHADOW_TRAIL_MAX_OPACITY, shadowLifespan));
+	AnimatedSpriteComponent::markIfAnimated(registry, shadow);
 	registry.assign<DespawnComponent>(shadow, shadowLifespan);
 }
 
@@ -345,7 +395,8 @@ void EMPDropItemCommand::execute(EntityCreationQueue & queue) {
 		registry.assign<CollectibleComponent>(itemEntity, item, item->getActivationRadius());
 		registry.assign<DespawnComponent>(itemEntity, ITEM_DESPAWN_TIME);
 		auto& sprite = registry.assign<SpriteComponent>(itemEntity, spriteLoader, item->getAnimatable(), true, ITEM_LAYER, spriteSublayer);
-		registry.assign<HitboxComponent>(itemEntity, item->getHitboxRadius(), sprite.getSprite());
+		AnimatedSpriteComponent::markIfAnimated(registry, itemEntity);
+		registry.assign<HitboxComponent>(itemEntity, item->getHitboxRadius());
 		registry.assign<PositionComponent>(itemEntity, x, y);
 
 		// Movement path mimics an explosion upwards (70-110 degrees) and then dropping down
@@ -356,7 +407,7 @@ void EMPDropItemCommand::execute(EntityCreationQueue & queue) {
 		std::shared_ptr<TFV> explosionAngle = std::make_shared<ConstantTFV>(explosionAngleDistribution(eng));
 		actions.push_back(std::make_shared<MoveCustomPolarEMPA>(explosionDistance, explosionAngle, explosionTime));
 		// Drop down
-		std::shared_ptr<TFV> dropDistance = std::make_shared<DampenedStartTFV>(0, MAP_HEIGHT + 250 + sprite.getSprite()->getOrigin().y, ITEM_DESPAWN_TIME - explosionTime, 10);
+		std::shared_ptr<TFV> dropDistance = std::make_shared<DampenedStartTFV>(0, MAP_HEIGHT + 250 + sprite.getSpriteTemplate()->getOrigin().y, ITEM_DESPAWN_TIME - explosionTime, 10);
 		std::shared_ptr<TFV> dropAngle = std::make_shared<ConstantTFV>(3.0f * PI/2.0f);
 		actions.push_back(std::make_shared<MoveCustomPolarEMPA>(dropDistance, dropAngle, ITEM_DESPAWN_TIME));
 		registry.assign<MovementPathComponent>(itemEntity, queue, itemEntity, registry, NULL, std::make_shared<SpecificGlobalEMPSpawn>(0, x, y), actions, 0);
@@ -389,8 +440,8 @@ void ParticleExplosionCommand::execute(EntityCreationQueue & queue) {
 		registry.assign<DespawnComponent>(particle, particleLifespan);
 		registry.assign<PositionComponent>(particle, sourceX, sourceY);
 		auto& sprite = registry.assign<SpriteComponent>(particle, spriteLoader, animatable, loopAnimatable, PARTICLE_LAYER, spriteSublayer);
-		// Overwrite sprite sheet entry's color
-		sprite.getSprite()->setColor(color);
+		// Tint the sprite sheet entry's color
+		sprite.setTint(color);
 
 		std::vector<std::shared_ptr<EMPAction>> path = { std::make_shared<MoveCustomPolarEMPA>(std::make_shared<LinearTFV>(0, distance(eng), particleLifespan), std::make_shared<ConstantTFV>(angle(eng)), particleLifespan) };
 		registry.assign<MovementPathComponent>(particle, queue, particle, registry, particle, std::make_shared<SpecificGlobalEMPSpawn>(0, sourceX, sourceY), path, 0);
@@ -398,10 +449,11 @@ void ParticleExplosionCommand::execute(EntityCreationQueue & queue) {
 		if (effect == ParticleExplosionDeathAction::PARTICLE_EFFECT::NONE) {
 			// Do nothing
 		} else if (effect == ParticleExplosionDeathAction::PARTICLE_EFFECT::FADE_AWAY) {
-			sprite.setEffectAnimation(std::make_unique<FadeAwaySEA>(sprite.getSprite(), 0, color.a/255.0f, particleLifespan));
+			sprite.setEffectAnimation(std::make_unique<FadeAwaySEA>(0, color.a/255.0f, particleLifespan));
 		} else if (effect == ParticleExplosionDeathAction::PARTICLE_EFFECT::SHRINK) {
-			sprite.setEffectAnimation(std::make_unique<ChangeSizeSEA>(sprite.getSprite(), 1, 0, particleLifespan));
+			sprite.setEffectAnimation(std::make_unique<ChangeSizeSEA>(1, 0, particleLifespan));
 		}
+		AnimatedSpriteComponent::markIfAnimated(registry, particle);
 	}
 }
 
@@ -423,9 +475,9 @@ void PlayDeathAnimatableCommand::execute(EntityCreationQueue & queue) {
 	if (animatable.isSprite()) {
 		registry.assign<DespawnComponent>(newEntity, duration);
 	} else {
-		std::unique_ptr<Animation> animation = spriteLoader.getAnimation(animatable.getAnimatableName(), animatable.getSpriteSheetName(), false);
-		if (animation) {
-			registry.assign<DespawnComponent>(newEntity, animation->getTotalDuration());
+		std::shared_ptr<const AnimationClip> clip = spriteLoader.getAnimationClip(animatable.getAnimatableName(), animatable.getSpriteSheetName());
+		if (clip) {
+			registry.assign<DespawnComponent>(newEntity, clip->getTotalDuration());
 		} else {
 			registry.assign<DespawnComponent>(newEntity, duration);
 		}
@@ -434,10 +486,11 @@ void PlayDeathAnimatableCommand::execute(EntityCreationQueue & queue) {
 	if (effect == PlayAnimatableDeathAction::DEATH_ANIMATION_EFFECT::NONE) {
 		// Do nothing
 	} else if (effect == PlayAnimatableDeathAction::DEATH_ANIMATION_EFFECT::SHRINK) {
-		spriteComponent.setEffectAnimation(std::make_unique<ChangeSizeSEA>(spriteComponent.getSprite(), 0.0f, 1.0f, duration));
+		spriteComponent.setEffectAnimation(std::make_unique<ChangeSizeSEA>(0.0f, 1.0f, duration));
 	} else if (effect == PlayAnimatableDeathAction::DEATH_ANIMATION_EFFECT::FADE_AWAY) {
-		spriteComponent.setEffectAnimation(std::make_unique<FadeAwaySEA>(spriteComponent.getSprite(), 0.0f, spriteComponent.getSprite()->getColor().a, duration));
+		spriteComponent.setEffectAnimation(std::make_unique<FadeAwaySEA>(0.0f, spriteComponent.getSpriteInstance().tint.a / 255.0f, duration));
 	}
+	AnimatedSpriteComponent::markIfAnimated(registry, newEntity);
 
 	auto& oldPos = registry.get<PositionComponent>(dyingEntity);
 	registry.assign<PositionComponent>(newEntity, oldPos.getX(), oldPos.getY());
@@ -13,9 +13,12 @@
 #include <Util/TextFileParser.h>
 #include <Util/StringUtils.h>
 #include <Util/Logger.h>
+#include <Util/Profiler.h>
+#include <Util/ParallelUtils.h>
 #include <DataStructs/SpriteLoader.h>
 #include <DataStructs/TimeFunctionVariable.h>
 #include <DataStructs/MovablePoint.h>
+#include <DataStructs/BakedTrajectory.h>
 #include <LevelPack/LevelPack.h>
 #include <LevelPack/Player.h>
 #include <LevelPack/Level.h>
@@ -142,7 +145,8 @@ GameInstance::GameInstance(std::string levelPackName) {
 	std::lock_guard<std::recursive_mutex> lock(tguiMutex);
 
 	audioPlayer = std::make_unique<AudioPlayer>();
-	levelPack = std::make_unique<LevelPack>(*audioPlayer, levelPackName);
+	// The game only reads the level pack, so it can use the cooked file if there is one
+	levelPack = std::make_unique<LevelPack>(*audioPlayer, levelPackName, nullptr, true);
 
 	if (!levelPack->getAttemptedLoad()) {
 		L_(lerror) << "Failed to instantiate game instance. The level pack did not attempt to load.";
@@ -154,8 +158,9 @@ GameInstance::GameInstance(std::string levelPackName) {
 
 	playerInfo = levelPack->getGameplayPlayer();
 
+	// The level pack started loading its sprite sheets, from the cooked file's metadata if it has one.
+	// Their images are decoded while the rest of the game is set up, and render() uploads them as they finish.
 	spriteLoader = levelPack->getSpriteLoader();
-	spriteLoader->loadFromSpriteSheetsFolder();
 
 	//TODO: these numbers should come from settings
 	window = std::make_unique<sf::RenderWindow>(sf::VideoMode(1600, 900), "Bullet Hell Maker");
@@ -208,6 +213,7 @@ GameInstance::GameInstance(std::string levelPackName) {
 	renderSystem = std::make_unique<RenderSystem>(registry, *window, *spriteLoader, 1.0f);
 	collisionSystem = std::make_unique<CollisionSystem>(*levelPack, *queue, *spriteLoader, registry, MAP_WIDTH, MAP_HEIGHT);
 	despawnSystem = std::make_unique<DespawnSystem>(registry);
+	offScreenSystem = std::make_unique<OffScreenSystem>(registry, MAP_WIDTH, MAP_HEIGHT);
 	enemySystem = std::make_unique<EnemySystem>(*queue, *spriteLoader, *levelPack, registry);
 	spriteAnimationSystem = std::make_unique<SpriteAnimationSystem>(*spriteLoader, registry);
 	shadowTrailSystem = std::make_unique<ShadowTrailSystem>(*queue, registry);
@@ -379,6 +385,7 @@ void GameInstance::physicsUpdate(float deltaTime) {
 		registry.get<LevelManagerTag>().update(*queue, *spriteLoader, registry, deltaTime);
 		queue->executeAll();
 
+		offScreenSystem->update(deltaTime);
 		despawnSystem->update(deltaTime);
 		queue->executeAll();
 
@@ -404,6 +411,10 @@ void GameInstance::physicsUpdate(float deltaTime) {
 }
 
 void GameInstance::render(float deltaTime) {
+	if (spriteLoader->getPendingSpriteSheetsCount() > 0) {
+		spriteLoader->uploadDecodedSpriteSheets();
+	}
+
 	if (!paused) {
 		spriteAnimationSystem->update(deltaTime);
 	}
@@ -445,8 +456,28 @@ void GameInstance::loadLevel(int levelIndex) {
 		return;
 	}
 
+	// Flush stats from whatever was running before this level
+	Profiler::logAndReset("before level " + std::to_string(levelIndex));
+
+	// Paths baked for the previous level are unlikely to be used again
+	BakedTrajectory::clearCache();
+
 	currentLevel = levelPack->getGameplayLevel(levelIndex);
 
+	// Bake every path the level can use now so that executing an EMPA only has to look its path up
+	BakedTrajectory::setEnabled(currentLevel->getBakeTrajectories());
+	if (currentLevel->getBakeTrajectories()) {
+		std::vector<std::shared_ptr<EditorMovablePoint>> emps = levelPack->searchLevelEMPs(levelIndex);
+		parallelFor(emps.size(), [&emps](std::size_t i) {
+			for (std::shared_ptr<EMPAction> action : emps[i]->getActions()) {
+				action->bakeTrajectory();
+			}
+		});
+	}
+
+	// Decode every sound the level can play now rather than the first time each one is played
+	levelPack->preloadSounds(levelPack->searchLevelSoundFileNames(levelIndex));
+
 	// Update relevant gui elements
 	levelNameLabel->setText(currentLevel->getName());
 
@@ -454,6 +485,10 @@ void GameInstance::loadLevel(int levelIndex) {
 	registry.reset();
 	reserveMemory(registry, INITIAL_ENTITY_RESERVATION);
 
+	// Pack every sprite the level can show into texture atlases so that RenderSystem can batch sprites from different sprite sheets.
+	// This has to happen after the registry is reset, since it invalidates the sprites of existing entities.
+	spriteLoader->buildAtlases(levelPack->searchLevelAnimatables(levelIndex));
+
 	// Create the level manager
 	registry.reserve<LevelManagerTag>(1);
 	registry.reserve(registry.alive() + 1);
@@ -469,6 +504,13 @@ void GameInstance::loadLevel(int levelIndex) {
 	// Play level music
 	currentLevelMusic = levelPack->playMusic(currentLevel->getMusicSettings());
 
+	// Open the music of enemies that start playing music as soon as they spawn, so that spawning them doesn't have to.
+	// The music of their later phases is prefetched by EnemyComponent as phases begin.
+	levelPack->clearPrefetchedMusic();
+	for (const MusicSettings& music : levelPack->searchLevelFirstPhaseMusic(levelIndex)) {
+		levelPack->prefetchMusic(music);
+	}
+
 	// Set the background
 	std::shared_ptr<sf::Texture> background = spriteLoader->getBackground(currentLevel->getBackgroundFileName());
 
@@ -490,6 +532,8 @@ void GameInstance::endLevel() {
 
 	// Add points from the level that is ending
 	points += registry.get<LevelManagerTag>().getPoints();
+
+	Profiler::logAndReset("level \"" + currentLevel->getName() + "\"");
 }
 
 void GameInstance::gameOver() {
@@ -8,18 +8,23 @@
 CollectibleSystem::CollectibleSystem(EntityCreationQueue & queue, entt::DefaultRegistry & registry, const LevelPack& levelPack, float mapWidth, float mapHeight) : queue(queue), registry(registry) {
 	itemHitboxTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, levelPack.searchLargestItemCollectionHitbox() * 2.0f);
 	activationTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, levelPack.searchLargestItemActivationHitbox() * 2.0f);
+
+	registry.destruction<CollectibleComponent>().connect<CollectibleSystem, &CollectibleSystem::onCollectibleDestroy>(this);
+}
+
+CollectibleSystem::~CollectibleSystem() {
+	registry.destruction<CollectibleComponent>().disconnect<CollectibleSystem, &CollectibleSystem::onCollectibleDestroy>(this);
 }
 
 void CollectibleSystem::update(float deltaTime) {
 	auto view = registry.view<PositionComponent, HitboxComponent, CollectibleComponent>();
 
-	itemHitboxTable.clear();
-	activationTable.clear();
 	view.each([this](auto entity, auto& pos, auto& hitbox, auto& collectible) {
 		if (collectible.isActivated()) {
-			itemHitboxTable.insert(entity, hitbox, pos);
+			activationTable.remove(entity);
+			itemHitboxTable.update(entity, hitbox, pos);
 		} else {
-			activationTable.insert(entity, hitbox.getX(), hitbox.getY(), collectible.getItem()->getActivationRadius(), pos);
+			activationTable.update(entity, hitbox.getX(), hitbox.getY(), collectible.getItem()->getActivationRadius(), pos);
 		}
 	});
 
@@ -49,4 +54,9 @@ void CollectibleSystem::update(float deltaTime) {
 			}
 		}
 	}
+}
+
+void CollectibleSystem::onCollectibleDestroy(entt::DefaultRegistry& registry, uint32_t entity) {
+	itemHitboxTable.remove(entity);
+	activationTable.remove(entity);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <Game/Systems/CollisionSystem.h>
 
 #include <algorithm>
+#include <cmath>
 
 #include <Util/MathUtils.h>
 #include <LevelPack/LevelPack.h>
@@ -10,6 +11,7 @@
 #include <Game/Components/EnemyComponent.h>
 #include <Game/Components/EnemyBulletComponent.h>
 #include <Game/Components/SpriteComponent.h>
+#include <Game/Components/AnimatedSpriteComponent.h>
 #include <Game/Components/PositionComponent.h>
 #include <Game/Components/HitboxComponent.h>
 #include <Game/EntityCreationQueue.h>
@@ -19,6 +21,12 @@ CollisionSystem::CollisionSystem(LevelPack& levelPack, EntityCreationQueue& queu
 	defaultTableObjectMaxSize = 2.0f * std::max(mapWidth, mapHeight) / 10.0;
 	defaultTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, defaultTableObjectMaxSize/2.0f);
 	largeObjectsTable = SpatialHashTable<uint32_t>(mapWidth, mapHeight, levelPack.searchLargestBulletHitbox() * 2.0f);
+
+	registry.destruction<HitboxComponent>().connect<CollisionSystem, &CollisionSystem::onHitboxDestroy>(this);
+}
+
+CollisionSystem::~CollisionSystem() {
+	registry.destruction<HitboxComponent>().disconnect<CollisionSystem, &CollisionSystem::onHitboxDestroy>(this);
 }
 
 void CollisionSystem::update(float deltaTime) {
@@ -36,55 +44,56 @@ void CollisionSystem::update(float deltaTime) {
 		// only update the player's hitbox
 		playerHitbox.update(deltaTime);
 
-		// largeObjectsTable always contains players and enemies
-		// Insert player
-		if (playerHitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(player, playerHitbox, playerPosition);
-		}
-		largeObjectsTable.insert(player, playerHitbox, playerPosition);
+		updatePlayerOrEnemyInTables(player, playerPosition, playerHitbox);
 	}
 
-	// Reinsert all bullets, players, and enemies into tables
-	defaultTable.clear();
-	largeObjectsTable.clear();
+	// Update all bullets and enemies in the tables; only entities that moved to different cells are actually moved
 	playerBulletView.each([this, deltaTime](auto entity, auto& playerBullet, auto& position, auto& hitbox) {
 		playerBullet.update(deltaTime);
 
-		// Check hitbox size for insertion into correct table
-		if (hitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(entity, hitbox, position);
-		} else {
-			largeObjectsTable.insert(entity, hitbox, position);
+		// Bullet hitboxes are only ever disabled permanently, so disabled bullets can never collide
+		if (hitbox.isDisabled()) {
+			removeFromTables(entity);
+			return;
 		}
+
+		updateBulletInTables(entity, position, hitbox);
 	});
 	enemyBulletView.each([this, deltaTime](auto entity, auto& enemyBullet, auto& position, auto& hitbox) {
 		enemyBullet.update(deltaTime);
 
-		// Check hitbox size for insertion into correct table
-		if (hitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(entity, hitbox, position);
-		} else {
-			largeObjectsTable.insert(entity, hitbox, position);
+		// Bullet hitboxes are only ever disabled permanently, so disabled bullets can never collide
+		if (hitbox.isDisabled()) {
+			removeFromTables(entity);
+			return;
 		}
+
+		updateBulletInTables(entity, position, hitbox);
 	});
 
 	// Insert enemies
 	enemyView.each([this](auto entity, auto& enemy, auto& position, auto& hitbox) {
-		if (hitbox.getRadius() < defaultTableObjectMaxSize) {
-			defaultTable.insert(entity, hitbox, position);
-		}
-		largeObjectsTable.insert(entity, hitbox, position);
+		updatePlayerOrEnemyInTables(entity, position, hitbox);
 	});
 
-	// Collision detection, looping through only players and enemies
+	detectCollisions();
+	respondToCollisions();
+}
+
+void CollisionSystem::detectCollisions() {
+	events.clear();
+
+	auto playerBulletView = registry.view<PlayerBulletComponent, PositionComponent, HitboxComponent>(entt::persistent_t{});
+	auto enemyBulletView = registry.view<EnemyBulletComponent, PositionComponent, HitboxComponent>(entt::persistent_t{});
+	auto enemyView = registry.view<EnemyComponent, PositionComponent, HitboxComponent>(entt::persistent_t{});
+
+	// Loop through only players and enemies
 	if (registry.has<PlayerTag>()) {
 		uint32_t player = registry.attachee<PlayerTag>();
 		auto& playerHitbox = registry.get<HitboxComponent>(player);
 		auto& playerPosition = registry.get<PositionComponent>(player);
 		auto& playerTag = registry.get<PlayerTag>();
 
-		// Check for player
-		
 		if (!playerHitbox.isDisabled() && !playerTag.isDead() && !playerTag.isInvincible()) {
 			auto all = defaultTable.getNearbyObjects(playerHitbox, playerPosition);
 			auto large = largeObjectsTable.getNearbyObjects(playerHitbox, playerPosition);
@@ -95,137 +104,246 @@ void CollisionSystem::update(float deltaTime) {
 					continue;
 				}
 
-				// This is to prevent the player from taking multiple hits in the same frame
-				// We can break instead of continuing because if player hitbox is disabled, no other bullet can hit the player so just stop collision checking
-				if (playerHitbox.isDisabled()) {
-					break;
-				}
-
 				auto& bulletPosition = enemyBulletView.get<PositionComponent>(bullet);
 				auto& bulletHitbox = enemyBulletView.get<HitboxComponent>(bullet);
 				// Note: No DeathComponent::isMarkedForDeath() check here because player does not despawn on death
-				if (registry.get<EnemyBulletComponent>(bullet).isValidCollision(player) && !bulletHitbox.isDisabled() && collides(playerPosition, playerHitbox, bulletPosition, bulletHitbox)) {
-					// Disable hitbox for invulnerability time
-					float invulnTime = playerTag.getInvulnerabilityTime();
-					if (invulnTime > 0) {
-						playerHitbox.disable(invulnTime);
-						// Player flashes white
-						registry.get<SpriteComponent>(player).setEffectAnimation(std::make_unique<FlashWhiteSEA>(registry.get<SpriteComponent>(player).getSprite(), invulnTime));
-					}
-
-					// Player takes damage
-					if (registry.has<HealthComponent>(player) && registry.get<HealthComponent>(player).takeDamage(registry.get<EnemyBulletComponent>(bullet).getDamage())) {
-						// Player is dead
-
-						// Play death sound
-						registry.get<LevelManagerTag>().getLevelPack()->playSound(registry.get<PlayerTag>().getDeathSound());
-
-						playerTag.setIsDead(true);
-						registry.get<SpriteComponent>(player).setEffectAnimation(std::make_unique<FadeAwaySEA>(registry.get<SpriteComponent>(player).getSprite(), 0, 1, PLAYER_DEATH_FADE_TIME, true));
-					} else {
-						registry.get<EnemyBulletComponent>(bullet).onCollision(player);
-
-						// Play death sound
-						registry.get<LevelManagerTag>().getLevelPack()->playSound(registry.get<PlayerTag>().getHurtSound());
-					}
-
-					// Handle OnCollisionAction
-					switch (registry.get<EnemyBulletComponent>(bullet).getOnCollisionAction()) {
-					case BULLET_ON_COLLISION_ACTION::DESTROY_THIS_BULLET_AND_ATTACHED_CHILDREN:
-						registry.get<DespawnComponent>(bullet).setMaxTime(0);
-						break;
-					case BULLET_ON_COLLISION_ACTION::DESTROY_THIS_BULLET_ONLY:
-						// Remove all components except for MovementPathComponent, PositionComponent, and DespawnComponent
-						// Hitbox is simply disabled indefinitely in case other stuff uses its hitbox
-						registry.get<HitboxComponent>(bullet).disable(9999999999);
-
-						if (registry.has<ShadowTrailComponent>(bullet)) {
-							registry.remove<ShadowTrailComponent>(bullet);
-						}
-						registry.remove<SpriteComponent>(bullet);
-						registry.remove<EnemyBulletComponent>(bullet);
-						if (registry.has<EMPSpawnerComponent>(bullet)) {
-							registry.remove<EMPSpawnerComponent>(bullet);
-						}
-						break;
-					case BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY:
-						// Flash bullet
-						auto& sprite = registry.get<SpriteComponent>(bullet);
-						sprite.setEffectAnimation(std::make_unique<FlashWhiteSEA>(sprite.getSprite(), registry.get<EnemyBulletComponent>(bullet).getPierceResetTime()));
-					}
+				if (registry.get<EnemyBulletComponent>(bullet).isValidCollision(player) && !bulletHitbox.isDisabled() && bulletCollides(playerPosition, playerHitbox, bulletPosition, bulletHitbox)) {
+					events.push_back({ COLLISION_EVENT_TYPE::ENEMY_BULLET_HIT_PLAYER, player, bullet });
 				}
 			}
 		}
 	}
 
 	enemyView.each([this, &playerBulletView](auto entity, auto& enemy, auto& position, auto& hitbox) {
-		if (!hitbox.isDisabled()) {
-			auto all = defaultTable.getNearbyObjects(hitbox, position);
-			auto large = largeObjectsTable.getNearbyObjects(hitbox, position);
-			all.insert(all.end(), large.begin(), large.end());
-			for (auto bullet : all) {
-				// Make sure it's a player bullet
-				if (!registry.has<PlayerBulletComponent>(bullet)) {
-					continue;
-				}
+		if (hitbox.isDisabled() || registry.get<DespawnComponent>(entity).isMarkedForDespawn()) {
+			return;
+		}
 
-				auto& bulletPosition = playerBulletView.get<PositionComponent>(bullet);
-				auto& bulletHitbox = playerBulletView.get<HitboxComponent>(bullet);
-				if (!registry.get<DespawnComponent>(entity).isMarkedForDespawn() && registry.get<PlayerBulletComponent>(bullet).isValidCollision(entity) && !bulletHitbox.isDisabled() && collides(position, hitbox, bulletPosition, bulletHitbox)) {
-					// Enemy takes damage
-					if (registry.has<HealthComponent>(entity) && registry.get<HealthComponent>(entity).takeDamage(registry.get<PlayerBulletComponent>(bullet).getDamage())) {
-						// Enemy is dead
-
-						// Play death sound
-						registry.get<LevelManagerTag>().getLevelPack()->playSound(enemy.getEnemyData()->getDeathSound());
-
-						// Call the enemy's DeathActions
-						for (std::shared_ptr<DeathAction> deathAction : enemy.getEnemyData()->getDeathActions()) {
-							deathAction->execute(levelPack, queue, registry, spriteLoader, entity);
-						}
-						// Play death animation
-						enemy.getCurrentDeathAnimationAction()->execute(levelPack, queue, registry, spriteLoader, entity);
-
-						// Drop items, if any
-						auto currentLevel = registry.get<LevelManagerTag>().getLevel();
-						for (auto itemAndAmountPair : enemy.getEnemySpawnInfo()->getItemsDroppedOnDeath()) {
-							queue.pushBack(std::make_unique<EMPDropItemCommand>(registry, spriteLoader, position.getX(), position.getY(), itemAndAmountPair.first, itemAndAmountPair.second));
-						}
-
-						// Delete enemy
-						registry.get<DespawnComponent>(entity).setMaxTime(0);
-					} else {
-						registry.get<PlayerBulletComponent>(bullet).onCollision(entity);
-
-						// Play hurt sound
-						registry.get<LevelManagerTag>().getLevelPack()->playSound(enemy.getEnemyData()->getHurtSound());
-					}
-
-					// Handle OnCollisionAction
-					switch (registry.get<PlayerBulletComponent>(bullet).getOnCollisionAction()) {
-					case BULLET_ON_COLLISION_ACTION::DESTROY_THIS_BULLET_AND_ATTACHED_CHILDREN:
-						registry.get<DespawnComponent>(bullet).setMaxTime(0);
-						break;
-					case BULLET_ON_COLLISION_ACTION::DESTROY_THIS_BULLET_ONLY:
-						// Remove all components except for MovementPathComponent, PositionComponent, and DespawnComponent
-						// Hitbox is simply disabled indefinitely in case other stuff uses its hitbox
-						registry.get<HitboxComponent>(bullet).disable(9999999999);
-
-						if (registry.has<ShadowTrailComponent>(bullet)) {
-							registry.remove<ShadowTrailComponent>(bullet);
-						}
-						registry.remove<SpriteComponent>(bullet);
-						registry.remove<PlayerBulletComponent>(bullet);
-						if (registry.has<EMPSpawnerComponent>(bullet)) {
-							registry.remove<EMPSpawnerComponent>(bullet);
-						}
-						break;
-					case BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY:
-						// Do nothing
-						break;
-					}
-				}
+		auto all = defaultTable.getNearbyObjects(hitbox, position);
+		auto large = largeObjectsTable.getNearbyObjects(hitbox, position);
+		all.insert(all.end(), large.begin(), large.end());
+		for (auto bullet : all) {
+			// Make sure it's a player bullet
+			if (!registry.has<PlayerBulletComponent>(bullet)) {
+				continue;
+			}
+
+			auto& bulletPosition = playerBulletView.get<PositionComponent>(bullet);
+			auto& bulletHitbox = playerBulletView.get<HitboxComponent>(bullet);
+			if (registry.get<PlayerBulletComponent>(bullet).isValidCollision(entity) && !bulletHitbox.isDisabled() && bulletCollides(position, hitbox, bulletPosition, bulletHitbox)) {
+				events.push_back({ COLLISION_EVENT_TYPE::PLAYER_BULLET_HIT_ENEMY, entity, bullet });
 			}
 		}
 	});
+
+	// A bullet in multiple cells can be found multiple times by the same query.
+	// Sorting also makes the response order independent of the order of the tables' buckets.
+	std::sort(events.begin(), events.end());
+	events.erase(std::unique(events.begin(), events.end()), events.end());
+}
+
+void CollisionSystem::respondToCollisions() {
+	// Responding to an event can invalidate later events (the player becomes invulnerable, an enemy dies,
+	// a bullet is destroyed), so every event rechecks that the collision is still valid
+	for (const CollisionEvent& event : events) {
+		switch (event.type) {
+		case COLLISION_EVENT_TYPE::ENEMY_BULLET_HIT_PLAYER:
+			onEnemyBulletHitPlayer(event.target, event.bullet);
+			break;
+		case COLLISION_EVENT_TYPE::PLAYER_BULLET_HIT_ENEMY:
+			onPlayerBulletHitEnemy(event.target, event.bullet);
+			break;
+		}
+	}
+
+	for (const std::pair<SoundSettings, int>& sound : soundsToPlay) {
+		registry.get<LevelManagerTag>().getLevelPack()->playSound(sound.first, sound.second);
+	}
+	soundsToPlay.clear();
+
+	for (uint32_t bullet : bulletsToDespawn) {
+		registry.get<DespawnComponent>(bullet).setMaxTime(0);
+	}
+	bulletsToDespawn.clear();
+
+	for (uint32_t bullet : bulletsToStrip) {
+		// Remove all components except for MovementPathComponent, PositionComponent, and DespawnComponent
+		// Hitbox is simply disabled indefinitely in case other stuff uses its hitbox
+		if (registry.has<ShadowTrailComponent>(bullet)) {
+			registry.remove<ShadowTrailComponent>(bullet);
+		}
+		registry.remove<SpriteComponent>(bullet);
+		if (registry.has<PlayerBulletComponent>(bullet)) {
+			registry.remove<PlayerBulletComponent>(bullet);
+		}
+		if (registry.has<EnemyBulletComponent>(bullet)) {
+			registry.remove<EnemyBulletComponent>(bullet);
+		}
+		if (registry.has<EMPSpawnerComponent>(bullet)) {
+			registry.remove<EMPSpawnerComponent>(bullet);
+		}
+	}
+	bulletsToStrip.clear();
+}
+
+void CollisionSystem::onEnemyBulletHitPlayer(uint32_t player, uint32_t bullet) {
+	auto& playerHitbox = registry.get<HitboxComponent>(player);
+	auto& playerTag = registry.get<PlayerTag>();
+	auto& enemyBullet = registry.get<EnemyBulletComponent>(bullet);
+
+	// This is to prevent the player from taking multiple hits in the same frame
+	if (playerHitbox.isDisabled() || playerTag.isDead() || !enemyBullet.isValidCollision(player) || registry.get<HitboxComponent>(bullet).isDisabled()) {
+		return;
+	}
+
+	// Disable hitbox for invulnerability time
+	float invulnTime = playerTag.getInvulnerabilityTime();
+	if (invulnTime > 0) {
+		playerHitbox.disable(invulnTime);
+		// Player flashes white
+		registry.get<SpriteComponent>(player).setEffectAnimation(std::make_unique<FlashWhiteSEA>(invulnTime));
+		AnimatedSpriteComponent::markIfAnimated(registry, player);
+	}
+
+	// Player takes damage
+	if (registry.has<HealthComponent>(player) && registry.get<HealthComponent>(player).takeDamage(enemyBullet.getDamage())) {
+		// Player is dead
+
+		// Play death sound
+		queueSound(playerTag.getDeathSound(), PLAYER_SOUND_PRIORITY);
+
+		playerTag.setIsDead(true);
+		registry.get<SpriteComponent>(player).setEffectAnimation(std::make_unique<FadeAwaySEA>(0, 1, PLAYER_DEATH_FADE_TIME, true));
+		AnimatedSpriteComponent::markIfAnimated(registry, player);
+	} else {
+		enemyBullet.onCollision(player);
+
+		// Play hurt sound
+		queueSound(playerTag.getHurtSound(), PLAYER_SOUND_PRIORITY);
+	}
+
+	if (enemyBullet.getOnCollisionAction() == BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY) {
+		// Flash bullet
+		auto& sprite = registry.get<SpriteComponent>(bullet);
+		sprite.setEffectAnimation(std::make_unique<FlashWhiteSEA>(enemyBullet.getPierceResetTime()));
+		AnimatedSpriteComponent::markIfAnimated(registry, bullet);
+	} else {
+		onBulletCollision(bullet, enemyBullet.getOnCollisionAction());
+	}
+}
+
+void CollisionSystem::onPlayerBulletHitEnemy(uint32_t enemy, uint32_t bullet) {
+	auto& enemyComponent = registry.get<EnemyComponent>(enemy);
+	auto& playerBullet = registry.get<PlayerBulletComponent>(bullet);
+
+	if (registry.get<DespawnComponent>(enemy).isMarkedForDespawn() || !playerBullet.isValidCollision(enemy) || registry.get<HitboxComponent>(bullet).isDisabled()) {
+		return;
+	}
+
+	// Death actions can assign components, so the action is read before any references are invalidated
+	BULLET_ON_COLLISION_ACTION action = playerBullet.getOnCollisionAction();
+
+	// Enemy takes damage
+	if (registry.has<HealthComponent>(enemy) && registry.get<HealthComponent>(enemy).takeDamage(playerBullet.getDamage())) {
+		// Enemy is dead
+
+		// Play death sound
+		queueSound(enemyComponent.getEnemyData()->getDeathSound());
+
+		// Call the enemy's DeathActions
+		for (std::shared_ptr<DeathAction> deathAction : enemyComponent.getEnemyData()->getDeathActions()) {
+			deathAction->execute(levelPack, queue, registry, spriteLoader, enemy);
+		}
+		// Play death animation
+		enemyComponent.getCurrentDeathAnimationAction()->execute(levelPack, queue, registry, spriteLoader, enemy);
+
+		// Drop items, if any
+		auto& position = registry.get<PositionComponent>(enemy);
+		for (auto itemAndAmountPair : enemyComponent.getEnemySpawnInfo()->getItemsDroppedOnDeath()) {
+			queue.pushBack(std::make_unique<EMPDropItemCommand>(registry, spriteLoader, position.getX(), position.getY(), itemAndAmountPair.first, itemAndAmountPair.second));
+		}
+
+		// Delete enemy
+		registry.get<DespawnComponent>(enemy).setMaxTime(0);
+	} else {
+		playerBullet.onCollision(enemy);
+
+		// Play hurt sound
+		queueSound(enemyComponent.getEnemyData()->getHurtSound());
+	}
+
+	onBulletCollision(bullet, action);
+}
+
+void CollisionSystem::onBulletCollision(uint32_t bullet, BULLET_ON_COLLISION_ACTION action) {
+	switch (action) {
+	case BULLET_ON_COLLISION_ACTION::DESTROY_THIS_BULLET_AND_ATTACHED_CHILDREN:
+		bulletsToDespawn.push_back(bullet);
+		break;
+	case BULLET_ON_COLLISION_ACTION::DESTROY_THIS_BULLET_ONLY:
+		// Disabling the hitbox right away stops the bullet from hitting anything else in this update
+		registry.get<HitboxComponent>(bullet).disablePermanently();
+		removeFromTables(bullet);
+		bulletsToStrip.push_back(bullet);
+		break;
+	case BULLET_ON_COLLISION_ACTION::PIERCE_ENTITY:
+		// Do nothing
+		break;
+	}
+}
+
+void CollisionSystem::queueSound(const SoundSettings& sound, int priority) {
+	for (const std::pair<SoundSettings, int>& queued : soundsToPlay) {
+		if (queued.first == sound) {
+			return;
+		}
+	}
+	soundsToPlay.push_back(std::make_pair(sound, priority));
+}
+
+void CollisionSystem::updateBulletInTables(uint32_t bullet, const PositionComponent& position, HitboxComponent& hitbox) {
+	// Check hitbox size for insertion into correct table
+	if (hitbox.updateLargeObject(defaultTableObjectMaxSize)) {
+		// The bullet may still be in the other table from before its radius changed
+		(hitbox.isLargeObject() ? defaultTable : largeObjectsTable).remove(bullet);
+	}
+	SpatialHashTable<uint32_t>& table = hitbox.isLargeObject() ? largeObjectsTable : defaultTable;
+
+	if (hitbox.updateSweep(position)) {
+		// Cover every cell the hitbox passed through since the last update
+		sf::Vector2f start = hitbox.getSweepStart();
+		float halfDx = (start.x - position.getX()) / 2.0f;
+		float halfDy = (start.y - position.getY()) / 2.0f;
+		table.update(bullet, hitbox.getX() + halfDx, hitbox.getY() + halfDy, hitbox.getRadius() + std::sqrt(halfDx * halfDx + halfDy * halfDy), position);
+	} else {
+		table.update(bullet, hitbox, position);
+	}
+}
+
+void CollisionSystem::updatePlayerOrEnemyInTables(uint32_t entity, const PositionComponent& position, HitboxComponent& hitbox) {
+	if (hitbox.updateLargeObject(defaultTableObjectMaxSize) && hitbox.isLargeObject()) {
+		// The entity may still be in defaultTable from before its radius changed
+		defaultTable.remove(entity);
+	}
+	if (!hitbox.isLargeObject()) {
+		defaultTable.update(entity, hitbox, position);
+	}
+	largeObjectsTable.update(entity, hitbox, position);
+}
+
+bool CollisionSystem::bulletCollides(const PositionComponent& targetPosition, const HitboxComponent& targetHitbox, const PositionComponent& bulletPosition, const HitboxComponent& bulletHitbox) {
+	if (bulletHitbox.isSweeping()) {
+		sf::Vector2f start = bulletHitbox.getSweepStart();
+		return sweptCollides(targetPosition, targetHitbox, start.x, start.y, bulletPosition, bulletHitbox);
+	}
+	return collides(targetPosition, targetHitbox, bulletPosition, bulletHitbox);
+}
+
+void CollisionSystem::removeFromTables(uint32_t entity) {
+	defaultTable.remove(entity);
+	largeObjectsTable.remove(entity);
+}
+
+void CollisionSystem::onHitboxDestroy(entt::DefaultRegistry& registry, uint32_t entity) {
+	removeFromTables(entity);
 }
\ No newline at end of file
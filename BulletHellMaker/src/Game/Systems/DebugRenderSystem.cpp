@@ -16,8 +16,13 @@ void DebugRenderSystem::update(float deltaTime) {
 
 	auto view = registry.view<PositionComponent, SpriteComponent>(entt::persistent_t{});
 	view.each([this](auto entity, auto& position, auto& sprite) {
-		if (sprite.getSprite()) {
-			sprite.getSprite()->setPosition(position.getX() * resolutionMultiplier, (MAP_HEIGHT - position.getY()) * resolutionMultiplier);
+		if (sprite.hasSprite()) {
+			if (sprite.isStretched()) {
+				sf::Vector2f offset = sprite.applyStretch(resolutionMultiplier);
+				sprite.setPosition((position.getX() + offset.x) * resolutionMultiplier, (MAP_HEIGHT - (position.getY() + offset.y)) * resolutionMultiplier);
+			} else {
+				sprite.setPosition(position.getX() * resolutionMultiplier, (MAP_HEIGHT - position.getY()) * resolutionMultiplier);
+			}
 			layers[sprite.getRenderLayer()].push_back(std::ref(sprite));
 		}
 	});
@@ -42,13 +47,13 @@ void DebugRenderSystem::update(float deltaTime) {
 	window.draw(backgroundAsSprite, backgroundStates);
 
 	// Draw the layers onto the window directly
+	batchTexture = nullptr;
 	for (int i = 0; i < layers.size(); i++) {
 		for (SpriteComponent& sprite : layers[i]) {
-			std::shared_ptr<sf::Sprite> spritePtr = sprite.getSprite();
-
-			window.draw(*spritePtr);
+			batchSprite(sprite, window);
 		}
 	}
+	flushBatch(window);
 
 	// Draw the hitboxes
 	auto view2 = registry.view<PositionComponent, HitboxComponent>(entt::persistent_t{});
@@ -62,8 +67,18 @@ void DebugRenderSystem::update(float deltaTime) {
 			} else {
 				circleFormat.setOutlineColor(sf::Color(sf::Color::Magenta));
 			}
-			circleFormat.setPosition((position.getX() + hitbox.getX() - circleFormat.getRadius()) * resolutionMultiplier, (MAP_HEIGHT - (position.getY() + hitbox.getY() + circleFormat.getRadius())) * resolutionMultiplier);
-			window.draw(circleFormat);
+			if (hitbox.isCapsule()) {
+				// Draw the circles at both ends of the capsule's segment
+				for (float side : { -1.0f, 1.0f }) {
+					float x = position.getX() + hitbox.getX() + side * hitbox.getCapsuleHalfX();
+					float y = position.getY() + hitbox.getY() + side * hitbox.getCapsuleHalfY();
+					circleFormat.setPosition((x - circleFormat.getRadius()) * resolutionMultiplier, (MAP_HEIGHT - (y + circleFormat.getRadius())) * resolutionMultiplier);
+					window.draw(circleFormat);
+				}
+			} else {
+				circleFormat.setPosition((position.getX() + hitbox.getX() - circleFormat.getRadius()) * resolutionMultiplier, (MAP_HEIGHT - (position.getY() + hitbox.getY() + circleFormat.getRadius())) * resolutionMultiplier);
+				window.draw(circleFormat);
+			}
 		}
 	});
 }
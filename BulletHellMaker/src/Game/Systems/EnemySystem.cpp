@@ -1,5 +1,8 @@
 #include <Game/Systems/EnemySystem.h>
 
+#include <cmath>
+
+#include <Constants.h>
 #include <Game/Components/EnemyComponent.h>
 #include <Game/EntityCreationQueue.h>
 
@@ -8,9 +11,69 @@ EnemySystem::EnemySystem(EntityCreationQueue& queue, SpriteLoader& spriteLoader,
 }
 
 void EnemySystem::update(float deltaTime) {
+	time += deltaTime;
+
 	auto view = registry.view<EnemyComponent>();
+	view.each([deltaTime](auto entity, auto& enemy) {
+		enemy.updateTime(deltaTime);
+	});
 
-	view.each([this, deltaTime](auto entity, auto& enemy) {
-		enemy.update(queue, spriteLoader, levelPack, registry, entity, deltaTime);
+	// Enemies are woken up EPSILON early so that floating point differences between time and each enemy's
+	// own timers can never make an attack late; EnemyComponent itself decides whether anything is actually due
+	dueEnemies.clear();
+	while (!schedule.empty() && schedule.top().time <= time + EPSILON) {
+		ScheduledEnemy scheduled = schedule.top();
+		schedule.pop();
+		if (registry.valid(scheduled.entity) && registry.has<EnemyComponent>(scheduled.entity)
+			&& registry.get<EnemyComponent>(scheduled.entity).getScheduleID() == scheduled.scheduleID) {
+			dueEnemies.push_back(scheduled.entity);
+		}
+	}
+	for (uint32_t entity : dueEnemies) {
+		registry.get<EnemyComponent>(entity).checkAttacksAndAttackPatterns(queue, spriteLoader, levelPack, registry, entity);
+	}
+
+	while (!phaseSchedule.empty() && phaseSchedule.top().time <= time + EPSILON) {
+		ScheduledEnemy scheduled = phaseSchedule.top();
+		phaseSchedule.pop();
+		if (registry.valid(scheduled.entity) && registry.has<EnemyComponent>(scheduled.entity)
+			&& registry.get<EnemyComponent>(scheduled.entity).getPhaseScheduleID() == scheduled.scheduleID) {
+			registry.get<EnemyComponent>(scheduled.entity).markPhaseCheckDue();
+		}
+	}
+
+	view.each([this](auto entity, auto& enemy) {
+		enemy.checkPhases(queue, spriteLoader, levelPack, registry, entity);
+		if (enemy.needsPhaseRescheduling()) {
+			schedulePhaseCheck(entity, enemy);
+		}
+		if (enemy.needsRescheduling()) {
+			scheduleEnemy(entity, enemy);
+		}
 	});
+}
+
+void EnemySystem::scheduleEnemy(uint32_t entity, EnemyComponent& enemy) {
+	unsigned long long scheduleID = nextScheduleID++;
+	enemy.setScheduleID(scheduleID);
+
+	float timeUntilNext = enemy.getTimeUntilNextAttackOrAttackPattern(levelPack);
+	if (std::isinf(timeUntilNext)) {
+		// Nothing to schedule until the enemy's next phase
+		return;
+	}
+	schedule.push({ time + timeUntilNext, entity, scheduleID });
+}
+
+
+void EnemySystem::schedulePhaseCheck(uint32_t entity, EnemyComponent& enemy) {
+	unsigned long long scheduleID = nextScheduleID++;
+	enemy.setPhaseScheduleID(scheduleID);
+
+	float timeUntilCheck = enemy.getTimeUntilNextPhaseCheck();
+	if (std::isinf(timeUntilCheck)) {
+		// Only something other than time can satisfy the condition
+		return;
+	}
+	phaseSchedule.push({ time + timeUntilCheck, entity, scheduleID });
 }
\ No newline at end of file
@@ -14,37 +14,154 @@ MovementSystem::MovementSystem(EntityCreationQueue& queue, SpriteLoader& spriteL
 }
 
 void MovementSystem::update(float deltaTime) {
+	steerHomingEntities(deltaTime);
+	evaluateExpressionTFVs(deltaTime);
+
 	auto view = registry.view<PositionComponent, MovementPathComponent>(entt::persistent_t{});
 	view.each([this, deltaTime](auto entity, auto& position, auto& path) {
+		if (path.isFrozen()) {
+			return;
+		}
+
 		float prevX = position.getX();
 		float prevY = position.getY();
 		path.update(queue, registry, entity, position, deltaTime);
-		// Calculate angle of movement
-		float angle = std::atan2(position.getY() - prevY, position.getX() - prevX);
-		if (registry.has<SpriteComponent>(entity)) {
-			// Rotate sprite
-			auto& sprite = registry.get<SpriteComponent>(entity);
-			sprite.rotate(angle);
-
-			if (registry.has<HitboxComponent>(entity)) {
-				if (sprite.getSprite()) {
-					// Rotate hitbox according to sprite orientation
-					registry.get<HitboxComponent>(entity).rotate(sprite.getSprite());
-				} else {
-					// Rotate hitbox according to angle
-					registry.get<HitboxComponent>(entity).rotate(angle);
-				}
-			}
-		} else {
-			// Rotate hitbox
-			if (registry.has<HitboxComponent>(entity)) {
-				registry.get<HitboxComponent>(entity).rotate(angle);
-			}
-		}
+
+		rotationBatch.entities.push_back(entity);
+		rotationBatch.dx.push_back(position.getX() - prevX);
+		rotationBatch.dy.push_back(position.getY() - prevY);
 	});
+	expressionTFVBatch.clear();
+	rotateEntities();
 
 	auto spawnerView = registry.view<EMPSpawnerComponent>();
 	spawnerView.each([this, deltaTime](auto entity, auto& spawner) {
 		spawner.update(registry, spriteLoader, queue, deltaTime);
 	});
 }
+
+void MovementSystem::steerHomingEntities(float deltaTime) {
+	homingSteeringBatch.clear();
+
+	// Nearly every homing entity targets the player, so remember the last target's position
+	bool hasCachedTarget = false;
+	uint32_t cachedTarget = 0;
+	float cachedTargetX = 0, cachedTargetY = 0;
+
+	auto view = registry.view<PositionComponent, MovementPathComponent, HitboxComponent>(entt::persistent_t{});
+	view.each([&](auto entity, auto& position, auto& path, auto& hitbox) {
+		HomingMP* homing = path.getHomingPath();
+		if (!homing || homing->getFrom() != entity || path.isFrozen()) {
+			return;
+		}
+		float time = path.getTime() + deltaTime;
+		if (time >= homing->getLifespan()) {
+			// The path will change during this update, so let evaluate() handle it normally
+			return;
+		}
+
+		if (homing->getTargetsEntity()) {
+			uint32_t target = homing->getTarget();
+			if (!hasCachedTarget || cachedTarget != target) {
+				if (!registry.valid(target) || !registry.has<PositionComponent>(target) || !registry.has<HitboxComponent>(target)) {
+					return;
+				}
+				auto& targetPos = registry.get<PositionComponent>(target);
+				auto& targetHitbox = registry.get<HitboxComponent>(target);
+				hasCachedTarget = true;
+				cachedTarget = target;
+				cachedTargetX = targetPos.getX() + targetHitbox.getX();
+				cachedTargetY = targetPos.getY() + targetHitbox.getY();
+			}
+		}
+
+		homing->addToSteeringBatch(homingSteeringBatch, time, position.getX() + hitbox.getX(), position.getY() + hitbox.getY(), cachedTargetX, cachedTargetY);
+	});
+
+	HomingMP::steer(homingSteeringBatch);
+}
+
+void MovementSystem::evaluateExpressionTFVs(float deltaTime) {
+	auto view = registry.view<MovementPathComponent>();
+	view.each([&](auto entity, auto& path) {
+		if (path.isFrozen()) {
+			return;
+		}
+		// Same time that MovementPathComponent::update() will evaluate the path at
+		float time = path.getTime() + deltaTime;
+		MovablePoint* mp = path.getPath().get();
+		if (time >= mp->getLifespan()) {
+			// The path may change during this update, so let it be evaluated normally
+			return;
+		}
+		mp->addToExpressionTFVBatch(expressionTFVBatch, time);
+	});
+
+	expressionTFVBatch.run();
+}
+
+void MovementSystem::rotateEntities() {
+	// Find what each entity has to rotate, dropping entities with nothing to rotate.
+	// Nothing is added to or removed from the registry until the end of this function, so the component pointers stay valid.
+	int count = 0;
+	for (int i = 0; i < rotationBatch.entities.size(); i++) {
+		uint32_t entity = rotationBatch.entities[i];
+		SpriteComponent* sprite = registry.has<SpriteComponent>(entity) ? &registry.get<SpriteComponent>(entity) : nullptr;
+		HitboxComponent* hitbox = nullptr;
+		if (registry.has<HitboxComponent>(entity)) {
+			hitbox = &registry.get<HitboxComponent>(entity);
+			if (hitbox->isRotationInvariant()) {
+				hitbox = nullptr;
+			}
+		}
+		if (!sprite && !hitbox) {
+			continue;
+		}
+
+		rotationBatch.entities[count] = entity;
+		rotationBatch.dx[count] = rotationBatch.dx[i];
+		rotationBatch.dy[count] = rotationBatch.dy[i];
+		rotationBatch.sprites.push_back(sprite);
+		rotationBatch.hitboxes.push_back(hitbox);
+		count++;
+	}
+
+	// Angles of movement; kept in its own loop over contiguous arrays so that it can be vectorized
+	rotationBatch.angles.resize(count);
+	const float* dx = rotationBatch.dx.data();
+	const float* dy = rotationBatch.dy.data();
+	float* angles = rotationBatch.angles.data();
+	for (int i = 0; i < count; i++) {
+		angles[i] = std::atan2(dy[i], dx[i]);
+	}
+
+	for (int i = 0; i < count; i++) {
+		float angle = angles[i];
+		SpriteComponent* sprite = rotationBatch.sprites[i];
+		HitboxComponent* hitbox = rotationBatch.hitboxes[i];
+
+		if (sprite) {
+			sprite->rotate(angle);
+		}
+		if (hitbox) {
+			// The sine and cosine of the angle of movement are just the normalized movement vector
+			float length = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]);
+			if (length > 0) {
+				hitbox->rotate(angle, dy[i] / length, dx[i] / length);
+			} else {
+				hitbox->rotate(angle, 0, 1);
+			}
+		}
+	}
+
+	rotationBatch.clear();
+}
+
+void MovementSystem::RotationBatch::clear() {
+	entities.clear();
+	dx.clear();
+	dy.clear();
+	sprites.clear();
+	hitboxes.clear();
+	angles.clear();
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <Game/Systems/OffScreenSystem.h>
+
+#include <Util/Profiler.h>
+#include <Game/Components/PositionComponent.h>
+#include <Game/Components/OffScreenComponent.h>
+#include <Game/Components/DespawnComponent.h>
+#include <Game/Components/MovementPathComponent.h>
+#include <Game/Components/HitboxComponent.h>
+#include <Game/Components/EMPSpawnerComponent.h>
+#include <Game/Components/SimpleEMPReferenceComponent.h>
+
+OffScreenSystem::OffScreenSystem(entt::DefaultRegistry& registry, float mapWidth, float mapHeight)
+	: registry(registry), mapWidth(mapWidth), mapHeight(mapHeight) {
+}
+
+void OffScreenSystem::update(float deltaTime) {
+	entities.clear();
+	xs.clear();
+	ys.clear();
+	margins.clear();
+
+	auto view = registry.view<OffScreenComponent, PositionComponent>(entt::persistent_t{});
+	view.each([this](auto entity, auto& offScreenComponent, auto& position) {
+		entities.push_back(entity);
+		xs.push_back(position.getX());
+		ys.push_back(position.getY());
+		margins.push_back(offScreenComponent.getMargin());
+	});
+
+	// Branchless so that the compiler can vectorize it
+	int count = entities.size();
+	offScreen.resize(count);
+	int offScreenCount = 0;
+	for (int i = 0; i < count; i++) {
+		float m = margins[i];
+		uint8_t outside = (xs[i] < -m) | (xs[i] > mapWidth + m) | (ys[i] < -m) | (ys[i] > mapHeight + m);
+		offScreen[i] = outside;
+		offScreenCount += outside;
+	}
+	// Set every update, since Profiler::logAndReset() clears gauges
+	Profiler::setGauge("Off-screen entities", offScreenCount);
+
+	if (offScreenCount == 0) {
+		return;
+	}
+	for (int i = 0; i < count; i++) {
+		if (!offScreen[i]) {
+			continue;
+		}
+
+		uint32_t entity = entities[i];
+		switch (registry.get<OffScreenComponent>(entity).getAction()) {
+		case OFF_SCREEN_ACTION::DESPAWN:
+			// Entities that something else still depends on are checked again next update
+			if (canDespawnEarly(entity)) {
+				auto& despawn = registry.get<DespawnComponent>(entity);
+				despawn.removeEntityAttachment(registry, entity);
+				despawn.setMaxTime(0);
+				registry.remove<OffScreenComponent>(entity);
+				Profiler::addToCounter("Off-screen entities despawned");
+			}
+			break;
+		case OFF_SCREEN_ACTION::FREEZE:
+			// Hitbox is disabled instead of removed in case other stuff uses it
+			if (registry.has<MovementPathComponent>(entity)) {
+				registry.get<MovementPathComponent>(entity).setFrozen(true);
+			}
+			if (registry.has<HitboxComponent>(entity)) {
+				registry.get<HitboxComponent>(entity).disablePermanently();
+			}
+			registry.remove<OffScreenComponent>(entity);
+			Profiler::addToCounter("Off-screen entities frozen");
+			break;
+		default:
+			registry.remove<OffScreenComponent>(entity);
+			break;
+		}
+	}
+}
+
+bool OffScreenSystem::canDespawnEarly(uint32_t entity) const {
+	if (!registry.has<DespawnComponent>(entity) || registry.get<DespawnComponent>(entity).isMarkedForDespawn()) {
+		return false;
+	}
+	if (registry.has<EMPSpawnerComponent>(entity) && registry.get<EMPSpawnerComponent>(entity).hasPendingEMPs()) {
+		return false;
+	}
+	return onlyHasReferenceChildren(entity);
+}
+
+bool OffScreenSystem::onlyHasReferenceChildren(uint32_t entity) const {
+	for (uint32_t child : registry.get<DespawnComponent>(entity).getChildren()) {
+		if (!registry.valid(child)) {
+			continue;
+		}
+		if (!registry.has<SimpleEMPReferenceComponent>(child) || !onlyHasReferenceChildren(child)) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -50,7 +50,7 @@ void PlayerSystem::update(float deltaTime) {
 
 	if (playerTag.update(deltaTime, levelPack, queue, spriteLoader, registry, playerEntity) && playerTag.getBombCount() > 0) {
 		// Play bomb ready sound
-		levelPack.playSound(levelPack.getPlayer()->getBombReadySound());
+		levelPack.playSound(levelPack.getPlayer()->getBombReadySound(), PLAYER_SOUND_PRIORITY);
 	}
 
 	// Movement
@@ -66,12 +66,8 @@ void PlayerSystem::update(float deltaTime) {
 		float angle = std::atan2(pos.getY() - prevY, pos.getX() - prevX);
 
 		// Rotate sprite and hitbox
-		auto& sprite = registry.get<SpriteComponent>(playerEntity);
-		sprite.rotate(angle);
-		if (sprite.getSprite()) {
-			// Rotate hitbox according to sprite orientation
-			hitbox.rotate(sprite.getSprite());
-		}
+		registry.get<SpriteComponent>(playerEntity).rotate(angle);
+		hitbox.rotate(angle);
 	}
 	
 	// Make sure player doesn't go out of bounds
@@ -7,12 +7,14 @@
 #include <LevelPack/Level.h>
 #include <Game/Components/PositionComponent.h>
 #include <Game/Components/SpriteComponent.h>
+#include <Util/Profiler.h>
 
 const sf::BlendMode RenderSystem::DEFAULT_BLEND_MODE = sf::BlendMode(sf::BlendMode::Factor::SrcAlpha, sf::BlendMode::Factor::OneMinusSrcAlpha, sf::BlendMode::Equation::Add, sf::BlendMode::Factor::SrcAlpha, sf::BlendMode::Factor::OneMinusSrcAlpha, sf::BlendMode::Equation::Add);
 
 RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow & window, SpriteLoader& spriteLoader, float resolutionMultiplier, bool initShaders) : registry(registry), window(window), resolutionMultiplier(resolutionMultiplier) {
 	// Initialize layers to be size of the max layer
 	layers = std::vector<std::vector<std::reference_wrapper<SpriteComponent>>>(HIGHEST_RENDER_LAYER + 1);
+	batchVertices.setPrimitiveType(sf::Triangles);
 
 	setResolution(spriteLoader, resolutionMultiplier);
 
@@ -20,6 +22,10 @@ RenderSystem::RenderSystem(entt::DefaultRegistry & registry, sf::RenderWindow &
 }
 
 void RenderSystem::update(float deltaTime) {
+	drawCalls = 0;
+	textureSwitches = 0;
+	batchTexture = nullptr;
+
 	for (int i = 0; i < layers.size(); i++) {
 		layers[i].clear();
 		layerTextures[i].clear(sf::Color::Transparent);
@@ -27,8 +33,13 @@ void RenderSystem::update(float deltaTime) {
 
 	auto view = registry.view<PositionComponent, SpriteComponent>(entt::persistent_t{});
 	view.each([this](auto entity, auto& position, auto& sprite) {
-		if (sprite.getSprite()) {
-			sprite.getSprite()->setPosition(position.getX() * resolutionMultiplier, -position.getY() * resolutionMultiplier);
+		if (sprite.hasSprite()) {
+			if (sprite.isStretched()) {
+				sf::Vector2f offset = sprite.applyStretch(resolutionMultiplier);
+				sprite.setPosition((position.getX() + offset.x) * resolutionMultiplier, -(position.getY() + offset.y) * resolutionMultiplier);
+			} else {
+				sprite.setPosition(position.getX() * resolutionMultiplier, -position.getY() * resolutionMultiplier);
+			}
 			layers[sprite.getRenderLayer()].push_back(std::ref(sprite));
 		}
 	});
@@ -53,14 +64,16 @@ void RenderSystem::update(float deltaTime) {
 
 	for (int i = 0; i < layers.size(); i++) {
 		for (SpriteComponent& sprite : layers[i]) {
-			std::shared_ptr<sf::Sprite> spritePtr = sprite.getSprite();
-
 			if (sprite.usesShader()) {
-				layerTextures[i].draw(*spritePtr, &sprite.getShader());
+				// Sprites with shaders are drawn alone
+				flushBatch(layerTextures[i]);
+				batchSprite(sprite, layerTextures[i]);
+				flushBatch(layerTextures[i], &sprite.getShader());
 			} else {
-				layerTextures[i].draw(*spritePtr);
+				batchSprite(sprite, layerTextures[i]);
 			}
 		}
+		flushBatch(layerTextures[i]);
 		if (layers[i].size() == 0) {
 			continue;
 		}
@@ -77,6 +90,50 @@ void RenderSystem::update(float deltaTime) {
 			window.draw(textureAsSprite, states);
 		}
 	}
+
+	Profiler::setGauge("Render draw calls", drawCalls);
+	Profiler::setGauge("Render texture switches", textureSwitches);
+}
+
+void RenderSystem::batchSprite(const SpriteComponent& sprite, sf::RenderTarget& target) {
+	const SpriteTemplate& spriteTemplate = *sprite.getSpriteTemplate();
+	if (spriteTemplate.getTexture() != batchTexture) {
+		flushBatch(target);
+		batchTexture = spriteTemplate.getTexture();
+		textureSwitches++;
+	}
+
+	// Same vertices as the ones sf::Sprite draws
+	const sf::IntRect& textureRect = spriteTemplate.getTextureRect();
+	sf::FloatRect bounds(0, 0, std::abs(textureRect.width), std::abs(textureRect.height));
+	sf::Transform transform = sprite.getTransform();
+	sf::Color color = sprite.getColor();
+	float left = textureRect.left;
+	float right = left + textureRect.width;
+	float top = textureRect.top;
+	float bottom = top + textureRect.height;
+	sf::Vertex topLeft(transform.transformPoint(0, 0), color, sf::Vector2f(left, top));
+	sf::Vertex bottomLeft(transform.transformPoint(0, bounds.height), color, sf::Vector2f(left, bottom));
+	sf::Vertex topRight(transform.transformPoint(bounds.width, 0), color, sf::Vector2f(right, top));
+	sf::Vertex bottomRight(transform.transformPoint(bounds.width, bounds.height), color, sf::Vector2f(right, bottom));
+	batchVertices.append(topLeft);
+	batchVertices.append(bottomLeft);
+	batchVertices.append(topRight);
+	batchVertices.append(topRight);
+	batchVertices.append(bottomLeft);
+	batchVertices.append(bottomRight);
+}
+
+void RenderSystem::flushBatch(sf::RenderTarget& target, const sf::Shader* shader) {
+	if (batchVertices.getVertexCount() == 0) {
+		return;
+	}
+	sf::RenderStates states;
+	states.texture = batchTexture;
+	states.shader = shader;
+	target.draw(batchVertices, states);
+	batchVertices.clear();
+	drawCalls++;
 }
 
 void RenderSystem::setResolution(SpriteLoader& spriteLoader, float resolutionMultiplier) {
@@ -13,9 +13,8 @@ void ShadowTrailSystem::update(float deltaTime) {
 
 	view.each([this, deltaTime](auto entity, auto& position, auto& sprite, auto& trail) {
 		if (trail.update(deltaTime)) {
-			auto spritePtr = sprite.getSprite();
-			if (spritePtr) {
-				queue.pushBack(std::make_unique<SpawnShadowTrailCommand>(registry, *spritePtr, position.getX(), position.getY(), sprite.getInheritedRotationAngle(), trail.getLifespan()));
+			if (sprite.hasSprite()) {
+				queue.pushBack(std::make_unique<SpawnShadowTrailCommand>(registry, sprite.getSpriteTemplate(), sprite.getSpriteInstance(), position.getX(), position.getY(), sprite.getInheritedRotationAngle(), trail.getLifespan()));
 			}
 		}
 	});
@@ -4,22 +4,34 @@
 
 #include <Game/Components/PositionComponent.h>
 #include <Game/Components/AnimatableSetComponent.h>
+#include <Game/Components/AnimatedSpriteComponent.h>
 #include <Game/Components/SpriteComponent.h>
 
 void SpriteAnimationSystem::update(float deltaTime) {
-	auto view = registry.view<SpriteComponent>();
 	auto animatableSetView = registry.view<PositionComponent, AnimatableSetComponent, SpriteComponent>(entt::persistent_t{});
 
 	animatableSetView.each([this, deltaTime](auto entity, auto& position, auto& set, auto& sprite) {
 		set.update(spriteLoader, position.getX(), position.getY(), sprite, deltaTime);
+		AnimatedSpriteComponent::markIfAnimated(registry, entity);
 	});
 
-	view.each([this, deltaTime](auto entity, auto& sprite) {
+	// Only sprites that are animated need to be updated
+	auto view = registry.view<AnimatedSpriteComponent, SpriteComponent>();
+	view.each([this, deltaTime](auto entity, auto& animated, auto& sprite) {
 		sprite.update(deltaTime);
+		if (!sprite.isAnimated()) {
+			stoppedEntities.push_back(entity);
+		}
 	});
+	// Components can't be removed while iterating over them
+	for (uint32_t entity : stoppedEntities) {
+		registry.remove<AnimatedSpriteComponent>(entity);
+	}
+	stoppedEntities.clear();
 
 	animatableSetView.each([this](auto entity, auto& position, auto& set, auto& sprite) {
 		// Update again with 0 delta time in case some state needs to be changed
 		set.update(spriteLoader, position.getX(), position.getY(), sprite, 0);
+		AnimatedSpriteComponent::markIfAnimated(registry, entity);
 	});
-}
+}
\ No newline at end of file
@@ -1,17 +1,27 @@
 #include <LevelPack/Animation.h>
 
-Animation::Animation(std::string name, std::vector<std::pair<float, std::shared_ptr<sf::Sprite>>> sprites, bool loops) 
-	: name(name), sprites(sprites), looping(loops) {
-	for (auto p : sprites) {
+AnimationClip::AnimationClip(std::string name, std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>> sprites)
+	: name(name), sprites(sprites) {
+	for (auto& p : this->sprites) {
 		totalDuration += p.first;
 	}
 }
 
-std::shared_ptr<sf::Sprite> Animation::update(float deltaTime) {
-	if (done || currentSpriteIndex >= sprites.size()) {
-		return nullptr;
+Animation::Animation()
+	: done(true) {
+}
+
+Animation::Animation(std::shared_ptr<const AnimationClip> clip, bool loops)
+	: clip(clip), looping(loops) {
+}
+
+const std::shared_ptr<const SpriteTemplate>& Animation::update(float deltaTime) {
+	static const std::shared_ptr<const SpriteTemplate> noSprite;
+	if (done || !clip || currentSpriteIndex >= clip->getSprites().size()) {
+		return noSprite;
 	}
-	
+
+	const std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>>& sprites = clip->getSprites();
 	time += deltaTime;
 	while (time >= sprites[currentSpriteIndex].first) {
 		time -= sprites[currentSpriteIndex].first;
@@ -21,7 +31,7 @@ std::shared_ptr<sf::Sprite> Animation::update(float deltaTime) {
 				currentSpriteIndex = 0;
 			} else {
 				done = true;
-				return nullptr;
+				return noSprite;
 			}
 		}
 	}
@@ -91,10 +91,8 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EditorAttack:
 	return std::make_pair(status, messages);
 }
 
-void EditorAttack::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
-	if (!symbolTable.isEmpty()) {
-		symbolTables.push_back(symbolTable.toExprtkSymbolTable());
-	}
+void EditorAttack::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
+	DEFINE_SYMBOL_TABLES_FOR_COMPILE
 
 	mainEMP->compileExpressions(symbolTables);
 }
@@ -187,15 +187,14 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EditorAttackP
 	return std::make_pair(status, messages);
 }
 
-void EditorAttackPattern::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EditorAttackPattern::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(shadowTrailInterval)
 	COMPILE_EXPRESSION_FOR_FLOAT(shadowTrailLifespan)
 
 	compiledAttackIDs.clear();
-	for (auto t : attackIDs) {
-		parser.compile(std::get<0>(t), expr);
-		compiledAttackIDs.push_back(std::make_tuple(expr.value(), std::get<1>(t), std::get<2>(t).toLowerLevelSymbolTable(expr)));
+	for (const auto& t : attackIDs) {
+		compiledAttackIDs.push_back(std::make_tuple(expr.evaluate(std::get<0>(t)), std::get<1>(t), std::get<2>(t).toLowerLevelSymbolTable(expr)));
 	}
 	// Keep it sorted ascending by time
 	std::sort(compiledAttackIDs.begin(), compiledAttackIDs.end(), [](auto const& t1, auto const& t2) {
@@ -0,0 +1,155 @@
+#include <LevelPack/CookedLevelPack.h>
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Util/Logger.h>
+#include <Util/ParallelUtils.h>
+
+const std::uint32_t CookedLevelPack::FORMAT_VERSION = 2;
+
+static const char COOKED_LEVEL_PACK_MAGIC[4] = { 'B', 'H', 'M', 'P' };
+
+static_assert(sizeof(CookedLevelPack::OBJECT_TYPE) == sizeof(std::uint32_t), "OBJECT_TYPE is stored as a uint32_t");
+
+bool CookedLevelPack::write(const std::string& fileName, const std::vector<Object>& objects) {
+	std::vector<std::size_t> order(objects.size());
+	for (std::size_t i = 0; i < order.size(); i++) {
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&objects](std::size_t a, std::size_t b) {
+		return std::make_pair(objects[a].type, objects[a].id) < std::make_pair(objects[b].type, objects[b].id);
+	});
+
+	std::vector<std::vector<std::uint8_t>> encoded(order.size());
+	parallelFor(order.size(), [&objects, &order, &encoded](std::size_t i) {
+		encoded[i] = nlohmann::json::to_msgpack(objects[order[i]].json);
+	});
+
+	std::vector<Entry> table(order.size());
+	std::uint64_t offset = sizeof(Header) + table.size() * sizeof(Entry);
+	for (std::size_t i = 0; i < order.size(); i++) {
+		table[i].type = (std::uint32_t)objects[order[i]].type;
+		table[i].id = objects[order[i]].id;
+		table[i].offset = offset;
+		table[i].size = encoded[i].size();
+		table[i].checksum = computeChecksum(encoded[i].data(), encoded[i].size());
+		offset += encoded[i].size();
+	}
+
+	Header header;
+	std::memcpy(header.magic, COOKED_LEVEL_PACK_MAGIC, sizeof(header.magic));
+	header.version = FORMAT_VERSION;
+	header.entryCount = (std::uint32_t)table.size();
+	header.reserved = 0;
+	header.fileSize = offset;
+	header.checksum = computeChecksum((const unsigned char*)table.data(), table.size() * sizeof(Entry));
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	file.write((const char*)&header, sizeof(Header));
+	file.write((const char*)table.data(), table.size() * sizeof(Entry));
+	for (const std::vector<std::uint8_t>& bytes : encoded) {
+		file.write((const char*)bytes.data(), bytes.size());
+	}
+	file.close();
+	if (!file) {
+		L_(lerror) << "Failed to write cooked level pack \"" << fileName << "\"";
+		return false;
+	}
+	return true;
+}
+
+bool CookedLevelPack::open(const std::string& fileName) {
+	entries = nullptr;
+	entryCount = 0;
+
+	if (!file.open(fileName)) {
+		L_(lerror) << "Failed to open cooked level pack \"" << fileName << "\"";
+		return false;
+	}
+
+	Header header;
+	if (file.getSize() < sizeof(Header)) {
+		L_(lerror) << "Cooked level pack \"" << fileName << "\" is truncated";
+		file.close();
+		return false;
+	}
+	std::memcpy(&header, file.getData(), sizeof(Header));
+	if (std::memcmp(header.magic, COOKED_LEVEL_PACK_MAGIC, sizeof(header.magic)) != 0) {
+		L_(lerror) << "\"" << fileName << "\" is not a cooked level pack";
+		file.close();
+		return false;
+	}
+	if (header.version != FORMAT_VERSION) {
+		L_(lerror) << "Cooked level pack \"" << fileName << "\" has version " << header.version << " but version " << FORMAT_VERSION << " is required";
+		file.close();
+		return false;
+	}
+	if (header.fileSize != file.getSize() || sizeof(Header) + (std::uint64_t)header.entryCount * sizeof(Entry) > header.fileSize) {
+		L_(lerror) << "Cooked level pack \"" << fileName << "\" is truncated";
+		file.close();
+		return false;
+	}
+	// Only the table is checked here; each object is checked when it is read, so opening doesn't have to read the whole file
+	if (computeChecksum(file.getData() + sizeof(Header), (std::size_t)header.entryCount * sizeof(Entry)) != header.checksum) {
+		L_(lerror) << "Cooked level pack \"" << fileName << "\" is corrupted";
+		file.close();
+		return false;
+	}
+
+	// The header is 8-byte aligned and so is every entry, so the table can be used in place
+	entries = (const Entry*)(file.getData() + sizeof(Header));
+	entryCount = header.entryCount;
+	return true;
+}
+
+bool CookedLevelPack::contains(OBJECT_TYPE type, int id) const {
+	return findEntry(type, id) != nullptr;
+}
+
+std::vector<int> CookedLevelPack::getIDs(OBJECT_TYPE type) const {
+	std::vector<int> ids;
+	const Entry* begin = std::lower_bound(entries, entries + entryCount, (std::uint32_t)type, [](const Entry& entry, std::uint32_t type) {
+		return entry.type < type;
+	});
+	for (const Entry* entry = begin; entry != entries + entryCount && entry->type == (std::uint32_t)type; entry++) {
+		ids.push_back(entry->id);
+	}
+	return ids;
+}
+
+nlohmann::json CookedLevelPack::read(OBJECT_TYPE type, int id) const {
+	const Entry* entry = findEntry(type, id);
+	if (!entry) {
+		throw std::out_of_range("Cooked level pack does not contain object " + std::to_string(id) + " of type " + std::to_string((std::uint32_t)type));
+	}
+	if (entry->offset + entry->size > file.getSize()) {
+		throw std::out_of_range("Cooked level pack object " + std::to_string(id) + " of type " + std::to_string((std::uint32_t)type) + " is out of bounds");
+	}
+	const unsigned char* begin = file.getData() + entry->offset;
+	if (computeChecksum(begin, entry->size) != entry->checksum) {
+		throw std::out_of_range("Cooked level pack object " + std::to_string(id) + " of type " + std::to_string((std::uint32_t)type) + " is corrupted");
+	}
+	return nlohmann::json::from_msgpack(begin, begin + entry->size);
+}
+
+const CookedLevelPack::Entry* CookedLevelPack::findEntry(OBJECT_TYPE type, int id) const {
+	auto key = std::make_pair((std::uint32_t)type, (std::int32_t)id);
+	const Entry* entry = std::lower_bound(entries, entries + entryCount, key, [](const Entry& entry, const std::pair<std::uint32_t, std::int32_t>& key) {
+		return std::make_pair(entry.type, entry.id) < key;
+	});
+	if (entry == entries + entryCount || entry->type != key.first || entry->id != key.second) {
+		return nullptr;
+	}
+	return entry;
+}
+
+std::uint64_t CookedLevelPack::computeChecksum(const unsigned char* data, std::size_t size, std::uint64_t hash) {
+	for (std::size_t i = 0; i < size; i++) {
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
@@ -70,7 +70,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> PlayAnimatabl
 	return std::make_pair(status, messages);
 }
 
-void PlayAnimatableDeathAction::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void PlayAnimatableDeathAction::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(duration)
 }
@@ -148,7 +148,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> PlaySoundDeat
 	return std::make_pair(status, messages);
 }
 
-void PlaySoundDeathAction::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void PlaySoundDeathAction::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing to be done
 }
 
@@ -255,11 +255,11 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> ExecuteAttack
 	return std::make_pair(status, messages);
 }
 
-void ExecuteAttacksDeathAction::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void ExecuteAttacksDeathAction::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 
 	compiledAttackIDs.clear();
-	for (auto p : attackIDs) {
+	for (const auto& p : attackIDs) {
 		compiledAttackIDs.push_back(std::make_pair(p.first, p.second.toLowerLevelSymbolTable(expr)));
 	}
 }
@@ -383,7 +383,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> ParticleExplo
 	return std::pair<LEGAL_STATUS, std::vector<std::string>>();
 }
 
-void ParticleExplosionDeathAction::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void ParticleExplosionDeathAction::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(minParticles)
 	COMPILE_EXPRESSION_FOR_INT(maxParticles)
@@ -549,7 +549,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> NullDeathActi
 	return std::make_pair(LEGAL_STATUS::LEGAL, std::vector<std::string>());
 }
 
-void NullDeathAction::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void NullDeathAction::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 }
 
 void NullDeathAction::execute(LevelPack& levelPack, EntityCreationQueue& queue, entt::DefaultRegistry& registry, SpriteLoader& spriteLoader, uint32_t entity) {
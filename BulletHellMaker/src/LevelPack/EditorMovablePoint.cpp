@@ -1,5 +1,8 @@
 #include <LevelPack/EditorMovablePoint.h>
 
+#include <cmath>
+
+#include <Util/MathUtils.h>
 #include <LevelPack/EditorMovablePointSpawnType.h>
 #include <LevelPack/Attack.h>
 #include <LevelPack/LevelPack.h>
@@ -57,7 +60,8 @@ std::string EditorMovablePoint::format() const {
 		+ formatString(pierceResetTime) + formatTMObject(soundSettings) + tos(bulletModelID) + formatBool(inheritRadius)
 		+ formatBool(inheritDespawnTime) + formatBool(inheritShadowTrailInterval) + formatBool(inheritShadowTrailLifespan)
 		+ formatBool(inheritAnimatables) + formatBool(inheritDamage) + formatBool(inheritPierceResetTime) + formatBool(inheritSoundSettings) + formatBool(isBullet)
-		+ formatTMObject(symbolTable);
+		+ formatTMObject(symbolTable) + formatBool(overridesOffScreenPolicy) + formatTMObject(offScreenPolicy) + formatBool(continuousCollision)
+		+ tos(capsuleEndX) + tos(capsuleEndY);
 
 	return res;
 }
@@ -124,6 +128,17 @@ void EditorMovablePoint::load(std::string formattedString) {
 	inheritSoundSettings = unformatBool(items.at(i++));
 	isBullet = unformatBool(items.at(i++));
 	symbolTable.load(items.at(i++));
+	loadOffScreenPolicy(items, i);
+	// EMPs saved before continuous collision existed don't use it
+	continuousCollision = i + 2 < items.size() && unformatBool(items.at(i + 2));
+	// EMPs saved before capsules existed are circles
+	if (i + 4 < items.size()) {
+		capsuleEndX = std::stof(items.at(i + 3));
+		capsuleEndY = std::stof(items.at(i + 4));
+	} else {
+		capsuleEndX = 0;
+		capsuleEndY = 0;
+	}
 }
 
 nlohmann::json EditorMovablePoint::toJson() {
@@ -151,7 +166,12 @@ nlohmann::json EditorMovablePoint::toJson() {
 		{"inheritDamage", inheritDamage},
 		{"inheritPierceResetTime", inheritPierceResetTime},
 		{"inheritSoundSettings", inheritSoundSettings},
-		{"isBullet", isBullet}
+		{"isBullet", isBullet},
+		{"overridesOffScreenPolicy", overridesOffScreenPolicy},
+		{"offScreenPolicy", offScreenPolicy.toJson()},
+		{"continuousCollision", continuousCollision},
+		{"capsuleEndX", capsuleEndX},
+		{"capsuleEndY", capsuleEndY}
 	};
 
 	nlohmann::json childrenJson;
@@ -218,6 +238,25 @@ void EditorMovablePoint::load(const nlohmann::json& j) {
 	j.at("inheritPierceResetTime").get_to(inheritPierceResetTime);
 	j.at("inheritSoundSettings").get_to(inheritSoundSettings);
 	j.at("isBullet").get_to(isBullet);
+	if (j.contains("offScreenPolicy")) {
+		j.at("overridesOffScreenPolicy").get_to(overridesOffScreenPolicy);
+		offScreenPolicy.load(j.at("offScreenPolicy"));
+	} else {
+		overridesOffScreenPolicy = false;
+		offScreenPolicy = OffScreenPolicy();
+	}
+	if (j.contains("continuousCollision")) {
+		j.at("continuousCollision").get_to(continuousCollision);
+	} else {
+		continuousCollision = false;
+	}
+	if (j.contains("capsuleEndX")) {
+		j.at("capsuleEndX").get_to(capsuleEndX);
+		j.at("capsuleEndY").get_to(capsuleEndY);
+	} else {
+		capsuleEndX = 0;
+		capsuleEndY = 0;
+	}
 
 	children.clear();
 	if (j.contains("children")) {
@@ -321,7 +360,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EditorMovable
 	return std::make_pair(status, messages);
 }
 
-void EditorMovablePoint::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EditorMovablePoint::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(hitboxRadius)
 	COMPILE_EXPRESSION_FOR_FLOAT(shadowTrailInterval)
@@ -523,6 +562,98 @@ void EditorMovablePoint::removeChild(int id) {
 	children.erase(children.begin() + pos);
 }
 
+namespace {
+	/*
+	Parses a string that is only a number. Unlike std::stof, anything after the number makes this fail.
+	*/
+	bool tryParseNumber(const std::string& str, float& result) {
+		try {
+			size_t end;
+			result = std::stof(str, &end);
+			return str.find_first_not_of(' ', end) == std::string::npos;
+		} catch (...) {
+			return false;
+		}
+	}
+}
+
+std::vector<std::shared_ptr<EditorMovablePoint>> EditorMovablePoint::getChildrenChain() const {
+	// Max distance in pixels that a link can be from the line through the chain, since chains are usually placed by hand
+	const float maxDistanceFromLine = 0.5f;
+
+	std::vector<std::shared_ptr<EditorMovablePoint>> links;
+	std::vector<float> xs, ys;
+	for (auto child : children) {
+		float x, y;
+		if (!child->isBullet || child->isCapsule() || !child->children.empty() || !dynamic_cast<EntityAttachedEMPSpawn*>(child->spawnType.get())
+			|| !tryParseNumber(child->spawnType->getRawX(), x) || !tryParseNumber(child->spawnType->getRawY(), y)) {
+			continue;
+		}
+		// A capsule made from a chain would rotate as a whole, unlike the circles it replaces, so only unrotated chains can be converted
+		if (child->animatable.getRotationType() != ROTATION_TYPE::LOCK_ROTATION) {
+			continue;
+		}
+		if (!links.empty() && !links[0]->isSameChainLink(*child)) {
+			continue;
+		}
+		links.push_back(child);
+		xs.push_back(x);
+		ys.push_back(y);
+	}
+	if (links.size() < 2) {
+		return {};
+	}
+
+	// The chain's direction is from the first link to the link farthest from it
+	float farthestDistance = 0;
+	float dirX = 0, dirY = 0;
+	for (int i = 1; i < links.size(); i++) {
+		float linkDistance = distance(xs[0], ys[0], xs[i], ys[i]);
+		if (linkDistance > farthestDistance) {
+			farthestDistance = linkDistance;
+			dirX = (xs[i] - xs[0]) / linkDistance;
+			dirY = (ys[i] - ys[0]) / linkDistance;
+		}
+	}
+	if (farthestDistance == 0) {
+		return {};
+	}
+
+	// Sort the links by how far along the chain they are
+	std::vector<std::pair<float, int>> linkOrder;
+	for (int i = 0; i < links.size(); i++) {
+		float relativeX = xs[i] - xs[0];
+		float relativeY = ys[i] - ys[0];
+		if (std::abs(relativeX * dirY - relativeY * dirX) > maxDistanceFromLine) {
+			return {};
+		}
+		linkOrder.push_back(std::make_pair(relativeX * dirX + relativeY * dirY, i));
+	}
+	std::sort(linkOrder.begin(), linkOrder.end());
+
+	std::vector<std::shared_ptr<EditorMovablePoint>> chain;
+	for (auto link : linkOrder) {
+		chain.push_back(links[link.second]);
+	}
+	return chain;
+}
+
+std::vector<std::shared_ptr<EditorMovablePoint>> EditorMovablePoint::convertChildrenChainToCapsule() {
+	std::vector<std::shared_ptr<EditorMovablePoint>> chain = getChildrenChain();
+	if (chain.empty()) {
+		return chain;
+	}
+
+	// getChildrenChain() already made sure the spawn positions are numbers
+	std::shared_ptr<EMPSpawnType> first = chain.front()->spawnType;
+	std::shared_ptr<EMPSpawnType> last = chain.back()->spawnType;
+	chain.front()->setCapsuleEnd(std::stof(last->getRawX()) - std::stof(first->getRawX()), std::stof(last->getRawY()) - std::stof(first->getRawY()));
+	for (int i = 1; i < chain.size(); i++) {
+		removeChild(chain[i]->id);
+	}
+	return chain;
+}
+
 void EditorMovablePoint::detachFromParent() {
 	if (!parent.expired()) {
 		parent.lock()->removeChild(id);
@@ -545,7 +676,11 @@ void EditorMovablePoint::addChild(std::shared_ptr<EditorMovablePoint> child) {
 			break;
 		}
 	}
-	children.insert(children.begin() + indexToInsert, child);
+	insertChild(indexToInsert, child);
+}
+
+void EditorMovablePoint::insertChild(int index, std::shared_ptr<EditorMovablePoint> child) {
+	children.insert(children.begin() + index, child);
 	child->resolveIDConflicts(true);
 	child->updateBulletModelToBulletModelsCount(true);
 	child->parent = shared_from_this();
@@ -624,6 +759,9 @@ bool EditorMovablePoint::operator==(const EditorMovablePoint& other) const {
 		&& inheritShadowTrailInterval == other.inheritShadowTrailInterval && inheritShadowTrailLifespan == other.inheritShadowTrailLifespan
 		&& inheritAnimatables == other.inheritAnimatables && inheritDamage == other.inheritDamage && inheritPierceResetTime == other.inheritPierceResetTime
 		&& inheritSoundSettings == other.inheritSoundSettings
+		&& overridesOffScreenPolicy == other.overridesOffScreenPolicy && offScreenPolicy == other.offScreenPolicy
+		&& continuousCollision == other.continuousCollision
+		&& capsuleEndX == other.capsuleEndX && capsuleEndY == other.capsuleEndY
 		&& bulletModelsCount->size() == other.bulletModelsCount->size()
 		&& std::equal(bulletModelsCount->begin(), bulletModelsCount->end(), other.bulletModelsCount->begin());
 }
@@ -688,6 +826,54 @@ void EditorMovablePoint::copyConstructorLoad(std::string formattedString) {
 	inheritPierceResetTime = unformatBool(items.at(i++));
 	inheritSoundSettings = unformatBool(items.at(i++));
 	isBullet = unformatBool(items.at(i++));
+	// Symbol table is not copied
+	i++;
+	loadOffScreenPolicy(items, i);
+	// EMPs saved before continuous collision existed don't use it
+	continuousCollision = i + 2 < items.size() && unformatBool(items.at(i + 2));
+	// EMPs saved before capsules existed are circles
+	if (i + 4 < items.size()) {
+		capsuleEndX = std::stof(items.at(i + 3));
+		capsuleEndY = std::stof(items.at(i + 4));
+	} else {
+		capsuleEndX = 0;
+		capsuleEndY = 0;
+	}
+}
+
+void EditorMovablePoint::loadOffScreenPolicy(const std::vector<std::string>& items, int i) {
+	// EMPs saved before off-screen policies existed use their level's policy
+	if (i + 1 < items.size()) {
+		overridesOffScreenPolicy = unformatBool(items.at(i));
+		offScreenPolicy.load(items.at(i + 1));
+	} else {
+		overridesOffScreenPolicy = false;
+		offScreenPolicy = OffScreenPolicy();
+	}
+}
+
+bool EditorMovablePoint::isSameChainLink(const EditorMovablePoint& other) const {
+	if (actions.size() != other.actions.size()) {
+		return false;
+	}
+	for (int i = 0; i < actions.size(); i++) {
+		if (actions[i]->format() != other.actions[i]->format()) {
+			return false;
+		}
+	}
+	return isBullet == other.isBullet && hitboxRadius == other.hitboxRadius && despawnTime == other.despawnTime
+		&& spawnType->getRawTime() == other.spawnType->getRawTime()
+		&& shadowTrailInterval == other.shadowTrailInterval && shadowTrailLifespan == other.shadowTrailLifespan
+		&& animatable == other.animatable && loopAnimation == other.loopAnimation && baseSprite == other.baseSprite
+		&& damage == other.damage && onCollisionAction == other.onCollisionAction && pierceResetTime == other.pierceResetTime
+		&& continuousCollision == other.continuousCollision && bulletModelID == other.bulletModelID
+		&& overridesOffScreenPolicy == other.overridesOffScreenPolicy && offScreenPolicy == other.offScreenPolicy
+		&& capsuleEndX == other.capsuleEndX && capsuleEndY == other.capsuleEndY
+		&& soundSettings.format() == other.soundSettings.format() && symbolTable.format() == other.symbolTable.format()
+		&& inheritRadius == other.inheritRadius && inheritDespawnTime == other.inheritDespawnTime
+		&& inheritShadowTrailInterval == other.inheritShadowTrailInterval && inheritShadowTrailLifespan == other.inheritShadowTrailLifespan
+		&& inheritAnimatables == other.inheritAnimatables && inheritDamage == other.inheritDamage
+		&& inheritPierceResetTime == other.inheritPierceResetTime && inheritSoundSettings == other.inheritSoundSettings;
 }
 
 void EditorMovablePoint::getChildrenIDsHelper(std::vector<int>& arr) const {
@@ -871,7 +1057,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> BulletModel::
 	return std::make_pair(LEGAL_STATUS::ILLEGAL, std::vector<std::string>());
 }
 
-void BulletModel::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void BulletModel::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing to compile
 }
 
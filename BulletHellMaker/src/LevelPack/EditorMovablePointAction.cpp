@@ -1,6 +1,7 @@
 #include <LevelPack/EditorMovablePointAction.h>
 
 #include <cmath>
+#include <algorithm>
 
 #include <LevelPack/EditorMovablePointSpawnType.h>
 
@@ -57,7 +58,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EMPAAngleOffs
 	return std::make_pair(status, messages);
 }
 
-void EMPAAngleOffsetToPlayer::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EMPAAngleOffsetToPlayer::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(xOffset)
 	COMPILE_EXPRESSION_FOR_FLOAT(yOffset)
@@ -131,7 +132,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EMPAAngleOffs
 	return std::make_pair(status, messages);
 }
 
-void EMPAAngleOffsetToGlobalPosition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EMPAAngleOffsetToGlobalPosition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(x)
 	COMPILE_EXPRESSION_FOR_FLOAT(y)
@@ -186,7 +187,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EMPAAngleOffs
 	return std::make_pair(LEGAL_STATUS::LEGAL, std::vector<std::string>());
 }
 
-void EMPAAngleOffsetZero::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EMPAAngleOffsetZero::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing to be done
 }
 
@@ -243,7 +244,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EMPAAngleOffs
 	return std::make_pair(status, messages);
 }
 
-void EMPAAngleOffsetConstant::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EMPAAngleOffsetConstant::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(value)
 }
@@ -289,7 +290,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EMPAngleOffse
 	return std::make_pair(LEGAL_STATUS::LEGAL, std::vector<std::string>());
 }
 
-void EMPAngleOffsetPlayerSpriteAngle::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EMPAngleOffsetPlayerSpriteAngle::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing to be done
 }
 
@@ -344,7 +345,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> DetachFromPar
 	return std::make_pair(LEGAL_STATUS::LEGAL, std::vector<std::string>());
 }
 
-void DetachFromParentEMPA::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void DetachFromParentEMPA::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing to be done
 }
 
@@ -426,7 +427,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> StayStillAtLa
 	return std::make_pair(status, messages);
 }
 
-void StayStillAtLastPositionEMPA::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void StayStillAtLastPositionEMPA::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing to be done
 }
 
@@ -440,6 +441,10 @@ std::shared_ptr<MovablePoint> StayStillAtLastPositionEMPA::execute(EntityCreatio
 	// Queue creation of the reference entity
 	queue.pushFront(std::make_unique<CreateMovementReferenceEntityCommand>(registry, entity, timeLag, lastPos.getX(), lastPos.getY()));
 
+	std::shared_ptr<const BakedTrajectory> baked = BakedTrajectory::getBaked({ (float)BakedTrajectory::PATH_TYPE::STATIONARY, duration });
+	if (baked) {
+		return std::make_shared<BakedMP>(baked);
+	}
 	return std::make_shared<StationaryMP>(sf::Vector2f(0, 0), duration);
 }
 
@@ -447,6 +452,11 @@ std::shared_ptr<MovablePoint> StayStillAtLastPositionEMPA::generateStandaloneMP(
 	return std::make_shared<StationaryMP>(sf::Vector2f(x, y), duration);
 }
 
+void StayStillAtLastPositionEMPA::bakeTrajectory() {
+	StationaryMP mp(sf::Vector2f(0, 0), duration);
+	BakedTrajectory::getOrBakeSteps({ (float)BakedTrajectory::PATH_TYPE::STATIONARY, duration }, mp, { 0 });
+}
+
 bool StayStillAtLastPositionEMPA::operator==(const EMPAction& other) const {
 	const StayStillAtLastPositionEMPA& derived = dynamic_cast<const StayStillAtLastPositionEMPA&>(other);
 	return duration == derived.duration;
@@ -543,10 +553,12 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> MoveCustomPol
 	return std::make_pair(status, messages);
 }
 
-void MoveCustomPolarEMPA::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void MoveCustomPolarEMPA::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 
 	angleOffset->compileExpressions(symbolTables);
+	distance->bindSymbols(symbolTables);
+	angle->bindSymbols(symbolTables);
 }
 
 std::string MoveCustomPolarEMPA::getGuiFormat() {
@@ -562,6 +574,16 @@ std::shared_ptr<MovablePoint> MoveCustomPolarEMPA::execute(EntityCreationQueue&
 	float referenceEntityDistanceOffset = distance->evaluate(0);
 	queue.pushFront(std::make_unique<CreateMovementReferenceEntityCommand>(registry, entity, timeLag, lastPos.getX() + referenceEntityDistanceOffset * std::cos(referenceEntityAngleOffset + PI), lastPos.getY() + referenceEntityDistanceOffset * std::sin(referenceEntityAngleOffset + PI)));
 	
+	BakedTrajectory::Key key;
+	std::vector<float> stepTimes;
+	if (BakedTrajectory::isEnabled() && getTrajectoryKey(key, stepTimes)) {
+		std::shared_ptr<const BakedTrajectory> baked = BakedTrajectory::getBaked(key);
+		if (baked) {
+			// Adding an angle offset rotates the whole path around (0, 0)
+			return std::make_shared<BakedMP>(baked, angleOffset ? angleOffset->evaluate(registry, lastPos.getX(), lastPos.getY()) : 0);
+		}
+	}
+
 	if (angleOffset == nullptr) {
 		return std::make_shared<PolarMP>(time, distance, angle);
 	} else {
@@ -583,6 +605,52 @@ std::shared_ptr<MovablePoint> MoveCustomPolarEMPA::generateStandaloneMP(float x,
 	}
 }
 
+void MoveCustomPolarEMPA::bakeTrajectory() {
+	BakedTrajectory::Key key;
+	std::vector<float> stepTimes;
+	if (!getTrajectoryKey(key, stepTimes)) {
+		return;
+	}
+	PolarMP mp(time, distance, angle);
+	BakedTrajectory::getOrBakeSteps(key, mp, stepTimes);
+}
+
+bool MoveCustomPolarEMPA::getTrajectoryKey(BakedTrajectory::Key& key, std::vector<float>& stepTimes) {
+	key = { (float)BakedTrajectory::PATH_TYPE::POLAR, time };
+	stepTimes = { 0 };
+	// Adds a TFV's (start time, value) pairs to the key, or returns false if it isn't constant or piecewise constant
+	auto addSteps = [this, &key, &stepTimes](std::shared_ptr<TFV> tfv) {
+		if (auto constant = std::dynamic_pointer_cast<ConstantTFV>(tfv)) {
+			key.insert(key.end(), { 1, 0, constant->getValue() });
+			return true;
+		}
+		auto piecewise = std::dynamic_pointer_cast<PiecewiseTFV>(tfv);
+		if (!piecewise) {
+			return false;
+		}
+		key.push_back((float)piecewise->getSegmentsCount());
+		for (int i = 0; i < piecewise->getSegmentsCount(); i++) {
+			std::pair<float, std::shared_ptr<TFV>> segment = piecewise->getSegment(i);
+			auto constant = std::dynamic_pointer_cast<ConstantTFV>(segment.second);
+			if (!constant) {
+				return false;
+			}
+			key.insert(key.end(), { segment.first, constant->getValue() });
+			if (segment.first > 0 && segment.first < time) {
+				stepTimes.push_back(segment.first);
+			}
+		}
+		return true;
+	};
+	if (!addSteps(distance) || !addSteps(angle)) {
+		return false;
+	}
+
+	std::sort(stepTimes.begin(), stepTimes.end());
+	stepTimes.erase(std::unique(stepTimes.begin(), stepTimes.end()), stepTimes.end());
+	return true;
+}
+
 bool MoveCustomPolarEMPA::operator==(const EMPAction& other) const {
 	const MoveCustomPolarEMPA& derived = dynamic_cast<const MoveCustomPolarEMPA&>(other);
 	return *distance == *derived.distance && *angle == *derived.angle && time == derived.time && ((!angleOffset && !derived.angleOffset) || *angleOffset == *derived.angleOffset);
@@ -609,7 +677,7 @@ std::shared_ptr<LevelPackObject> MoveCustomBezierEMPA::clone() const {
 
 std::string MoveCustomBezierEMPA::format() const {
 	std::string ret = formatString("MoveCustomBezierEMPA");
-	ret += tos(time) + formatTMObject(*rotationAngle) + formatTMObject(symbolTable);
+	ret += tos(time) + formatTMObject(*rotationAngle) + formatTMObject(symbolTable) + formatBool(constantSpeed);
 	for (auto p : unrotatedControlPoints) {
 		ret += tos(p.x) + tos(p.y);
 	}
@@ -621,11 +689,15 @@ void MoveCustomBezierEMPA::load(std::string formattedString) {
 	time = std::stof(items.at(1));
 	rotationAngle = EMPAAngleOffsetFactory::create(items.at(2));
 	symbolTable.load(items.at(3));
+	constantSpeed = unformatBool(items.at(4));
 	unrotatedControlPoints.clear();
 	int i;
-	for (i = 4; i < items.size(); i += 2) {
+	for (i = 5; i < items.size(); i += 2) {
 		unrotatedControlPoints.push_back(sf::Vector2f(std::stof(items.at(i)), std::stof(items.at(i + 1))));
 	}
+	arcLengthTable = nullptr;
+	bakedTrajectory = nullptr;
+	bakeAttempted = false;
 }
 
 nlohmann::json MoveCustomBezierEMPA::toJson() {
@@ -633,7 +705,8 @@ nlohmann::json MoveCustomBezierEMPA::toJson() {
 		{"className", "MoveCustomBezierEMPA"},
 		{"time", time},
 		{"rotationAngle", rotationAngle->toJson()},
-		{"valueSymbolTable", symbolTable.toJson()}
+		{"valueSymbolTable", symbolTable.toJson()},
+		{"constantSpeed", constantSpeed}
 	};
 
 	nlohmann::json unrotatedControlPointsJson;
@@ -663,6 +736,15 @@ void MoveCustomBezierEMPA::load(const nlohmann::json& j) {
 			unrotatedControlPoints.push_back(sf::Vector2f(x, y));
 		}
 	}
+	arcLengthTable = nullptr;
+	bakedTrajectory = nullptr;
+	bakeAttempted = false;
+
+	if (j.contains("constantSpeed")) {
+		j.at("constantSpeed").get_to(constantSpeed);
+	} else {
+		constantSpeed = false;
+	}
 
 	if (j.contains("valueSymbolTable")) {
 		symbolTable.load(j.at("valueSymbolTable"));
@@ -693,7 +775,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> MoveCustomBez
 	return std::make_pair(status, messages);
 }
 
-void MoveCustomBezierEMPA::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void MoveCustomBezierEMPA::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 
 	rotationAngle->compileExpressions(symbolTables);
@@ -710,52 +792,82 @@ std::shared_ptr<MovablePoint> MoveCustomBezierEMPA::execute(EntityCreationQueue
 	// Queue creation of the reference entity
 	queue.pushFront(std::make_unique<CreateMovementReferenceEntityCommand>(registry, entity, timeLag, lastPos.getX(), lastPos.getY()));
 
-	if (rotationAngle) {
-		// Rotate all control points around (0, 0)
-		float radians = rotationAngle->evaluate(registry, lastPos.getX(), lastPos.getY());
-		float cos = std::cos(radians);
-		float sin = std::sin(radians);
-
-		std::vector<sf::Vector2f> controlPoints;
-		controlPoints.push_back(sf::Vector2f(0, 0));
-		// Skip the first control point since it's always going to be (0, 0)
-		for (int i = 1; i < unrotatedControlPoints.size(); i++) {
-			controlPoints.push_back(sf::Vector2f(unrotatedControlPoints[i].x * cos - unrotatedControlPoints[i].y * sin,
-				unrotatedControlPoints[i].x * sin + unrotatedControlPoints[i].y * cos));
-		}
-
-		return std::make_shared<BezierMP>(time, controlPoints);
-	} else {
-		return std::make_shared<BezierMP>(time, unrotatedControlPoints);
+	float rotation = rotationAngle ? rotationAngle->evaluate(registry, lastPos.getX(), lastPos.getY()) : 0;
+	if (getBakedTrajectory()) {
+		return std::make_shared<BakedMP>(bakedTrajectory, rotation);
 	}
+	return createBezierMP(rotation);
 }
 
 std::shared_ptr<MovablePoint> MoveCustomBezierEMPA::generateStandaloneMP(float x, float y, float playerX, float playerY) {
 	if (rotationAngle) {
+		return createBezierMP(rotationAngle->evaluate(x, y, playerX, playerY));
+	} else {
+		return createBezierMP(0);
+	}
+}
+
+bool MoveCustomBezierEMPA::operator==(const EMPAction& other) const {
+	const MoveCustomBezierEMPA& derived = dynamic_cast<const MoveCustomBezierEMPA&>(other);
+	return time == derived.time && ((!rotationAngle && !derived.rotationAngle) || *rotationAngle == *derived.rotationAngle)
+		&& unrotatedControlPoints.size() == derived.unrotatedControlPoints.size()
+		&& std::equal(unrotatedControlPoints.begin(), unrotatedControlPoints.end(), derived.unrotatedControlPoints.begin())
+		&& constantSpeed == derived.constantSpeed;
+}
+
+std::shared_ptr<MovablePoint> MoveCustomBezierEMPA::createBezierMP(float rotationRadians) {
+	std::vector<sf::Vector2f> controlPoints;
+	if (rotationRadians == 0) {
+		controlPoints = unrotatedControlPoints;
+	} else {
 		// Rotate all control points around (0, 0)
-		float radians = rotationAngle->evaluate(x, y, playerX, playerY);
-		float cos = std::cos(radians);
-		float sin = std::sin(radians);
+		float cos = std::cos(rotationRadians);
+		float sin = std::sin(rotationRadians);
 
-		std::vector<sf::Vector2f> controlPoints;
 		controlPoints.push_back(sf::Vector2f(0, 0));
 		// Skip the first control point since it's always going to be (0, 0)
 		for (int i = 1; i < unrotatedControlPoints.size(); i++) {
 			controlPoints.push_back(sf::Vector2f(unrotatedControlPoints[i].x * cos - unrotatedControlPoints[i].y * sin,
 				unrotatedControlPoints[i].x * sin + unrotatedControlPoints[i].y * cos));
 		}
+	}
 
+	if (!constantSpeed) {
 		return std::make_shared<BezierMP>(time, controlPoints);
-	} else {
-		return std::make_shared<BezierMP>(time, unrotatedControlPoints);
 	}
+	if (!arcLengthTable) {
+		arcLengthTable = BezierMP::computeArcLengthTable(unrotatedControlPoints);
+	}
+	return std::make_shared<BezierMP>(time, controlPoints, true, arcLengthTable);
 }
 
-bool MoveCustomBezierEMPA::operator==(const EMPAction& other) const {
-	const MoveCustomBezierEMPA& derived = dynamic_cast<const MoveCustomBezierEMPA&>(other);
-	return time == derived.time && ((!rotationAngle && !derived.rotationAngle) || *rotationAngle == *derived.rotationAngle)
-		&& unrotatedControlPoints.size() == derived.unrotatedControlPoints.size()
-		&& std::equal(unrotatedControlPoints.begin(), unrotatedControlPoints.end(), derived.unrotatedControlPoints.begin());
+void MoveCustomBezierEMPA::bakeTrajectory() {
+	if (!constantSpeed) {
+		return;
+	}
+	if (!arcLengthTable) {
+		arcLengthTable = BezierMP::computeArcLengthTable(unrotatedControlPoints);
+	}
+	BezierMP mp(time, unrotatedControlPoints, true, arcLengthTable);
+	BakedTrajectory::getOrBake(getTrajectoryKey(), mp);
+}
+
+BakedTrajectory::Key MoveCustomBezierEMPA::getTrajectoryKey() const {
+	BakedTrajectory::Key key = { (float)BakedTrajectory::PATH_TYPE::CONSTANT_SPEED_BEZIER, time };
+	for (auto p : unrotatedControlPoints) {
+		key.push_back(p.x);
+		key.push_back(p.y);
+	}
+	return key;
+}
+
+std::shared_ptr<const BakedTrajectory> MoveCustomBezierEMPA::getBakedTrajectory() {
+	if (!constantSpeed || bakeAttempted || !BakedTrajectory::isEnabled()) {
+		return bakedTrajectory;
+	}
+	bakeAttempted = true;
+	bakedTrajectory = BakedTrajectory::getBaked(getTrajectoryKey());
+	return bakedTrajectory;
 }
 
 MovePlayerHomingEMPA::MovePlayerHomingEMPA() {
@@ -829,8 +941,11 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> MovePlayerHom
 	return std::make_pair(status, messages);
 }
 
-void MovePlayerHomingEMPA::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
-	// Nothing to be done
+void MovePlayerHomingEMPA::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
+	DEFINE_SYMBOL_TABLES_FOR_COMPILE
+
+	homingStrength->bindSymbols(symbolTables);
+	speed->bindSymbols(symbolTables);
 }
 
 std::string MovePlayerHomingEMPA::getGuiFormat() {
@@ -928,10 +1043,13 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> MoveGlobalHom
 	return std::make_pair(status, messages);
 }
 
-void MoveGlobalHomingEMPA::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void MoveGlobalHomingEMPA::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(targetX)
 	COMPILE_EXPRESSION_FOR_FLOAT(targetY)
+
+	homingStrength->bindSymbols(symbolTables);
+	speed->bindSymbols(symbolTables);
 }
 
 std::string MoveGlobalHomingEMPA::getGuiFormat() {
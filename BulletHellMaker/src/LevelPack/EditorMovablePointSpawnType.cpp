@@ -99,7 +99,7 @@ nlohmann::json EntityRelativeEMPSpawn::toJson() {
 MPSpawnInformation EntityRelativeEMPSpawn::getSpawnInfo(entt::DefaultRegistry & registry, uint32_t entity, float timeLag) {
 	// Assume that if the entity spawning this has no MovementPathComponent, it has stayed at the same global position for its entire lifespan
 	if (registry.has<MovementPathComponent>(entity)) {
-		auto& pos = registry.get<MovementPathComponent>(entity).getPreviousPosition(registry, timeLag);
+		auto pos = registry.get<MovementPathComponent>(entity).getPreviousPosition(registry, timeLag);
 		// Offset by the hitbox origin, if the entity has one
 		if (registry.has<HitboxComponent>(entity)) {
 			auto hitbox = registry.get<HitboxComponent>(entity);
@@ -242,7 +242,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EMPSpawnType:
 	return std::make_pair(status, messages);
 }
 
-void EMPSpawnType::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EMPSpawnType::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(time)
 	COMPILE_EXPRESSION_FOR_FLOAT(x)
@@ -224,13 +224,13 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EditorEnemy::
 	return std::make_pair(status, messages);
 }
 
-void EditorEnemy::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EditorEnemy::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(hitboxRadius)
 	COMPILE_EXPRESSION_FOR_INT(health)
 	COMPILE_EXPRESSION_FOR_FLOAT(despawnTime)
 
-	for (auto t : phaseIDs) {
+	for (auto& t : phaseIDs) {
 		std::get<0>(t)->compileExpressions(symbolTables);
 		std::get<4>(t) = std::get<3>(t).toLowerLevelSymbolTable(expr);
 	}
@@ -155,14 +155,13 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EditorEnemyPh
 	return std::make_pair(status, messages);
 }
 
-void EditorEnemyPhase::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EditorEnemyPhase::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(attackPatternLoopDelay)
 
 	compiledAttackPatternIDs.clear();
-	for (auto t : attackPatternIDs) {
-		parser.compile(std::get<0>(t), expr);
-		compiledAttackPatternIDs.push_back(std::make_tuple(expr.value(), std::get<1>(t), std::get<2>(t).toLowerLevelSymbolTable(expr)));
+	for (const auto& t : attackPatternIDs) {
+		compiledAttackPatternIDs.push_back(std::make_tuple(expr.evaluate(std::get<0>(t)), std::get<1>(t), std::get<2>(t).toLowerLevelSymbolTable(expr)));
 	}
 	// Keep it sorted ascending by time
 	std::sort(compiledAttackPatternIDs.begin(), compiledAttackPatternIDs.end(), [](auto const& t1, auto const& t2) {
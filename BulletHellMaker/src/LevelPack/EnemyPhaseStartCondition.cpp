@@ -2,6 +2,7 @@
 
 #include <Game/Components/HealthComponent.h>
 #include <Game/Components/EnemyComponent.h>
+#include <Game/Components/LevelManagerTag.h>
 
 TimeBasedEnemyPhaseStartCondition::TimeBasedEnemyPhaseStartCondition() {
 }
@@ -54,7 +55,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> TimeBasedEnem
 	return std::make_pair(status, messages);
 }
 
-void TimeBasedEnemyPhaseStartCondition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void TimeBasedEnemyPhaseStartCondition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(time)
 }
@@ -63,6 +64,10 @@ bool TimeBasedEnemyPhaseStartCondition::satisfied(entt::DefaultRegistry & regist
 	return registry.get<EnemyComponent>(entity).getTimeSinceLastPhase() >= timeExprCompiledValue;
 }
 
+float TimeBasedEnemyPhaseStartCondition::getEarliestSatisfiedTime() {
+	return timeExprCompiledValue;
+}
+
 float TimeBasedEnemyPhaseStartCondition::getTime() {
 	return timeExprCompiledValue;
 }
@@ -121,7 +126,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> HPBasedEnemyP
 	return std::make_pair(status, messages);
 }
 
-void HPBasedEnemyPhaseStartCondition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void HPBasedEnemyPhaseStartCondition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(ratio)
 }
@@ -131,6 +136,10 @@ bool HPBasedEnemyPhaseStartCondition::satisfied(entt::DefaultRegistry & registry
 	return health.getHealth()/health.getMaxHealth() <= ratioExprCompiledValue;
 }
 
+float HPBasedEnemyPhaseStartCondition::getEarliestSatisfiedTime() {
+	return std::numeric_limits<float>::infinity();
+}
+
 float HPBasedEnemyPhaseStartCondition::getRatio() {
 	return ratioExprCompiledValue;
 }
@@ -190,13 +199,17 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EnemyCountBas
 	return std::make_pair(status, messages);
 }
 
-void EnemyCountBasedEnemyPhaseStartCondition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EnemyCountBasedEnemyPhaseStartCondition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(enemyCount)
 }
 
 bool EnemyCountBasedEnemyPhaseStartCondition::satisfied(entt::DefaultRegistry & registry, uint32_t entity) {
-	return registry.view<EnemyComponent>().size() - 1 <= enemyCountExprCompiledValue;
+	return registry.get<LevelManagerTag>().getEnemiesAliveCount() - 1 <= enemyCountExprCompiledValue;
+}
+
+float EnemyCountBasedEnemyPhaseStartCondition::getEarliestSatisfiedTime() {
+	return std::numeric_limits<float>::infinity();
 }
 
 int EnemyCountBasedEnemyPhaseStartCondition::getEnemyCount() {
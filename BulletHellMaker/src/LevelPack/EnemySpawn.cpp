@@ -114,17 +114,16 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EnemySpawnInf
 	return std::make_pair(status, messages);
 }
 
-void EnemySpawnInfo::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EnemySpawnInfo::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(x)
 	COMPILE_EXPRESSION_FOR_FLOAT(y)
 	compiledEnemySymbolsDefiner = enemySymbolsDefiner.toLowerLevelSymbolTable(expr);
 
 	itemsDroppedOnDeathExprCompiledValue.clear();
-	for (auto p : itemsDroppedOnDeath) {
+	for (const auto& p : itemsDroppedOnDeath) {
 		p.first->compileExpressions(symbolTables);
-		parser.compile(p.second, expr);
-		itemsDroppedOnDeathExprCompiledValue.push_back(std::make_pair(p.first, expr.value()));
+		itemsDroppedOnDeathExprCompiledValue.push_back(std::make_pair(p.first, expr.evaluate(p.second)));
 	}
 }
 
@@ -0,0 +1,271 @@
+#include <LevelPack/ExpressionCompiler.h>
+
+#include <chrono>
+#include <cctype>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+std::mutex ExpressionCompiler::cacheMutex;
+std::unordered_map<std::string, float> ExpressionCompiler::cache;
+
+std::atomic<unsigned long long> ExpressionCompiler::compiles(0);
+std::atomic<unsigned long long> ExpressionCompiler::fastPathHits(0);
+std::atomic<unsigned long long> ExpressionCompiler::cacheHits(0);
+std::atomic<long long> ExpressionCompiler::compileNanoseconds(0);
+
+namespace {
+	/*
+	Recursive descent evaluator for expressions made only of numeric literals, + - * / and parentheses.
+	Every operation is done in float, same as exprtk::expression<float>.
+	*/
+	class ConstantExpressionParser {
+	public:
+		ConstantExpressionParser(const std::string& str) : str(str) {}
+
+		bool parse(float& result) {
+			float value;
+			if (!parseSum(value)) {
+				return false;
+			}
+			skipWhitespace();
+			if (pos != str.size()) {
+				return false;
+			}
+			result = value;
+			return true;
+		}
+
+	private:
+		const std::string& str;
+		size_t pos = 0;
+
+		void skipWhitespace() {
+			while (pos < str.size() && std::isspace((unsigned char)str[pos])) {
+				pos++;
+			}
+		}
+
+		bool parseSum(float& result) {
+			if (!parseProduct(result)) {
+				return false;
+			}
+			while (true) {
+				skipWhitespace();
+				if (pos >= str.size() || (str[pos] != '+' && str[pos] != '-')) {
+					return true;
+				}
+				char op = str[pos++];
+				float rhs;
+				if (!parseProduct(rhs)) {
+					return false;
+				}
+				result = (op == '+') ? (result + rhs) : (result - rhs);
+			}
+		}
+
+		bool parseProduct(float& result) {
+			if (!parseUnary(result)) {
+				return false;
+			}
+			while (true) {
+				skipWhitespace();
+				if (pos >= str.size() || (str[pos] != '*' && str[pos] != '/')) {
+					return true;
+				}
+				char op = str[pos++];
+				float rhs;
+				if (!parseUnary(rhs)) {
+					return false;
+				}
+				result = (op == '*') ? (result * rhs) : (result / rhs);
+			}
+		}
+
+		bool parseUnary(float& result) {
+			skipWhitespace();
+			if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) {
+				char op = str[pos++];
+				if (!parseUnary(result)) {
+					return false;
+				}
+				if (op == '-') {
+					result = -result;
+				}
+				return true;
+			}
+			return parsePrimary(result);
+		}
+
+		bool parsePrimary(float& result) {
+			skipWhitespace();
+			if (pos >= str.size()) {
+				return false;
+			}
+			if (str[pos] == '(') {
+				pos++;
+				if (!parseSum(result)) {
+					return false;
+				}
+				skipWhitespace();
+				if (pos >= str.size() || str[pos] != ')') {
+					return false;
+				}
+				pos++;
+				return checkNoImplicitMultiplication();
+			}
+			return parseNumber(result);
+		}
+
+		bool parseNumber(float& result) {
+			size_t start = pos;
+			while (pos < str.size() && (std::isdigit((unsigned char)str[pos]) || str[pos] == '.')) {
+				pos++;
+			}
+			if (pos == start) {
+				return false;
+			}
+			if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+				size_t exponentStart = pos++;
+				if (pos < str.size() && (str[pos] == '+' || str[pos] == '-')) {
+					pos++;
+				}
+				size_t exponentDigitsStart = pos;
+				while (pos < str.size() && std::isdigit((unsigned char)str[pos])) {
+					pos++;
+				}
+				if (pos == exponentDigitsStart) {
+					// Something like "2e" or "2ex", which is a symbol or implicit multiplication to exprtk
+					return false;
+				}
+			}
+			// Use exprtk's own number parsing so that the result is bit-for-bit the same as if exprtk had compiled it
+			if (!exprtk::details::string_to_real(str.substr(start, pos - start), result)) {
+				return false;
+			}
+			return checkNoImplicitMultiplication();
+		}
+
+		/*
+		exprtk allows things like "2x" and "2(3)" to mean multiplication; leave those to exprtk.
+		*/
+		bool checkNoImplicitMultiplication() {
+			if (pos >= str.size()) {
+				return true;
+			}
+			char c = str[pos];
+			return !(std::isalnum((unsigned char)c) || c == '_' || c == '(' || c == '.');
+		}
+	};
+}
+
+ExpressionCompiler::Stats ExpressionCompiler::Stats::operator-(const Stats& other) const {
+	Stats res;
+	res.compiles = compiles - other.compiles;
+	res.fastPathHits = fastPathHits - other.fastPathHits;
+	res.cacheHits = cacheHits - other.cacheHits;
+	res.compileSeconds = compileSeconds - other.compileSeconds;
+	return res;
+}
+
+ExpressionCompiler::ExpressionCompiler(const std::vector<exprtk::symbol_table<float>>& symbolTables) : symbolTables(symbolTables) {
+}
+
+float ExpressionCompiler::evaluate(const std::string& expressionStr) {
+	float value;
+	if (tryEvaluateConstant(expressionStr, value)) {
+		fastPathHits++;
+		return value;
+	}
+
+	std::string key = getSignature() + expressionStr;
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		auto it = cache.find(key);
+		if (it != cache.end()) {
+			cacheHits++;
+			return it->second;
+		}
+	}
+
+	bool success;
+	value = compile(expressionStr, success);
+	// Don't cache expressions that failed to compile; they are illegal and should have been caught by the legal check anyway
+	if (success) {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		if (cache.size() >= MAX_CACHED_EXPRESSIONS) {
+			cache.clear();
+		}
+		cache[key] = value;
+	}
+	return value;
+}
+
+ExpressionCompiler::Stats ExpressionCompiler::getStats() {
+	Stats stats;
+	stats.compiles = compiles;
+	stats.fastPathHits = fastPathHits;
+	stats.cacheHits = cacheHits;
+	stats.compileSeconds = compileNanoseconds / 1e9;
+	return stats;
+}
+
+void ExpressionCompiler::clearCache() {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.clear();
+}
+
+exprtk::parser<float>& ExpressionCompiler::getParser() {
+	// exprtk::parser is expensive to construct but can compile any number of expressions,
+	// so keep one around per thread
+	thread_local exprtk::parser<float> parser;
+	return parser;
+}
+
+bool ExpressionCompiler::tryEvaluateConstant(const std::string& expressionStr, float& result) {
+	return ConstantExpressionParser(expressionStr).parse(result);
+}
+
+const std::string& ExpressionCompiler::getSignature() {
+	if (!signatureComputed) {
+		// Same order as the symbol_tables are registered in, since that decides which definition of a symbol is used
+		for (int i = symbolTables.size() - 1; i >= 0; i--) {
+			std::vector<std::pair<std::string, float>> variables;
+			symbolTables[i].get_variable_list(variables);
+			for (const auto& variable : variables) {
+				// Use the exact bits of the value so that values that print the same aren't confused
+				uint32_t bits;
+				std::memcpy(&bits, &variable.second, sizeof(bits));
+				char bitsStr[9];
+				std::snprintf(bitsStr, sizeof(bitsStr), "%08x", bits);
+
+				signature += variable.first;
+				signature += '=';
+				signature += bitsStr;
+				signature += ';';
+			}
+			signature += '|';
+		}
+		// Symbol names can't contain newlines, so this separates the signature from the expression string
+		signature += '\n';
+		signatureComputed = true;
+	}
+	return signature;
+}
+
+float ExpressionCompiler::compile(const std::string& expressionStr, bool& success) {
+	if (!expressionInitialized) {
+		for (int i = symbolTables.size() - 1; i >= 0; i--) {
+			expression.register_symbol_table(symbolTables[i]);
+		}
+		expressionInitialized = true;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	success = getParser().compile(expressionStr, expression);
+	float value = expression.value();
+	compileNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	compiles++;
+
+	return value;
+}
@@ -112,7 +112,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> HealthPackIte
 	return std::make_pair(status, messages);
 }
 
-void HealthPackItem::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void HealthPackItem::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(healthRestoreAmount)
 }
@@ -184,7 +184,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> PowerPackItem
 	return std::make_pair(status, messages);
 }
 
-void PowerPackItem::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void PowerPackItem::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(powerAmount)
 	COMPILE_EXPRESSION_FOR_INT(pointsPerExtraPower)
@@ -253,7 +253,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> PointsPackIte
 	return std::make_pair(status, messages);
 }
 
-void PointsPackItem::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void PointsPackItem::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(pointsAmount)
 }
@@ -325,7 +325,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> BombItem::leg
 	return std::make_pair(status, messages);
 }
 
-void BombItem::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void BombItem::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(bombsAmount)
 	COMPILE_EXPRESSION_FOR_INT(pointsPerExtraBomb)
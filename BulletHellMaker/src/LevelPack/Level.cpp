@@ -19,7 +19,7 @@ std::string Level::format() const {
 		+ formatString(backgroundFileName) + tos(backgroundScrollSpeedX) + tos(backgroundScrollSpeedY) + tos(backgroundTextureWidth)
 		+ tos(backgroundTextureHeight) + tos(bossNameColor.r) + tos(bossNameColor.g) + tos(bossNameColor.b) + tos(bossNameColor.a)
 		+ tos(bossHPBarColor.r) + tos(bossHPBarColor.g) + tos(bossHPBarColor.b) + tos(bossHPBarColor.a);
-	res += formatTMObject(symbolTable);
+	res += formatTMObject(symbolTable) + formatTMObject(offScreenPolicy) + formatBool(bakeTrajectories);
 	return res;
 }
 
@@ -66,6 +66,18 @@ void Level::load(std::string formattedString) {
 	bossNameColor = sf::Color(std::stof(items.at(i++)), std::stof(items.at(i++)), std::stof(items.at(i++)), std::stof(items.at(i++)));
 	bossHPBarColor = sf::Color(std::stof(items.at(i++)), std::stof(items.at(i++)), std::stof(items.at(i++)), std::stof(items.at(i++)));
 	symbolTable.load(items.at(i++));
+	// Levels saved before off-screen policies existed keep every off-screen bullet
+	if (i < items.size()) {
+		offScreenPolicy.load(items.at(i++));
+	} else {
+		offScreenPolicy = OffScreenPolicy();
+	}
+	// Levels saved before trajectory baking existed don't bake
+	if (i < items.size()) {
+		bakeTrajectories = unformatBool(items.at(i++));
+	} else {
+		bakeTrajectories = false;
+	}
 }
 
 nlohmann::json Level::toJson() {
@@ -86,6 +98,8 @@ nlohmann::json Level::toJson() {
 			{"b", bossNameColor.b}, {"a", bossNameColor.a} }},
 		{"bossHPBarColor", nlohmann::json{ {"r", bossHPBarColor.r}, {"g", bossHPBarColor.g},
 			{"b", bossHPBarColor.b}, {"a", bossHPBarColor.a} }},
+		{"offScreenPolicy", offScreenPolicy.toJson()},
+		{"bakeTrajectories", bakeTrajectories}
 	};
 
 	nlohmann::json eventsJson;
@@ -125,6 +139,16 @@ void Level::load(const nlohmann::json& j) {
 	j.at("bossHPBarColor").at("g").get_to(bossHPBarColor.g);
 	j.at("bossHPBarColor").at("b").get_to(bossHPBarColor.b);
 	j.at("bossHPBarColor").at("a").get_to(bossHPBarColor.a);
+	if (j.contains("offScreenPolicy")) {
+		offScreenPolicy.load(j.at("offScreenPolicy"));
+	} else {
+		offScreenPolicy = OffScreenPolicy();
+	}
+	if (j.contains("bakeTrajectories")) {
+		j.at("bakeTrajectories").get_to(bakeTrajectories);
+	} else {
+		bakeTrajectories = false;
+	}
 
 	events.clear();
 	enemyIDCount.clear();
@@ -179,10 +203,8 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> Level::legal(
 	return std::make_pair(status, messages);
 }
 
-void Level::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
-	if (!symbolTable.isEmpty()) {
-		symbolTables.push_back(symbolTable.toExprtkSymbolTable());
-	}
+void Level::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
+	DEFINE_SYMBOL_TABLES_FOR_COMPILE
 	for (auto p : events) {
 		p.second->compileExpressions(symbolTables);
 	}
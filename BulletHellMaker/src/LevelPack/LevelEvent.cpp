@@ -84,10 +84,8 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> SpawnEnemiesL
 	}
 }
 
-void SpawnEnemiesLevelEvent::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
-	if (!symbolTable.isEmpty()) {
-		symbolTables.push_back(symbolTable.toExprtkSymbolTable());
-	}
+void SpawnEnemiesLevelEvent::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
+	DEFINE_SYMBOL_TABLES_FOR_COMPILE
 
 	for (std::shared_ptr<EnemySpawnInfo> info : spawnInfo) {
 		info->compileExpressions(symbolTables);
@@ -185,7 +183,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> ShowDialogueL
 	return std::make_pair(LEGAL_STATUS::ILLEGAL, std::vector<std::string>());
 }
 
-void ShowDialogueLevelEvent::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void ShowDialogueLevelEvent::compileExpressions(const std::vector<exprtk::symbol_table<float>>& symbolTables) {
 	// Nothing needs to be done
 }
 
@@ -53,7 +53,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> GlobalTimeBas
 	return std::make_pair(status, messages);
 }
 
-void GlobalTimeBasedEnemySpawnCondition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void GlobalTimeBasedEnemySpawnCondition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(time)
 }
@@ -62,6 +62,10 @@ bool GlobalTimeBasedEnemySpawnCondition::satisfied(entt::DefaultRegistry & regis
 	return registry.get<LevelManagerTag>().getTimeSinceStartOfLevel() >= timeExprCompiledValue;
 }
 
+float GlobalTimeBasedEnemySpawnCondition::getEarliestSatisfiedTime(entt::DefaultRegistry& registry) {
+	return timeExprCompiledValue;
+}
+
 EnemyCountBasedEnemySpawnCondition::EnemyCountBasedEnemySpawnCondition() {
 }
 
@@ -113,13 +117,17 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EnemyCountBas
 	return std::make_pair(status, messages);
 }
 
-void EnemyCountBasedEnemySpawnCondition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EnemyCountBasedEnemySpawnCondition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_INT(enemyCount)
 }
 
 bool EnemyCountBasedEnemySpawnCondition::satisfied(entt::DefaultRegistry & registry) {
-	return registry.view<EnemyComponent>().size() - 1 <= enemyCountExprCompiledValue;
+	return registry.get<LevelManagerTag>().getEnemiesAliveCount() - 1 <= enemyCountExprCompiledValue;
+}
+
+float EnemyCountBasedEnemySpawnCondition::getEarliestSatisfiedTime(entt::DefaultRegistry& registry) {
+	return std::numeric_limits<float>::infinity();
 }
 
 TimeBasedEnemySpawnCondition::TimeBasedEnemySpawnCondition() {
@@ -173,7 +181,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> TimeBasedEnem
 	return std::make_pair(status, messages);
 }
 
-void TimeBasedEnemySpawnCondition::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void TimeBasedEnemySpawnCondition::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(time)
 }
@@ -182,6 +190,11 @@ bool TimeBasedEnemySpawnCondition::satisfied(entt::DefaultRegistry & registry) {
 	return registry.get<LevelManagerTag>().getTimeSinceLastEnemySpawn() >= timeExprCompiledValue;
 }
 
+float TimeBasedEnemySpawnCondition::getEarliestSatisfiedTime(entt::DefaultRegistry& registry) {
+	auto& levelManager = registry.get<LevelManagerTag>();
+	return levelManager.getTimeSinceStartOfLevel() - levelManager.getTimeSinceLastEnemySpawn() + timeExprCompiledValue;
+}
+
 std::shared_ptr<LevelEventStartCondition> LevelEventStartConditionFactory::create(std::string formattedString) {
 	auto name = split(formattedString, TextMarshallable::DELIMITER)[0];
 	std::shared_ptr<LevelEventStartCondition> ptr;
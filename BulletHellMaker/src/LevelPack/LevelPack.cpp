@@ -1,9 +1,16 @@
 #include <LevelPack/LevelPack.h>
 
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <functional>
+#include <chrono>
+#include <filesystem>
 
 #include <Config.h>
 #include <Util/Logger.h>
+#include <Util/IOUtils.h>
 #include <Util/TextFileParser.h>
 #include <LevelPack/Attack.h>
 #include <LevelPack/AttackPattern.h>
@@ -29,6 +36,9 @@
 #include <Constants.h>
 #include <LevelPack/EditorMovablePointAction.h>
 #include <Game/EntityCreationQueue.h>
+#include <LevelPack/ExpressionCompiler.h>
+#include <Util/Profiler.h>
+#include <Util/ParallelUtils.h>
 
 const std::string LevelPack::LEVELS_ORDER_FILE_NAME = "levels_order" + LEVEL_PACK_SERIALIZED_DATA_FORMAT;
 const std::string LevelPack::PLAYER_FILE_NAME = "player" + LEVEL_PACK_SERIALIZED_DATA_FORMAT;
@@ -40,15 +50,15 @@ const std::string LevelPack::BULLET_MODEL_FILE_PREFIX = "bullet_model";
 const std::string LevelPack::ENEMY_FILE_PREFIX = "enemy";
 const std::string LevelPack::ENEMY_PHASE_FILE_PREFIX = "enemy_phase";
 
-LevelPack::LevelPack(AudioPlayer& audioPlayer, std::string name, std::shared_ptr<SpriteLoader> spriteLoader) 
+LevelPack::LevelPack(AudioPlayer& audioPlayer, std::string name, std::shared_ptr<SpriteLoader> spriteLoader, bool preferCookedFile) 
 	: audioPlayer(audioPlayer), name(name) {
 
 	onChange = std::make_shared<entt::SigH<void(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE, int)>>();
 	if (spriteLoader) {
 		this->spriteLoader = spriteLoader;
 	} else {
+		// Sprite sheets start loading below, since the cooked file might have them
 		this->spriteLoader = std::make_shared<SpriteLoader>(name);
-		this->spriteLoader->loadFromSpriteSheetsFolder();
 	}
 
 	/*
@@ -301,15 +311,166 @@ LevelPack::LevelPack(AudioPlayer& audioPlayer, std::string name, std::shared_ptr
 
 	setFontFileName("font.ttf");
 	
+	if (preferCookedFile && loadCooked(!spriteLoader)) {
+		return;
+	}
+	if (!spriteLoader) {
+		// The images are decoded while the caller sets up, and the caller uploads them with SpriteLoader::uploadDecodedSpriteSheets()
+		spriteSheetsLoad = this->spriteLoader->loadFromSpriteSheetsFolderAsync();
+	}
 	//TODO: uncomment
 	load();
 	//save();
 }
 
+template<class T>
+void LevelPack::loadLevelPackObjectFiles(const std::string& folderPath, const std::string& levelPackObjectFilePrefix, const std::string& typeName,
+	std::map<int, std::shared_ptr<T>>& objects, IDGenerator& idGen, int& failed, int& total, std::function<void(std::shared_ptr<T>)> onLoad) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	objects.clear();
+	std::set<int> existingFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(folderPath.c_str(), name.c_str()),
+		levelPackObjectFilePrefix, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
+	std::vector<int> ids(existingFilesIDs.begin(), existingFilesIDs.end());
+
+	// Each thread only writes to the slots of the files it parsed
+	struct ParsedFile {
+		std::string fileName;
+		std::shared_ptr<T> object;
+		// Only set if object is nullptr
+		std::string error;
+	};
+	std::vector<ParsedFile> parsedFiles(ids.size());
+	parallelFor(ids.size(), [&](std::size_t i) {
+		ParsedFile& parsed = parsedFiles[i];
+		parsed.fileName = format(folderPath + "\\%s%d%s", name.c_str(), levelPackObjectFilePrefix.c_str(), ids[i], LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
+		std::ifstream file(parsed.fileName);
+		try {
+			std::shared_ptr<T> object = std::make_shared<T>();
+
+			nlohmann::json j;
+			file >> j;
+			object->load(j);
+
+			parsed.object = object;
+		} catch (const std::exception& e) {
+			parsed.error = std::string("Exception: ") + e.what();
+		} catch (...) {
+			parsed.error = "Unknown exception.";
+		}
+		file.close();
+	});
+	auto parsedTime = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < ids.size(); i++) {
+		ParsedFile& parsed = parsedFiles[i];
+		if (parsed.object) {
+			try {
+				if (parsed.object->getID() != ids[i]) {
+					L_(lwarning) << "ID of the object in " << parsed.fileName << " does not match the file name";
+				}
+
+				idGen.markIDAsUsed(parsed.object->getID());
+
+				if (onLoad) {
+					onLoad(parsed.object);
+				}
+				objects[parsed.object->getID()] = parsed.object;
+				L_(linfo) << "Successfully loaded " << parsed.fileName;
+			} catch (const std::exception& e) {
+				parsed.error = std::string("Exception: ") + e.what();
+			} catch (...) {
+				parsed.error = "Unknown exception.";
+			}
+		}
+		if (!parsed.error.empty()) {
+			L_(lerror) << "Failed to load " << parsed.fileName << ". " << parsed.error;
+			failed++;
+		}
+		total++;
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	double parseSeconds = std::chrono::duration<double>(parsedTime - start).count();
+	double totalSeconds = std::chrono::duration<double>(end - start).count();
+	L_(ldebug) << "Loaded " << ids.size() << " " << typeName << " in " << totalSeconds << "s (" << parseSeconds << "s reading and parsing)";
+	Profiler::addTime("Level pack load: " + typeName, totalSeconds);
+}
+
+template<class T>
+std::shared_ptr<T> LevelPack::findObject(std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type, int id) const {
+	auto it = objects.find(id);
+	if (it != objects.end()) {
+		return it->second;
+	}
+	if (!cookedLevelPack || fullyDecodedCookedTypes.count(type) > 0 || !cookedLevelPack->contains(type, id)) {
+		return nullptr;
+	}
+
+	std::shared_ptr<T> object = std::make_shared<T>();
+	try {
+		object->load(cookedLevelPack->read(type, id));
+	} catch (const std::exception& e) {
+		L_(lerror) << "Failed to decode object " << id << " of type " << (int)type << " from the cooked level pack. Exception: " << e.what();
+		throw;
+	}
+	objects[id] = object;
+	onCookedObjectDecoded(object);
+	Profiler::addToCounter("Cooked objects decoded");
+	return object;
+}
+
+template<class T>
+std::shared_ptr<T> LevelPack::getObject(std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type, int id) const {
+	std::shared_ptr<T> object = findObject(objects, type, id);
+	if (!object) {
+		throw std::out_of_range("Level pack does not contain object " + std::to_string(id) + " of type " + std::to_string((int)type));
+	}
+	return object;
+}
+
+template<class T>
+bool LevelPack::containsObject(const std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type, int id) const {
+	if (objects.find(id) != objects.end()) {
+		return true;
+	}
+	return cookedLevelPack && fullyDecodedCookedTypes.count(type) == 0 && cookedLevelPack->contains(type, id);
+}
+
+template<class T>
+void LevelPack::decodeAllCookedObjects(std::map<int, std::shared_ptr<T>>& objects, CookedLevelPack::OBJECT_TYPE type) const {
+	if (!cookedLevelPack || fullyDecodedCookedTypes.count(type) > 0) {
+		return;
+	}
+	for (int id : cookedLevelPack->getIDs(type)) {
+		findObject(objects, type, id);
+	}
+	fullyDecodedCookedTypes.insert(type);
+}
+
+void LevelPack::decodeAllCookedObjects() const {
+	// Bullet models first so that attacks don't decode them one by one
+	decodeAllCookedObjects(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL);
+	decodeAllCookedObjects(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK);
+	decodeAllCookedObjects(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN);
+	decodeAllCookedObjects(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE);
+	decodeAllCookedObjects(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY);
+	decodeAllCookedObjects(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL);
+}
+
+void LevelPack::onCookedObjectDecoded(std::shared_ptr<EditorAttack> attack) const {
+	// Same as in load()
+	attack->loadEMPBulletModels(*this);
+}
+
 LevelPack::LoadMetrics LevelPack::load() {
 	attemptedLoad = true;
+	cookedLevelPack = nullptr;
+	fullyDecodedCookedTypes.clear();
 
 	LoadMetrics loadMetrics;
+	ExpressionCompiler::Stats expressionStatsBeforeLoad = ExpressionCompiler::getStats();
 
 	L_(linfo) << "Loading level pack from \"" << format(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME, name.c_str()) << "\"...";
 
@@ -333,38 +494,8 @@ LevelPack::LoadMetrics LevelPack::load() {
 	playerFile.close();
 
 	// Read levels
-	levelsMap.clear();
-	std::set<int> existingLevelFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME.c_str(), name.c_str()),
-		LEVEL_FILE_PREFIX, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-	for (int id : existingLevelFilesIDs) {
-		std::string fileName = format(RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME + "\\%s%d%s", name.c_str(),
-			LEVEL_FILE_PREFIX.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
-		std::ifstream file(fileName);
-		try {
-			std::shared_ptr<Level> level = std::make_shared<Level>();
-
-			nlohmann::json j;
-			file >> j;
-			level->load(j);
-
-			if (level->getID() != id) {
-				L_(lwarning) << "ID of the object in " << fileName << " does not match the file name";
-			}
-
-			levelIDGen.markIDAsUsed(level->getID());
-
-			levelsMap[level->getID()] = level;
-			L_(linfo) << "Successfully loaded " << fileName;
-		} catch (const std::exception& e) {
-			L_(lerror) << "Failed to load " << fileName << ". Exception: " << e.what();
-			loadMetrics.levelsFailed++;
-		} catch (...) {
-			L_(lerror) << "Failed to load " << fileName << ". Unknown exception.";
-			loadMetrics.levelsFailed++;
-		}
-		loadMetrics.levelsTotal++;
-		file.close();
-	}
+	loadLevelPackObjectFiles(RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME, LEVEL_FILE_PREFIX, "levels", levelsMap, levelIDGen,
+		loadMetrics.levelsFailed, loadMetrics.levelsTotal);
 
 	// Read levels ordering
 	levels.clear();
@@ -381,179 +512,32 @@ LevelPack::LoadMetrics LevelPack::load() {
 	} else {
 		L_(lerror) << "Unable to load " << levelsOrderingFilePath;
 	}
+	bool levelsOrderingFileMissing = !levelsOrderingFile;
 	levelsOrderingFile.close();
 
 	// Read bullet models
-	bulletModels.clear();
-	std::set<int> existingBulletModelFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(RELATIVE_LEVEL_PACK_BULLET_MODELS_FOLDER_NAME.c_str(), name.c_str()),
-		BULLET_MODEL_FILE_PREFIX, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-	for (int id : existingBulletModelFilesIDs) {
-		std::string fileName = format(RELATIVE_LEVEL_PACK_BULLET_MODELS_FOLDER_NAME + "\\%s%d%s", name.c_str(),
-			BULLET_MODEL_FILE_PREFIX.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
-		std::ifstream file(fileName);
-		try {
-			std::shared_ptr<BulletModel> bulletModel = std::make_shared<BulletModel>();
-
-			nlohmann::json j;
-			file >> j;
-			bulletModel->load(j);
-
-			if (bulletModel->getID() != id) {
-				L_(lwarning) << "ID of the object in " << fileName << " does not match the file name";
-			}
-
-			bulletModelIDGen.markIDAsUsed(bulletModel->getID());
-
-			bulletModels[bulletModel->getID()] = bulletModel;
-			L_(linfo) << "Successfully loaded " << fileName;
-		} catch (const std::exception& e) {
-			L_(lerror) << "Failed to load " << fileName << ". Exception: " << e.what();
-			loadMetrics.bulletModelsFailed++;
-		} catch (...) {
-			L_(lerror) << "Failed to load " << fileName << ". Unknown exception.";
-			loadMetrics.bulletModelsFailed++;
-		}
-		loadMetrics.bulletModelsTotal++;
-		file.close();
-	}
+	loadLevelPackObjectFiles(RELATIVE_LEVEL_PACK_BULLET_MODELS_FOLDER_NAME, BULLET_MODEL_FILE_PREFIX, "bullet models", bulletModels, bulletModelIDGen,
+		loadMetrics.bulletModelsFailed, loadMetrics.bulletModelsTotal);
 
 	// Read attacks
-	attacks.clear();
-	std::set<int> existingAttackFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME.c_str(), name.c_str()),
-		ATTACK_FILE_PREFIX, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-	for (int id : existingAttackFilesIDs) {
-		std::string fileName = format(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME + "\\%s%d%s", name.c_str(),
-			ATTACK_FILE_PREFIX.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
-		std::ifstream file(fileName);
-		try {
-			std::shared_ptr<EditorAttack> attack = std::make_shared<EditorAttack>();
-
-			nlohmann::json j;
-			file >> j;
-			attack->load(j);
-
-			if (attack->getID() != id) {
-				L_(lwarning) << "ID of the object in " << fileName << " does not match the file name";
-			}
-
-			attackIDGen.markIDAsUsed(attack->getID());
-
-			// Load bullet models for every EMP
-			attack->loadEMPBulletModels(*this);
-			attacks[attack->getID()] = attack;
-			L_(linfo) << "Successfully loaded " << fileName;
-		} catch (const std::exception& e) {
-			L_(lerror) << "Failed to load " << fileName << ". Exception: " << e.what();
-			loadMetrics.attacksFailed++;
-		} catch (...) {
-			L_(lerror) << "Failed to load " << fileName << ". Unknown exception.";
-			loadMetrics.attacksFailed++;
-		}
-		loadMetrics.attacksTotal++;
-		file.close();
-	}
+	// Bullet models must be loaded first. Loading them into EMPs registers the EMPs with the models, so it isn't done in parallel.
+	loadLevelPackObjectFiles<EditorAttack>(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME, ATTACK_FILE_PREFIX, "attacks", attacks, attackIDGen,
+		loadMetrics.attacksFailed, loadMetrics.attacksTotal, [this](std::shared_ptr<EditorAttack> attack) {
+		// Load bullet models for every EMP
+		attack->loadEMPBulletModels(*this);
+	});
 
 	// Read attack patterns
-	attackPatterns.clear();
-	std::set<int> existingAttackPatternFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME.c_str(), name.c_str()),
-		ATTACK_PATTERN_FILE_PREFIX, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-	for (int id : existingAttackPatternFilesIDs) {
-		std::string fileName = format(RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME + "\\%s%d%s", name.c_str(),
-			ATTACK_PATTERN_FILE_PREFIX.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
-		std::ifstream file(fileName);
-		try {
-			std::shared_ptr<EditorAttackPattern> attackPattern = std::make_shared<EditorAttackPattern>();
-
-			nlohmann::json j;
-			file >> j;
-			attackPattern->load(j);
-
-			if (attackPattern->getID() != id) {
-				L_(lwarning) << "ID of the object in " << fileName << " does not match the file name";
-			}
-
-			attackPatternIDGen.markIDAsUsed(attackPattern->getID());
-
-			attackPatterns[attackPattern->getID()] = attackPattern;
-			L_(linfo) << "Successfully loaded " << fileName;
-		} catch (const std::exception& e) {
-			L_(lerror) << "Failed to load " << fileName << ". Exception: " << e.what();
-			loadMetrics.attackPatternsFailed++;
-		} catch (...) {
-			L_(lerror) << "Failed to load " << fileName << ". Unknown exception.";
-			loadMetrics.attackPatternsFailed++;
-		}
-		loadMetrics.attackPatternsTotal++;
-		file.close();
-	}
+	loadLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME, ATTACK_PATTERN_FILE_PREFIX, "attack patterns", attackPatterns, attackPatternIDGen,
+		loadMetrics.attackPatternsFailed, loadMetrics.attackPatternsTotal);
 
 	// Read enemies
-	enemies.clear();
-	std::set<int> existingEnemyFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME.c_str(), name.c_str()),
-		ENEMY_FILE_PREFIX, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-	for (int id : existingEnemyFilesIDs) {
-		std::string fileName = format(RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME + "\\%s%d%s", name.c_str(),
-			ENEMY_FILE_PREFIX.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
-		std::ifstream file(fileName);
-		try {
-			std::shared_ptr<EditorEnemy> enemy = std::make_shared<EditorEnemy>();
-
-			nlohmann::json j;
-			file >> j;
-			enemy->load(j);
-
-			if (enemy->getID() != id) {
-				L_(lwarning) << "ID of the object in " << fileName << " does not match the file name";
-			}
-
-			enemyIDGen.markIDAsUsed(enemy->getID());
-
-			enemies[enemy->getID()] = enemy;
-			L_(linfo) << "Successfully loaded " << fileName;
-		} catch (const std::exception& e) {
-			L_(lerror) << "Failed to load " << fileName << ". Exception: " << e.what();
-			loadMetrics.enemiesFailed++;
-		} catch (...) {
-			L_(lerror) << "Failed to load " << fileName << ". Unknown exception.";
-			loadMetrics.enemiesFailed++;
-		}
-		loadMetrics.enemiesTotal++;
-		file.close();
-	}
+	loadLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME, ENEMY_FILE_PREFIX, "enemies", enemies, enemyIDGen,
+		loadMetrics.enemiesFailed, loadMetrics.enemiesTotal);
 
 	// Read enemy phases
-	enemyPhases.clear();
-	std::set<int> existingEnemyPhaseFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME.c_str(), name.c_str()),
-		ENEMY_PHASE_FILE_PREFIX, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-	for (int id : existingEnemyPhaseFilesIDs) {
-		std::string fileName = format(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME + "\\%s%d%s", name.c_str(),
-			ENEMY_PHASE_FILE_PREFIX.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
-		std::ifstream file(fileName);
-		try {
-			std::shared_ptr<EditorEnemyPhase> enemyPhase = std::make_shared<EditorEnemyPhase>();
-
-			nlohmann::json j;
-			file >> j;
-			enemyPhase->load(j);
-
-			if (enemyPhase->getID() != id) {
-				L_(lwarning) << "ID of the object in " << fileName << " does not match the file name";
-			}
-
-			enemyPhaseIDGen.markIDAsUsed(enemyPhase->getID());
-
-			enemyPhases[enemyPhase->getID()] = enemyPhase;
-			L_(linfo) << "Successfully loaded " << fileName;
-		} catch (const std::exception& e) {
-			L_(lerror) << "Failed to load " << fileName << ". Exception: " << e.what();
-			loadMetrics.enemyPhasesFailed++;
-		} catch (...) {
-			L_(lerror) << "Failed to load " << fileName << ". Unknown exception.";
-			loadMetrics.enemyPhasesFailed++;
-		}
-		loadMetrics.enemyPhasesTotal++;
-		file.close();
-	}
+	loadLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME, ENEMY_PHASE_FILE_PREFIX, "enemy phases", enemyPhases, enemyPhaseIDGen,
+		loadMetrics.enemyPhasesFailed, loadMetrics.enemyPhasesTotal);
 
 	successfulLoad = loadMetrics.playerSuccess && (loadMetrics.attacksFailed == 0)
 		&& (loadMetrics.attackPatternsFailed == 0) && (loadMetrics.bulletModelsFailed == 0)
@@ -566,10 +550,29 @@ LevelPack::LoadMetrics LevelPack::load() {
 		L_(lerror) << "Failed to load level pack from \"" << format(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME, name.c_str()) << "\"";
 	}
 
+	ExpressionCompiler::Stats expressionStats = ExpressionCompiler::getStats() - expressionStatsBeforeLoad;
+	L_(ldebug) << "Expressions during level pack load: " << expressionStats.compiles << " compiled in " << expressionStats.compileSeconds
+		<< "s, " << expressionStats.fastPathHits << " constant-folded, " << expressionStats.cacheHits << " cached";
+
+	// Everything loaded now matches the files, so only files that couldn't be loaded need to be written by the next save
+	clearDirtyState();
+	if (!loadMetrics.playerSuccess) {
+		dirtyObjects.insert(std::make_pair(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::PLAYER, player->getID()));
+	}
+	levelsOrderDirty = levelsOrderingFileMissing;
+
 	return loadMetrics;
 }
 
-void LevelPack::save() {
+LevelPack::SaveMetrics LevelPack::save() {
+	auto start = std::chrono::steady_clock::now();
+	SaveMetrics saveMetrics;
+
+	// Objects that were never decoded from the cooked file would otherwise have their files deleted
+	if (everythingDirty) {
+		decodeAllCookedObjects();
+	}
+
 	// Create folders if they don't exist already
 	if (!std::filesystem::exists(RELATIVE_LOGS_FOLDER_PATH)) {
 		std::filesystem::create_directory(RELATIVE_LOGS_FOLDER_PATH);
@@ -587,51 +590,236 @@ void LevelPack::save() {
 	}
 
 	// Save sprite sheets' metadata
-	spriteLoader->saveMetadataFiles();
+	std::set<std::string> spriteSheetsToSave = everythingDirty ? spriteLoader->getLoadedSpriteSheetNamesAsSet() : dirtySpriteSheets;
+	for (const std::string& spriteSheetName : spriteSheetsToSave) {
+		std::shared_ptr<SpriteSheet> spriteSheet = spriteLoader->getSpriteSheet(spriteSheetName);
+		// Same as SpriteLoader::saveMetadataFiles(), only sprite sheets that were loaded successfully are saved
+		if (spriteSheet && !spriteSheet->isFailedMetafileLoad()) {
+			saveJsonFile(spriteLoader->formatPathToSpriteSheetMetafile(spriteSheetName), spriteSheet->toJson(), saveMetrics);
+		}
+	}
 
 	// Save player
-	std::ofstream playerFile(format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\%s", name.c_str(), PLAYER_FILE_NAME.c_str()));
-	playerFile << std::setw(4) << player->toJson() << std::endl;
-	playerFile.close();
+	if (everythingDirty || dirtyObjects.count(std::make_pair(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::PLAYER, player->getID())) > 0) {
+		saveJsonFile(format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\%s", name.c_str(), PLAYER_FILE_NAME.c_str()), player->toJson(), saveMetrics);
+	}
 
 	// Save levels, attacks, attack patterns, bullet models, enemies, and enemy phases
-	for (std::tuple<std::string, std::string, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>> dataTypeAttributes
-		: { std::make_tuple(RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME, LEVEL_FILE_PREFIX, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>{levelsMap.begin(), levelsMap.end()}),
-		std::make_tuple(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME, ATTACK_FILE_PREFIX, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>{attacks.begin(), attacks.end()}),
-		std::make_tuple(RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME, ATTACK_PATTERN_FILE_PREFIX, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>{attackPatterns.begin(), attackPatterns.end()}),
-		std::make_tuple(RELATIVE_LEVEL_PACK_BULLET_MODELS_FOLDER_NAME, BULLET_MODEL_FILE_PREFIX, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>{bulletModels.begin(), bulletModels.end()}),
-		std::make_tuple(RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME, ENEMY_FILE_PREFIX, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>{enemies.begin(), enemies.end()}),
-		std::make_tuple(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME, ENEMY_PHASE_FILE_PREFIX, std::map<int, std::shared_ptr<LayerRootLevelPackObject>>{enemyPhases.begin(), enemyPhases.end()}) }) {
-
-		std::set<int> existingFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(std::get<0>(dataTypeAttributes), name.c_str()),
-			std::get<1>(dataTypeAttributes), LEVEL_PACK_SERIALIZED_DATA_FORMAT);
-		std::set<int> newFilesIDs;
-		for (std::pair<int, std::shared_ptr<LayerRootLevelPackObject>> p : std::get<2>(dataTypeAttributes)) {
-			// Skip if ID < 0, because that signifies that it's a temporary object
-			if (p.first < 0) continue;
+	saveLevelPackObjectFiles(RELATIVE_LEVEL_PACK_LEVELS_FOLDER_NAME, LEVEL_FILE_PREFIX, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::LEVEL, levelsMap, saveMetrics);
+	saveLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME, ATTACK_FILE_PREFIX, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attacks, saveMetrics);
+	saveLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ATTACK_PATTERNS_FOLDER_NAME, ATTACK_PATTERN_FILE_PREFIX, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN,
+		attackPatterns, saveMetrics);
+	saveLevelPackObjectFiles(RELATIVE_LEVEL_PACK_BULLET_MODELS_FOLDER_NAME, BULLET_MODEL_FILE_PREFIX, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL,
+		bulletModels, saveMetrics);
+	saveLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ENEMIES_FOLDER_NAME, ENEMY_FILE_PREFIX, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemies, saveMetrics);
+	saveLevelPackObjectFiles(RELATIVE_LEVEL_PACK_ENEMY_PHASES_FOLDER_NAME, ENEMY_PHASE_FILE_PREFIX, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE,
+		enemyPhases, saveMetrics);
+
+	// Save levels ordering
+	if (everythingDirty || levelsOrderDirty) {
+		saveJsonFile(format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\%s", name.c_str(), LEVELS_ORDER_FILE_NAME.c_str()), nlohmann::json{ {"idOrder", levels} }, saveMetrics);
+	}
+
+	// The cooked file no longer matches the level pack, so stop the game from loading it
+	std::string cookedFilePath = format(RELATIVE_LEVEL_PACK_COOKED_FILE_PATH, name.c_str());
+	if ((saveMetrics.filesWritten > 0 || saveMetrics.filesDeleted > 0) && std::filesystem::exists(cookedFilePath)) {
+		std::error_code error;
+		if (!std::filesystem::remove(cookedFilePath, error)) {
+			L_(lwarning) << "Failed to delete out of date cooked level pack \"" << cookedFilePath << "\": " << error.message();
+		}
+	}
+
+	// Objects whose files failed to be written stay dirty so that the next save tries again
+	if (saveMetrics.filesFailed == 0) {
+		clearDirtyState();
+	}
 
-			newFilesIDs.insert(p.first);
+	saveMetrics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	L_(linfo) << "Saved level pack \"" << name << "\" in " << saveMetrics.seconds << "s: " << saveMetrics.filesWritten << " files written, "
+		<< saveMetrics.filesDeleted << " deleted, " << saveMetrics.filesFailed << " failed";
+	Profiler::addTime("Level pack save", saveMetrics.seconds);
+	Profiler::addToCounter("Level pack files written", saveMetrics.filesWritten);
+	return saveMetrics;
+}
+
+template<class T>
+void LevelPack::saveLevelPackObjectFiles(const std::string& folderPath, const std::string& levelPackObjectFilePrefix, LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE type,
+	const std::map<int, std::shared_ptr<T>>& objects, SaveMetrics& saveMetrics) {
 
-			std::ofstream file(format(std::get<0>(dataTypeAttributes) + "\\%s%d%s", name.c_str(), std::get<1>(dataTypeAttributes).c_str(), 
-				p.first, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str()));
-			file << std::setw(4) << p.second->toJson() << std::endl;
-			file.close();
+	std::set<int> savedIDs;
+	std::set<int> fileIDsToBeDeleted;
+	if (everythingDirty) {
+		for (auto p : objects) {
+			savedIDs.insert(p.first);
 		}
-		// Delete all files that weren't just saved
-		std::set<int> fileIDsToBeDeleted;
-		std::set_difference(existingFilesIDs.begin(), existingFilesIDs.end(),
-			newFilesIDs.begin(), newFilesIDs.end(),
+		// Delete all files that won't be saved
+		std::set<int> existingFilesIDs = getAllExistingLevelPackObjectFilesIDs(format(folderPath, name.c_str()),
+			levelPackObjectFilePrefix, LEVEL_PACK_SERIALIZED_DATA_FORMAT);
+		std::set_difference(existingFilesIDs.begin(), existingFilesIDs.end(), savedIDs.begin(), savedIDs.end(),
 			std::inserter(fileIDsToBeDeleted, fileIDsToBeDeleted.begin()));
-		deleteLevelPackObjectFiles(format(std::get<0>(dataTypeAttributes), name.c_str()),
-			std::get<1>(dataTypeAttributes), LEVEL_PACK_SERIALIZED_DATA_FORMAT, fileIDsToBeDeleted);
+	} else {
+		for (auto it = dirtyObjects.lower_bound(std::make_pair(type, std::numeric_limits<int>::min())); it != dirtyObjects.end() && it->first == type; it++) {
+			if (objects.find(it->second) != objects.end()) {
+				savedIDs.insert(it->second);
+			}
+		}
+		for (auto it = deletedObjects.lower_bound(std::make_pair(type, std::numeric_limits<int>::min())); it != deletedObjects.end() && it->first == type; it++) {
+			fileIDsToBeDeleted.insert(it->second);
+		}
 	}
 
-	// Save levels ordering
-	std::ofstream levelsOrderingFile(format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s\\%s", name.c_str(), LEVELS_ORDER_FILE_NAME.c_str()));
-	for (int id : levels) {
-		levelsOrderingFile << std::setw(4) << nlohmann::json{ {"idOrder", levels} };
+	for (int id : savedIDs) {
+		// Skip if ID < 0, because that signifies that it's a temporary object
+		if (id >= 0) {
+			saveJsonFile(format(folderPath + "\\%s%d%s", name.c_str(), levelPackObjectFilePrefix.c_str(), id, LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str()),
+				objects.at(id)->toJson(), saveMetrics);
+		}
 	}
-	levelsOrderingFile.close();
+	// Temporary objects never had files
+	fileIDsToBeDeleted.erase(fileIDsToBeDeleted.begin(), fileIDsToBeDeleted.lower_bound(0));
+	saveMetrics.filesDeleted += deleteLevelPackObjectFiles(format(folderPath, name.c_str()), levelPackObjectFilePrefix, LEVEL_PACK_SERIALIZED_DATA_FORMAT,
+		fileIDsToBeDeleted);
+}
+
+void LevelPack::saveJsonFile(const std::string& filePath, const nlohmann::json& j, SaveMetrics& saveMetrics) {
+	std::stringstream contents;
+	contents << std::setw(4) << j << std::endl;
+	if (writeFileAtomically(filePath, contents.str())) {
+		saveMetrics.filesWritten++;
+	} else {
+		L_(lerror) << "Failed to save " << filePath;
+		saveMetrics.filesFailed++;
+	}
+}
+
+void LevelPack::onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE type, int id, bool emitOnChange) {
+	dirtyObjects.insert(std::make_pair(type, id));
+	deletedObjects.erase(std::make_pair(type, id));
+	if (emitOnChange) {
+		onChange->publish(type, id);
+	}
+}
+
+void LevelPack::onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE type, int id) {
+	dirtyObjects.erase(std::make_pair(type, id));
+	deletedObjects.insert(std::make_pair(type, id));
+	onChange->publish(type, id);
+}
+
+void LevelPack::clearDirtyState() {
+	everythingDirty = false;
+	dirtyObjects.clear();
+	deletedObjects.clear();
+	dirtySpriteSheets.clear();
+	levelsOrderDirty = false;
+}
+
+bool LevelPack::cook() {
+	decodeAllCookedObjects();
+
+	auto start = std::chrono::steady_clock::now();
+	std::string cookedFilePath = format(RELATIVE_LEVEL_PACK_COOKED_FILE_PATH, name.c_str());
+
+	std::vector<CookedLevelPack::Object> objects;
+	nlohmann::json packInfo = { {"levelsOrder", levels}, {"largestBulletHitbox", searchLargestBulletHitbox()} };
+	objects.push_back({ CookedLevelPack::OBJECT_TYPE::PACK_INFO, 0, packInfo });
+	objects.push_back({ CookedLevelPack::OBJECT_TYPE::PLAYER, 0, player->toJson() });
+
+	nlohmann::json spriteSheetsMetadata = nlohmann::json::object();
+	for (std::pair<std::string, std::shared_ptr<SpriteSheet>> spriteSheet : spriteLoader->getSpriteSheets()) {
+		// Same as SpriteLoader::saveMetadataFiles(), only sprite sheets that were loaded successfully are kept
+		if (!spriteSheet.second->isFailedMetafileLoad()) {
+			spriteSheetsMetadata[spriteSheet.first] = spriteSheet.second->toJson();
+		}
+	}
+	objects.push_back({ CookedLevelPack::OBJECT_TYPE::SPRITE_SHEETS, 0, spriteSheetsMetadata });
+
+	auto addObjects = [&objects](CookedLevelPack::OBJECT_TYPE type, auto& objectsMap) {
+		for (auto p : objectsMap) {
+			// Skip if ID < 0, because that signifies that it's a temporary object
+			if (p.first >= 0) {
+				objects.push_back({ type, p.first, p.second->toJson() });
+			}
+		}
+	};
+	addObjects(CookedLevelPack::OBJECT_TYPE::LEVEL, levelsMap);
+	addObjects(CookedLevelPack::OBJECT_TYPE::ATTACK, attacks);
+	addObjects(CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN, attackPatterns);
+	addObjects(CookedLevelPack::OBJECT_TYPE::ENEMY, enemies);
+	addObjects(CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, enemyPhases);
+	addObjects(CookedLevelPack::OBJECT_TYPE::BULLET_MODEL, bulletModels);
+
+	if (!CookedLevelPack::write(cookedFilePath, objects)) {
+		return false;
+	}
+	L_(linfo) << "Cooked " << objects.size() << " objects into \"" << cookedFilePath << "\" in "
+		<< std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s";
+	return true;
+}
+
+bool LevelPack::loadCooked(bool loadSpriteSheets) {
+	auto start = std::chrono::steady_clock::now();
+	std::string cookedFilePath = format(RELATIVE_LEVEL_PACK_COOKED_FILE_PATH, name.c_str());
+	if (!std::filesystem::exists(cookedFilePath)) {
+		return false;
+	}
+
+	std::shared_ptr<CookedLevelPack> cooked = std::make_shared<CookedLevelPack>();
+	if (!cooked->open(cookedFilePath)) {
+		return false;
+	}
+
+	// Only the objects needed by the level pack as a whole are decoded now; everything else is decoded when it is first fetched
+	std::shared_ptr<EditorPlayer> cookedPlayer = std::make_shared<EditorPlayer>();
+	std::vector<int> cookedLevels;
+	float largestBulletHitbox = 0;
+	nlohmann::json spriteSheetsMetadata;
+	try {
+		nlohmann::json packInfo = cooked->read(CookedLevelPack::OBJECT_TYPE::PACK_INFO, 0);
+		cookedLevels = packInfo.at("levelsOrder").get<std::vector<int>>();
+		largestBulletHitbox = packInfo.at("largestBulletHitbox").get<float>();
+		cookedPlayer->load(cooked->read(CookedLevelPack::OBJECT_TYPE::PLAYER, 0));
+		if (loadSpriteSheets) {
+			spriteSheetsMetadata = cooked->read(CookedLevelPack::OBJECT_TYPE::SPRITE_SHEETS, 0);
+		}
+	} catch (const std::exception& e) {
+		L_(lerror) << "Failed to load cooked level pack \"" << cookedFilePath << "\". Exception: " << e.what();
+		return false;
+	}
+
+	attemptedLoad = true;
+	player = cookedPlayer;
+	levels = cookedLevels;
+	cookedLargestBulletHitbox = largestBulletHitbox;
+	levelsMap.clear();
+	attacks.clear();
+	attackPatterns.clear();
+	enemies.clear();
+	enemyPhases.clear();
+	bulletModels.clear();
+	for (std::pair<CookedLevelPack::OBJECT_TYPE, IDGenerator*> typeAndIDGen : { std::make_pair(CookedLevelPack::OBJECT_TYPE::LEVEL, &levelIDGen),
+		std::make_pair(CookedLevelPack::OBJECT_TYPE::ATTACK, &attackIDGen), std::make_pair(CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN, &attackPatternIDGen),
+		std::make_pair(CookedLevelPack::OBJECT_TYPE::ENEMY, &enemyIDGen), std::make_pair(CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, &enemyPhaseIDGen),
+		std::make_pair(CookedLevelPack::OBJECT_TYPE::BULLET_MODEL, &bulletModelIDGen) }) {
+
+		for (int id : cooked->getIDs(typeAndIDGen.first)) {
+			typeAndIDGen.second->markIDAsUsed(id);
+		}
+	}
+	cookedLevelPack = cooked;
+	fullyDecodedCookedTypes.clear();
+
+	if (loadSpriteSheets) {
+		spriteSheetsLoad = spriteLoader->loadFromMetadataAsync(spriteSheetsMetadata);
+	}
+	successfulLoad = true;
+	// The JSON files may have been edited since the level pack was cooked, so the next save rewrites all of them
+	everythingDirty = true;
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	L_(linfo) << "Successfully loaded cooked level pack \"" << cookedFilePath << "\" with " << cooked->getObjectCount() << " objects in " << seconds << "s";
+	Profiler::addTime("Level pack load: cooked", seconds);
+	return true;
 }
 
 std::shared_ptr<SpriteLoader> LevelPack::getSpriteLoader() {
@@ -640,6 +828,7 @@ std::shared_ptr<SpriteLoader> LevelPack::getSpriteLoader() {
 
 void LevelPack::insertLevel(int index, int levelID) {
 	levels.insert(levels.begin() + index, levelID);
+	levelsOrderDirty = true;
 	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::LEVEL, levelID);
 }
 
@@ -650,7 +839,7 @@ std::shared_ptr<Level> LevelPack::createLevel() {
 std::shared_ptr<Level> LevelPack::createLevel(int id) {
 	auto level = std::make_shared<Level>(id);
 	levelsMap[level->getID()] = level;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::LEVEL, level->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::LEVEL, level->getID());
 	return level;
 }
 
@@ -662,7 +851,7 @@ std::shared_ptr<EditorAttack> LevelPack::createAttack(int id) {
 	attackIDGen.markIDAsUsed(id);
 	auto attack = std::make_shared<EditorAttack>(id);
 	attacks[attack->getID()] = attack;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attack->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attack->getID());
 	return attack;
 }
 
@@ -675,7 +864,7 @@ std::shared_ptr<EditorAttackPattern> LevelPack::createAttackPattern(int id) {
 	attackPatternIDGen.markIDAsUsed(id);
 	auto attackPattern = std::make_shared<EditorAttackPattern>(id);
 	attackPatterns[attackPattern->getID()] = attackPattern;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, attackPattern->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, attackPattern->getID());
 	return attackPattern;
 }
 
@@ -687,7 +876,7 @@ std::shared_ptr<EditorEnemy> LevelPack::createEnemy() {
 std::shared_ptr<EditorEnemy> LevelPack::createEnemy(int id) {
 	auto enemy = std::make_shared<EditorEnemy>(id);
 	enemies[enemy->getID()] = enemy;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemy->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemy->getID());
 	return enemy;
 }
 
@@ -698,19 +887,20 @@ std::shared_ptr<EditorEnemyPhase> LevelPack::createEnemyPhase() {
 std::shared_ptr<EditorEnemyPhase> LevelPack::createEnemyPhase(int id) {
 	auto enemyPhase = std::make_shared<EditorEnemyPhase>(id);
 	enemyPhases[enemyPhase->getID()] = enemyPhase;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, enemyPhase->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, enemyPhase->getID());
 	return enemyPhase;
 }
 
 std::shared_ptr<BulletModel> LevelPack::createBulletModel() {
 	auto bulletModel = std::make_shared<BulletModel>(bulletModelIDGen.generateID());
 	bulletModels[bulletModel->getID()] = bulletModel;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, bulletModel->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, bulletModel->getID());
 	return bulletModel;
 }
 
 void LevelPack::updateSpriteSheet(std::shared_ptr<SpriteSheet> spriteSheet, bool emitOnChange) {
 	spriteLoader->updateSpriteSheet(spriteSheet);
+	dirtySpriteSheets.insert(spriteSheet->getName());
 	if (emitOnChange) {
 		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::SPRITE_SHEET, -1);
 	}
@@ -719,89 +909,71 @@ void LevelPack::updateSpriteSheet(std::shared_ptr<SpriteSheet> spriteSheet, bool
 void LevelPack::updateAttack(std::shared_ptr<EditorAttack> attack, bool emitOnChange) {
 	attackIDGen.markIDAsUsed(attack->getID());
 	attacks[attack->getID()] = attack;
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attack->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attack->getID(), emitOnChange);
 }
 
 void LevelPack::updateAttack(std::shared_ptr<LayerRootLevelPackObject> attack, bool emitOnChange) {
 	attackIDGen.markIDAsUsed(attack->getID());
 	attacks[attack->getID()] = std::dynamic_pointer_cast<EditorAttack>(attack);
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attack->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, attack->getID(), emitOnChange);
 }
 
 void LevelPack::updateAttackPattern(std::shared_ptr<EditorAttackPattern> attackPattern, bool emitOnChange) {
 	attackPatternIDGen.markIDAsUsed(attackPattern->getID());
 	attackPatterns[attackPattern->getID()] = attackPattern;
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, attackPattern->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, attackPattern->getID(), emitOnChange);
 }
 
 void LevelPack::updateAttackPattern(std::shared_ptr<LayerRootLevelPackObject> attackPattern, bool emitOnChange) {
 	attackPatternIDGen.markIDAsUsed(attackPattern->getID());
 	attackPatterns[attackPattern->getID()] = std::dynamic_pointer_cast<EditorAttackPattern>(attackPattern);
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, attackPattern->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, attackPattern->getID(), emitOnChange);
 }
 
 void LevelPack::updateEnemy(std::shared_ptr<EditorEnemy> enemy, bool emitOnChange) {
 	enemyIDGen.markIDAsUsed(enemy->getID());
 	enemies[enemy->getID()] = enemy;
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemy->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemy->getID(), emitOnChange);
 }
 
 void LevelPack::updateEnemy(std::shared_ptr<LayerRootLevelPackObject> enemy, bool emitOnChange) {
 	enemyIDGen.markIDAsUsed(enemy->getID());
 	enemies[enemy->getID()] = std::dynamic_pointer_cast<EditorEnemy>(enemy);
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemy->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, enemy->getID(), emitOnChange);
 }
 
 void LevelPack::updateEnemyPhase(std::shared_ptr<EditorEnemyPhase> enemyPhase, bool emitOnChange) {
 	enemyPhaseIDGen.markIDAsUsed(enemyPhase->getID());
 	enemyPhases[enemyPhase->getID()] = enemyPhase;
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, enemyPhase->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, enemyPhase->getID(), emitOnChange);
 }
 
 void LevelPack::updateEnemyPhase(std::shared_ptr<LayerRootLevelPackObject> enemyPhase, bool emitOnChange) {
 	enemyPhaseIDGen.markIDAsUsed(enemyPhase->getID());
 	enemyPhases[enemyPhase->getID()] = std::dynamic_pointer_cast<EditorEnemyPhase>(enemyPhase);
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, enemyPhase->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, enemyPhase->getID(), emitOnChange);
 }
 
 void LevelPack::updateBulletModel(std::shared_ptr<BulletModel> bulletModel, bool emitOnChange) {
 	bulletModelIDGen.markIDAsUsed(bulletModel->getID());
 	bulletModels[bulletModel->getID()] = bulletModel;
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, bulletModel->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, bulletModel->getID(), emitOnChange);
 }
 
 void LevelPack::updateBulletModel(std::shared_ptr<LayerRootLevelPackObject> bulletModel, bool emitOnChange) {
 	bulletModelIDGen.markIDAsUsed(bulletModel->getID());
 	bulletModels[bulletModel->getID()] = std::dynamic_pointer_cast<BulletModel>(bulletModel);
-	if (emitOnChange) {
-		onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, bulletModel->getID());
-	}
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, bulletModel->getID(), emitOnChange);
 }
 
 void LevelPack::removeLevelFromPlayableLevelsList(int levelIndex) {
 	levels.erase(levels.begin() + levelIndex);
+	levelsOrderDirty = true;
 	// Don't emit onChange here because the actual Level isn't modified from this operation
 }
 
 void LevelPack::deleteLevel(int id) {
+	decodeAllCookedObjects(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL);
 	levelIDGen.deleteID(id);
 	levelsMap.erase(id);
 
@@ -813,40 +985,46 @@ void LevelPack::deleteLevel(int id) {
 		}
 	}
 
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::LEVEL, id);
+	onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::LEVEL, id);
 }
 
 void LevelPack::deleteAttack(int id) {
+	decodeAllCookedObjects(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK);
 	attackIDGen.deleteID(id);
 	attacks.erase(id);
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, id);
+	onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK, id);
 }
 
 void LevelPack::deleteAttackPattern(int id) {
+	decodeAllCookedObjects(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN);
 	attackPatternIDGen.deleteID(id);
 	attackPatterns.erase(id);
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, id);
+	onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ATTACK_PATTERN, id);
 }
 
 void LevelPack::deleteEnemy(int id) {
+	decodeAllCookedObjects(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY);
 	enemyIDGen.deleteID (id);
 	enemies.erase(id);
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, id);
+	onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY, id);
 }
 
 void LevelPack::deleteEnemyPhase(int id) {
+	decodeAllCookedObjects(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE);
 	enemyPhaseIDGen.deleteID(id);
 	enemyPhases.erase(id);
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, id);
+	onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::ENEMY_PHASE, id);
 }
 
 void LevelPack::deleteBulletModel(int id) {
+	decodeAllCookedObjects(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL);
 	bulletModelIDGen.deleteID(id);
 	bulletModels.erase(id);
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, id);
+	onObjectDeleted(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::BULLET_MODEL, id);
 }
 
 std::vector<int> LevelPack::getEnemyUsers(int enemyID) {
+	decodeAllCookedObjects(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL);
 	std::vector<int> results;
 	for (auto it = levelsMap.begin(); it != levelsMap.end(); it++) {
 		if (it->second->usesEnemy(enemyID)) {
@@ -857,6 +1035,7 @@ std::vector<int> LevelPack::getEnemyUsers(int enemyID) {
 }
 
 std::vector<int> LevelPack::getEditorEnemyUsers(int editorEnemyPhaseID) {
+	decodeAllCookedObjects(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY);
 	std::vector<int> results;
 	for (auto it = enemies.begin(); it != enemies.end(); it++) {
 		if (it->second->usesEnemyPhase(editorEnemyPhaseID)) {
@@ -867,6 +1046,7 @@ std::vector<int> LevelPack::getEditorEnemyUsers(int editorEnemyPhaseID) {
 }
 
 std::vector<int> LevelPack::getAttackPatternEnemyUsers(int attackPatternID) {
+	decodeAllCookedObjects(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE);
 	std::vector<int> results;
 	for (auto it = enemyPhases.begin(); it != enemyPhases.end(); it++) {
 		if (it->second->usesAttackPattern(attackPatternID)) {
@@ -881,6 +1061,7 @@ bool LevelPack::getAttackPatternIsUsedByPlayer(int attackPatternID) {
 }
 
 std::vector<int> LevelPack::getAttackUsers(int attackID) {
+	decodeAllCookedObjects(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN);
 	std::vector<int> results;
 	for (auto it = attackPatterns.begin(); it != attackPatterns.end(); it++) {
 		if (it->second->usesAttack(attackID)) {
@@ -891,6 +1072,7 @@ std::vector<int> LevelPack::getAttackUsers(int attackID) {
 }
 
 std::vector<int> LevelPack::getBulletModelUsers(int bulletModelID) {
+	decodeAllCookedObjects(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK);
 	std::vector<int> results;
 	for (auto it = attacks.begin(); it != attacks.end(); it++) {
 		if (it->second->usesBulletModel(bulletModelID)) {
@@ -901,23 +1083,23 @@ std::vector<int> LevelPack::getBulletModelUsers(int bulletModelID) {
 }
 
 bool LevelPack::hasEnemy(int id) {
-	return enemies.find(id) != enemies.end();
+	return containsObject(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY, id);
 }
 
 bool LevelPack::hasEnemyPhase(int id) {
-	return enemyPhases.find(id) != enemyPhases.end();
+	return containsObject(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, id);
 }
 
 bool LevelPack::hasAttackPattern(int id) {
-	return attackPatterns.find(id) != attackPatterns.end();
+	return containsObject(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN, id);
 }
 
 bool LevelPack::hasAttack(int id) {
-	return attacks.find(id) != attacks.end();
+	return containsObject(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK, id);
 }
 
 bool LevelPack::hasBulletModel(int id) {
-	return bulletModels.find(id) != bulletModels.end();
+	return containsObject(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL, id);
 }
 
 bool LevelPack::hasLevel(int levelIndex) {
@@ -928,12 +1110,33 @@ std::string LevelPack::getName() {
 	return name;
 }
 
+/*
+Reports the time taken by a LevelPack gameplay fetch, and the expression compilation work done during it, to the Profiler.
+*/
+class GameplayFetchProfiler {
+public:
+	GameplayFetchProfiler() : timer("LevelPack gameplay fetch"), statsBefore(ExpressionCompiler::getStats()) {
+	}
+	~GameplayFetchProfiler() {
+		ExpressionCompiler::Stats stats = ExpressionCompiler::getStats() - statsBefore;
+		Profiler::addToCounter("Gameplay fetch expressions compiled", stats.compiles);
+		Profiler::addToCounter("Gameplay fetch expressions constant-folded", stats.fastPathHits);
+		Profiler::addToCounter("Gameplay fetch expressions cached", stats.cacheHits);
+		Profiler::addTime("Gameplay fetch expression compilation", stats.compileSeconds);
+	}
+
+private:
+	ProfilerTimer timer;
+	ExpressionCompiler::Stats statsBefore;
+};
+
 std::shared_ptr<Level> LevelPack::getLevel(int levelIndex) const {
-	return levelsMap.at(levels[levelIndex]);
+	return getObject(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL, levels[levelIndex]);
 }
 
 std::shared_ptr<Level> LevelPack::getGameplayLevel(int levelIndex) const {
-	auto level = levelsMap.at(levels[levelIndex])->clone();
+	GameplayFetchProfiler profiler;
+	auto level = getObject(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL, levels[levelIndex])->clone();
 	// Level is a top-level object so every expression it uses should be in terms of only its own
 	// unredelegated, well-defined symbols
 	auto derived = std::dynamic_pointer_cast<Level>(level);
@@ -942,51 +1145,55 @@ std::shared_ptr<Level> LevelPack::getGameplayLevel(int levelIndex) const {
 }
 
 std::shared_ptr<EditorAttack> LevelPack::getAttack(int id) const {
-	return attacks.at(id);
+	return getObject(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK, id);
 }
 
 std::shared_ptr<EditorAttack> LevelPack::getGameplayAttack(int id, exprtk::symbol_table<float> symbolsDefiner) const {
-	auto attack = attacks.at(id)->clone();
+	GameplayFetchProfiler profiler;
+	auto attack = getObject(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK, id)->clone();
 	auto derived = std::dynamic_pointer_cast<EditorAttack>(attack);
 	derived->compileExpressions({ symbolsDefiner });
 	return derived;
 }
 
 std::shared_ptr<EditorAttackPattern> LevelPack::getAttackPattern(int id) const {
-	return attackPatterns.at(id);
+	return getObject(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN, id);
 }
 
 std::shared_ptr<EditorAttackPattern> LevelPack::getGameplayAttackPattern(int id, exprtk::symbol_table<float> symbolsDefiner) const {
-	auto attackPattern = attackPatterns.at(id)->clone();
+	GameplayFetchProfiler profiler;
+	auto attackPattern = getObject(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN, id)->clone();
 	auto derived = std::dynamic_pointer_cast<EditorAttackPattern>(attackPattern);
 	derived->compileExpressions({ symbolsDefiner });
 	return derived;
 }
 
 std::shared_ptr<EditorEnemy> LevelPack::getEnemy(int id) const {
-	return enemies.at(id);
+	return getObject(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY, id);
 }
 
 std::shared_ptr<EditorEnemy> LevelPack::getGameplayEnemy(int id, exprtk::symbol_table<float> symbolsDefiner) const {
-	auto enemy = enemies.at(id)->clone();
+	GameplayFetchProfiler profiler;
+	auto enemy = getObject(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY, id)->clone();
 	auto derived = std::dynamic_pointer_cast<EditorEnemy>(enemy);
 	derived->compileExpressions({ symbolsDefiner });
 	return derived;
 }
 
 std::shared_ptr<EditorEnemyPhase> LevelPack::getEnemyPhase(int id) const {
-	return enemyPhases.at(id);
+	return getObject(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, id);
 }
 
 std::shared_ptr<EditorEnemyPhase> LevelPack::getGameplayEnemyPhase(int id, exprtk::symbol_table<float> symbolsDefiner) const {
-	auto phase = enemyPhases.at(id)->clone();
+	GameplayFetchProfiler profiler;
+	auto phase = getObject(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, id)->clone();
 	auto derived = std::dynamic_pointer_cast<EditorEnemyPhase>(phase);
 	derived->compileExpressions({ symbolsDefiner });
 	return derived;
 }
 
 std::shared_ptr<BulletModel> LevelPack::getBulletModel(int id) const {
-	return bulletModels.at(id);
+	return getObject(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL, id);
 }
 
 std::shared_ptr<EditorPlayer> LevelPack::getPlayer() const {
@@ -994,6 +1201,7 @@ std::shared_ptr<EditorPlayer> LevelPack::getPlayer() const {
 }
 
 std::shared_ptr<EditorPlayer> LevelPack::getGameplayPlayer() const {
+	GameplayFetchProfiler profiler;
 	auto clonedPlayer = player->clone();
 	// EditorPlayer is a top-level object so every expression it uses should be in terms of only its own
 	// unredelegated, well-defined symbols
@@ -1007,42 +1215,52 @@ std::string LevelPack::getFontFileName() {
 }
 
 std::map<int, std::shared_ptr<EditorAttack>>::iterator LevelPack::getAttackIteratorBegin() {
+	decodeAllCookedObjects(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK);
 	return attacks.begin();
 }
 
 std::map<int, std::shared_ptr<EditorAttack>>::iterator LevelPack::getAttackIteratorEnd() {
+	decodeAllCookedObjects(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK);
 	return attacks.end();
 }
 
 std::map<int, std::shared_ptr<EditorAttackPattern>>::iterator LevelPack::getAttackPatternIteratorBegin() {
+	decodeAllCookedObjects(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN);
 	return attackPatterns.begin();
 }
 
 std::map<int, std::shared_ptr<EditorAttackPattern>>::iterator LevelPack::getAttackPatternIteratorEnd() {
+	decodeAllCookedObjects(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN);
 	return attackPatterns.end();
 }
 
 std::map<int, std::shared_ptr<EditorEnemy>>::iterator LevelPack::getEnemyIteratorBegin() {
+	decodeAllCookedObjects(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY);
 	return enemies.begin();
 }
 
 std::map<int, std::shared_ptr<EditorEnemy>>::iterator LevelPack::getEnemyIteratorEnd() {
+	decodeAllCookedObjects(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY);
 	return enemies.end();
 }
 
 std::map<int, std::shared_ptr<EditorEnemyPhase>>::iterator LevelPack::getEnemyPhaseIteratorBegin() {
+	decodeAllCookedObjects(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE);
 	return enemyPhases.begin();
 }
 
 std::map<int, std::shared_ptr<EditorEnemyPhase>>::iterator LevelPack::getEnemyPhaseIteratorEnd() {
+	decodeAllCookedObjects(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE);
 	return enemyPhases.end();
 }
 
 std::map<int, std::shared_ptr<BulletModel>>::iterator LevelPack::getBulletModelIteratorBegin() {
+	decodeAllCookedObjects(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL);
 	return bulletModels.begin();
 }
 
 std::map<int, std::shared_ptr<BulletModel>>::iterator LevelPack::getBulletModelIteratorEnd() {
+	decodeAllCookedObjects(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL);
 	return bulletModels.end();
 }
 
@@ -1102,15 +1320,19 @@ std::shared_ptr<entt::SigH<void(LevelPack::LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROO
 }
 
 bool LevelPack::hasBulletModel(int id) const {
-	return bulletModels.find(id) != bulletModels.end();
+	return containsObject(bulletModels, CookedLevelPack::OBJECT_TYPE::BULLET_MODEL, id);
 }
 
 void LevelPack::setPlayer(std::shared_ptr<EditorPlayer> player) {
 	this->player = player;
-	onChange->publish(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::PLAYER, player->getID());
+	onObjectChanged(LEVEL_PACK_OBJECT_HIERARCHY_LAYER_ROOT_TYPE::PLAYER, player->getID());
 }
 
 float LevelPack::searchLargestBulletHitbox() const {
+	if (cookedLevelPack && fullyDecodedCookedTypes.count(CookedLevelPack::OBJECT_TYPE::ATTACK) == 0) {
+		return cookedLargestBulletHitbox;
+	}
+
 	float max = 0;
 	for (auto p : attacks) {
 		max = std::max(max, p.second->searchLargestHitbox());
@@ -1121,11 +1343,11 @@ float LevelPack::searchLargestBulletHitbox() const {
 float LevelPack::searchLargestItemActivationHitbox() const {
 	float max = 0;
 	for (int levelID : levels) {
-		if (levelsMap.find(levelID) == levelsMap.end()) {
+		std::shared_ptr<Level> level = findObject(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL, levelID);
+		if (!level) {
 			continue;
 		}
 
-		std::shared_ptr<Level> level = levelsMap.at(levelID);
 		max = std::max(max, level->getHealthPack()->getActivationRadius());
 		max = std::max(max, level->getPointsPack()->getActivationRadius());
 		max = std::max(max, level->getPowerPack()->getActivationRadius());
@@ -1137,11 +1359,11 @@ float LevelPack::searchLargestItemActivationHitbox() const {
 float LevelPack::searchLargestItemCollectionHitbox() const {
 	float max = 0;
 	for (int levelID : levels) {
-		if (levelsMap.find(levelID) == levelsMap.end()) {
+		std::shared_ptr<Level> level = findObject(levelsMap, CookedLevelPack::OBJECT_TYPE::LEVEL, levelID);
+		if (!level) {
 			continue;
 		}
-		
-		std::shared_ptr<Level> level = levelsMap.at(levelID);
+
 		max = std::max(max, level->getHealthPack()->getHitboxRadius());
 		max = std::max(max, level->getPointsPack()->getHitboxRadius());
 		max = std::max(max, level->getPowerPack()->getHitboxRadius());
@@ -1150,11 +1372,189 @@ float LevelPack::searchLargestItemCollectionHitbox() const {
 	return max;
 }
 
-void LevelPack::playSound(const SoundSettings & soundSettings) const {
+std::vector<MusicSettings> LevelPack::searchLevelFirstPhaseMusic(int levelIndex) const {
+	std::vector<MusicSettings> music;
+	for (auto enemyIDAndCount : getLevel(levelIndex)->getEnemyIDCount()) {
+		if (enemyIDAndCount.second <= 0) {
+			continue;
+		}
+		std::shared_ptr<EditorEnemy> enemy = findObject(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY, enemyIDAndCount.first);
+		if (!enemy || enemy->getPhasesCount() == 0) {
+			continue;
+		}
+		std::shared_ptr<EditorEnemyPhase> phase = findObject(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, std::get<1>(enemy->getPhaseData(0)));
+		if (phase && phase->getPlayMusic()) {
+			music.push_back(phase->getMusicSettings());
+		}
+	}
+	return music;
+}
+
+std::set<std::string> LevelPack::searchLevelSoundFileNames(int levelIndex) const {
+	std::set<std::string> fileNames;
+	auto addSound = [&fileNames](const SoundSettings& soundSettings) {
+		if (!soundSettings.isDisabled() && soundSettings.getFileName() != "") {
+			fileNames.insert(soundSettings.getFileName());
+		}
+	};
+
+	std::shared_ptr<Level> level = getLevel(levelIndex);
+	addSound(level->getHealthPack()->getOnCollectSound());
+	addSound(level->getPointsPack()->getOnCollectSound());
+	addSound(level->getPowerPack()->getOnCollectSound());
+	addSound(level->getBombItem()->getOnCollectSound());
+
+	visitLevelObjects(levelIndex, [&addSound](std::shared_ptr<EditorEnemy> enemy) {
+		addSound(enemy->getHurtSound());
+		addSound(enemy->getDeathSound());
+		for (std::shared_ptr<DeathAction> deathAction : enemy->getDeathActions()) {
+			if (auto playSound = std::dynamic_pointer_cast<PlaySoundDeathAction>(deathAction)) {
+				addSound(playSound->getSoundSettings());
+			}
+		}
+	}, [&addSound](std::shared_ptr<EditorMovablePoint> emp) {
+		addSound(emp->getSoundSettings());
+	});
+
+	if (player) {
+		addSound(player->getHurtSound());
+		addSound(player->getDeathSound());
+		addSound(player->getBombReadySound());
+	}
+
+	return fileNames;
+}
+
+std::vector<Animatable> LevelPack::searchLevelAnimatables(int levelIndex) const {
+	std::vector<Animatable> animatables;
+	auto addAnimatableSet = [&animatables](const EntityAnimatableSet& animatableSet) {
+		animatables.push_back(animatableSet.getIdleAnimatable());
+		animatables.push_back(animatableSet.getMovementAnimatable());
+		animatables.push_back(animatableSet.getAttackAnimatable());
+	};
+
+	std::shared_ptr<Level> level = getLevel(levelIndex);
+	animatables.push_back(level->getHealthPack()->getAnimatable());
+	animatables.push_back(level->getPointsPack()->getAnimatable());
+	animatables.push_back(level->getPowerPack()->getAnimatable());
+	animatables.push_back(level->getBombItem()->getAnimatable());
+
+	visitLevelObjects(levelIndex, [&animatables, &addAnimatableSet](std::shared_ptr<EditorEnemy> enemy) {
+		for (const EntityAnimatableSet& animatableSet : enemy->getAnimatableSets()) {
+			addAnimatableSet(animatableSet);
+		}
+		for (std::shared_ptr<DeathAction> deathAction : enemy->getDeathActions()) {
+			if (auto playAnimatable = std::dynamic_pointer_cast<PlayAnimatableDeathAction>(deathAction)) {
+				animatables.push_back(playAnimatable->getAnimatable());
+			} else if (auto particleExplosion = std::dynamic_pointer_cast<ParticleExplosionDeathAction>(deathAction)) {
+				animatables.push_back(particleExplosion->getAnimatable());
+			}
+		}
+	}, [&animatables](std::shared_ptr<EditorMovablePoint> emp) {
+		animatables.push_back(emp->getAnimatable());
+		animatables.push_back(emp->getBaseSprite());
+	});
+
+	if (player) {
+		for (std::shared_ptr<PlayerPowerTier> powerTier : player->getPowerTiers()) {
+			addAnimatableSet(powerTier->getAnimatableSet());
+		}
+	}
+
+	return animatables;
+}
+
+std::vector<std::shared_ptr<EditorMovablePoint>> LevelPack::searchLevelEMPs(int levelIndex) const {
+	std::vector<std::shared_ptr<EditorMovablePoint>> emps;
+	visitLevelObjects(levelIndex, [](std::shared_ptr<EditorEnemy> enemy) {}, [&emps](std::shared_ptr<EditorMovablePoint> emp) {
+		emps.push_back(emp);
+	});
+	return emps;
+}
+
+void LevelPack::visitLevelObjects(int levelIndex, std::function<void(std::shared_ptr<EditorEnemy>)> onEnemy,
+	std::function<void(std::shared_ptr<EditorMovablePoint>)> onEMP) const {
+
+	// Walk from the level and player down to every EMP that can be spawned, visiting each object once
+	std::set<int> visitedAttacks;
+	std::set<int> visitedAttackPatterns;
+	std::function<void(std::shared_ptr<EditorMovablePoint>)> visitEMP = [&](std::shared_ptr<EditorMovablePoint> emp) {
+		onEMP(emp);
+		for (std::shared_ptr<EditorMovablePoint> child : emp->getChildren()) {
+			visitEMP(child);
+		}
+	};
+	auto visitAttack = [&](int attackID) {
+		if (!visitedAttacks.insert(attackID).second) {
+			return;
+		}
+		std::shared_ptr<EditorAttack> attack = findObject(attacks, CookedLevelPack::OBJECT_TYPE::ATTACK, attackID);
+		if (attack) {
+			visitEMP(attack->getMainEMP());
+		}
+	};
+	auto visitAttackPattern = [&](int attackPatternID) {
+		if (!visitedAttackPatterns.insert(attackPatternID).second) {
+			return;
+		}
+		std::shared_ptr<EditorAttackPattern> attackPattern = findObject(attackPatterns, CookedLevelPack::OBJECT_TYPE::ATTACK_PATTERN, attackPatternID);
+		if (!attackPattern) {
+			return;
+		}
+		for (auto attackIDAndCount : *attackPattern->getAttackIDsCount()) {
+			visitAttack(attackIDAndCount.first);
+		}
+	};
+
+	for (auto enemyIDAndCount : getLevel(levelIndex)->getEnemyIDCount()) {
+		if (enemyIDAndCount.second <= 0) {
+			continue;
+		}
+		std::shared_ptr<EditorEnemy> enemy = findObject(enemies, CookedLevelPack::OBJECT_TYPE::ENEMY, enemyIDAndCount.first);
+		if (!enemy) {
+			continue;
+		}
+		onEnemy(enemy);
+		for (std::shared_ptr<DeathAction> deathAction : enemy->getDeathActions()) {
+			if (auto executeAttacks = std::dynamic_pointer_cast<ExecuteAttacksDeathAction>(deathAction)) {
+				for (auto attackIDAndSymbols : executeAttacks->getAttackIDs()) {
+					visitAttack(attackIDAndSymbols.first);
+				}
+			}
+		}
+		for (int i = 0; i < enemy->getPhasesCount(); i++) {
+			std::shared_ptr<EditorEnemyPhase> phase = findObject(enemyPhases, CookedLevelPack::OBJECT_TYPE::ENEMY_PHASE, std::get<1>(enemy->getPhaseData(i)));
+			if (!phase) {
+				continue;
+			}
+			for (auto attackPatternIDAndCount : *phase->getAttackPatternsIDCount()) {
+				visitAttackPattern(attackPatternIDAndCount.first);
+			}
+		}
+	}
+
+	if (player) {
+		for (std::shared_ptr<PlayerPowerTier> powerTier : player->getPowerTiers()) {
+			visitAttackPattern(powerTier->getAttackPatternID());
+			visitAttackPattern(powerTier->getFocusedAttackPatternID());
+			visitAttackPattern(powerTier->getBombAttackPatternID());
+		}
+	}
+}
+
+void LevelPack::playSound(const SoundSettings & soundSettings, int priority) const {
 	if (soundSettings.getFileName() == "") return;
 	SoundSettings alteredPath = SoundSettings(soundSettings);
 	alteredPath.setFileName("Level Packs/" + name + "/Sounds/" + alteredPath.getFileName());
-	audioPlayer.playSound(alteredPath);
+	audioPlayer.playSound(alteredPath, priority);
+}
+
+void LevelPack::preloadSounds(const std::set<std::string>& soundFileNames) const {
+	std::set<std::string> alteredPaths;
+	for (const std::string& fileName : soundFileNames) {
+		alteredPaths.insert("Level Packs/" + name + "/Sounds/" + fileName);
+	}
+	audioPlayer.preloadSounds(alteredPaths);
 }
 
 std::shared_ptr<sf::Music> LevelPack::playMusic(const MusicSettings & musicSettings) const {
@@ -1171,6 +1571,17 @@ void LevelPack::playMusic(std::shared_ptr<sf::Music> music, const MusicSettings&
 	audioPlayer.playMusic(music, alteredPath);
 }
 
+void LevelPack::prefetchMusic(const MusicSettings& musicSettings) const {
+	if (musicSettings.getFileName() == "") return;
+	MusicSettings alteredPath = MusicSettings(musicSettings);
+	alteredPath.setFileName("Level Packs/" + name + "/Music/" + alteredPath.getFileName());
+	audioPlayer.prefetchMusic(alteredPath);
+}
+
+void LevelPack::clearPrefetchedMusic() const {
+	audioPlayer.clearPrefetchedMusic();
+}
+
 std::set<int> LevelPack::getAllExistingLevelPackObjectFilesIDs(std::string folderPath, std::string levelPackObjectFilePrefix, std::string levelPackObjectFileExtension) {
 	std::set<int> results;
 	
@@ -1197,14 +1608,18 @@ std::set<int> LevelPack::getAllExistingLevelPackObjectFilesIDs(std::string folde
 	return results;
 }
 
-void LevelPack::deleteLevelPackObjectFiles(std::string folderPath, std::string levelPackObjectFilePrefix, std::string levelPackObjectFileExtension, std::set<int> ids) {
+int LevelPack::deleteLevelPackObjectFiles(std::string folderPath, std::string levelPackObjectFilePrefix, std::string levelPackObjectFileExtension, std::set<int> ids) {
+	int deletedCount = 0;
 	for (int id : ids) {
-		if (std::remove(format("%s\\%s%d%s", folderPath.c_str(), levelPackObjectFilePrefix.c_str(),
-			id, levelPackObjectFileExtension.c_str()).c_str()) != 0) {
-
-			// TODO: log warning: unable to delete file
+		std::string fileName = format("%s\\%s%d%s", folderPath.c_str(), levelPackObjectFilePrefix.c_str(), id, levelPackObjectFileExtension.c_str());
+		std::error_code error;
+		if (std::filesystem::remove(fileName, error)) {
+			deletedCount++;
+		} else if (error) {
+			L_(lwarning) << "Failed to delete " << fileName << ": " << error.message();
 		}
 	}
+	return deletedCount;
 }
 
 std::string LevelPack::LoadMetrics::formatForUser() {
@@ -0,0 +1,33 @@
+#include <LevelPack/OffScreenPolicy.h>
+
+OffScreenPolicy::OffScreenPolicy() {
+}
+
+OffScreenPolicy::OffScreenPolicy(OFF_SCREEN_ACTION action, float margin) : action(action), margin(margin) {
+}
+
+std::string OffScreenPolicy::format() const {
+	return tos(static_cast<int>(action)) + tos(margin);
+}
+
+void OffScreenPolicy::load(std::string formattedString) {
+	auto items = split(formattedString, TextMarshallable::DELIMITER);
+	action = static_cast<OFF_SCREEN_ACTION>(std::stoi(items.at(0)));
+	margin = std::stof(items.at(1));
+}
+
+nlohmann::json OffScreenPolicy::toJson() {
+	return {
+		{"action", action},
+		{"margin", margin}
+	};
+}
+
+void OffScreenPolicy::load(const nlohmann::json& j) {
+	j.at("action").get_to(action);
+	j.at("margin").get_to(margin);
+}
+
+bool OffScreenPolicy::operator==(const OffScreenPolicy& other) const {
+	return action == other.action && margin == other.margin;
+}
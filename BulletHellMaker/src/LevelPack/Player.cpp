@@ -184,7 +184,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> EditorPlayer:
 	return std::make_pair(status, messages);
 }
 
-void EditorPlayer::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void EditorPlayer::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(initialHealth)
 	COMPILE_EXPRESSION_FOR_FLOAT(maxHealth)
@@ -300,7 +300,7 @@ std::pair<LevelPackObject::LEGAL_STATUS, std::vector<std::string>> PlayerPowerTi
 	return std::make_pair(status, messages);
 }
 
-void PlayerPowerTier::compileExpressions(std::vector<exprtk::symbol_table<float>> symbolTables) {
+void PlayerPowerTier::compileExpressions(const std::vector<exprtk::symbol_table<float>>& higherLevelSymbolTables) {
 	DEFINE_PARSER_AND_EXPR_FOR_COMPILE
 	COMPILE_EXPRESSION_FOR_FLOAT(attackPatternLoopDelay)
 	COMPILE_EXPRESSION_FOR_FLOAT(focusedAttackPatternLoopDelay)
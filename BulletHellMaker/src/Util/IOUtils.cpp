@@ -4,6 +4,7 @@
 #include <functional>
 #include <filesystem>
 #include <set>
+#include <fstream>
 
 #include <Constants.h>
 
@@ -222,3 +223,20 @@ std::string getCurDateTimeInWindowsFileNameCompliantFormat() {
 	std::replace(curTime.begin(), curTime.end(), ':', '.');
 	return curTime;
 }
+
+bool writeFileAtomically(const std::string& filePath, const std::string& contents) {
+	std::string tempFilePath = filePath + ".tmp";
+	std::ofstream file(tempFilePath, std::ios::binary | std::ios::trunc);
+	file.write(contents.data(), contents.size());
+	file.close();
+	if (!file) {
+		std::remove(tempFilePath.c_str());
+		return false;
+	}
+
+	if (!MoveFileExA(tempFilePath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		std::remove(tempFilePath.c_str());
+		return false;
+	}
+	return true;
+}
@@ -1,6 +1,7 @@
 #include <Util/MathUtils.h>
 
 #include <cmath>
+#include <algorithm>
 
 #include <Game/Components/HitboxComponent.h>
 #include <Game/Components/PositionComponent.h>
@@ -14,10 +15,83 @@ float distance(float x1, float y1, float x2, float y2) {
     return sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
 }
 
+namespace {
+    float pointSegmentDistanceSquared(float px, float py, float ax, float ay, float bx, float by) {
+        float dx = bx - ax;
+        float dy = by - ay;
+        float lengthSquared = dx * dx + dy * dy;
+        float t = 0;
+        if (lengthSquared > 0) {
+            t = ((px - ax) * dx + (py - ay) * dy) / lengthSquared;
+            t = std::max(0.0f, std::min(1.0f, t));
+        }
+        float closestX = ax + dx * t - px;
+        float closestY = ay + dy * t - py;
+        return closestX * closestX + closestY * closestY;
+    }
+
+    float cross(float ox, float oy, float ax, float ay, float bx, float by) {
+        return (ax - ox) * (by - oy) - (ay - oy) * (bx - ox);
+    }
+}
+
+float segmentDistanceSquared(float ax1, float ay1, float ax2, float ay2, float bx1, float by1, float bx2, float by2) {
+    // Segments that cross each other have distance 0. Touching and collinear segments are
+    // caught by the endpoint distances below, so only proper crossings need to be checked here.
+    float d1 = cross(bx1, by1, bx2, by2, ax1, ay1);
+    float d2 = cross(bx1, by1, bx2, by2, ax2, ay2);
+    float d3 = cross(ax1, ay1, ax2, ay2, bx1, by1);
+    float d4 = cross(ax1, ay1, ax2, ay2, bx2, by2);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        return 0;
+    }
+
+    // Otherwise, the closest pair of points always includes an endpoint of one of the segments
+    return std::min(std::min(pointSegmentDistanceSquared(ax1, ay1, bx1, by1, bx2, by2), pointSegmentDistanceSquared(ax2, ay2, bx1, by1, bx2, by2)),
+        std::min(pointSegmentDistanceSquared(bx1, by1, ax1, ay1, ax2, ay2), pointSegmentDistanceSquared(bx2, by2, ax1, ay1, ax2, ay2)));
+}
+
 bool collides(const PositionComponent& p1, const HitboxComponent& h1, const PositionComponent& p2, const HitboxComponent& h2) {
-    return distance(p1.getX() + h1.getX(), p1.getY() + h1.getY(), p2.getX() + h2.getX(), p2.getY() + h2.getY()) <= (h1.getRadius() + h2.getRadius());
+    if (!h1.isCapsule() && !h2.isCapsule()) {
+        return distance(p1.getX() + h1.getX(), p1.getY() + h1.getY(), p2.getX() + h2.getX(), p2.getY() + h2.getY()) <= (h1.getRadius() + h2.getRadius());
+    }
+
+    // A circle is a capsule with a segment of length 0
+    float x1 = p1.getX() + h1.getX();
+    float y1 = p1.getY() + h1.getY();
+    float x2 = p2.getX() + h2.getX();
+    float y2 = p2.getY() + h2.getY();
+    float radii = h1.getRadius() + h2.getRadius();
+    return segmentDistanceSquared(x1 - h1.getCapsuleHalfX(), y1 - h1.getCapsuleHalfY(), x1 + h1.getCapsuleHalfX(), y1 + h1.getCapsuleHalfY(),
+        x2 - h2.getCapsuleHalfX(), y2 - h2.getCapsuleHalfY(), x2 + h2.getCapsuleHalfX(), y2 + h2.getCapsuleHalfY()) <= radii * radii;
 }
 
 bool collides(const PositionComponent& p1, const HitboxComponent& h1, const PositionComponent& p2, float h2x, float h2y, float h2radius) {
-    return distance(p1.getX() + h1.getX(), p1.getY() + h1.getY(), p2.getX() + h2x, p2.getY() + h2y) <= (h1.getRadius() + h2radius);
+    if (!h1.isCapsule()) {
+        return distance(p1.getX() + h1.getX(), p1.getY() + h1.getY(), p2.getX() + h2x, p2.getY() + h2y) <= (h1.getRadius() + h2radius);
+    }
+
+    float x1 = p1.getX() + h1.getX();
+    float y1 = p1.getY() + h1.getY();
+    float radii = h1.getRadius() + h2radius;
+    return pointSegmentDistanceSquared(p2.getX() + h2x, p2.getY() + h2y, x1 - h1.getCapsuleHalfX(), y1 - h1.getCapsuleHalfY(),
+        x1 + h1.getCapsuleHalfX(), y1 + h1.getCapsuleHalfY()) <= radii * radii;
 }
+
+bool sweptCollides(const PositionComponent& p1, const HitboxComponent& h1, float h2StartX, float h2StartY, const PositionComponent& p2, const HitboxComponent& h2) {
+    float targetX = p1.getX() + h1.getX();
+    float targetY = p1.getY() + h1.getY();
+
+    float startX = h2StartX + h2.getX();
+    float startY = h2StartY + h2.getY();
+    float endX = p2.getX() + h2.getX();
+    float endY = p2.getY() + h2.getY();
+
+    // Closest approach between the target (a point, or a segment if it is a capsule) and the segment swept by h2's center
+    float radii = h1.getRadius() + h2.getRadius();
+    if (!h1.isCapsule()) {
+        return pointSegmentDistanceSquared(targetX, targetY, startX, startY, endX, endY) <= radii * radii;
+    }
+    return segmentDistanceSquared(targetX - h1.getCapsuleHalfX(), targetY - h1.getCapsuleHalfY(), targetX + h1.getCapsuleHalfX(), targetY + h1.getCapsuleHalfY(),
+        startX, startY, endX, endY) <= radii * radii;
+}
\ No newline at end of file
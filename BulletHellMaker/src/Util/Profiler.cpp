@@ -0,0 +1,76 @@
+#include <Util/Profiler.h>
+
+#include <algorithm>
+
+#include <Util/Logger.h>
+
+std::mutex Profiler::mutex;
+std::map<std::string, long long> Profiler::counters;
+std::map<std::string, Profiler::Gauge> Profiler::gauges;
+std::map<std::string, Profiler::Timer> Profiler::timers;
+
+void Profiler::addToCounter(const std::string& name, long long amount) {
+	std::lock_guard<std::mutex> lock(mutex);
+	counters[name] += amount;
+}
+
+void Profiler::setGauge(const std::string& name, double value) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = gauges.find(name);
+	if (it == gauges.end()) {
+		gauges[name] = { value, value };
+	} else {
+		it->second.last = value;
+		it->second.max = std::max(it->second.max, value);
+	}
+}
+
+void Profiler::addTime(const std::string& name, double seconds) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Timer& timer = timers[name];
+	timer.totalSeconds += seconds;
+	timer.samples++;
+}
+
+long long Profiler::getCounter(const std::string& name) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = counters.find(name);
+	return it == counters.end() ? 0 : it->second;
+}
+
+double Profiler::getGaugeMax(const std::string& name) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = gauges.find(name);
+	return it == gauges.end() ? 0 : it->second.max;
+}
+
+void Profiler::logAndReset(const std::string& title) {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (counters.empty() && gauges.empty() && timers.empty()) {
+		return;
+	}
+
+	L_(ldebug) << "Profiler stats: " << title;
+	for (auto it = counters.begin(); it != counters.end(); it++) {
+		L_(ldebug1) << it->first << ": " << it->second;
+	}
+	for (auto it = gauges.begin(); it != gauges.end(); it++) {
+		L_(ldebug1) << it->first << ": last " << it->second.last << ", max " << it->second.max;
+	}
+	for (auto it = timers.begin(); it != timers.end(); it++) {
+		double averageMs = it->second.samples == 0 ? 0 : it->second.totalSeconds * 1000.0 / it->second.samples;
+		L_(ldebug1) << it->first << ": " << it->second.samples << " samples, " << (it->second.totalSeconds * 1000.0) << " ms total, " << averageMs << " ms average";
+	}
+
+	counters.clear();
+	gauges.clear();
+	timers.clear();
+}
+
+ProfilerTimer::ProfilerTimer(std::string name) : name(name), start(std::chrono::steady_clock::now()) {
+}
+
+ProfilerTimer::~ProfilerTimer() {
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	Profiler::addTime(name, elapsed.count());
+}
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <DataStructs/BakedTrajectory.h>
+#include <DataStructs/MovablePoint.h>
+#include <DataStructs/TimeFunctionVariable.h>
+
+namespace {
+    const std::vector<sf::Vector2f> CONTROL_POINTS = { sf::Vector2f(0, 0), sf::Vector2f(300, -200), sf::Vector2f(-100, 400), sf::Vector2f(250, 250) };
+    const float LIFESPAN = 3;
+
+    BakedTrajectory::Key makeKey(float lifespan, const std::vector<sf::Vector2f>& controlPoints) {
+        BakedTrajectory::Key key = { lifespan };
+        for (auto p : controlPoints) {
+            key.push_back(p.x);
+            key.push_back(p.y);
+        }
+        return key;
+    }
+
+    float distance(sf::Vector2f a, sf::Vector2f b) {
+        return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+    }
+
+    class BakedTrajectoryTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            BakedTrajectory::clearCache();
+            BakedTrajectory::setEnabled(true);
+        }
+
+        void TearDown() override {
+            BakedTrajectory::setEnabled(false);
+            BakedTrajectory::clearCache();
+        }
+    };
+}
+
+TEST_F(BakedTrajectoryTest, BakedPositionsMatchExactPositions) {
+    BezierMP exact(LIFESPAN, CONTROL_POINTS, true);
+    auto baked = BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), exact);
+    ASSERT_NE(baked, nullptr);
+    EXPECT_LE(baked->getMaxError(), BakedTrajectory::MAX_ALLOWED_ERROR);
+
+    // Includes times between samples and times outside the path's lifespan
+    BakedMP bakedMP(baked);
+    for (float time = -0.1f; time <= LIFESPAN + 0.1f; time += 0.0037f) {
+        float clamped = std::max(0.0f, std::min(LIFESPAN, time));
+        EXPECT_LE(distance(bakedMP.compute(sf::Vector2f(0, 0), time), exact.compute(sf::Vector2f(0, 0), clamped)), BakedTrajectory::MAX_ALLOWED_ERROR) << "at t=" << time;
+    }
+}
+
+TEST_F(BakedTrajectoryTest, RotatedPositionsMatchRotatedPath) {
+    const float rotation = 1.2f;
+    std::vector<sf::Vector2f> rotatedControlPoints;
+    for (auto p : CONTROL_POINTS) {
+        rotatedControlPoints.push_back(sf::Vector2f(p.x * std::cos(rotation) - p.y * std::sin(rotation), p.x * std::sin(rotation) + p.y * std::cos(rotation)));
+    }
+    BezierMP unrotated(LIFESPAN, CONTROL_POINTS, true);
+    BezierMP exact(LIFESPAN, rotatedControlPoints, true);
+    BakedMP bakedMP(BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), unrotated), rotation);
+    for (float time = 0; time <= LIFESPAN; time += 0.01f) {
+        // Rotating the control points rounds them, so allow a little more than the baking error
+        EXPECT_LE(distance(bakedMP.compute(sf::Vector2f(0, 0), time), exact.compute(sf::Vector2f(0, 0), time)), BakedTrajectory::MAX_ALLOWED_ERROR + 0.01f) << "at t=" << time;
+    }
+}
+
+TEST_F(BakedTrajectoryTest, IdenticalPathsShareTrajectory) {
+    BezierMP a(LIFESPAN, CONTROL_POINTS, true);
+    BezierMP b(LIFESPAN, CONTROL_POINTS, true);
+    auto bakedA = BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), a);
+    auto bakedB = BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), b);
+    EXPECT_EQ(bakedA, bakedB);
+
+    BakedTrajectory::clearCache();
+    EXPECT_NE(BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), a), bakedA);
+}
+
+TEST_F(BakedTrajectoryTest, KeysAreComparedExactly) {
+    // Differs from CONTROL_POINTS by less than the precision of tos()
+    std::vector<sf::Vector2f> nudged = CONTROL_POINTS;
+    nudged[3].x = std::nextafter(nudged[3].x, 1000.0f);
+    BezierMP original(LIFESPAN, CONTROL_POINTS, true);
+    BezierMP nudgedMP(LIFESPAN, nudged, true);
+    auto bakedOriginal = BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), original);
+    auto bakedNudged = BakedTrajectory::getOrBake(makeKey(LIFESPAN, nudged), nudgedMP);
+    EXPECT_NE(bakedOriginal, bakedNudged);
+}
+
+TEST_F(BakedTrajectoryTest, DisabledBakesNothing) {
+    BakedTrajectory::setEnabled(false);
+    BezierMP mp(LIFESPAN, CONTROL_POINTS, true);
+    EXPECT_EQ(BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), mp), nullptr);
+}
+
+TEST_F(BakedTrajectoryTest, SteppedPathsAreBakedExactly) {
+    auto distanceTFV = std::make_shared<PiecewiseTFV>();
+    distanceTFV->insertSegment(std::make_pair(0.0f, std::make_shared<ConstantTFV>(100)), LIFESPAN);
+    distanceTFV->insertSegment(std::make_pair(1.0f, std::make_shared<ConstantTFV>(200)), LIFESPAN);
+    distanceTFV->insertSegment(std::make_pair(2.5f, std::make_shared<ConstantTFV>(50)), LIFESPAN);
+    PolarMP exact(LIFESPAN, distanceTFV, std::make_shared<ConstantTFV>(0.7f));
+    const std::vector<float> stepTimes = { 0, 1, 2.5f };
+    BakedMP bakedMP(BakedTrajectory::getOrBakeSteps({ 1, 2, 3 }, exact, stepTimes));
+    for (float time = 0; time <= LIFESPAN; time += 0.0037f) {
+        // Which side of a jump the jump itself is on is up to the TFV
+        bool atJump = std::any_of(stepTimes.begin(), stepTimes.end(), [time](float stepTime) { return std::abs(time - stepTime) < 0.001f; });
+        if (!atJump) {
+            EXPECT_LE(distance(bakedMP.compute(sf::Vector2f(0, 0), time), exact.compute(sf::Vector2f(0, 0), time)), 0.001f) << "at t=" << time;
+        }
+    }
+}
+
+TEST_F(BakedTrajectoryTest, GetBakedOnlyLooksUp) {
+    BezierMP mp(LIFESPAN, CONTROL_POINTS, true);
+    EXPECT_EQ(BakedTrajectory::getBaked(makeKey(LIFESPAN, CONTROL_POINTS)), nullptr);
+    auto baked = BakedTrajectory::getOrBake(makeKey(LIFESPAN, CONTROL_POINTS), mp);
+    EXPECT_EQ(BakedTrajectory::getBaked(makeKey(LIFESPAN, CONTROL_POINTS)), baked);
+}
\ No newline at end of file
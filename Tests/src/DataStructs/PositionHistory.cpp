@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+#include <DataStructs/PositionHistory.h>
+
+TEST(PositionHistoryTest, OldestTimeStartsAtFirstRecord) {
+    PositionHistory history;
+    EXPECT_TRUE(history.isEmpty());
+
+    history.record(0.5f, sf::Vector2f(10, 0));
+    EXPECT_FLOAT_EQ(history.getOldestTime(), 0.5f);
+
+    history.record(0.51f, sf::Vector2f(20, 0));
+    EXPECT_FLOAT_EQ(history.getOldestTime(), 0.5f);
+    EXPECT_NEAR(history.get(0.505f).x, 15.0f, 0.01f);
+}
+
+TEST(PositionHistoryTest, OldestTimeMovesForwardOnceFull) {
+    PositionHistory history;
+    history.record(0, sf::Vector2f(0, 0));
+    history.record(10, sf::Vector2f(100, 0));
+
+    float window = (PositionHistory::CAPACITY - 1) * POSITION_HISTORY_SAMPLE_INTERVAL;
+    EXPECT_GE(history.getOldestTime(), 10 - window - POSITION_HISTORY_SAMPLE_INTERVAL);
+    EXPECT_LE(history.getOldestTime(), 10.0f);
+    EXPECT_NEAR(history.get(history.getOldestTime()).x, history.getOldestTime() * 10.0f, 0.01f);
+}
\ No newline at end of file
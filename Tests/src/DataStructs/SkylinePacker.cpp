@@ -0,0 +1,66 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <DataStructs/SkylinePacker.h>
+
+namespace {
+    struct PackedRect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+}
+
+TEST(SkylinePackerTest, PackedRectsDontOverlap) {
+    const int binSize = 512;
+    SkylinePacker packer(binSize, binSize);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> size(1, 48);
+    std::vector<PackedRect> packed;
+    long long packedArea = 0;
+    for (int i = 0; i < 1000; i++) {
+        PackedRect rect{ 0, 0, size(rng), size(rng) };
+        if (packer.insert(rect.width, rect.height, rect.x, rect.y)) {
+            ASSERT_GE(rect.x, 0);
+            ASSERT_GE(rect.y, 0);
+            ASSERT_LE(rect.x + rect.width, binSize);
+            ASSERT_LE(rect.y + rect.height, binSize);
+            packed.push_back(rect);
+            packedArea += rect.width * rect.height;
+        }
+    }
+
+    for (int i = 0; i < packed.size(); i++) {
+        for (int j = i + 1; j < packed.size(); j++) {
+            const PackedRect& a = packed[i];
+            const PackedRect& b = packed[j];
+            bool overlap = a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+            ASSERT_FALSE(overlap) << "Rects " << i << " and " << j << " overlap";
+        }
+    }
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), (float)((double)packedArea / (binSize * binSize)));
+    // Random sizes that don't all fit should still fill most of the bin
+    EXPECT_GT(packer.getOccupancy(), 0.8f);
+}
+
+TEST(SkylinePackerTest, RejectsRectsThatDontFit) {
+    SkylinePacker packer(64, 64);
+    int x, y;
+    EXPECT_FALSE(packer.insert(65, 1, x, y));
+    EXPECT_FALSE(packer.insert(1, 65, x, y));
+    EXPECT_FALSE(packer.insert(0, 10, x, y));
+
+    EXPECT_TRUE(packer.insert(64, 32, x, y));
+    EXPECT_EQ(x, 0);
+    EXPECT_EQ(y, 0);
+    EXPECT_TRUE(packer.insert(32, 32, x, y));
+    EXPECT_EQ(y, 32);
+    EXPECT_FALSE(packer.insert(33, 32, x, y));
+    EXPECT_TRUE(packer.insert(32, 32, x, y));
+    EXPECT_EQ(x, 32);
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 1.0f);
+    EXPECT_FALSE(packer.insert(1, 1, x, y));
+}
@@ -0,0 +1,259 @@
+#include <random>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <Constants.h>
+#include <Util/MathUtils.h>
+#include <LevelPack/Animatable.h>
+#include <DataStructs/SpatialHashTable.h>
+
+namespace {
+    struct Mover {
+        uint32_t id;
+        PositionComponent position;
+        float vx;
+        float vy;
+    };
+
+    std::vector<Mover> createMovers(int count, float minSpeed, float maxSpeed, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> x(0, MAP_WIDTH);
+        std::uniform_real_distribution<float> y(0, MAP_HEIGHT);
+        std::uniform_real_distribution<float> angle(0, 6.2831853f);
+        std::uniform_real_distribution<float> speed(minSpeed, maxSpeed);
+        std::vector<Mover> movers;
+        for (int i = 0; i < count; i++) {
+            float a = angle(rng);
+            float s = speed(rng);
+            movers.push_back({ (uint32_t)i, PositionComponent(x(rng), y(rng)), s * std::cos(a), s * std::sin(a) });
+        }
+        return movers;
+    }
+
+    void step(std::vector<Mover>& movers, float deltaTime) {
+        for (Mover& mover : movers) {
+            float x = mover.position.getX() + mover.vx * deltaTime;
+            float y = mover.position.getY() + mover.vy * deltaTime;
+            // Bounce off the map edges so that the number of objects in the table stays constant
+            if (x < 0 || x > MAP_WIDTH) {
+                mover.vx = -mover.vx;
+            }
+            if (y < 0 || y > MAP_HEIGHT) {
+                mover.vy = -mover.vy;
+            }
+            mover.position.setX(std::max(0.0f, std::min((float)MAP_WIDTH, x)));
+            mover.position.setY(std::max(0.0f, std::min((float)MAP_HEIGHT, y)));
+        }
+    }
+
+    /*
+    The table as it was before it was incremental: every object is reinserted into every cell it overlaps each frame.
+    */
+    class RebuildingTable {
+    public:
+        RebuildingTable(float mapWidth, float mapHeight, float cellSize) : cellSize(cellSize) {
+            cellsPerMapWidth = (int)std::ceil(mapWidth / cellSize);
+            cellsPerMapHeight = (int)std::ceil(mapHeight / cellSize);
+            buckets.resize(cellsPerMapWidth * cellsPerMapHeight);
+        }
+
+        void clear() {
+            for (auto& bucket : buckets) {
+                bucket.clear();
+            }
+        }
+
+        void insert(uint32_t object, const HitboxComponent& hitbox, const PositionComponent& position) {
+            int left = std::max(0, (int)((position.getX() + hitbox.getX() - hitbox.getRadius()) / cellSize));
+            int right = std::min(cellsPerMapWidth - 1, (int)((position.getX() + hitbox.getX() + hitbox.getRadius()) / cellSize));
+            int bottom = std::max(0, (int)((position.getY() + hitbox.getY() - hitbox.getRadius()) / cellSize));
+            int top = std::min(cellsPerMapHeight - 1, (int)((position.getY() + hitbox.getY() + hitbox.getRadius()) / cellSize));
+            for (int xCell = left; xCell <= right; xCell++) {
+                for (int yCell = bottom; yCell <= top; yCell++) {
+                    buckets[xCell + yCell * cellsPerMapWidth].push_back(object);
+                }
+            }
+        }
+
+        const std::vector<uint32_t>& getBucket(int xCell, int yCell) const {
+            return buckets[xCell + yCell * cellsPerMapWidth];
+        }
+
+        int getCellsPerMapWidth() const {
+            return cellsPerMapWidth;
+        }
+
+        int getCellsPerMapHeight() const {
+            return cellsPerMapHeight;
+        }
+
+    private:
+        float cellSize;
+        int cellsPerMapWidth;
+        int cellsPerMapHeight;
+        std::vector<std::vector<uint32_t>> buckets;
+    };
+
+    std::vector<uint32_t> sorted(std::vector<uint32_t> objects) {
+        std::sort(objects.begin(), objects.end());
+        return objects;
+    }
+
+    // Objects are returned once for every cell they share with the query
+    std::vector<uint32_t> sortedUnique(std::vector<uint32_t> objects) {
+        objects = sorted(objects);
+        objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+        return objects;
+    }
+}
+
+TEST(SpatialHashTableTest, IncrementalUpdatesMatchRebuild) {
+    HitboxComponent hitbox(ROTATION_TYPE::LOCK_ROTATION, 4, 0, 0);
+    HitboxComponent queryHitbox(ROTATION_TYPE::LOCK_ROTATION, 30, 0, 0);
+    std::vector<Mover> movers = createMovers(500, 0, 600, 1);
+
+    SpatialHashTable<uint32_t> incremental(MAP_WIDTH, MAP_HEIGHT, 20);
+    for (int frame = 0; frame < 60; frame++) {
+        step(movers, 1 / 60.0f);
+        for (const Mover& mover : movers) {
+            incremental.update(mover.id, hitbox, mover.position);
+        }
+
+        SpatialHashTable<uint32_t> rebuilt(MAP_WIDTH, MAP_HEIGHT, 20);
+        for (const Mover& mover : movers) {
+            rebuilt.update(mover.id, hitbox, mover.position);
+        }
+
+        for (int i = 0; i < 10; i++) {
+            PositionComponent query(i * MAP_WIDTH / 10.0f, (frame * 37 % 100) * MAP_HEIGHT / 100.0f);
+            EXPECT_EQ(sorted(incremental.getNearbyObjects(queryHitbox, query)), sorted(rebuilt.getNearbyObjects(queryHitbox, query)));
+        }
+    }
+}
+
+TEST(SpatialHashTableTest, RemoveKeepsOtherObjects) {
+    HitboxComponent hitbox(ROTATION_TYPE::LOCK_ROTATION, 15, 0, 0);
+    SpatialHashTable<uint32_t> table(MAP_WIDTH, MAP_HEIGHT, 20);
+    // Every object overlaps the same 4 cells so that removing one swaps another into its slots
+    for (uint32_t i = 0; i < 4; i++) {
+        table.update(i, hitbox, PositionComponent(20, 20));
+    }
+    table.remove(1);
+    table.remove(1);
+
+    EXPECT_FALSE(table.contains(1));
+    EXPECT_TRUE(table.contains(3));
+    auto nearby = sorted(table.getNearbyObjects(hitbox, PositionComponent(20, 20)));
+    nearby.erase(std::unique(nearby.begin(), nearby.end()), nearby.end());
+    EXPECT_EQ(nearby, std::vector<uint32_t>({ 0, 2, 3 }));
+
+    // Moving the object that was swapped must remove it from all of its old cells
+    table.update(3, hitbox, PositionComponent(300, 300));
+    nearby = sorted(table.getNearbyObjects(hitbox, PositionComponent(20, 20)));
+    nearby.erase(std::unique(nearby.begin(), nearby.end()), nearby.end());
+    EXPECT_EQ(nearby, std::vector<uint32_t>({ 0, 2 }));
+    nearby = sorted(table.getNearbyObjects(hitbox, PositionComponent(300, 300)));
+    nearby.erase(std::unique(nearby.begin(), nearby.end()), nearby.end());
+    EXPECT_EQ(nearby, std::vector<uint32_t>({ 3 }));
+}
+
+TEST(SpatialHashTableTest, CapsuleOnlyUsesCellsAlongSegment) {
+    HitboxComponent laser(ROTATION_TYPE::LOCK_ROTATION, 2, 0, 0);
+    laser.setCapsule(0, 0, 180, 180);
+    HitboxComponent query(ROTATION_TYPE::LOCK_ROTATION, 2, 0, 0);
+    SpatialHashTable<uint32_t> table(MAP_WIDTH, MAP_HEIGHT, 20);
+    table.update(0, laser, PositionComponent(10, 10));
+
+    // On the diagonal
+    EXPECT_EQ(sortedUnique(table.getNearbyObjects(query, PositionComponent(100, 100))), std::vector<uint32_t>({ 0 }));
+    EXPECT_EQ(sortedUnique(table.getNearbyObjects(query, PositionComponent(185, 185))), std::vector<uint32_t>({ 0 }));
+    // Inside the capsule's bounding box but nowhere near the segment
+    EXPECT_EQ(table.getNearbyObjects(query, PositionComponent(180, 20)).size(), 0);
+    EXPECT_EQ(table.getNearbyObjects(query, PositionComponent(20, 180)).size(), 0);
+
+    // Querying with the capsule itself only finds objects along it
+    table.update(1, query, PositionComponent(100, 100));
+    table.update(2, query, PositionComponent(180, 20));
+    EXPECT_EQ(sortedUnique(table.getNearbyObjects(laser, PositionComponent(10, 10))), std::vector<uint32_t>({ 0, 1 }));
+}
+
+TEST(SpatialHashTableTest, MovingCapsulesAreNeverMissed) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> x(0, MAP_WIDTH);
+    std::uniform_real_distribution<float> y(0, MAP_HEIGHT);
+    std::uniform_real_distribution<float> angle(-PI, PI);
+    HitboxComponent query(ROTATION_TYPE::LOCK_ROTATION, 3, 0, 0);
+
+    // Lasers spinning around their positions, mixed in with circles
+    std::vector<HitboxComponent> hitboxes;
+    std::vector<PositionComponent> positions;
+    for (int i = 0; i < 100; i++) {
+        HitboxComponent hitbox(ROTATION_TYPE::ROTATE_WITH_MOVEMENT, 4, 0, 0);
+        if (i % 2 == 0) {
+            hitbox.setCapsule(0, 0, 150, 0);
+        }
+        hitboxes.push_back(hitbox);
+        positions.push_back(PositionComponent(x(rng), y(rng)));
+    }
+
+    SpatialHashTable<uint32_t> table(MAP_WIDTH, MAP_HEIGHT, 20);
+    for (int frame = 0; frame < 20; frame++) {
+        for (uint32_t i = 0; i < hitboxes.size(); i++) {
+            float a = angle(rng);
+            hitboxes[i].rotate(a, std::sin(a), std::cos(a));
+            table.update(i, hitboxes[i], positions[i]);
+        }
+
+        for (int q = 0; q < 200; q++) {
+            PositionComponent queryPosition(x(rng), y(rng));
+            std::vector<uint32_t> nearby = table.getNearbyObjects(query, queryPosition);
+            for (uint32_t i = 0; i < hitboxes.size(); i++) {
+                if (collides(queryPosition, query, positions[i], hitboxes[i])) {
+                    EXPECT_TRUE(std::find(nearby.begin(), nearby.end(), i) != nearby.end());
+                }
+            }
+        }
+    }
+}
+
+TEST(SpatialHashTableTest, IncrementalCellsMatchRebuiltCells) {
+    const int bullets = 1000;
+    const int frames = 60;
+    const float deltaTime = 1 / 120.0f;
+    // Cell size used by CollisionSystem's default table
+    const float cellSize = std::max(MAP_WIDTH, MAP_HEIGHT) / 10.0f;
+    HitboxComponent hitbox(ROTATION_TYPE::LOCK_ROTATION, 4, 0, 0);
+    // Small enough that a query at a cell's center returns exactly that cell's objects
+    HitboxComponent pointHitbox(ROTATION_TYPE::LOCK_ROTATION, 0, 0, 0);
+
+    struct SpeedDistribution {
+        float minSpeed;
+        float maxSpeed;
+    };
+    for (const SpeedDistribution& distribution : { SpeedDistribution{ 20, 80 }, SpeedDistribution{ 20, 500 }, SpeedDistribution{ 400, 900 } }) {
+        std::vector<Mover> movers = createMovers(bullets, distribution.minSpeed, distribution.maxSpeed, 2);
+        SpatialHashTable<uint32_t> incrementalTable(MAP_WIDTH, MAP_HEIGHT, cellSize);
+        RebuildingTable rebuildTable(MAP_WIDTH, MAP_HEIGHT, cellSize);
+
+        for (int frame = 0; frame < frames; frame++) {
+            step(movers, deltaTime);
+            rebuildTable.clear();
+            for (const Mover& mover : movers) {
+                // Every few frames, some objects leave the table and come back, like despawned and respawned bullets
+                if (mover.id % 7 == frame % 7) {
+                    incrementalTable.remove(mover.id);
+                }
+                incrementalTable.update(mover.id, hitbox, mover.position);
+                rebuildTable.insert(mover.id, hitbox, mover.position);
+            }
+
+            for (int xCell = 0; xCell < rebuildTable.getCellsPerMapWidth(); xCell++) {
+                for (int yCell = 0; yCell < rebuildTable.getCellsPerMapHeight(); yCell++) {
+                    PositionComponent cellCenter(std::min((xCell + 0.5f) * cellSize, (float)MAP_WIDTH), std::min((yCell + 0.5f) * cellSize, (float)MAP_HEIGHT));
+                    ASSERT_EQ(sorted(incrementalTable.getNearbyObjects(pointHitbox, cellCenter)), sorted(rebuildTable.getBucket(xCell, yCell)))
+                        << "cell (" << xCell << ", " << yCell << ") on frame " << frame;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
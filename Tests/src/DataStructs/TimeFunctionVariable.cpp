@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <DataStructs/TimeFunctionVariable.h>
+
+TEST(ExpressionTFVTest, Evaluate) {
+    ExpressionTFV tfv("if(t < 1, 100*t, 100 + 50*(t-1))", 3);
+    tfv.bindSymbols({});
+    EXPECT_NEAR(tfv.evaluate(0.5f), 50.0f, 0.001f);
+    EXPECT_NEAR(tfv.evaluate(2.0f), 150.0f, 0.001f);
+}
+
+TEST(ExpressionTFVTest, IllegalExpressionEvaluatesToZero) {
+    ExpressionTFV tfv("t +* ", 3);
+    tfv.bindSymbols({});
+    EXPECT_EQ(tfv.evaluate(1.0f), 0.0f);
+}
+
+TEST(ExpressionTFVTest, FormatAndLoad) {
+    ExpressionTFV tfv("sin(t) * 4", 2);
+    ExpressionTFV loaded;
+    loaded.load(tfv.format());
+    EXPECT_EQ(tfv, loaded);
+}
+
+TEST(ExpressionTFVTest, CopyEvaluatesIndependently) {
+    ExpressionTFV tfv("10*t", 3);
+    tfv.bindSymbols({});
+    EXPECT_NEAR(tfv.evaluate(1.0f), 10.0f, 0.001f);
+
+    ExpressionTFV copy(tfv);
+    std::shared_ptr<TFV> cloned = tfv.clone();
+    tfv.setExpressionStr("20*t");
+    EXPECT_NEAR(tfv.evaluate(2.0f), 40.0f, 0.001f);
+    EXPECT_NEAR(copy.evaluate(0.5f), 5.0f, 0.001f);
+    EXPECT_NEAR(cloned->evaluate(0.25f), 2.5f, 0.001f);
+    EXPECT_NEAR(tfv.evaluate(1.0f), 20.0f, 0.001f);
+
+    ExpressionTFV assigned;
+    assigned = copy;
+    EXPECT_NEAR(assigned.evaluate(3.0f), 30.0f, 0.001f);
+    EXPECT_NEAR(copy.evaluate(1.5f), 15.0f, 0.001f);
+}
+
+TEST(ExpressionTFVTest, BatchMatchesPiecewise) {
+    const int bullets = 240;
+    const float deltaTime = 1 / 120.0f;
+
+    // The same curve written by hand as two linear segments
+    std::shared_ptr<ExpressionTFV> expressionTFV = std::make_shared<ExpressionTFV>("if(t < 1, 100*t, 100 + 50*(t-1))", 3);
+    expressionTFV->bindSymbols({});
+    std::shared_ptr<PiecewiseTFV> piecewiseTFV = std::make_shared<PiecewiseTFV>();
+    piecewiseTFV->insertSegment(std::make_pair(0.0f, std::make_shared<LinearTFV>(0, 100, 1)), 3);
+    piecewiseTFV->insertSegment(std::make_pair(1.0f, std::make_shared<LinearTFV>(100, 200, 2)), 3);
+
+    ExpressionTFVBatch batch;
+    std::shared_ptr<TFV> asTFV = expressionTFV;
+    for (int i = 0; i < bullets; i++) {
+        asTFV->addToExpressionBatch(batch, i * deltaTime);
+    }
+    batch.run();
+    for (int i = 0; i < bullets; i++) {
+        EXPECT_NEAR(asTFV->evaluate(i * deltaTime), piecewiseTFV->evaluate(i * deltaTime), 0.001f);
+    }
+    batch.clear();
+}
\ No newline at end of file
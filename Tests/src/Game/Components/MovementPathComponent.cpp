@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <Game/Components/MovementPathComponent.h>
+#include <Game/Components/PositionComponent.h>
+#include <Game/Components/HitboxComponent.h>
+#include <Game/EntityCreationQueue.h>
+#include <LevelPack/EditorMovablePointAction.h>
+#include <LevelPack/EditorMovablePointSpawnType.h>
+#include <DataStructs/TimeFunctionVariable.h>
+#include <DataStructs/MovablePoint.h>
+#include <LevelPack/Animatable.h>
+
+namespace {
+    // Moves 100 units to the right of the reference entity over 1 second
+    std::vector<std::shared_ptr<EMPAction>> moveRight() {
+        return { std::make_shared<MoveCustomPolarEMPA>(std::make_shared<LinearTFV>(0, 100, 1), std::make_shared<ConstantTFV>(0), 1) };
+    }
+}
+
+TEST(MovementPathComponentTest, PreviousPositionOfNewEntityIsComputedFromPath) {
+    entt::DefaultRegistry registry;
+    EntityCreationQueue queue(registry);
+
+    uint32_t reference = registry.create();
+    registry.assign<PositionComponent>(reference, 100.0f, 0.0f);
+    uint32_t entity = registry.create();
+    registry.assign<PositionComponent>(entity, 0.0f, 0.0f);
+    // Spawned as if it happened 0.5 seconds ago, so the position history holds only the current position
+    MPSpawnInformation spawnInfo{ true, reference, sf::Vector2f(0, 0) };
+    auto& path = registry.assign<MovementPathComponent>(entity, queue, entity, registry, reference, spawnInfo, moveRight(), 0.5f);
+
+    EXPECT_NEAR(registry.get<PositionComponent>(entity).getX(), 150.0f, 0.01f);
+    EXPECT_NEAR(path.getPreviousPosition(registry, 0).x, 150.0f, 0.01f);
+    EXPECT_NEAR(path.getPreviousPosition(registry, 0.25f).x, 125.0f, 0.01f);
+}
+
+TEST(MovementPathComponentTest, PreviousPositionUsesHistoryOnceRecorded) {
+    entt::DefaultRegistry registry;
+    EntityCreationQueue queue(registry);
+
+    uint32_t reference = registry.create();
+    registry.assign<PositionComponent>(reference, 100.0f, 0.0f);
+    uint32_t entity = registry.create();
+    registry.assign<PositionComponent>(entity, 0.0f, 0.0f);
+    MPSpawnInformation spawnInfo{ true, reference, sf::Vector2f(0, 0) };
+    auto& path = registry.assign<MovementPathComponent>(entity, queue, entity, registry, reference, spawnInfo, moveRight(), 0);
+    path.update(queue, registry, entity, registry.get<PositionComponent>(entity), 0.01f);
+    path.update(queue, registry, entity, registry.get<PositionComponent>(entity), 0.01f);
+
+    EXPECT_NEAR(path.getPreviousPosition(registry, 0.01f).x, 101.0f, 0.01f);
+    EXPECT_NEAR(path.getPreviousPosition(registry, 0.015f).x, 100.5f, 0.01f);
+}
+
+TEST(MovementPathComponentTest, PathChangeResetsHitboxSweep) {
+    entt::DefaultRegistry registry;
+    EntityCreationQueue queue(registry);
+
+    uint32_t reference = registry.create();
+    registry.assign<PositionComponent>(reference, 100.0f, 0.0f);
+    uint32_t entity = registry.create();
+    registry.assign<PositionComponent>(entity, 0.0f, 0.0f);
+    MPSpawnInformation spawnInfo{ true, reference, sf::Vector2f(0, 0) };
+    auto& path = registry.assign<MovementPathComponent>(entity, queue, entity, registry, reference, spawnInfo, moveRight(), 0);
+    auto& hitbox = registry.assign<HitboxComponent>(entity, ROTATION_TYPE::LOCK_ROTATION, 1.0f, 0.0f, 0.0f);
+    hitbox.updateSweep(registry.get<PositionComponent>(entity));
+
+    // Jump 300 units away
+    path.setPath(queue, registry, entity, registry.get<PositionComponent>(entity), std::make_shared<StationaryMP>(sf::Vector2f(300, 0), 1), 0);
+    EXPECT_FALSE(hitbox.updateSweep(registry.get<PositionComponent>(entity)));
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <LevelPack/Animation.h>
+
+namespace {
+    std::shared_ptr<const AnimationClip> makeClip(std::shared_ptr<const SpriteTemplate> frame1, std::shared_ptr<const SpriteTemplate> frame2) {
+        return std::make_shared<AnimationClip>("Test", std::vector<std::pair<float, std::shared_ptr<const SpriteTemplate>>>{ { 1.0f, frame1 }, { 2.0f, frame2 } });
+    }
+}
+
+TEST(AnimationTest, CursorsSharingAClipAdvanceIndependently) {
+    auto frame1 = std::make_shared<SpriteTemplate>(nullptr, sf::IntRect(0, 0, 8, 8), sf::Vector2f(), sf::Vector2f(1, 1), sf::Color::White);
+    auto frame2 = std::make_shared<SpriteTemplate>(nullptr, sf::IntRect(8, 0, 8, 8), sf::Vector2f(), sf::Vector2f(1, 1), sf::Color::White);
+    std::shared_ptr<const AnimationClip> clip = makeClip(frame1, frame2);
+    EXPECT_FLOAT_EQ(clip->getTotalDuration(), 3.0f);
+
+    Animation a(clip, false);
+    Animation b(clip, false);
+    EXPECT_EQ(a.update(0.5f), frame1);
+    EXPECT_EQ(b.update(1.5f), frame2);
+    EXPECT_EQ(a.update(0.0f), frame1);
+    EXPECT_EQ(b.update(2.0f), nullptr);
+    EXPECT_TRUE(b.isDone());
+    EXPECT_FALSE(a.isDone());
+}
+
+TEST(AnimationTest, LoopingCursorWrapsAround) {
+    auto frame1 = std::make_shared<SpriteTemplate>(nullptr, sf::IntRect(0, 0, 8, 8), sf::Vector2f(), sf::Vector2f(1, 1), sf::Color::White);
+    auto frame2 = std::make_shared<SpriteTemplate>(nullptr, sf::IntRect(8, 0, 8, 8), sf::Vector2f(), sf::Vector2f(1, 1), sf::Color::White);
+    Animation animation(makeClip(frame1, frame2), true);
+    EXPECT_EQ(animation.update(3.5f), frame1);
+    EXPECT_EQ(animation.update(1.0f), frame2);
+    EXPECT_FALSE(animation.isDone());
+}
+
+TEST(AnimationTest, DefaultCursorIsDone) {
+    Animation animation;
+    EXPECT_FALSE(animation.hasClip());
+    EXPECT_TRUE(animation.isDone());
+    EXPECT_EQ(animation.update(1.0f), nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <LevelPack/CookedLevelPack.h>
+
+static const std::string COOKED_FILE_NAME = "CookedLevelPackTest.bhmpack";
+
+static std::vector<CookedLevelPack::Object> createObjects() {
+    return {
+        { CookedLevelPack::OBJECT_TYPE::ATTACK, 3, { {"name", "first"} } },
+        { CookedLevelPack::OBJECT_TYPE::ATTACK, 1, { {"name", "second"} } },
+        { CookedLevelPack::OBJECT_TYPE::ENEMY, 1, { {"name", "last"} } }
+    };
+}
+
+TEST(CookedLevelPackTest, ReadsBackWrittenObjects) {
+    ASSERT_TRUE(CookedLevelPack::write(COOKED_FILE_NAME, createObjects()));
+
+    {
+        CookedLevelPack cooked;
+        ASSERT_TRUE(cooked.open(COOKED_FILE_NAME));
+        EXPECT_EQ(cooked.getObjectCount(), 3);
+        EXPECT_EQ(cooked.getIDs(CookedLevelPack::OBJECT_TYPE::ATTACK), std::vector<int>({ 1, 3 }));
+        EXPECT_FALSE(cooked.contains(CookedLevelPack::OBJECT_TYPE::ENEMY, 3));
+        for (const CookedLevelPack::Object& object : createObjects()) {
+            EXPECT_EQ(cooked.read(object.type, object.id), object.json);
+        }
+        EXPECT_THROW(cooked.read(CookedLevelPack::OBJECT_TYPE::ENEMY, 3), std::out_of_range);
+    }
+
+    std::filesystem::remove(COOKED_FILE_NAME);
+}
+
+TEST(CookedLevelPackTest, CorruptedObjectFailsOnlyItsRead) {
+    ASSERT_TRUE(CookedLevelPack::write(COOKED_FILE_NAME, createObjects()));
+
+    // The objects are stored sorted by type and then ID, so the last byte belongs to the enemy
+    {
+        std::fstream file(COOKED_FILE_NAME, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char last = file.get();
+        file.seekp(-1, std::ios::end);
+        file.put(last ^ 0x5A);
+    }
+
+    {
+        CookedLevelPack cooked;
+        ASSERT_TRUE(cooked.open(COOKED_FILE_NAME));
+        EXPECT_EQ(cooked.read(CookedLevelPack::OBJECT_TYPE::ATTACK, 1)["name"], "second");
+        EXPECT_EQ(cooked.read(CookedLevelPack::OBJECT_TYPE::ATTACK, 3)["name"], "first");
+        EXPECT_THROW(cooked.read(CookedLevelPack::OBJECT_TYPE::ENEMY, 1), std::out_of_range);
+    }
+
+    std::filesystem::remove(COOKED_FILE_NAME);
+}
+
+TEST(CookedLevelPackTest, CorruptedTableFailsOpen) {
+    ASSERT_TRUE(CookedLevelPack::write(COOKED_FILE_NAME, createObjects()));
+
+    // The header is 32 bytes and is followed by the first entry, whose first byte is part of its type
+    {
+        std::fstream file(COOKED_FILE_NAME, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(32);
+        file.put(0x7F);
+    }
+
+    {
+        CookedLevelPack cooked;
+        EXPECT_FALSE(cooked.open(COOKED_FILE_NAME));
+    }
+
+    std::filesystem::remove(COOKED_FILE_NAME);
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <Config.h>
+#include <Game/AudioPlayer.h>
+#include <DataStructs/SpriteLoader.h>
+#include <LevelPack/LevelPack.h>
+#include <LevelPack/Attack.h>
+#include <LevelPack/AttackPattern.h>
+#include <LevelPack/Enemy.h>
+#include <LevelPack/EnemyPhase.h>
+#include <LevelPack/EditorMovablePoint.h>
+#include <Util/StringUtils.h>
+
+struct SyntheticLevelPackIDs {
+    std::vector<int> attackIDs;
+    std::vector<int> attackPatternIDs;
+    std::vector<int> enemyPhaseIDs;
+    std::vector<int> enemyIDs;
+};
+
+/*
+Fills a level pack with objectsCount small objects that reference each other.
+*/
+static SyntheticLevelPackIDs createSyntheticLevelPack(LevelPack& levelPack, int objectsCount) {
+    const int attacksCount = objectsCount * 70 / 100;
+    const int attackPatternsCount = objectsCount * 15 / 100;
+    const int enemyPhasesCount = objectsCount * 10 / 100;
+    const int enemiesCount = objectsCount * 5 / 100;
+
+    SyntheticLevelPackIDs ids;
+    for (int i = 0; i < attacksCount; i++) {
+        std::shared_ptr<EditorAttack> attack = levelPack.createAttack();
+        attack->setName("attack " + std::to_string(i));
+        attack->getMainEMP()->createChild()->setHitboxRadius(std::to_string(i % 17));
+        ids.attackIDs.push_back(attack->getID());
+    }
+    for (int i = 0; i < attackPatternsCount; i++) {
+        std::shared_ptr<EditorAttackPattern> attackPattern = levelPack.createAttackPattern();
+        attackPattern->addAttack(std::to_string(i % 5), ids.attackIDs[i % attacksCount], ExprSymbolTable());
+        ids.attackPatternIDs.push_back(attackPattern->getID());
+    }
+    for (int i = 0; i < enemyPhasesCount; i++) {
+        std::shared_ptr<EditorEnemyPhase> enemyPhase = levelPack.createEnemyPhase();
+        enemyPhase->addAttackPatternID(std::to_string(i % 3), ids.attackPatternIDs[i % attackPatternsCount], ExprSymbolTable());
+        ids.enemyPhaseIDs.push_back(enemyPhase->getID());
+    }
+    for (int i = 0; i < enemiesCount; i++) {
+        std::shared_ptr<EditorEnemy> enemy = levelPack.createEnemy();
+        enemy->setName("enemy " + std::to_string(i));
+        ids.enemyIDs.push_back(enemy->getID());
+    }
+    return ids;
+}
+
+static void expectSameObjects(const LevelPack& loaded, const LevelPack& original, const SyntheticLevelPackIDs& ids) {
+    for (int id : ids.attackIDs) {
+        ASSERT_TRUE(loaded.getAttack(id) != nullptr);
+        EXPECT_EQ(*loaded.getAttack(id), *original.getAttack(id));
+    }
+    for (int id : ids.attackPatternIDs) {
+        ASSERT_TRUE(loaded.getAttackPattern(id) != nullptr);
+        EXPECT_EQ(loaded.getAttackPattern(id)->toJson(), original.getAttackPattern(id)->toJson());
+    }
+    for (int id : ids.enemyPhaseIDs) {
+        ASSERT_TRUE(loaded.getEnemyPhase(id) != nullptr);
+        EXPECT_EQ(loaded.getEnemyPhase(id)->toJson(), original.getEnemyPhase(id)->toJson());
+    }
+    for (int id : ids.enemyIDs) {
+        ASSERT_TRUE(loaded.getEnemy(id) != nullptr);
+        EXPECT_EQ(loaded.getEnemy(id)->toJson(), original.getEnemy(id)->toJson());
+    }
+}
+
+/*
+Saves a synthetic level pack, then checks that loading it back gives the same objects.
+*/
+TEST(LevelPackTest, SavedPackRoundTrip) {
+    const std::string packName = "LevelPackTest_SavedPackRoundTrip";
+    const std::string packFolder = format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s", packName.c_str());
+    std::filesystem::remove_all(packFolder);
+    std::filesystem::create_directories(packFolder);
+
+    AudioPlayer audioPlayer;
+    std::shared_ptr<SpriteLoader> spriteLoader = std::make_shared<SpriteLoader>(packName);
+
+    LevelPack original(audioPlayer, packName, spriteLoader);
+    SyntheticLevelPackIDs ids = createSyntheticLevelPack(original, 100);
+    LevelPack::SaveMetrics saveMetrics = original.save();
+    EXPECT_EQ(saveMetrics.filesFailed, 0);
+
+    // The constructor loads the level pack
+    LevelPack loaded(audioPlayer, packName, spriteLoader);
+    EXPECT_TRUE(loaded.getSuccessfulLoad());
+    EXPECT_EQ(loaded.getNextAttackID(), original.getNextAttackID());
+    EXPECT_FALSE(loaded.hasAttack(original.getNextAttackID()));
+    expectSameObjects(loaded, original, ids);
+
+    std::filesystem::remove_all(packFolder);
+}
+
+/*
+Cooks a synthetic level pack, then checks that loading the cooked file gives the same objects and that saving a change
+makes the cooked file unusable.
+*/
+TEST(LevelPackTest, CookedPackRoundTrip) {
+    const std::string packName = "LevelPackTest_CookedPackRoundTrip";
+    const std::string packFolder = format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s", packName.c_str());
+    std::filesystem::remove_all(packFolder);
+    std::filesystem::create_directories(packFolder);
+
+    AudioPlayer audioPlayer;
+    std::shared_ptr<SpriteLoader> spriteLoader = std::make_shared<SpriteLoader>(packName);
+
+    LevelPack original(audioPlayer, packName, spriteLoader);
+    SyntheticLevelPackIDs ids = createSyntheticLevelPack(original, 100);
+    original.save();
+    ASSERT_TRUE(original.cook());
+
+    // The constructor loads the cooked file
+    LevelPack cooked(audioPlayer, packName, spriteLoader, true);
+    EXPECT_TRUE(cooked.getSuccessfulLoad());
+    EXPECT_FLOAT_EQ(cooked.searchLargestBulletHitbox(), original.searchLargestBulletHitbox());
+    EXPECT_TRUE(cooked.hasAttack(ids.attackIDs.back()));
+    EXPECT_FALSE(cooked.hasAttack(original.getNextAttackID()));
+    EXPECT_EQ(cooked.getNextAttackID(), original.getNextAttackID());
+    expectSameObjects(cooked, original, ids);
+
+    // Saving a change makes the cooked file out of date, so it must be deleted
+    original.getAttack(ids.attackIDs[0])->setName("changed");
+    original.updateAttack(original.getAttack(ids.attackIDs[0]));
+    original.save();
+    EXPECT_FALSE(std::filesystem::exists(format(RELATIVE_LEVEL_PACK_COOKED_FILE_PATH, packName.c_str())));
+    LevelPack notCooked(audioPlayer, packName, spriteLoader);
+    EXPECT_FALSE(notCooked.loadCooked(false));
+
+    std::filesystem::remove_all(packFolder);
+}
+
+/*
+Saves a synthetic level pack, then checks that saving it again only touches the files of objects
+that were changed or deleted since.
+*/
+TEST(LevelPackTest, SaveOnlyChangedObjects) {
+    const std::string packName = "LevelPackTest_SaveOnlyChangedObjects";
+    const std::string packFolder = format(RELATIVE_LEVEL_PACKS_FOLDER_PATH + "\\%s", packName.c_str());
+    std::filesystem::remove_all(packFolder);
+    std::filesystem::create_directories(packFolder);
+
+    AudioPlayer audioPlayer;
+    std::shared_ptr<SpriteLoader> spriteLoader = std::make_shared<SpriteLoader>(packName);
+
+    LevelPack levelPack(audioPlayer, packName, spriteLoader);
+    SyntheticLevelPackIDs ids = createSyntheticLevelPack(levelPack, 100);
+    LevelPack::SaveMetrics fullSave = levelPack.save();
+    EXPECT_EQ(fullSave.filesFailed, 0);
+    EXPECT_GE(fullSave.filesWritten, (int)(ids.attackIDs.size() + ids.attackPatternIDs.size() + ids.enemyPhaseIDs.size() + ids.enemyIDs.size()));
+
+    // Nothing changed
+    LevelPack::SaveMetrics emptySave = levelPack.save();
+    EXPECT_EQ(emptySave.filesWritten, 0);
+    EXPECT_EQ(emptySave.filesDeleted, 0);
+
+    std::shared_ptr<EditorAttack> attack = levelPack.getAttack(ids.attackIDs[42]);
+    attack->setName("changed");
+    levelPack.updateAttack(attack);
+    LevelPack::SaveMetrics changeSave = levelPack.save();
+    EXPECT_EQ(changeSave.filesWritten, 1);
+    EXPECT_EQ(changeSave.filesDeleted, 0);
+
+    std::string deletedAttackFile = format(RELATIVE_LEVEL_PACK_ATTACKS_FOLDER_NAME + "\\attack%d%s", packName.c_str(),
+        ids.attackIDs[7], LEVEL_PACK_SERIALIZED_DATA_FORMAT.c_str());
+    ASSERT_TRUE(std::filesystem::exists(deletedAttackFile));
+    levelPack.deleteAttack(ids.attackIDs[7]);
+    LevelPack::SaveMetrics deleteSave = levelPack.save();
+    EXPECT_EQ(deleteSave.filesWritten, 0);
+    EXPECT_EQ(deleteSave.filesDeleted, 1);
+    EXPECT_FALSE(std::filesystem::exists(deletedAttackFile));
+
+    // The files must still hold the whole level pack
+    LevelPack loaded(audioPlayer, packName, spriteLoader);
+    EXPECT_EQ(loaded.getAttack(ids.attackIDs[42])->getName(), "changed");
+    EXPECT_FALSE(loaded.hasAttack(ids.attackIDs[7]));
+    EXPECT_EQ(loaded.getAttackPattern(ids.attackPatternIDs[0])->toJson(), levelPack.getAttackPattern(ids.attackPatternIDs[0])->toJson());
+
+    std::filesystem::remove_all(packFolder);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <Constants.h>
+#include <Util/MathUtils.h>
+#include <LevelPack/Animatable.h>
+#include <Game/Components/HitboxComponent.h>
+#include <Game/Components/PositionComponent.h>
+
+TEST(SweptCollidesTest, FastBulletDoesNotTunnel) {
+    HitboxComponent playerHitbox(ROTATION_TYPE::LOCK_ROTATION, 2, 0, 0);
+    HitboxComponent bulletHitbox(ROTATION_TYPE::LOCK_ROTATION, 3, 0, 0);
+    PositionComponent player(100, 100);
+
+    // 1200 px/s at the longest physics tick moves the bullet 40px, jumping over the player
+    float step = 1200 * MAX_PHYSICS_DELTA_TIME;
+    PositionComponent before(100, 100 - step / 2);
+    PositionComponent after(100, 100 + step / 2);
+    EXPECT_FALSE(collides(player, playerHitbox, before, bulletHitbox));
+    EXPECT_FALSE(collides(player, playerHitbox, after, bulletHitbox));
+    EXPECT_TRUE(sweptCollides(player, playerHitbox, before.getX(), before.getY(), after, bulletHitbox));
+}
+
+TEST(SweptCollidesTest, MissesWhenPathIsFarAway) {
+    HitboxComponent playerHitbox(ROTATION_TYPE::LOCK_ROTATION, 2, 0, 0);
+    HitboxComponent bulletHitbox(ROTATION_TYPE::LOCK_ROTATION, 3, 0, 0);
+    PositionComponent player(100, 100);
+
+    // Passes 6px to the side, just out of reach
+    EXPECT_FALSE(sweptCollides(player, playerHitbox, 106, 0, PositionComponent(106, 200), bulletHitbox));
+    // Stops just short of the player
+    EXPECT_FALSE(sweptCollides(player, playerHitbox, 100, 0, PositionComponent(100, 94), bulletHitbox));
+    // Doesn't move at all, so it is the same as the discrete test
+    EXPECT_TRUE(sweptCollides(player, playerHitbox, 100, 96, PositionComponent(100, 96), bulletHitbox));
+}
+
+TEST(SweptCollidesTest, UpdateSweepOnlyWhenFastOrForced) {
+    HitboxComponent hitbox(ROTATION_TYPE::LOCK_ROTATION, 3, 0, 0);
+    EXPECT_FALSE(hitbox.updateSweep(PositionComponent(0, 0)));
+    // Moved less than its radius
+    EXPECT_FALSE(hitbox.updateSweep(PositionComponent(2, 0)));
+    // Moved more than its radius
+    EXPECT_TRUE(hitbox.updateSweep(PositionComponent(10, 0)));
+    EXPECT_EQ(hitbox.getSweepStart(), sf::Vector2f(2, 0));
+
+    hitbox.setContinuousCollision(true);
+    EXPECT_TRUE(hitbox.updateSweep(PositionComponent(11, 0)));
+    EXPECT_FALSE(hitbox.updateSweep(PositionComponent(11, 0)));
+}
+
+TEST(SweptCollidesTest, ResetSweepSkipsJump) {
+    HitboxComponent hitbox(ROTATION_TYPE::LOCK_ROTATION, 3, 0, 0);
+    hitbox.setContinuousCollision(true);
+    EXPECT_FALSE(hitbox.updateSweep(PositionComponent(0, 0)));
+    EXPECT_TRUE(hitbox.updateSweep(PositionComponent(10, 0)));
+
+    // Teleported across the map
+    hitbox.resetSweep();
+    EXPECT_FALSE(hitbox.isSweeping());
+    EXPECT_FALSE(hitbox.updateSweep(PositionComponent(400, 300)));
+    // Continuous motion afterwards is swept from the new position
+    EXPECT_TRUE(hitbox.updateSweep(PositionComponent(405, 300)));
+    EXPECT_EQ(hitbox.getSweepStart(), sf::Vector2f(400, 300));
+}
+
+TEST(CapsuleCollidesTest, CircleVsCapsule) {
+    HitboxComponent circle(ROTATION_TYPE::LOCK_ROTATION, 2, 0, 0);
+    HitboxComponent capsule(ROTATION_TYPE::LOCK_ROTATION, 3, 0, 0);
+    // Laser from (100, 100) to (200, 100)
+    capsule.setCapsule(0, 0, 100, 0);
+    PositionComponent laser(100, 100);
+
+    // Touching the middle of the segment, far from both ends
+    EXPECT_TRUE(collides(PositionComponent(150, 105), circle, laser, capsule));
+    EXPECT_TRUE(collides(laser, capsule, PositionComponent(150, 95), circle));
+    EXPECT_FALSE(collides(PositionComponent(150, 106), circle, laser, capsule));
+    // Rounded ends
+    EXPECT_TRUE(collides(PositionComponent(204, 101), circle, laser, capsule));
+    EXPECT_FALSE(collides(PositionComponent(204, 104), circle, laser, capsule));
+    EXPECT_FALSE(collides(PositionComponent(94, 100), circle, laser, capsule));
+    // Same checks against the activation radius overload
+    EXPECT_TRUE(collides(laser, capsule, PositionComponent(150, 105), 0, 0, 2));
+    EXPECT_FALSE(collides(laser, capsule, PositionComponent(150, 106), 0, 0, 2));
+}
+
+TEST(CapsuleCollidesTest, CapsuleRotatesWithEntity) {
+    HitboxComponent circle(ROTATION_TYPE::LOCK_ROTATION, 1, 0, 0);
+    HitboxComponent capsule(ROTATION_TYPE::ROTATE_WITH_MOVEMENT, 1, 0, 0);
+    capsule.setCapsule(0, 0, 50, 0);
+    EXPECT_FALSE(capsule.isRotationInvariant());
+    EXPECT_EQ(capsule.getBoundingRadius(), 26.0f);
+    PositionComponent laser(0, 0);
+
+    EXPECT_TRUE(collides(PositionComponent(40, 0), circle, laser, capsule));
+    EXPECT_FALSE(collides(PositionComponent(0, 40), circle, laser, capsule));
+
+    // Pointing straight up
+    capsule.rotate(PI / 2, 1, 0);
+    EXPECT_FALSE(collides(PositionComponent(40, 0), circle, laser, capsule));
+    EXPECT_TRUE(collides(PositionComponent(0, 40), circle, laser, capsule));
+
+    HitboxComponent locked(ROTATION_TYPE::LOCK_ROTATION, 1, 0, 0);
+    locked.setCapsule(0, 0, 50, 0);
+    EXPECT_TRUE(locked.isRotationInvariant());
+    EXPECT_FALSE(locked.updateSweep(PositionComponent(0, 0)));
+    EXPECT_FALSE(locked.updateSweep(PositionComponent(500, 0)));
+}
+
+TEST(CapsuleCollidesTest, CapsuleVsCapsule) {
+    HitboxComponent horizontal(ROTATION_TYPE::LOCK_ROTATION, 1, 0, 0);
+    horizontal.setCapsule(-50, 0, 50, 0);
+    HitboxComponent vertical(ROTATION_TYPE::LOCK_ROTATION, 1, 0, 0);
+    vertical.setCapsule(0, -50, 0, 50);
+
+    // Crossing in the middle, where no endpoint is anywhere near the other segment
+    EXPECT_TRUE(collides(PositionComponent(0, 0), horizontal, PositionComponent(10, 10), vertical));
+    // Parallel and 3px apart
+    EXPECT_FALSE(collides(PositionComponent(0, 0), horizontal, PositionComponent(20, 3), horizontal));
+    EXPECT_TRUE(collides(PositionComponent(0, 0), horizontal, PositionComponent(20, 2), horizontal));
+    // T-shape with a 1px gap
+    EXPECT_TRUE(collides(PositionComponent(0, 0), horizontal, PositionComponent(0, 52), vertical));
+    EXPECT_FALSE(collides(PositionComponent(0, 0), horizontal, PositionComponent(0, 53), vertical));
+
+    EXPECT_EQ(segmentDistanceSquared(0, 0, 10, 0, 5, 5, 5, 5), 25.0f);
+    EXPECT_EQ(segmentDistanceSquared(0, 0, 10, 0, 13, 4, 20, 4), 25.0f);
+}